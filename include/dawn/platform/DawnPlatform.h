@@ -44,6 +44,17 @@ enum class TraceCategory {
     GPUWork,     // Actual GPU work
 };
 
+using CachedDataReleaseCallback = void (*)(void* userdata);
+
+// A read-only view of a value held by a CachingInterface, see CachingInterface::LoadDataView.
+struct CachedDataView {
+    const void* data = nullptr;
+    size_t size = 0;
+    // Called with |userdata| once the view isn't used anymore, possibly on another thread.
+    CachedDataReleaseCallback release = nullptr;
+    void* userdata = nullptr;
+};
+
 class DAWN_PLATFORM_EXPORT CachingInterface {
   public:
     CachingInterface();
@@ -63,6 +74,13 @@ class DAWN_PLATFORM_EXPORT CachingInterface {
                            const void* value,
                            size_t valueSize) = 0;
 
+    // LoadDataView is an optional extension of LoadData for caches that already hold their values
+    // in memory, for example in a memory-mapped file. Instead of copying the value corresponding
+    // to the |key|, it returns a view of it in |viewOut| that must stay valid until its release
+    // callback is called. Returns false if the |key| doesn't exist. The default implementation
+    // copies the value in a new allocation with LoadData.
+    virtual bool LoadDataView(const void* key, size_t keySize, CachedDataView* viewOut);
+
   private:
     CachingInterface(const CachingInterface&) = delete;
     CachingInterface& operator=(const CachingInterface&) = delete;
@@ -78,12 +96,25 @@ class DAWN_PLATFORM_EXPORT WaitableEvent {
 
 using PostWorkerTaskCallback = void (*)(void* userdata);
 
+// Hint for the order in which a WorkerTaskPool should start queued tasks.
+enum class TaskPriority {
+    High,    // Work the application is waiting on, like pipeline compilation.
+    Normal,  // Default priority of PostWorkerTask.
+};
+
 class DAWN_PLATFORM_EXPORT WorkerTaskPool {
   public:
     WorkerTaskPool() = default;
     virtual ~WorkerTaskPool() = default;
     virtual std::unique_ptr<WaitableEvent> PostWorkerTask(PostWorkerTaskCallback,
                                                           void* userdata) = 0;
+
+    // Posts a task with a priority hint. Pools that don't support priorities can keep the
+    // default implementation which forwards to PostWorkerTask.
+    virtual std::unique_ptr<WaitableEvent> PostWorkerTaskWithPriority(
+        PostWorkerTaskCallback callback,
+        void* userdata,
+        TaskPriority priority);
 };
 
 // These features map to similarly named ones in src/chromium/src/gpu/config/gpu_finch_features.h
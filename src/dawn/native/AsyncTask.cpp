@@ -28,54 +28,155 @@
 #include "dawn/native/AsyncTask.h"
 
 #include <utility>
+#include <vector>
 
+#include "dawn/common/Assert.h"
 #include "dawn/platform/DawnPlatform.h"
 
 namespace dawn::native {
 
+AsyncTaskHandle::AsyncTaskHandle(AsyncTaskManager* taskManager,
+                                 AsyncTask asyncTask,
+                                 AsyncTask cancelTask)
+    : mTaskManager(taskManager),
+      mAsyncTask(std::move(asyncTask)),
+      mCancelTask(std::move(cancelTask)),
+      mIsCancellable(mCancelTask != nullptr) {}
+
+AsyncTaskHandle::~AsyncTaskHandle() = default;
+
+bool AsyncTaskHandle::TryStart() {
+    State expected = State::Pending;
+    return mState.compare_exchange_strong(expected, State::Running);
+}
+
+bool AsyncTaskHandle::Cancel() {
+    if (!mIsCancellable || !TryStart()) {
+        return false;
+    }
+    mTaskManager->RunStartedTask(this, true);
+    return true;
+}
+
+bool AsyncTaskHandle::RunNow() {
+    if (!TryStart()) {
+        return false;
+    }
+    mTaskManager->RunStartedTask(this, false);
+    return true;
+}
+
+void AsyncTaskHandle::Wait() {
+    mTaskManager->WaitForTask(this);
+}
+
+bool AsyncTaskHandle::HasStarted() const {
+    return mState.load() != State::Pending;
+}
+
+bool AsyncTaskHandle::IsFinished() const {
+    return mState.load() == State::Finished;
+}
+
+bool AsyncTaskHandle::WasCancelled() const {
+    return mWasCancelled.load();
+}
+
 AsyncTaskManager::AsyncTaskManager(dawn::platform::WorkerTaskPool* workerTaskPool)
     : mWorkerTaskPool(workerTaskPool) {}
 
-void AsyncTaskManager::PostTask(AsyncTask asyncTask) {
+Ref<AsyncTaskHandle> AsyncTaskManager::PostTask(AsyncTask asyncTask) {
+    return PostTask(std::move(asyncTask), dawn::platform::TaskPriority::Normal);
+}
+
+Ref<AsyncTaskHandle> AsyncTaskManager::PostTask(AsyncTask asyncTask,
+                                                dawn::platform::TaskPriority priority) {
+    return PostCancellableTask(std::move(asyncTask), nullptr, priority);
+}
+
+Ref<AsyncTaskHandle> AsyncTaskManager::PostCancellableTask(AsyncTask asyncTask,
+                                                           AsyncTask cancelTask,
+                                                           dawn::platform::TaskPriority priority) {
     // If these allocations becomes expensive, we can slab-allocate tasks.
-    Ref<WaitableTask> waitableTask = AcquireRef(new WaitableTask());
-    waitableTask->taskManager = this;
-    waitableTask->asyncTask = std::move(asyncTask);
+    Ref<AsyncTaskHandle> task =
+        AcquireRef(new AsyncTaskHandle(this, std::move(asyncTask), std::move(cancelTask)));
 
     {
-        // We insert new waitableTask objects into mPendingTasks in main thread (PostTask()),
-        // and we may remove waitableTask objects from mPendingTasks in either main thread
-        // (WaitAllPendingTasks()) or sub-thread (TaskCompleted), so mPendingTasks should be
-        // protected by a mutex.
+        // We insert new tasks into mPendingTasks in main thread (PostTask()), and we may remove
+        // them from mPendingTasks in either main thread (Cancel() or RunNow()) or sub-thread
+        // (DoWaitableTask), so mPendingTasks should be protected by a mutex.
         std::lock_guard<std::mutex> lock(mPendingTasksMutex);
-        mPendingTasks.emplace(waitableTask.Get(), waitableTask);
+        mPendingTasks.emplace(task.Get(), task);
     }
 
-    // Ref the task since it is accessed inside the worker function.
-    // The worker function will acquire and release the task upon completion.
-    waitableTask->Reference();
-    waitableTask->waitableEvent =
-        mWorkerTaskPool->PostWorkerTask(DoWaitableTask, waitableTask.Get());
+    // Ref the task since it is accessed inside the worker function. The worker function will
+    // acquire and release the task upon completion. Completion is tracked by the task itself so
+    // the event returned by the pool isn't needed.
+    task->Reference();
+    mWorkerTaskPool->PostWorkerTaskWithPriority(DoWaitableTask, task.Get(), priority);
+
+    return task;
+}
+
+void AsyncTaskManager::RunStartedTask(AsyncTaskHandle* task, bool cancel) {
+    DAWN_ASSERT(task->mState.load() == AsyncTaskHandle::State::Running);
+    if (cancel) {
+        task->mWasCancelled = true;
+        task->mCancelTask();
+    } else {
+        task->mAsyncTask();
+    }
+    // Release the captured state now as the task may stay referenced by the worker thread for a
+    // while if it was cancelled or stolen.
+    task->mAsyncTask = nullptr;
+    task->mCancelTask = nullptr;
+
+    // The Ref in mPendingTasks is released after the lock is released: it may be the last
+    // reference to the task.
+    Ref<AsyncTaskHandle> pendingTaskRef;
+    {
+        std::lock_guard<std::mutex> lock(mPendingTasksMutex);
+        task->mState = AsyncTaskHandle::State::Finished;
+        auto iter = mPendingTasks.find(task);
+        if (iter != mPendingTasks.end()) {
+            pendingTaskRef = std::move(iter->second);
+            mPendingTasks.erase(iter);
+        }
+        // Notify while the lock is held so that the manager can't be destroyed by a waiter
+        // before the notification is done.
+        mTaskFinishedCondition.notify_all();
+    }
 }
 
-void AsyncTaskManager::HandleTaskCompletion(WaitableTask* task) {
+void AsyncTaskManager::WaitForTask(AsyncTaskHandle* task) {
+    std::unique_lock<std::mutex> lock(mPendingTasksMutex);
+    mTaskFinishedCondition.wait(lock, [task] { return task->IsFinished(); });
+}
+
+std::vector<Ref<AsyncTaskHandle>> AsyncTaskManager::GetAllPendingTasks() {
     std::lock_guard<std::mutex> lock(mPendingTasksMutex);
-    auto iter = mPendingTasks.find(task);
-    if (iter != mPendingTasks.end()) {
-        mPendingTasks.erase(iter);
+    std::vector<Ref<AsyncTaskHandle>> allPendingTasks;
+    allPendingTasks.reserve(mPendingTasks.size());
+    for (auto& [_, task] : mPendingTasks) {
+        allPendingTasks.push_back(task);
     }
+    return allPendingTasks;
 }
 
 void AsyncTaskManager::WaitAllPendingTasks() {
-    std::unordered_map<WaitableTask*, Ref<WaitableTask>> allPendingTasks;
-
-    {
-        std::lock_guard<std::mutex> lock(mPendingTasksMutex);
-        allPendingTasks.swap(mPendingTasks);
+    std::vector<Ref<AsyncTaskHandle>> allPendingTasks = GetAllPendingTasks();
+    for (Ref<AsyncTaskHandle>& task : allPendingTasks) {
+        WaitForTask(task.Get());
     }
+}
 
-    for (auto& [_, task] : allPendingTasks) {
-        task->waitableEvent->Wait();
+void AsyncTaskManager::CancelAllPendingTasks() {
+    std::vector<Ref<AsyncTaskHandle>> allPendingTasks = GetAllPendingTasks();
+    for (Ref<AsyncTaskHandle>& task : allPendingTasks) {
+        task->Cancel();
+    }
+    for (Ref<AsyncTaskHandle>& task : allPendingTasks) {
+        WaitForTask(task.Get());
     }
 }
 
@@ -85,13 +186,13 @@ bool AsyncTaskManager::HasPendingTasks() {
 }
 
 void AsyncTaskManager::DoWaitableTask(void* task) {
-    Ref<WaitableTask> waitableTask = AcquireRef(static_cast<WaitableTask*>(task));
-    waitableTask->asyncTask();
-    waitableTask->taskManager->HandleTaskCompletion(waitableTask.Get());
+    Ref<AsyncTaskHandle> waitableTask = AcquireRef(static_cast<AsyncTaskHandle*>(task));
+    // The task was cancelled or stolen by another thread, which is responsible for finishing it.
+    // Don't touch the task manager as it may already be destroyed.
+    if (!waitableTask->TryStart()) {
+        return;
+    }
+    waitableTask->mTaskManager->RunStartedTask(waitableTask.Get(), false);
 }
 
-AsyncTaskManager::WaitableTask::WaitableTask() = default;
-
-AsyncTaskManager::WaitableTask::~WaitableTask() = default;
-
 }  // namespace dawn::native
@@ -28,52 +28,103 @@
 #ifndef SRC_DAWN_NATIVE_ASYNCTASK_H_
 #define SRC_DAWN_NATIVE_ASYNCTASK_H_
 
+#include <atomic>
+#include <condition_variable>
 #include <functional>
 #include <memory>
 #include <mutex>
 #include <unordered_map>
+#include <vector>
 
 #include "dawn/common/Ref.h"
 #include "dawn/common/RefCounted.h"
 
 namespace dawn::platform {
-class WaitableEvent;
 class WorkerTaskPool;
+enum class TaskPriority;
 }  // namespace dawn::platform
 
 namespace dawn::native {
 
-// TODO(crbug.com/dawn/826): we'll add additional things to AsyncTask in the future, like
-// Cancel() and RunNow(). Cancelling helps avoid running the task's body when we are just
-// shutting down the device. RunNow() could be used for more advanced scenarios, for example
-// always doing ShaderModule initial compilation asynchronously, but being able to steal the
-// task if we need it for synchronous pipeline compilation.
 using AsyncTask = std::function<void()>;
 
+class AsyncTaskManager;
+
+// Handle to a task posted to the AsyncTaskManager. Until a worker thread starts the task, it can be
+// cancelled, for example when the device is shutting down, or stolen to run on the current thread
+// when its result is needed synchronously.
+class AsyncTaskHandle : public RefCounted {
+  public:
+    ~AsyncTaskHandle() override;
+
+    // Cancels the task if no thread started it yet, in which case its cancellation task is run on
+    // the current thread instead of the task itself. Returns false if the task isn't cancellable
+    // or was already started.
+    bool Cancel();
+
+    // Runs the task on the current thread if no thread started it yet. Returns false if the task
+    // was already started, in which case Wait() can be used to wait for it to finish.
+    bool RunNow();
+    void Wait();
+
+    bool HasStarted() const;
+    bool IsFinished() const;
+    bool WasCancelled() const;
+
+  private:
+    friend class AsyncTaskManager;
+
+    enum class State {
+        Pending,
+        Running,
+        Finished,
+    };
+
+    AsyncTaskHandle(AsyncTaskManager* taskManager, AsyncTask asyncTask, AsyncTask cancelTask);
+
+    // Moves the task from Pending to Running. Only the thread that succeeds runs the task.
+    bool TryStart();
+
+    AsyncTaskManager* mTaskManager;
+    // Only accessed by the thread that started the task, after TryStart() succeeded.
+    AsyncTask mAsyncTask;
+    AsyncTask mCancelTask;
+    const bool mIsCancellable;
+    std::atomic<State> mState = State::Pending;
+    std::atomic<bool> mWasCancelled = false;
+};
+
 class AsyncTaskManager {
   public:
     explicit AsyncTaskManager(dawn::platform::WorkerTaskPool* workerTaskPool);
 
-    void PostTask(AsyncTask asyncTask);
+    Ref<AsyncTaskHandle> PostTask(AsyncTask asyncTask);
+    Ref<AsyncTaskHandle> PostTask(AsyncTask asyncTask, dawn::platform::TaskPriority priority);
+
+    // Posts a task that can be cancelled until it starts. |cancelTask| is run instead of
+    // |asyncTask| on the cancelling thread, so that the task can still report its result.
+    Ref<AsyncTaskHandle> PostCancellableTask(AsyncTask asyncTask,
+                                             AsyncTask cancelTask,
+                                             dawn::platform::TaskPriority priority);
+
     void WaitAllPendingTasks();
+    // Cancels all the cancellable tasks that haven't started yet, then waits for the others.
+    void CancelAllPendingTasks();
     bool HasPendingTasks();
 
   private:
-    class WaitableTask : public RefCounted {
-      public:
-        WaitableTask();
-        ~WaitableTask() override;
-
-        AsyncTask asyncTask;
-        AsyncTaskManager* taskManager;
-        std::unique_ptr<dawn::platform::WaitableEvent> waitableEvent;
-    };
+    friend class AsyncTaskHandle;
 
     static void DoWaitableTask(void* task);
-    void HandleTaskCompletion(WaitableTask* task);
+    // Runs the body of a task that was started by the current thread and marks it finished.
+    void RunStartedTask(AsyncTaskHandle* task, bool cancel);
+    void WaitForTask(AsyncTaskHandle* task);
+    std::vector<Ref<AsyncTaskHandle>> GetAllPendingTasks();
 
+    // Protects mPendingTasks and the transitions of tasks to the Finished state.
     std::mutex mPendingTasksMutex;
-    std::unordered_map<WaitableTask*, Ref<WaitableTask>> mPendingTasks;
+    std::condition_variable mTaskFinishedCondition;
+    std::unordered_map<AsyncTaskHandle*, Ref<AsyncTaskHandle>> mPendingTasks;
     dawn::platform::WorkerTaskPool* mWorkerTaskPool;
 };
 
@@ -28,6 +28,7 @@
 #include "dawn/native/BindGroup.h"
 
 #include "dawn/common/Assert.h"
+#include "dawn/common/HashUtils.h"
 #include "dawn/common/Math.h"
 #include "dawn/common/ityp_bitset.h"
 #include "dawn/native/BindGroupLayout.h"
@@ -395,6 +396,14 @@ MaybeError ValidateBindGroupDescriptor(DeviceBase* device,
 BindGroupBase::BindGroupBase(DeviceBase* device,
                              const BindGroupDescriptor* descriptor,
                              void* bindingDataStart)
+    : BindGroupBase(device, descriptor, bindingDataStart, kUntrackedByDevice) {
+    GetObjectTrackingList()->Track(this);
+}
+
+BindGroupBase::BindGroupBase(DeviceBase* device,
+                             const BindGroupDescriptor* descriptor,
+                             void* bindingDataStart,
+                             ApiObjectBase::UntrackedByDeviceTag tag)
     : ApiObjectBase(device, descriptor->label),
       mLayout(descriptor->layout),
       mBindingData(GetLayout()->ComputeBindingDataPointers(bindingDataStart)) {
@@ -481,13 +490,12 @@ BindGroupBase::BindGroupBase(DeviceBase* device,
                                                 mBindingData.unverifiedBufferSizes[packedIndex] =
                                                     mBindingData.bufferData[bindingIndex].size;
                                             });
-
-    GetObjectTrackingList()->Track(this);
 }
 
 BindGroupBase::~BindGroupBase() = default;
 
 void BindGroupBase::DestroyImpl() {
+    Uncache();
     if (mLayout != nullptr) {
         DAWN_ASSERT(!IsError());
         for (BindingIndex i{0}; i < GetLayout()->GetBindingCount(); ++i) {
@@ -578,4 +586,80 @@ void BindGroupBase::ForEachUnverifiedBufferBindingIndex(
     ForEachUnverifiedBufferBindingIndexImpl(GetLayout(), fn);
 }
 
+bool BindGroupBase::IsCacheable() const {
+    DAWN_ASSERT(!IsError());
+    if (!mBoundExternalTextures.empty()) {
+        return false;
+    }
+    // Buffers and textures are removed from their tracking list when they are destroyed, and the
+    // texture views along with their texture.
+    for (BindingIndex i{0}; i < GetLayout()->GetBindingCount(); ++i) {
+        if (!static_cast<const ApiObjectBase*>(mBindingData.bindings[i].Get())->IsAlive()) {
+            return false;
+        }
+    }
+    return true;
+}
+
+size_t BindGroupBase::ComputeContentHash() {
+    // The resources are hashed by pointer, unlike for other cached objects, because bind groups
+    // can only be equal if they reference the exact same resources.
+    size_t hash = 0;
+    HashCombine(&hash, mLayout.Get());
+
+    const BindGroupLayoutInternalBase* layout = GetLayout();
+    for (BindingIndex i{0}; i < layout->GetBindingCount(); ++i) {
+        HashCombine(&hash, mBindingData.bindings[i].Get());
+        if (layout->GetBindingInfo(i).bindingType == BindingInfoType::Buffer) {
+            HashCombine(&hash, mBindingData.bufferData[i].offset, mBindingData.bufferData[i].size);
+        }
+    }
+    return hash;
+}
+
+bool BindGroupBase::EqualityFunc::operator()(const BindGroupBase* a,
+                                             const BindGroupBase* b) const {
+    if (a == b) {
+        return true;
+    }
+    if (a->mLayout.Get() != b->mLayout.Get()) {
+        return false;
+    }
+
+    // Bind groups that reference a destroyed resource are stale and never returned by the cache.
+    if (!a->IsCacheable() || !b->IsCacheable()) {
+        return false;
+    }
+
+    const BindGroupLayoutInternalBase* layout = a->GetLayout();
+    for (BindingIndex i{0}; i < layout->GetBindingCount(); ++i) {
+        if (a->mBindingData.bindings[i].Get() != b->mBindingData.bindings[i].Get()) {
+            return false;
+        }
+        if (layout->GetBindingInfo(i).bindingType == BindingInfoType::Buffer &&
+            (a->mBindingData.bufferData[i].offset != b->mBindingData.bufferData[i].offset ||
+             a->mBindingData.bufferData[i].size != b->mBindingData.bufferData[i].size)) {
+            return false;
+        }
+    }
+    return true;
+}
+
+// BindGroupBlueprint
+
+detail::BindGroupBlueprintDataHolder::BindGroupBlueprintDataHolder(size_t size)
+    // operator new[] returns a pointer aligned enough for the binding data.
+    : mBindingDataAllocation(new uint8_t[size]) {}
+
+BindGroupBlueprint::BindGroupBlueprint(DeviceBase* device, const BindGroupDescriptor* descriptor)
+    : BindGroupBlueprintDataHolder(
+          descriptor->layout->GetInternalBindGroupLayout()->GetBindingDataSize()),
+      BindGroupBase(device, descriptor, mBindingDataAllocation.get(), kUntrackedByDevice) {}
+
+BindGroupBlueprint::~BindGroupBlueprint() {
+    // The blueprint isn't tracked by the device so DestroyImpl, which releases the references to
+    // the resources, needs to be called explicitly before the binding data is freed.
+    BindGroupBase::DestroyImpl();
+}
+
 }  // namespace dawn::native
@@ -29,11 +29,14 @@
 #define SRC_DAWN_NATIVE_BINDGROUP_H_
 
 #include <array>
+#include <memory>
 #include <vector>
 
 #include "dawn/common/Constants.h"
+#include "dawn/common/ContentLessObjectCacheable.h"
 #include "dawn/common/Math.h"
 #include "dawn/native/BindGroupLayout.h"
+#include "dawn/native/CachedObject.h"
 #include "dawn/native/Error.h"
 #include "dawn/native/Forward.h"
 #include "dawn/native/ObjectBase.h"
@@ -55,7 +58,9 @@ struct BufferBinding {
     uint64_t size;
 };
 
-class BindGroupBase : public ApiObjectBase {
+class BindGroupBase : public ApiObjectBase,
+                      public CachedObject,
+                      public ContentLessObjectCacheable<BindGroupBase> {
   public:
     static BindGroupBase* MakeError(DeviceBase* device, const char* label);
 
@@ -74,6 +79,19 @@ class BindGroupBase : public ApiObjectBase {
 
     void ForEachUnverifiedBufferBindingIndex(std::function<void(BindingIndex, uint32_t)> fn) const;
 
+    // Returns whether the bind group can be deduplicated by the device. Bind groups with external
+    // textures, or that reference a destroyed resource, are never deduplicated.
+    bool IsCacheable() const;
+
+    // Functions necessary for the unordered_set<BindGroupBase*>-based cache. Bind groups are
+    // equal if they have the same layout and reference the same resources with the same buffer
+    // ranges, so the hash is only meaningful for the lifetime of the resources.
+    size_t ComputeContentHash() override;
+
+    struct EqualityFunc {
+        bool operator()(const BindGroupBase* a, const BindGroupBase* b) const;
+    };
+
   protected:
     // To save memory, the size of a bind group is dynamically determined and the bind group is
     // placement-allocated into memory big enough to hold the bind group with its
@@ -82,6 +100,10 @@ class BindGroupBase : public ApiObjectBase {
     BindGroupBase(DeviceBase* device,
                   const BindGroupDescriptor* descriptor,
                   void* bindingDataStart);
+    BindGroupBase(DeviceBase* device,
+                  const BindGroupDescriptor* descriptor,
+                  void* bindingDataStart,
+                  ApiObjectBase::UntrackedByDeviceTag tag);
 
     // Helper to instantiate BindGroupBase. We pass in |derived| because BindGroupBase may not
     // be first in the allocation. The binding data is stored after the Derived class.
@@ -112,6 +134,28 @@ class BindGroupBase : public ApiObjectBase {
     std::vector<Ref<ExternalTextureBase>> mBoundExternalTextures;
 };
 
+namespace detail {
+
+// Helper class so |BindGroupBlueprint| can allocate memory for its binding data, before calling
+// the BindGroupBase base class constructor.
+class BindGroupBlueprintDataHolder {
+  protected:
+    explicit BindGroupBlueprintDataHolder(size_t size);
+
+    std::unique_ptr<uint8_t[]> mBindingDataAllocation;
+};
+
+}  // namespace detail
+
+// A frontend-only bind group that is used to look up the bind group cache of the device. Like in
+// the Null backend, the binding data is kept in a separate allocation.
+class BindGroupBlueprint final : private detail::BindGroupBlueprintDataHolder,
+                                 public BindGroupBase {
+  public:
+    BindGroupBlueprint(DeviceBase* device, const BindGroupDescriptor* descriptor);
+    ~BindGroupBlueprint() override;
+};
+
 }  // namespace dawn::native
 
 #endif  // SRC_DAWN_NATIVE_BINDGROUP_H_
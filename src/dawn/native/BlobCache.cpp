@@ -28,6 +28,7 @@
 #include "dawn/native/BlobCache.h"
 
 #include <algorithm>
+#include <utility>
 
 #include "dawn/common/Assert.h"
 #include "dawn/common/Version_autogen.h"
@@ -59,16 +60,25 @@ Blob BlobCache::LoadInternal(const CacheKey& key) {
     if (mCache == nullptr) {
         return Blob();
     }
-    const size_t expectedSize = mCache->LoadData(key.data(), key.size(), nullptr, 0);
-    if (expectedSize > 0) {
-        // Need to put this inside to trigger copy elision.
-        Blob result = CreateBlob(expectedSize);
-        const size_t actualSize =
-            mCache->LoadData(key.data(), key.size(), result.Data(), expectedSize);
-        DAWN_ASSERT(expectedSize == actualSize);
-        return result;
+    dawn::platform::CachedDataView view;
+    if (!mCache->LoadDataView(key.data(), key.size(), &view)) {
+        return Blob();
+    }
+    auto Release = [release = view.release, userdata = view.userdata] {
+        if (release != nullptr) {
+            release(userdata);
+        }
+    };
+    if (view.size == 0) {
+        Release();
+        return Blob();
     }
-    return Blob();
+
+    // The blob borrows the cached bytes instead of copying them. Blobs loaded from the cache are
+    // only ever read so it is fine to drop the const.
+    DAWN_ASSERT(view.data != nullptr);
+    return Blob::UnsafeCreateWithDeleter(static_cast<uint8_t*>(const_cast<void*>(view.data)),
+                                         view.size, std::move(Release));
 }
 
 void BlobCache::StoreInternal(const CacheKey& key, size_t valueSize, const void* value) {
@@ -37,6 +37,120 @@
 
 namespace dawn::native {
 
+namespace {
+
+void FreeBlocks(CommandBlockPool* blockPool, const CommandBlocks& blocks) {
+    if (blockPool != nullptr) {
+        blockPool->DeallocateBlocks(blocks);
+        return;
+    }
+    for (const BlockDef& block : blocks) {
+        free(block.block);
+    }
+}
+
+}  // anonymous namespace
+
+// CommandBlockPool
+
+CommandBlockPool::CommandBlockPool() = default;
+
+CommandBlockPool::~CommandBlockPool() {
+    for (SizeClass& sizeClass : mSizeClasses) {
+        DAWN_ASSERT(sizeClass.inUseCount == 0);
+        for (uint8_t* block : sizeClass.freeBlocks) {
+            free(block);
+        }
+    }
+}
+
+// static
+size_t CommandBlockPool::GetBlockSize(size_t minimumSize) {
+    if (minimumSize > kMaxPooledBlockSize) {
+        return minimumSize;
+    }
+    return std::max(kMinPooledBlockSize, static_cast<size_t>(NextPowerOfTwo(minimumSize)));
+}
+
+// static
+size_t CommandBlockPool::GetSizeClassIndex(size_t size) {
+    DAWN_ASSERT(IsPowerOfTwo(size));
+    DAWN_ASSERT(size >= kMinPooledBlockSize && size <= kMaxPooledBlockSize);
+    return Log2(uint64_t(size)) - ConstexprLog2(kMinPooledBlockSize);
+}
+
+uint8_t* CommandBlockPool::AllocateBlock(size_t size) {
+    DAWN_ASSERT(size == GetBlockSize(size));
+    if (size > kMaxPooledBlockSize) {
+        return static_cast<uint8_t*>(malloc(size));
+    }
+
+    {
+        std::lock_guard<std::mutex> lock(mMutex);
+        SizeClass& sizeClass = mSizeClasses[GetSizeClassIndex(size)];
+        mAllocationCount++;
+        sizeClass.inUseCount++;
+        sizeClass.peakInUseCount = std::max(sizeClass.peakInUseCount, sizeClass.inUseCount);
+
+        if (!sizeClass.freeBlocks.empty()) {
+            uint8_t* block = sizeClass.freeBlocks.back();
+            sizeClass.freeBlocks.pop_back();
+            mReuseCount++;
+            return block;
+        }
+    }
+
+    // Allocate outside of the lock so that other threads are not blocked on malloc.
+    uint8_t* block = static_cast<uint8_t*>(malloc(size));
+    if (DAWN_UNLIKELY(block == nullptr)) {
+        std::lock_guard<std::mutex> lock(mMutex);
+        mSizeClasses[GetSizeClassIndex(size)].inUseCount--;
+    }
+    return block;
+}
+
+void CommandBlockPool::DeallocateBlocks(const CommandBlocks& blocks) {
+    std::lock_guard<std::mutex> lock(mMutex);
+    for (const BlockDef& block : blocks) {
+        if (block.size > kMaxPooledBlockSize) {
+            free(block.block);
+            continue;
+        }
+        SizeClass& sizeClass = mSizeClasses[GetSizeClassIndex(block.size)];
+        DAWN_ASSERT(sizeClass.inUseCount > 0);
+        sizeClass.inUseCount--;
+        sizeClass.freeBlocks.push_back(block.block);
+    }
+}
+
+void CommandBlockPool::Trim() {
+    std::lock_guard<std::mutex> lock(mMutex);
+    for (SizeClass& sizeClass : mSizeClasses) {
+        // Keep enough blocks cached to reach the high-water mark of the last period again
+        // without allocating, and free the rest.
+        size_t blocksToKeep = sizeClass.peakInUseCount - sizeClass.inUseCount;
+        while (sizeClass.freeBlocks.size() > blocksToKeep) {
+            free(sizeClass.freeBlocks.back());
+            sizeClass.freeBlocks.pop_back();
+        }
+        sizeClass.peakInUseCount = sizeClass.inUseCount;
+    }
+}
+
+CommandBlockPool::Stats CommandBlockPool::GetStats() const {
+    std::lock_guard<std::mutex> lock(mMutex);
+    Stats stats;
+    stats.allocationCount = mAllocationCount;
+    stats.reuseCount = mReuseCount;
+    for (size_t i = 0; i < kSizeClassCount; ++i) {
+        stats.cachedBlockCount += mSizeClasses[i].freeBlocks.size();
+        stats.cachedBlockBytes += mSizeClasses[i].freeBlocks.size() * (kMinPooledBlockSize << i);
+    }
+    return stats;
+}
+
+// CommandIterator
+
 // TODO(cwallez@chromium.org): figure out a way to have more type safety for the iterator
 
 CommandIterator::CommandIterator() {
@@ -50,6 +164,7 @@ CommandIterator::~CommandIterator() {
 CommandIterator::CommandIterator(CommandIterator&& other) {
     if (!other.IsEmpty()) {
         mBlocks = std::move(other.mBlocks);
+        mBlockPool = other.mBlockPool;
         other.Reset();
     }
     Reset();
@@ -59,13 +174,15 @@ CommandIterator& CommandIterator::operator=(CommandIterator&& other) {
     DAWN_ASSERT(IsEmpty());
     if (!other.IsEmpty()) {
         mBlocks = std::move(other.mBlocks);
+        mBlockPool = other.mBlockPool;
         other.Reset();
     }
     Reset();
     return *this;
 }
 
-CommandIterator::CommandIterator(CommandAllocator allocator) : mBlocks(allocator.AcquireBlocks()) {
+CommandIterator::CommandIterator(CommandAllocator allocator)
+    : mBlocks(allocator.AcquireBlocks()), mBlockPool(allocator.mBlockPool) {
     Reset();
 }
 
@@ -75,6 +192,9 @@ void CommandIterator::AcquireCommandBlocks(std::vector<CommandAllocator> allocat
     for (CommandAllocator& allocator : allocators) {
         CommandBlocks blocks = allocator.AcquireBlocks();
         if (!blocks.empty()) {
+            // All the blocks must be returned to the same pool.
+            DAWN_ASSERT(mBlocks.empty() || mBlockPool == allocator.mBlockPool);
+            mBlockPool = allocator.mBlockPool;
             mBlocks.reserve(mBlocks.size() + blocks.size());
             for (BlockDef& block : blocks) {
                 mBlocks.push_back(std::move(block));
@@ -115,9 +235,7 @@ void CommandIterator::MakeEmptyAsDataWasDestroyed() {
         return;
     }
 
-    for (BlockDef& block : mBlocks) {
-        free(block.block);
-    }
+    FreeBlocks(mBlockPool, mBlocks);
     mBlocks.clear();
     Reset();
     DAWN_ASSERT(IsEmpty());
@@ -137,7 +255,9 @@ bool CommandIterator::IsEmpty() const {
 //  - Better block allocation, maybe have Dawn API to say command buffer is going to have size
 //    close to another
 
-CommandAllocator::CommandAllocator() {
+CommandAllocator::CommandAllocator() : CommandAllocator(nullptr) {}
+
+CommandAllocator::CommandAllocator(CommandBlockPool* blockPool) : mBlockPool(blockPool) {
     ResetPointers();
 }
 
@@ -146,7 +266,9 @@ CommandAllocator::~CommandAllocator() {
 }
 
 CommandAllocator::CommandAllocator(CommandAllocator&& other)
-    : mBlocks(std::move(other.mBlocks)), mLastAllocationSize(other.mLastAllocationSize) {
+    : mBlocks(std::move(other.mBlocks)),
+      mBlockPool(other.mBlockPool),
+      mLastAllocationSize(other.mLastAllocationSize) {
     other.mBlocks.clear();
     if (!other.IsEmpty()) {
         mCurrentPtr = other.mCurrentPtr;
@@ -159,6 +281,7 @@ CommandAllocator::CommandAllocator(CommandAllocator&& other)
 
 CommandAllocator& CommandAllocator::operator=(CommandAllocator&& other) {
     Reset();
+    mBlockPool = other.mBlockPool;
     if (!other.IsEmpty()) {
         std::swap(mBlocks, other.mBlocks);
         mLastAllocationSize = other.mLastAllocationSize;
@@ -170,9 +293,7 @@ CommandAllocator& CommandAllocator::operator=(CommandAllocator&& other) {
 }
 
 void CommandAllocator::Reset() {
-    for (BlockDef& block : mBlocks) {
-        free(block.block);
-    }
+    FreeBlocks(mBlockPool, mBlocks);
     mBlocks.clear();
     mLastAllocationSize = kDefaultBaseAllocationSize;
     ResetPointers();
@@ -220,7 +341,14 @@ bool CommandAllocator::GetNewBlock(size_t minimumSize) {
     // Allocate blocks doubling sizes each time, to a maximum of 16k (or at least minimumSize).
     mLastAllocationSize = std::max(minimumSize, std::min(mLastAllocationSize * 2, size_t(16384)));
 
-    uint8_t* block = static_cast<uint8_t*>(malloc(mLastAllocationSize));
+    uint8_t* block;
+    if (mBlockPool != nullptr) {
+        // Round up to the pool's size class so the block can be recycled.
+        mLastAllocationSize = CommandBlockPool::GetBlockSize(mLastAllocationSize);
+        block = mBlockPool->AllocateBlock(mLastAllocationSize);
+    } else {
+        block = static_cast<uint8_t*>(malloc(mLastAllocationSize));
+    }
     if (DAWN_UNLIKELY(block == nullptr)) {
         return false;
     }
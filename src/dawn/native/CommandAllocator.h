@@ -28,9 +28,11 @@
 #ifndef SRC_DAWN_NATIVE_COMMANDALLOCATOR_H_
 #define SRC_DAWN_NATIVE_COMMANDALLOCATOR_H_
 
+#include <array>
 #include <cstddef>
 #include <cstdint>
 #include <limits>
+#include <mutex>
 #include <vector>
 
 #include "dawn/common/Assert.h"
@@ -81,6 +83,58 @@ constexpr uint32_t kAdditionalData = std::numeric_limits<uint32_t>::max() - 1;
 
 class CommandAllocator;
 
+// A thread-safe cache of command blocks that is shared by all the CommandAllocators of a device.
+// Blocks are sorted in power-of-two size classes so that the blocks released when a command buffer
+// is destroyed can be reused by the next encoders instead of going back to malloc. Blocks larger
+// than kMaxPooledBlockSize are not pooled.
+class CommandBlockPool : public NonCopyable {
+  public:
+    static constexpr size_t kMinPooledBlockSize = 2048;
+    static constexpr size_t kMaxPooledBlockSize = 16384;
+
+    struct Stats {
+        // The number of blocks handed out by the pool, and how many of them were reused.
+        uint64_t allocationCount = 0;
+        uint64_t reuseCount = 0;
+        // The number of blocks (and their total size) currently cached in the pool.
+        size_t cachedBlockCount = 0;
+        size_t cachedBlockBytes = 0;
+    };
+
+    CommandBlockPool();
+    ~CommandBlockPool();
+
+    // Returns the size of the block the pool allocates for a request of |minimumSize| bytes.
+    static size_t GetBlockSize(size_t minimumSize);
+
+    // |size| must be a value returned by GetBlockSize. Returns nullptr on OOM.
+    uint8_t* AllocateBlock(size_t size);
+    // Returns the blocks to the pool, or frees them if they are too large to be pooled.
+    void DeallocateBlocks(const CommandBlocks& blocks);
+
+    // Frees the cached blocks that were not needed to serve the peak number of blocks in use
+    // since the last call to Trim.
+    void Trim();
+
+    Stats GetStats() const;
+
+  private:
+    static constexpr size_t kSizeClassCount =
+        ConstexprLog2(kMaxPooledBlockSize) - ConstexprLog2(kMinPooledBlockSize) + 1;
+    static size_t GetSizeClassIndex(size_t size);
+
+    struct SizeClass {
+        std::vector<uint8_t*> freeBlocks;
+        size_t inUseCount = 0;
+        size_t peakInUseCount = 0;
+    };
+
+    mutable std::mutex mMutex;
+    std::array<SizeClass, kSizeClassCount> mSizeClasses;
+    uint64_t mAllocationCount = 0;
+    uint64_t mReuseCount = 0;
+};
+
 class CommandIterator : public NonCopyable {
   public:
     CommandIterator();
@@ -154,6 +208,8 @@ class CommandIterator : public NonCopyable {
     }
 
     CommandBlocks mBlocks;
+    // The pool the blocks are returned to when they are destroyed, if any.
+    CommandBlockPool* mBlockPool = nullptr;
     uint8_t* mCurrentPtr = nullptr;
     size_t mCurrentBlock = 0;
     // Used to avoid a special case for empty iterators.
@@ -163,6 +219,8 @@ class CommandIterator : public NonCopyable {
 class CommandAllocator : public NonCopyable {
   public:
     CommandAllocator();
+    // Blocks are taken from and returned to |blockPool| when it is not null.
+    explicit CommandAllocator(CommandBlockPool* blockPool);
     ~CommandAllocator();
 
     // NOTE: A moved-from CommandAllocator is reset to its initial empty state.
@@ -266,6 +324,7 @@ class CommandAllocator : public NonCopyable {
     void ResetPointers();
 
     CommandBlocks mBlocks;
+    CommandBlockPool* mBlockPool = nullptr;
     size_t mLastAllocationSize = kDefaultBaseAllocationSize;
 
     // Data used for the block range at initialization so that the first call to Allocate sees
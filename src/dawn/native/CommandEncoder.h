@@ -28,7 +28,6 @@
 #ifndef SRC_DAWN_NATIVE_COMMANDENCODER_H_
 #define SRC_DAWN_NATIVE_COMMANDENCODER_H_
 
-#include <set>
 #include <string>
 
 #include "dawn/native/dawn_platform.h"
@@ -148,9 +147,9 @@ class CommandEncoder final : public ApiObjectBase {
     MaybeError ValidateFinish() const;
 
     EncodingContext mEncodingContext;
-    std::set<BufferBase*> mTopLevelBuffers;
-    std::set<TextureBase*> mTopLevelTextures;
-    std::set<QuerySetBase*> mUsedQuerySets;
+    FlatResourceSet<BufferBase> mTopLevelBuffers;
+    FlatResourceSet<TextureBase> mTopLevelTextures;
+    FlatResourceSet<QuerySetBase> mUsedQuerySets;
 
     uint64_t mDebugGroupStackSize = 0;
 
@@ -202,6 +202,10 @@ void OwnedCompilationMessages::ClearMessages() {
     mMessages.clear();
 }
 
+bool OwnedCompilationMessages::HasMessages() const {
+    return !mMessages.empty();
+}
+
 const WGPUCompilationInfo* OwnedCompilationMessages::GetCompilationInfo() {
     mCompilationInfo.messageCount = mMessages.size();
     mCompilationInfo.messages = mMessages.data();
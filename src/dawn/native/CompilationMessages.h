@@ -65,6 +65,7 @@ class OwnedCompilationMessages : public NonCopyable {
         uint64_t length = 0);
     MaybeError AddMessages(const tint::diag::List& diagnostics);
     void ClearMessages();
+    bool HasMessages() const;
 
     const WGPUCompilationInfo* GetCompilationInfo();
     const std::vector<std::string>& GetFormattedTintMessages();
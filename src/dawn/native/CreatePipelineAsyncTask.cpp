@@ -27,6 +27,7 @@
 
 #include "dawn/native/CreatePipelineAsyncTask.h"
 
+#include <memory>
 #include <utility>
 
 #include "dawn/native/AsyncTask.h"
@@ -56,6 +57,7 @@ void CreateComputePipelineAsyncTask::Run() {
     const char* eventLabel = utils::GetLabelForTrace(mComputePipeline->GetLabel().c_str());
 
     DeviceBase* device = mComputePipeline->GetDevice();
+    device->RemovePendingAsyncPipelineTask(this);
     TRACE_EVENT_FLOW_END1(device->GetPlatform(), General,
                           "CreateComputePipelineAsyncTask::RunAsync", this, "label", eventLabel);
     TRACE_EVENT1(device->GetPlatform(), General, "CreateComputePipelineAsyncTask::Run", "label",
@@ -73,28 +75,62 @@ void CreateComputePipelineAsyncTask::Run() {
         device->AddComputePipelineAsyncCallbackTask(
             maybeError.AcquireError(), mComputePipeline->GetLabel().c_str(), mCallback, mUserdata);
     } else {
+        mInitializationSucceeded = true;
         device->AddComputePipelineAsyncCallbackTask(mComputePipeline, mCallback, mUserdata);
     }
 }
 
+void CreateComputePipelineAsyncTask::Cancel() {
+    DeviceBase* device = mComputePipeline->GetDevice();
+    device->RemovePendingAsyncPipelineTask(this);
+
+    // Like pipelines that finish initializing after the device is lost, resolve the callback with
+    // an error pipeline.
+    ComputePipelineBase* pipeline =
+        ComputePipelineBase::MakeError(device, mComputePipeline->GetLabel().c_str());
+    device->GetCallbackTaskManager()->AddCallbackTask(
+        [callback = mCallback, userdata = mUserdata, pipeline]() {
+            callback(WGPUCreatePipelineAsyncStatus_Success, ToAPI(pipeline), "", userdata);
+        });
+}
+
+Ref<ComputePipelineBase> CreateComputePipelineAsyncTask::TryRunNow() {
+    DAWN_ASSERT(mTaskHandle != nullptr);
+    if (!mTaskHandle->RunNow() || !mInitializationSucceeded) {
+        return nullptr;
+    }
+    return mComputePipeline;
+}
+
+bool CreateComputePipelineAsyncTask::HasStarted() const {
+    return mTaskHandle->HasStarted();
+}
+
+ComputePipelineBase* CreateComputePipelineAsyncTask::GetPipeline() const {
+    return mComputePipeline.Get();
+}
+
 void CreateComputePipelineAsyncTask::RunAsync(
     std::unique_ptr<CreateComputePipelineAsyncTask> task) {
     DeviceBase* device = task->mComputePipeline->GetDevice();
 
     const char* eventLabel = utils::GetLabelForTrace(task->mComputePipeline->GetLabel().c_str());
 
-    // Using "taskPtr = std::move(task)" causes compilation error while it should be supported
-    // since C++14:
-    // https://docs.microsoft.com/en-us/cpp/cpp/lambda-expressions-in-cpp?view=msvc-160
-    auto asyncTask = [taskPtr = task.release()] {
-        std::unique_ptr<CreateComputePipelineAsyncTask> innnerTaskPtr(taskPtr);
-        innnerTaskPtr->Run();
-    };
+    // The task is shared between the functions run when it completes and when it is cancelled.
+    // Both are released once either of them ran.
+    std::shared_ptr<CreateComputePipelineAsyncTask> sharedTask = std::move(task);
+    auto asyncTask = [sharedTask] { sharedTask->Run(); };
+    auto cancelTask = [sharedTask] { sharedTask->Cancel(); };
 
     TRACE_EVENT_FLOW_BEGIN1(device->GetPlatform(), General,
-                            "CreateComputePipelineAsyncTask::RunAsync", task.get(), "label",
+                            "CreateComputePipelineAsyncTask::RunAsync", sharedTask.get(), "label",
                             eventLabel);
-    device->GetAsyncTaskManager()->PostTask(std::move(asyncTask));
+
+    sharedTask->mTaskHandle = device->GetAsyncTaskManager()->PostCancellableTask(
+        std::move(asyncTask), std::move(cancelTask), dawn::platform::TaskPriority::High);
+
+    // Track the task so that a synchronous creation of the same pipeline can steal it.
+    device->AddPendingAsyncPipelineTask(std::move(sharedTask));
 }
 
 CreateRenderPipelineAsyncTask::CreateRenderPipelineAsyncTask(
@@ -113,6 +149,7 @@ void CreateRenderPipelineAsyncTask::Run() {
     const char* eventLabel = utils::GetLabelForTrace(mRenderPipeline->GetLabel().c_str());
 
     DeviceBase* device = mRenderPipeline->GetDevice();
+    device->RemovePendingAsyncPipelineTask(this);
     TRACE_EVENT_FLOW_END1(device->GetPlatform(), General, "CreateRenderPipelineAsyncTask::RunAsync",
                           this, "label", eventLabel);
     TRACE_EVENT1(device->GetPlatform(), General, "CreateRenderPipelineAsyncTask::Run", "label",
@@ -130,26 +167,59 @@ void CreateRenderPipelineAsyncTask::Run() {
         device->AddRenderPipelineAsyncCallbackTask(
             maybeError.AcquireError(), mRenderPipeline->GetLabel().c_str(), mCallback, mUserdata);
     } else {
+        mInitializationSucceeded = true;
         device->AddRenderPipelineAsyncCallbackTask(mRenderPipeline, mCallback, mUserdata);
     }
 }
 
+void CreateRenderPipelineAsyncTask::Cancel() {
+    DeviceBase* device = mRenderPipeline->GetDevice();
+    device->RemovePendingAsyncPipelineTask(this);
+
+    // Like pipelines that finish initializing after the device is lost, resolve the callback with
+    // an error pipeline.
+    device->GetCallbackTaskManager()->AddCallbackTask(
+        [callback = mCallback, userdata = mUserdata,
+         pipeline = RenderPipelineBase::MakeError(device, mRenderPipeline->GetLabel().c_str())]() {
+            callback(WGPUCreatePipelineAsyncStatus_Success, ToAPI(pipeline), "", userdata);
+        });
+}
+
+Ref<RenderPipelineBase> CreateRenderPipelineAsyncTask::TryRunNow() {
+    DAWN_ASSERT(mTaskHandle != nullptr);
+    if (!mTaskHandle->RunNow() || !mInitializationSucceeded) {
+        return nullptr;
+    }
+    return mRenderPipeline;
+}
+
+bool CreateRenderPipelineAsyncTask::HasStarted() const {
+    return mTaskHandle->HasStarted();
+}
+
+RenderPipelineBase* CreateRenderPipelineAsyncTask::GetPipeline() const {
+    return mRenderPipeline.Get();
+}
+
 void CreateRenderPipelineAsyncTask::RunAsync(std::unique_ptr<CreateRenderPipelineAsyncTask> task) {
     DeviceBase* device = task->mRenderPipeline->GetDevice();
 
     const char* eventLabel = utils::GetLabelForTrace(task->mRenderPipeline->GetLabel().c_str());
 
-    // Using "taskPtr = std::move(task)" causes compilation error while it should be supported
-    // since C++14:
-    // https://docs.microsoft.com/en-us/cpp/cpp/lambda-expressions-in-cpp?view=msvc-160
-    auto asyncTask = [taskPtr = task.release()] {
-        std::unique_ptr<CreateRenderPipelineAsyncTask> innerTaskPtr(taskPtr);
-        innerTaskPtr->Run();
-    };
+    // The task is shared between the functions run when it completes and when it is cancelled.
+    // Both are released once either of them ran.
+    std::shared_ptr<CreateRenderPipelineAsyncTask> sharedTask = std::move(task);
+    auto asyncTask = [sharedTask] { sharedTask->Run(); };
+    auto cancelTask = [sharedTask] { sharedTask->Cancel(); };
 
     TRACE_EVENT_FLOW_BEGIN1(device->GetPlatform(), General,
-                            "CreateRenderPipelineAsyncTask::RunAsync", task.get(), "label",
+                            "CreateRenderPipelineAsyncTask::RunAsync", sharedTask.get(), "label",
                             eventLabel);
-    device->GetAsyncTaskManager()->PostTask(std::move(asyncTask));
+
+    sharedTask->mTaskHandle = device->GetAsyncTaskManager()->PostCancellableTask(
+        std::move(asyncTask), std::move(cancelTask), dawn::platform::TaskPriority::High);
+
+    // Track the task so that a synchronous creation of the same pipeline can steal it.
+    device->AddPendingAsyncPipelineTask(std::move(sharedTask));
 }
 }  // namespace dawn::native
@@ -38,6 +38,7 @@
 
 namespace dawn::native {
 
+class AsyncTaskHandle;
 class ComputePipelineBase;
 class DeviceBase;
 class PipelineLayoutBase;
@@ -55,6 +56,16 @@ class CreateComputePipelineAsyncTask {
     ~CreateComputePipelineAsyncTask();
 
     void Run();
+    // Called instead of Run() when the task is cancelled before it starts, because the device is
+    // being destroyed or lost.
+    void Cancel();
+
+    // Runs the task on the current thread if no worker started it yet. Returns the pipeline if it
+    // was successfully initialized.
+    Ref<ComputePipelineBase> TryRunNow();
+
+    bool HasStarted() const;
+    ComputePipelineBase* GetPipeline() const;
 
     static void RunAsync(std::unique_ptr<CreateComputePipelineAsyncTask> task);
 
@@ -62,6 +73,9 @@ class CreateComputePipelineAsyncTask {
     Ref<ComputePipelineBase> mComputePipeline;
     WGPUCreateComputePipelineAsyncCallback mCallback;
     void* mUserdata;
+
+    Ref<AsyncTaskHandle> mTaskHandle;
+    bool mInitializationSucceeded = false;
 };
 
 // CreateRenderPipelineAsyncTask defines all the inputs and outputs of
@@ -74,6 +88,16 @@ class CreateRenderPipelineAsyncTask {
     ~CreateRenderPipelineAsyncTask();
 
     void Run();
+    // Called instead of Run() when the task is cancelled before it starts, because the device is
+    // being destroyed or lost.
+    void Cancel();
+
+    // Runs the task on the current thread if no worker started it yet. Returns the pipeline if it
+    // was successfully initialized.
+    Ref<RenderPipelineBase> TryRunNow();
+
+    bool HasStarted() const;
+    RenderPipelineBase* GetPipeline() const;
 
     static void RunAsync(std::unique_ptr<CreateRenderPipelineAsyncTask> task);
 
@@ -81,6 +105,9 @@ class CreateRenderPipelineAsyncTask {
     Ref<RenderPipelineBase> mRenderPipeline;
     WGPUCreateRenderPipelineAsyncCallback mCallback;
     void* mUserdata;
+
+    Ref<AsyncTaskHandle> mTaskHandle;
+    bool mInitializationSucceeded = false;
 };
 
 }  // namespace dawn::native
@@ -29,7 +29,9 @@
 
 #include <algorithm>
 #include <array>
+#include <memory>
 #include <mutex>
+#include <unordered_map>
 #include <utility>
 
 #include "dawn/common/Log.h"
@@ -42,6 +44,7 @@
 #include "dawn/native/BlobCache.h"
 #include "dawn/native/Buffer.h"
 #include "dawn/native/ChainUtils.h"
+#include "dawn/native/CommandAllocator.h"
 #include "dawn/native/CommandBuffer.h"
 #include "dawn/native/CommandEncoder.h"
 #include "dawn/native/CompilationMessages.h"
@@ -58,6 +61,7 @@
 #include "dawn/native/PipelineCache.h"
 #include "dawn/native/QuerySet.h"
 #include "dawn/native/Queue.h"
+#include "dawn/native/RenderBundle.h"
 #include "dawn/native/RenderBundleEncoder.h"
 #include "dawn/native/RenderPipeline.h"
 #include "dawn/native/Sampler.h"
@@ -78,6 +82,7 @@ namespace dawn::native {
 
 struct DeviceBase::Caches {
     ContentLessObjectCache<AttachmentState> attachmentStates;
+    ContentLessObjectCache<BindGroupBase> bindGroups;
     ContentLessObjectCache<BindGroupLayoutInternalBase> bindGroupLayouts;
     ContentLessObjectCache<ComputePipelineBase> computePipelines;
     ContentLessObjectCache<PipelineLayoutBase> pipelineLayouts;
@@ -86,6 +91,61 @@ struct DeviceBase::Caches {
     ContentLessObjectCache<ShaderModuleBase> shaderModules;
 };
 
+// The async pipeline creation tasks that no worker thread started yet, indexed by the content of
+// their pipeline.
+struct DeviceBase::PendingAsyncPipelineTasks {
+    template <typename PipelineT, typename TaskT>
+    using TaskMap = std::unordered_map<PipelineT*,
+                                       std::shared_ptr<TaskT>,
+                                       CachedObject::HashFunc,
+                                       typename PipelineT::EqualityFunc>;
+
+    std::mutex mutex;
+    TaskMap<ComputePipelineBase, CreateComputePipelineAsyncTask> computePipelines;
+    TaskMap<RenderPipelineBase, CreateRenderPipelineAsyncTask> renderPipelines;
+};
+
+namespace {
+
+template <typename TaskMap, typename TaskT>
+void AddPendingTask(std::mutex& mutex, TaskMap& tasks, std::shared_ptr<TaskT> task) {
+    std::lock_guard<std::mutex> lock(mutex);
+    // If a worker thread already started the task, it already tried to remove it from the map.
+    if (task->HasStarted()) {
+        return;
+    }
+    auto* pipeline = task->GetPipeline();
+    tasks.emplace(pipeline, std::move(task));
+}
+
+template <typename TaskMap, typename TaskT>
+void RemovePendingTask(std::mutex& mutex, TaskMap& tasks, TaskT* task) {
+    std::lock_guard<std::mutex> lock(mutex);
+    auto iter = tasks.find(task->GetPipeline());
+    if (iter != tasks.end() && iter->second.get() == task) {
+        tasks.erase(iter);
+    }
+}
+
+template <typename TaskMap, typename PipelineT>
+Ref<PipelineT> StealPendingTask(std::mutex& mutex,
+                                TaskMap& tasks,
+                                PipelineT* uninitializedPipeline) {
+    typename TaskMap::mapped_type task;
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        auto iter = tasks.find(uninitializedPipeline);
+        if (iter == tasks.end()) {
+            return nullptr;
+        }
+        task = iter->second;
+    }
+    // Running the task removes it from the map, so the lock must not be held.
+    return task->TryRunNow();
+}
+
+}  // anonymous namespace
+
 // Tries to find an object in the cache, creating and inserting into the cache if not found.
 template <typename RefCountedT, typename CreateFn>
 auto GetOrCreate(ContentLessObjectCache<RefCountedT>& cache,
@@ -236,6 +296,7 @@ DeviceBase::DeviceBase(AdapterBase* adapter,
         GetPhysicalDevice()->GetLimits().experimentalSubgroupLimits;
 
     mFormatTable = BuildFormatTable(this);
+    mCommandBlockPool = std::make_unique<CommandBlockPool>();
 
     if (descriptor->label != nullptr && strlen(descriptor->label) != 0) {
         mLabel = descriptor->label;
@@ -298,6 +359,7 @@ MaybeError DeviceBase::Initialize(Ref<QueueBase> defaultQueue) {
     DAWN_ASSERT(GetPlatform() != nullptr);
     mWorkerTaskPool = GetPlatform()->CreateWorkerTaskPool();
     mAsyncTaskManager = std::make_unique<AsyncTaskManager>(mWorkerTaskPool.get());
+    mPendingAsyncPipelineTasks = std::make_unique<PendingAsyncPipelineTasks>();
 
     // Starting from now the backend can start doing reentrant calls so the device is marked as
     // alive.
@@ -464,9 +526,9 @@ void DeviceBase::Destroy() {
             mDeviceLostCallback = nullptr;
         }
 
-        // Call all the callbacks immediately as the device is about to shut down.
-        // TODO(crbug.com/dawn/826): Cancel the tasks that are in flight if possible.
-        mAsyncTaskManager->WaitAllPendingTasks();
+        // Call all the callbacks immediately as the device is about to shut down. Tasks that didn't
+        // start yet are cancelled instead of waited for.
+        mAsyncTaskManager->CancelAllPendingTasks();
         mCallbackTaskManager->HandleShutDown();
     }
 
@@ -612,8 +674,7 @@ void DeviceBase::HandleError(std::unique_ptr<ErrorData> error,
 
         mQueue->HandleDeviceLoss();
 
-        // TODO(crbug.com/dawn/826): Cancel the tasks that are in flight if possible.
-        mAsyncTaskManager->WaitAllPendingTasks();
+        mAsyncTaskManager->CancelAllPendingTasks();
         mCallbackTaskManager->HandleDeviceLoss();
 
         // Still forward device loss errors to the error scopes so they all reject.
@@ -891,6 +952,20 @@ Ref<RenderPipelineBase> DeviceBase::GetCachedRenderPipeline(
     return mCaches->renderPipelines.Find(uninitializedRenderPipeline);
 }
 
+Ref<ComputePipelineBase> DeviceBase::StealPendingAsyncComputePipeline(
+    ComputePipelineBase* uninitializedComputePipeline) {
+    return StealPendingTask(mPendingAsyncPipelineTasks->mutex,
+                            mPendingAsyncPipelineTasks->computePipelines,
+                            uninitializedComputePipeline);
+}
+
+Ref<RenderPipelineBase> DeviceBase::StealPendingAsyncRenderPipeline(
+    RenderPipelineBase* uninitializedRenderPipeline) {
+    return StealPendingTask(mPendingAsyncPipelineTasks->mutex,
+                            mPendingAsyncPipelineTasks->renderPipelines,
+                            uninitializedRenderPipeline);
+}
+
 Ref<ComputePipelineBase> DeviceBase::AddOrGetCachedComputePipeline(
     Ref<ComputePipelineBase> computePipeline) {
     DAWN_ASSERT(IsLockedByCurrentThreadIfNeeded());
@@ -976,6 +1051,38 @@ ResultOrError<Ref<PipelineLayoutBase>> DeviceBase::GetOrCreatePipelineLayout(
                        });
 }
 
+ResultOrError<Ref<BindGroupBase>> DeviceBase::GetOrCreateBindGroup(
+    const BindGroupDescriptor* descriptor) {
+    BindGroupBlueprint blueprint(this, descriptor);
+    if (!blueprint.IsCacheable()) {
+        return CreateBindGroupImpl(descriptor);
+    }
+
+    const size_t blueprintHash = blueprint.ComputeContentHash();
+    blueprint.SetContentHash(blueprintHash);
+
+    bool created = false;
+    Ref<BindGroupBase> result;
+    DAWN_TRY_ASSIGN(result, GetOrCreate(mCaches->bindGroups, &blueprint,
+                                        [&]() -> ResultOrError<Ref<BindGroupBase>> {
+                                            created = true;
+                                            Ref<BindGroupBase> bindGroup;
+                                            DAWN_TRY_ASSIGN(bindGroup,
+                                                            CreateBindGroupImpl(descriptor));
+                                            bindGroup->SetContentHash(blueprintHash);
+                                            return bindGroup;
+                                        }));
+
+    DAWN_HISTOGRAM_BOOLEAN(GetPlatform(), "BindGroupCacheHit", !created);
+    if (!created) {
+        // Each hit saves the creation of a backend bind group, for example the allocation and
+        // the writes of a descriptor set on Vulkan.
+        uint64_t hitCount = ++mBindGroupCacheHitCount;
+        TRACE_COUNTER1(GetPlatform(), General, "BindGroupCacheHits", hitCount);
+    }
+    return result;
+}
+
 ResultOrError<Ref<SamplerBase>> DeviceBase::GetOrCreateSampler(
     const SamplerDescriptor* descriptor) {
     SamplerBase blueprint(this, descriptor, ApiObjectBase::kUntrackedByDevice);
@@ -1004,11 +1111,15 @@ ResultOrError<Ref<ShaderModuleBase>> DeviceBase::GetOrCreateShaderModule(
 
     return GetOrCreate(
         mCaches->shaderModules, &blueprint, [&]() -> ResultOrError<Ref<ShaderModuleBase>> {
-            if (!parseResult->HasParsedShader()) {
+            if (!parseResult->HasParsedShader() && !parseResult->HasCachedReflection() &&
+                !parseResult->HasDeferredParsing()) {
                 // We skip the parse on creation if validation isn't enabled which let's us quickly
-                // lookup in the cache without validating and parsing. We need the parsed module
-                // now.
+                // lookup in the cache without validating and parsing. We need the parsed module,
+                // or its cached reflection, now.
                 DAWN_ASSERT(!IsValidationEnabled());
+                if (mAdapter != nullptr) {
+                    LoadCachedShaderModuleReflection(this, descriptor, parseResult);
+                }
                 DAWN_TRY(ValidateAndParseShaderModule(this, descriptor, parseResult,
                                                       compilationMessages));
             }
@@ -1023,6 +1134,17 @@ ResultOrError<Ref<ShaderModuleBase>> DeviceBase::GetOrCreateShaderModule(
             Ref<ShaderModuleBase> result;
             DAWN_TRY_ASSIGN(result, std::move(result_or_error));
             result->SetContentHash(blueprintHash);
+
+            // Store the reflection of newly parsed shader modules so that creating them again,
+            // in this process or a later one, can skip the parsing. Shader modules with
+            // compilation messages are always parsed so that the messages are reported again.
+            // Shader modules with deferred parsing store it once they are parsed.
+            // mAdapter is not set for mock test devices, which don't have a BlobCache.
+            if (mAdapter != nullptr && !parseResult->HasCachedReflection() &&
+                !parseResult->HasDeferredParsing() &&
+                (compilationMessages == nullptr || !compilationMessages->HasMessages())) {
+                result->StoreReflectionInBlobCache();
+            }
             return result;
         });
 }
@@ -1343,7 +1465,19 @@ bool DeviceBase::APITick() {
 }
 
 MaybeError DeviceBase::Tick() {
-    if (IsLost() || !mQueue->HasScheduledCommands()) {
+    // Release the command blocks that were cached beyond what the last period needed, even when
+    // idle so that the memory of a burst of encoding isn't held forever.
+    if (mCommandBlockPool != nullptr) {
+        mCommandBlockPool->Trim();
+    }
+
+    if (IsLost()) {
+        return {};
+    }
+    if (!mQueue->HasScheduledCommands()) {
+        // The completed serial doesn't advance while idle, so the unused staging buffers would
+        // stay allocated until the next submit. Free them now since they can be large.
+        mDynamicUploader->ReleaseUnusedStagingBuffers();
         return {};
     }
 
@@ -1499,6 +1633,10 @@ void DeviceBase::IncrementLazyClearCountForTesting() {
     ++mLazyClearCountForTesting;
 }
 
+uint64_t DeviceBase::GetBindGroupCacheHitCountForTesting() const {
+    return mBindGroupCacheHitCount;
+}
+
 size_t DeviceBase::GetDeprecationWarningCountForTesting() {
     return mDeprecationWarnings->count;
 }
@@ -1605,6 +1743,9 @@ ResultOrError<Ref<BindGroupBase>> DeviceBase::CreateBindGroup(const BindGroupDes
         DAWN_TRY_CONTEXT(ValidateBindGroupDescriptor(this, descriptor, mode),
                          "validating %s against %s", descriptor, descriptor->layout);
     }
+    if (IsToggleEnabled(Toggle::DeduplicateBindGroups)) {
+        return GetOrCreateBindGroup(descriptor);
+    }
     return CreateBindGroupImpl(descriptor);
 }
 
@@ -1649,6 +1790,14 @@ ResultOrError<Ref<ComputePipelineBase>> DeviceBase::CreateComputePipeline(
         return cachedComputePipeline;
     }
 
+    // Steal the initialization of an identical pipeline that is still queued by
+    // CreateComputePipelineAsync instead of initializing it twice.
+    Ref<ComputePipelineBase> stolenComputePipeline =
+        StealPendingAsyncComputePipeline(uninitializedComputePipeline.Get());
+    if (stolenComputePipeline != nullptr) {
+        return AddOrGetCachedComputePipeline(std::move(stolenComputePipeline));
+    }
+
     MaybeError maybeError;
     {
         SCOPED_DAWN_HISTOGRAM_TIMER_MICROS(GetPlatform(), "CreateComputePipelineUS");
@@ -1682,6 +1831,18 @@ Ref<PipelineCacheBase> DeviceBase::GetOrCreatePipelineCacheImpl(const CacheKey&
     DAWN_UNREACHABLE();
 }
 
+Ref<RenderBundleBase> DeviceBase::CreateRenderBundle(RenderBundleEncoder* encoder,
+                                                     const RenderBundleDescriptor* descriptor,
+                                                     Ref<AttachmentState> attachmentState,
+                                                     bool depthReadOnly,
+                                                     bool stencilReadOnly,
+                                                     RenderPassResourceUsage resourceUsage,
+                                                     IndirectDrawMetadata indirectDrawMetadata) {
+    return AcquireRef(new RenderBundleBase(encoder, descriptor, std::move(attachmentState),
+                                           depthReadOnly, stencilReadOnly, std::move(resourceUsage),
+                                           std::move(indirectDrawMetadata)));
+}
+
 ResultOrError<Ref<ComputePipelineBase>> DeviceBase::CreateUninitializedComputePipeline(
     const ComputePipelineDescriptor* descriptor) {
     DAWN_TRY(ValidateIsAlive());
@@ -1789,6 +1950,14 @@ ResultOrError<Ref<RenderPipelineBase>> DeviceBase::CreateRenderPipeline(
         return cachedRenderPipeline;
     }
 
+    // Steal the initialization of an identical pipeline that is still queued by
+    // CreateRenderPipelineAsync instead of initializing it twice.
+    Ref<RenderPipelineBase> stolenRenderPipeline =
+        StealPendingAsyncRenderPipeline(uninitializedRenderPipeline.Get());
+    if (stolenRenderPipeline != nullptr) {
+        return AddOrGetCachedRenderPipeline(std::move(stolenRenderPipeline));
+    }
+
     MaybeError maybeError;
     {
         SCOPED_DAWN_HISTOGRAM_TIMER_MICROS(GetPlatform(), "CreateRenderPipelineUS");
@@ -1845,6 +2014,12 @@ ResultOrError<Ref<ShaderModuleBase>> DeviceBase::CreateShaderModule(
     if (IsValidationEnabled()) {
         DAWN_TRY_ASSIGN_CONTEXT(unpacked, ValidateAndUnpack(descriptor),
                                 "validating and unpacking %s", descriptor);
+        // Shader modules that were already created in a previous run don't need to be parsed
+        // again: their reflection data is loaded from the BlobCache instead.
+        // mAdapter is not set for mock test devices, which don't have a BlobCache.
+        if (mAdapter != nullptr) {
+            LoadCachedShaderModuleReflection(this, unpacked, &parseResult);
+        }
         DAWN_TRY_CONTEXT(
             ValidateAndParseShaderModule(this, unpacked, &parseResult, compilationMessages),
             "validating %s", descriptor);
@@ -1934,6 +2109,10 @@ DynamicUploader* DeviceBase::GetDynamicUploader() const {
     return mDynamicUploader.get();
 }
 
+CommandBlockPool* DeviceBase::GetCommandBlockPool() const {
+    return mCommandBlockPool.get();
+}
+
 // The Toggle device facility
 
 std::vector<const char*> DeviceBase::GetTogglesUsed() const {
@@ -2075,6 +2254,26 @@ void DeviceBase::AddRenderPipelineAsyncCallbackTask(Ref<RenderPipelineBase> pipe
     });
 }
 
+void DeviceBase::AddPendingAsyncPipelineTask(std::shared_ptr<CreateComputePipelineAsyncTask> task) {
+    AddPendingTask(mPendingAsyncPipelineTasks->mutex, mPendingAsyncPipelineTasks->computePipelines,
+                   std::move(task));
+}
+
+void DeviceBase::AddPendingAsyncPipelineTask(std::shared_ptr<CreateRenderPipelineAsyncTask> task) {
+    AddPendingTask(mPendingAsyncPipelineTasks->mutex, mPendingAsyncPipelineTasks->renderPipelines,
+                   std::move(task));
+}
+
+void DeviceBase::RemovePendingAsyncPipelineTask(CreateComputePipelineAsyncTask* task) {
+    RemovePendingTask(mPendingAsyncPipelineTasks->mutex,
+                      mPendingAsyncPipelineTasks->computePipelines, task);
+}
+
+void DeviceBase::RemovePendingAsyncPipelineTask(CreateRenderPipelineAsyncTask* task) {
+    RemovePendingTask(mPendingAsyncPipelineTasks->mutex,
+                      mPendingAsyncPipelineTasks->renderPipelines, task);
+}
+
 PipelineCompatibilityToken DeviceBase::GetNextPipelineCompatibilityToken() {
     return PipelineCompatibilityToken(mNextPipelineCompatibilityToken++);
 }
@@ -65,12 +65,17 @@ class AttachmentStateBlueprint;
 class Blob;
 class BlobCache;
 class CallbackTaskManager;
+class CommandBlockPool;
+class CreateComputePipelineAsyncTask;
+class CreateRenderPipelineAsyncTask;
 class DynamicUploader;
 class ErrorScopeStack;
+class IndirectDrawMetadata;
 class SharedTextureMemory;
 class OwnedCompilationMessages;
 struct CallbackTask;
 struct InternalPipelineStore;
+struct RenderPassResourceUsage;
 struct ShaderModuleParseResult;
 struct TrackedFutureWaitInfo;
 
@@ -184,6 +189,15 @@ class DeviceBase : public RefCountedWithExternalCount {
     virtual ResultOrError<Ref<CommandBufferBase>> CreateCommandBuffer(
         CommandEncoder* encoder,
         const CommandBufferDescriptor* descriptor) = 0;
+    // Render bundles are implemented in the frontend, but backends can override this to create a
+    // subclass of RenderBundleBase that holds backend-specific data.
+    virtual Ref<RenderBundleBase> CreateRenderBundle(RenderBundleEncoder* encoder,
+                                                     const RenderBundleDescriptor* descriptor,
+                                                     Ref<AttachmentState> attachmentState,
+                                                     bool depthReadOnly,
+                                                     bool stencilReadOnly,
+                                                     RenderPassResourceUsage resourceUsage,
+                                                     IndirectDrawMetadata indirectDrawMetadata);
 
     // Many Dawn objects are completely immutable once created which means that if two
     // creations are given the same arguments, they can return the same object. Reusing
@@ -203,6 +217,10 @@ class DeviceBase : public RefCountedWithExternalCount {
         const BindGroupLayoutDescriptor* descriptor,
         PipelineCompatibilityToken pipelineCompatibilityToken = PipelineCompatibilityToken(0));
 
+    // Bind groups are only deduplicated when Toggle::DeduplicateBindGroups is enabled since the
+    // cache adds a lookup to every bind group creation.
+    ResultOrError<Ref<BindGroupBase>> GetOrCreateBindGroup(const BindGroupDescriptor* descriptor);
+
     BindGroupLayoutBase* GetEmptyBindGroupLayout();
     PipelineLayoutBase* GetEmptyPipelineLayout();
 
@@ -339,6 +357,7 @@ class DeviceBase : public RefCountedWithExternalCount {
                                         const Extent3D& copySizePixels);
 
     DynamicUploader* GetDynamicUploader() const;
+    CommandBlockPool* GetCommandBlockPool() const;
 
     // The device state which is a combination of creation state and loss state.
     //
@@ -373,6 +392,7 @@ class DeviceBase : public RefCountedWithExternalCount {
 
     size_t GetLazyClearCountForTesting();
     void IncrementLazyClearCountForTesting();
+    uint64_t GetBindGroupCacheHitCountForTesting() const;
     size_t GetDeprecationWarningCountForTesting();
     void EmitDeprecationWarning(const std::string& warning);
     void EmitWarningOnce(const std::string& message);
@@ -433,6 +453,14 @@ class DeviceBase : public RefCountedWithExternalCount {
                                             WGPUCreateRenderPipelineAsyncCallback callback,
                                             void* userdata);
 
+    // Track the async pipeline creation tasks that no worker thread started yet, so that the
+    // synchronous creation of an identical pipeline can run them inline instead of initializing
+    // the same pipeline twice.
+    void AddPendingAsyncPipelineTask(std::shared_ptr<CreateComputePipelineAsyncTask> task);
+    void AddPendingAsyncPipelineTask(std::shared_ptr<CreateRenderPipelineAsyncTask> task);
+    void RemovePendingAsyncPipelineTask(CreateComputePipelineAsyncTask* task);
+    void RemovePendingAsyncPipelineTask(CreateRenderPipelineAsyncTask* task);
+
     PipelineCompatibilityToken GetNextPipelineCompatibilityToken();
 
     const CacheKey& GetCacheKey() const;
@@ -527,6 +555,12 @@ class DeviceBase : public RefCountedWithExternalCount {
         ComputePipelineBase* uninitializedComputePipeline);
     Ref<RenderPipelineBase> GetCachedRenderPipeline(
         RenderPipelineBase* uninitializedRenderPipeline);
+    // Runs the pending async creation of a pipeline identical to the uninitialized one on the
+    // current thread, if there is one. Returns the pipeline if it was successfully initialized.
+    Ref<ComputePipelineBase> StealPendingAsyncComputePipeline(
+        ComputePipelineBase* uninitializedComputePipeline);
+    Ref<RenderPipelineBase> StealPendingAsyncRenderPipeline(
+        RenderPipelineBase* uninitializedRenderPipeline);
     Ref<ComputePipelineBase> AddOrGetCachedComputePipeline(
         Ref<ComputePipelineBase> computePipeline);
     Ref<RenderPipelineBase> AddOrGetCachedRenderPipeline(Ref<RenderPipelineBase> renderPipeline);
@@ -587,6 +621,12 @@ class DeviceBase : public RefCountedWithExternalCount {
 
     std::unique_ptr<DynamicUploader> mDynamicUploader;
     std::unique_ptr<AsyncTaskManager> mAsyncTaskManager;
+    // Kept alive until the device is destroyed since command buffers, which hold a reference to
+    // the device, return their blocks to it.
+    std::unique_ptr<CommandBlockPool> mCommandBlockPool;
+
+    struct PendingAsyncPipelineTasks;
+    std::unique_ptr<PendingAsyncPipelineTasks> mPendingAsyncPipelineTasks;
     Ref<QueueBase> mQueue;
 
     struct DeprecationWarnings;
@@ -604,6 +644,7 @@ class DeviceBase : public RefCountedWithExternalCount {
 
     size_t mLazyClearCountForTesting = 0;
     std::atomic_uint64_t mNextPipelineCompatibilityToken;
+    std::atomic_uint64_t mBindGroupCacheHitCount{0};
 
     CombinedLimits mLimits;
     FeaturesSet mEnabledFeatures;
@@ -27,6 +27,7 @@
 
 #include "dawn/native/DynamicUploader.h"
 
+#include <algorithm>
 #include <utility>
 
 #include "dawn/common/Math.h"
@@ -41,29 +42,79 @@ DynamicUploader::DynamicUploader(DeviceBase* device) : mDevice(device) {
 }
 
 void DynamicUploader::ReleaseStagingBuffer(Ref<BufferBase> stagingBuffer) {
+    // The buffer isn't owned by the uploader so it isn't counted in the stats, but it still
+    // counts towards the flush threshold until it is freed.
+    mReleasedStagingBytes += stagingBuffer->GetSize();
     mReleasedStagingBuffers.Enqueue(std::move(stagingBuffer), mDevice->GetPendingCommandSerial());
 }
 
+ResultOrError<Ref<BufferBase>> DynamicUploader::CreateStagingBuffer(uint64_t size) {
+    BufferDescriptor bufferDesc = {};
+    bufferDesc.usage = wgpu::BufferUsage::CopySrc | wgpu::BufferUsage::MapWrite;
+    bufferDesc.size = Align(size, 4);
+    bufferDesc.mappedAtCreation = true;
+    bufferDesc.label = "Dawn_DynamicUploaderStaging";
+
+    IgnoreLazyClearCountScope scope(mDevice);
+    return mDevice->CreateBuffer(&bufferDesc);
+}
+
+void DynamicUploader::RemoveResidentStagingBuffer(const Ref<BufferBase>& stagingBuffer) {
+    DAWN_ASSERT(mStats.residentStagingBytes >= stagingBuffer->GetSize());
+    mStats.residentStagingBytes -= stagingBuffer->GetSize();
+}
+
+ResultOrError<UploadHandle> DynamicUploader::AllocateFromPool(uint64_t allocationSize,
+                                                              ExecutionSerial serial) {
+    uint64_t sizeClass = std::max(NextPowerOfTwo(allocationSize), kRingBufferSize);
+    StagingBufferPool& pool = mStagingBufferPools[sizeClass];
+    pool.lastUsedSerial = serial;
+
+    Ref<BufferBase> stagingBuffer;
+    mStats.pooledAllocationCount++;
+    if (!pool.unusedBuffers.empty()) {
+        mStats.poolHitCount++;
+        stagingBuffer = std::move(pool.unusedBuffers.back());
+        pool.unusedBuffers.pop_back();
+        mUnusedPooledSize -= sizeClass;
+    } else {
+        DAWN_TRY_ASSIGN(stagingBuffer, CreateStagingBuffer(sizeClass));
+        mStats.residentStagingBytes += stagingBuffer->GetSize();
+        mStats.peakResidentStagingBytes =
+            std::max(mStats.peakResidentStagingBytes, mStats.residentStagingBytes);
+    }
+
+    UploadHandle uploadHandle;
+    uploadHandle.mappedBuffer = static_cast<uint8_t*>(stagingBuffer->GetMappedPointer());
+    uploadHandle.stagingBuffer = stagingBuffer.Get();
+
+    mPooledStagingBuffersInFlight.Enqueue(std::move(stagingBuffer), serial);
+    return uploadHandle;
+}
+
 ResultOrError<UploadHandle> DynamicUploader::AllocateInternal(uint64_t allocationSize,
                                                               ExecutionSerial serial,
                                                               uint64_t offsetAlignment) {
     // Disable further sub-allocation should the request be too large.
     if (allocationSize > kRingBufferSize) {
-        BufferDescriptor bufferDesc = {};
-        bufferDesc.usage = wgpu::BufferUsage::CopySrc | wgpu::BufferUsage::MapWrite;
-        bufferDesc.size = Align(allocationSize, 4);
-        bufferDesc.mappedAtCreation = true;
-        bufferDesc.label = "Dawn_DynamicUploaderStaging";
+        // Reuse the staging buffers for large allocations, since creating them is expensive.
+        if (NextPowerOfTwo(allocationSize) <=
+            std::min(kMaxPooledStagingBufferSize, mDevice->GetLimits().v1.maxBufferSize)) {
+            return AllocateFromPool(allocationSize, serial);
+        }
 
-        IgnoreLazyClearCountScope scope(mDevice);
         Ref<BufferBase> stagingBuffer;
-        DAWN_TRY_ASSIGN(stagingBuffer, mDevice->CreateBuffer(&bufferDesc));
+        DAWN_TRY_ASSIGN(stagingBuffer, CreateStagingBuffer(allocationSize));
+
+        mStats.residentStagingBytes += stagingBuffer->GetSize();
+        mStats.peakResidentStagingBytes =
+            std::max(mStats.peakResidentStagingBytes, mStats.residentStagingBytes);
 
         UploadHandle uploadHandle;
         uploadHandle.mappedBuffer = static_cast<uint8_t*>(stagingBuffer->GetMappedPointer());
         uploadHandle.stagingBuffer = stagingBuffer.Get();
 
-        ReleaseStagingBuffer(std::move(stagingBuffer));
+        mDedicatedStagingBuffersInFlight.Enqueue(std::move(stagingBuffer), serial);
         return uploadHandle;
     }
 
@@ -97,15 +148,12 @@ ResultOrError<UploadHandle> DynamicUploader::AllocateInternal(uint64_t allocatio
     // Allocate the staging buffer backing the ringbuffer.
     // Note: the first ringbuffer will be lazily created.
     if (targetRingBuffer->mStagingBuffer == nullptr) {
-        BufferDescriptor bufferDesc = {};
-        bufferDesc.usage = wgpu::BufferUsage::CopySrc | wgpu::BufferUsage::MapWrite;
-        bufferDesc.size = Align(targetRingBuffer->mAllocator.GetSize(), 4);
-        bufferDesc.mappedAtCreation = true;
-        bufferDesc.label = "Dawn_DynamicUploaderStaging";
-
-        IgnoreLazyClearCountScope scope(mDevice);
         Ref<BufferBase> stagingBuffer;
-        DAWN_TRY_ASSIGN(stagingBuffer, mDevice->CreateBuffer(&bufferDesc));
+        DAWN_TRY_ASSIGN(stagingBuffer,
+                        CreateStagingBuffer(targetRingBuffer->mAllocator.GetSize()));
+        mStats.residentStagingBytes += stagingBuffer->GetSize();
+        mStats.peakResidentStagingBytes =
+            std::max(mStats.peakResidentStagingBytes, mStats.residentStagingBytes);
         targetRingBuffer->mStagingBuffer = std::move(stagingBuffer);
     }
 
@@ -120,6 +168,30 @@ ResultOrError<UploadHandle> DynamicUploader::AllocateInternal(uint64_t allocatio
     return uploadHandle;
 }
 
+void DynamicUploader::TrimStagingBufferPools(ExecutionSerial lastCompletedSerial) {
+    // Free the unused buffers of the size classes that haven't been used recently.
+    for (auto& [sizeClass, pool] : mStagingBufferPools) {
+        if (pool.lastUsedSerial + kMaxUnusedPooledSerials < lastCompletedSerial) {
+            for (const Ref<BufferBase>& stagingBuffer : pool.unusedBuffers) {
+                RemoveResidentStagingBuffer(stagingBuffer);
+            }
+            mUnusedPooledSize -= sizeClass * pool.unusedBuffers.size();
+            pool.unusedBuffers.clear();
+        }
+    }
+
+    // Then free the largest unused buffers until they fit in the budget.
+    for (auto it = mStagingBufferPools.rbegin();
+         it != mStagingBufferPools.rend() && mUnusedPooledSize > kMaxUnusedPooledSize; ++it) {
+        auto& [sizeClass, pool] = *it;
+        while (!pool.unusedBuffers.empty() && mUnusedPooledSize > kMaxUnusedPooledSize) {
+            RemoveResidentStagingBuffer(pool.unusedBuffers.back());
+            mUnusedPooledSize -= sizeClass;
+            pool.unusedBuffers.pop_back();
+        }
+    }
+}
+
 void DynamicUploader::Deallocate(ExecutionSerial lastCompletedSerial) {
     // Reclaim memory within the ring buffers by ticking (or removing requests no longer
     // in-flight).
@@ -129,17 +201,56 @@ void DynamicUploader::Deallocate(ExecutionSerial lastCompletedSerial) {
         // Never erase the last buffer as to prevent re-creating smaller buffers
         // again. The last buffer is the largest.
         if (mRingBuffers[i]->mAllocator.Empty() && i < mRingBuffers.size() - 1) {
+            if (mRingBuffers[i]->mStagingBuffer != nullptr) {
+                RemoveResidentStagingBuffer(mRingBuffers[i]->mStagingBuffer);
+            }
             mRingBuffers.erase(mRingBuffers.begin() + i);
         }
     }
+
+    for (const Ref<BufferBase>& stagingBuffer :
+         mReleasedStagingBuffers.IterateUpTo(lastCompletedSerial)) {
+        DAWN_ASSERT(mReleasedStagingBytes >= stagingBuffer->GetSize());
+        mReleasedStagingBytes -= stagingBuffer->GetSize();
+    }
     mReleasedStagingBuffers.ClearUpTo(lastCompletedSerial);
+
+    for (const Ref<BufferBase>& stagingBuffer :
+         mDedicatedStagingBuffersInFlight.IterateUpTo(lastCompletedSerial)) {
+        RemoveResidentStagingBuffer(stagingBuffer);
+    }
+    mDedicatedStagingBuffersInFlight.ClearUpTo(lastCompletedSerial);
+
+    // Return the pooled staging buffers no longer in flight to their pool.
+    for (Ref<BufferBase>& stagingBuffer :
+         mPooledStagingBuffersInFlight.IterateUpTo(lastCompletedSerial)) {
+        uint64_t sizeClass = stagingBuffer->GetSize();
+        mUnusedPooledSize += sizeClass;
+        mStagingBufferPools[sizeClass].unusedBuffers.push_back(std::move(stagingBuffer));
+    }
+    mPooledStagingBuffersInFlight.ClearUpTo(lastCompletedSerial);
+
+    TrimStagingBufferPools(lastCompletedSerial);
+}
+
+void DynamicUploader::ReleaseUnusedStagingBuffers() {
+    for (auto& [sizeClass, pool] : mStagingBufferPools) {
+        for (const Ref<BufferBase>& stagingBuffer : pool.unusedBuffers) {
+            RemoveResidentStagingBuffer(stagingBuffer);
+        }
+        pool.unusedBuffers.clear();
+    }
+    mUnusedPooledSize = 0;
 }
 
 ResultOrError<UploadHandle> DynamicUploader::Allocate(uint64_t allocationSize,
                                                       ExecutionSerial serial,
                                                       uint64_t offsetAlignment) {
     DAWN_ASSERT(offsetAlignment > 0);
-    return AllocateInternal(allocationSize, serial, offsetAlignment);
+    UploadHandle uploadHandle;
+    DAWN_TRY_ASSIGN(uploadHandle, AllocateInternal(allocationSize, serial, offsetAlignment));
+    mStats.bytesUploaded += allocationSize;
+    return uploadHandle;
 }
 
 bool DynamicUploader::ShouldFlush() {
@@ -149,17 +260,14 @@ bool DynamicUploader::ShouldFlush() {
     return GetTotalAllocatedSize() > kTotalAllocatedSizeThreshold;
 }
 
+DynamicUploader::Stats DynamicUploader::GetStats() const {
+    return mStats;
+}
+
 uint64_t DynamicUploader::GetTotalAllocatedSize() {
-    uint64_t size = 0;
-    for (const auto& buffer : mReleasedStagingBuffers.IterateAll()) {
-        size += buffer->GetSize();
-    }
-    for (const auto& buffer : mRingBuffers) {
-        if (buffer->mStagingBuffer != nullptr) {
-            size += buffer->mStagingBuffer->GetSize();
-        }
-    }
-    return size;
+    // The unused pooled buffers are not counted since flushing the commands doesn't free them.
+    DAWN_ASSERT(mStats.residentStagingBytes >= mUnusedPooledSize);
+    return mStats.residentStagingBytes - mUnusedPooledSize + mReleasedStagingBytes;
 }
 
 }  // namespace dawn::native
@@ -28,6 +28,7 @@
 #ifndef SRC_DAWN_NATIVE_DYNAMICUPLOADER_H_
 #define SRC_DAWN_NATIVE_DYNAMICUPLOADER_H_
 
+#include <map>
 #include <memory>
 #include <vector>
 
@@ -64,9 +65,30 @@ class DynamicUploader {
                                          ExecutionSerial serial,
                                          uint64_t offsetAlignment);
     void Deallocate(ExecutionSerial lastCompletedSerial);
+    // Frees all the unused pooled staging buffers. Called while the queue is idle, since the size
+    // classes only age when serials complete.
+    void ReleaseUnusedStagingBuffers();
 
     bool ShouldFlush();
 
+    struct Stats {
+        uint64_t bytesUploaded = 0;
+        // Allocations larger than the ring buffers are served from pooled staging buffers.
+        uint64_t pooledAllocationCount = 0;
+        uint64_t poolHitCount = 0;
+        // Size of the staging buffers owned by the uploader, including the unused pooled ones.
+        uint64_t residentStagingBytes = 0;
+        uint64_t peakResidentStagingBytes = 0;
+    };
+    Stats GetStats() const;
+
+    // Large staging buffers are pooled by power-of-two size class, up to this size.
+    static constexpr uint64_t kMaxPooledStagingBufferSize = 256 * 1024 * 1024;
+    // Unused pooled staging buffers are freed when this many serials completed since their size
+    // class was last used, or when they take more than kMaxUnusedPooledSize bytes.
+    static constexpr ExecutionSerial kMaxUnusedPooledSerials = ExecutionSerial(8);
+    static constexpr uint64_t kMaxUnusedPooledSize = 256 * 1024 * 1024;
+
   private:
     static constexpr uint64_t kRingBufferSize = 4 * 1024 * 1024;
     uint64_t GetTotalAllocatedSize();
@@ -76,12 +98,33 @@ class DynamicUploader {
         RingBufferAllocator mAllocator;
     };
 
+    struct StagingBufferPool {
+        std::vector<Ref<BufferBase>> unusedBuffers;
+        ExecutionSerial lastUsedSerial = ExecutionSerial(0);
+    };
+
     ResultOrError<UploadHandle> AllocateInternal(uint64_t allocationSize,
                                                  ExecutionSerial serial,
                                                  uint64_t offsetAlignment);
+    ResultOrError<UploadHandle> AllocateFromPool(uint64_t allocationSize, ExecutionSerial serial);
+    ResultOrError<Ref<BufferBase>> CreateStagingBuffer(uint64_t size);
+    void TrimStagingBufferPools(ExecutionSerial lastCompletedSerial);
+    void RemoveResidentStagingBuffer(const Ref<BufferBase>& stagingBuffer);
 
     std::vector<std::unique_ptr<RingBuffer>> mRingBuffers;
+    // The staging buffers released by their owner, and their total size.
     SerialQueue<ExecutionSerial, Ref<BufferBase>> mReleasedStagingBuffers;
+    uint64_t mReleasedStagingBytes = 0;
+    // The staging buffers created for allocations too large to be pooled.
+    SerialQueue<ExecutionSerial, Ref<BufferBase>> mDedicatedStagingBuffersInFlight;
+
+    // The pools of large staging buffers, indexed by size class. The buffers are returned to
+    // their pool once the serial they were used with completes.
+    std::map<uint64_t, StagingBufferPool> mStagingBufferPools;
+    SerialQueue<ExecutionSerial, Ref<BufferBase>> mPooledStagingBuffersInFlight;
+    uint64_t mUnusedPooledSize = 0;
+
+    Stats mStats;
     DeviceBase* mDevice;
 };
 }  // namespace dawn::native
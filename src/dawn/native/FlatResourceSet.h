@@ -0,0 +1,185 @@
+// Copyright 2024 The Dawn & Tint Authors
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+//
+// 1. Redistributions of source code must retain the above copyright notice, this
+//    list of conditions and the following disclaimer.
+//
+// 2. Redistributions in binary form must reproduce the above copyright notice,
+//    this list of conditions and the following disclaimer in the documentation
+//    and/or other materials provided with the distribution.
+//
+// 3. Neither the name of the copyright holder nor the names of its
+//    contributors may be used to endorse or promote products derived from
+//    this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+// DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+// FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+// DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+// SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+// CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+// OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+// OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+
+#ifndef SRC_DAWN_NATIVE_FLATRESOURCESET_H_
+#define SRC_DAWN_NATIVE_FLATRESOURCESET_H_
+
+#include <cstdint>
+#include <limits>
+#include <utility>
+#include <vector>
+
+#include "dawn/common/Assert.h"
+#include "dawn/common/Math.h"
+
+namespace dawn::native {
+
+namespace detail {
+
+// Indexes a dense vector of resource pointers so that they can be looked up in O(1). Small
+// vectors are searched linearly (which is faster than hashing for a handful of elements) and
+// larger ones use an open-addressing hash table with linear probing. The table stores indices in
+// the vector instead of pointers so that it stays small and never needs node allocations.
+template <typename T>
+class ResourceIndexTable {
+  public:
+    // Returns the index of |resource| in |resources|, appending it if it isn't present yet. The
+    // bool is true iff the resource was appended.
+    std::pair<size_t, bool> FindOrAppend(T* resource, std::vector<T*>* resources) {
+        if (mSlots.empty()) {
+            for (size_t i = 0; i < resources->size(); ++i) {
+                if ((*resources)[i] == resource) {
+                    return {i, false};
+                }
+            }
+            resources->push_back(resource);
+            if (resources->size() > kMaxLinearSearchSize) {
+                Rehash(*resources);
+            }
+            return {resources->size() - 1, true};
+        }
+
+        size_t mask = mSlots.size() - 1;
+        for (size_t slot = GetSlot(resource);; slot = (slot + 1) & mask) {
+            uint32_t index = mSlots[slot];
+            if (index == kEmptySlot) {
+                DAWN_ASSERT(resources->size() < kEmptySlot);
+                mSlots[slot] = static_cast<uint32_t>(resources->size());
+                resources->push_back(resource);
+                // Keep the load factor under 1/2 so that probe sequences stay short.
+                if (resources->size() * 2 > mSlots.size()) {
+                    Rehash(*resources);
+                }
+                return {resources->size() - 1, true};
+            }
+            if ((*resources)[index] == resource) {
+                return {index, false};
+            }
+        }
+    }
+
+    void Clear() { mSlots.clear(); }
+
+  private:
+    static constexpr size_t kMaxLinearSearchSize = 16;
+    static constexpr uint32_t kEmptySlot = std::numeric_limits<uint32_t>::max();
+
+    size_t GetSlot(T* resource) const {
+        // Fibonacci hashing: the multiplication mixes the pointer bits into the high bits of
+        // the product which are then used as the slot index.
+        uint64_t hash = static_cast<uint64_t>(reinterpret_cast<uintptr_t>(resource)) *
+                        uint64_t(0x9E3779B97F4A7C15);
+        return static_cast<size_t>(hash >> mShift);
+    }
+
+    void Rehash(const std::vector<T*>& resources) {
+        size_t slotCount = NextPowerOfTwo(resources.size() * 4);
+        mSlots.assign(slotCount, kEmptySlot);
+        mShift = 64 - Log2(uint64_t(slotCount));
+
+        size_t mask = slotCount - 1;
+        for (size_t i = 0; i < resources.size(); ++i) {
+            size_t slot = GetSlot(resources[i]);
+            while (mSlots[slot] != kEmptySlot) {
+                slot = (slot + 1) & mask;
+            }
+            mSlots[slot] = static_cast<uint32_t>(i);
+        }
+    }
+
+    std::vector<uint32_t> mSlots;
+    uint32_t mShift = 64;
+};
+
+}  // namespace detail
+
+// A replacement for std::set<T*> that keeps the resources in insertion order in a vector. It is
+// used to track the resources used by passes and command buffers where the sets are built once,
+// then only iterated over.
+template <typename T>
+class FlatResourceSet {
+  public:
+    using const_iterator = typename std::vector<T*>::const_iterator;
+
+    // Returns true if the resource wasn't in the set yet.
+    bool insert(T* resource) { return mIndices.FindOrAppend(resource, &mResources).second; }
+
+    const_iterator begin() const { return mResources.begin(); }
+    const_iterator end() const { return mResources.end(); }
+    size_t size() const { return mResources.size(); }
+    bool empty() const { return mResources.empty(); }
+
+    void clear() {
+        mResources.clear();
+        mIndices.Clear();
+    }
+
+  private:
+    std::vector<T*> mResources;
+    detail::ResourceIndexTable<T> mIndices;
+};
+
+// A replacement for std::map<T*, Value> that stores the keys and the values in two parallel
+// vectors, in insertion order, so that they can be moved out without copies.
+template <typename T, typename Value>
+class FlatResourceMap {
+  public:
+    // Returns the value for |resource|, constructing it from |args| if it wasn't present.
+    template <typename... Args>
+    Value& GetOrCreate(T* resource, Args&&... args) {
+        auto [index, inserted] = mIndices.FindOrAppend(resource, &mResources);
+        if (inserted) {
+            DAWN_ASSERT(index == mValues.size());
+            mValues.emplace_back(std::forward<Args>(args)...);
+        }
+        return mValues[index];
+    }
+
+    size_t size() const { return mResources.size(); }
+
+    // Moves the resources and their values out and leaves the map empty.
+    void Acquire(std::vector<T*>* resources, std::vector<Value>* values) {
+        *resources = std::move(mResources);
+        *values = std::move(mValues);
+        clear();
+    }
+
+    void clear() {
+        mResources.clear();
+        mValues.clear();
+        mIndices.Clear();
+    }
+
+  private:
+    std::vector<T*> mResources;
+    std::vector<Value> mValues;
+    detail::ResourceIndexTable<T> mIndices;
+};
+
+}  // namespace dawn::native
+
+#endif  // SRC_DAWN_NATIVE_FLATRESOURCESET_H_
@@ -50,9 +50,8 @@ SyncScopeUsageTracker& SyncScopeUsageTracker::operator=(SyncScopeUsageTracker&&)
 void SyncScopeUsageTracker::BufferUsedAs(BufferBase* buffer,
                                          wgpu::BufferUsage usage,
                                          wgpu::ShaderStage shaderStages) {
-    // std::map's operator[] will create a new element using the default constructor
-    // if the key didn't exist before.
-    BufferSyncInfo& bufferSyncInfo = mBufferSyncInfos[buffer];
+    // A new element is created using the default constructor if the key didn't exist before.
+    BufferSyncInfo& bufferSyncInfo = mBufferSyncInfos.GetOrCreate(buffer);
 
     bufferSyncInfo.usage |= usage;
     bufferSyncInfo.shaderStages |= shaderStages;
@@ -70,12 +69,10 @@ void SyncScopeUsageTracker::TextureRangeUsedAs(TextureBase* texture,
                                                wgpu::ShaderStage shaderStages) {
     // Get or create a new TextureSubresourceSyncInfo for that texture (initially filled with
     // wgpu::TextureUsage::None and WGPUShaderStage_None)
-    auto it = mTextureSyncInfos.emplace(
-        std::piecewise_construct, std::forward_as_tuple(texture),
-        std::forward_as_tuple(texture->GetFormat().aspects, texture->GetArrayLayers(),
-                              texture->GetNumMipLevels(),
-                              TextureSyncInfo{wgpu::TextureUsage::None, wgpu::ShaderStage::None}));
-    TextureSubresourceSyncInfo& textureSyncInfo = it.first->second;
+    TextureSubresourceSyncInfo& textureSyncInfo = mTextureSyncInfos.GetOrCreate(
+        texture, texture->GetFormat().aspects, texture->GetArrayLayers(),
+        texture->GetNumMipLevels(),
+        TextureSyncInfo{wgpu::TextureUsage::None, wgpu::ShaderStage::None});
 
     textureSyncInfo.Update(
         range, [usage, shaderStages](const SubresourceRange&, TextureSyncInfo* storedSyncInfo) {
@@ -89,14 +86,12 @@ void SyncScopeUsageTracker::AddRenderBundleTextureUsage(
     const TextureSubresourceSyncInfo& textureSyncInfo) {
     // Get or create a new TextureSubresourceSyncInfo for that texture (initially filled with
     // wgpu::TextureUsage::None and WGPUShaderStage_None)
-    auto it = mTextureSyncInfos.emplace(
-        std::piecewise_construct, std::forward_as_tuple(texture),
-        std::forward_as_tuple(texture->GetFormat().aspects, texture->GetArrayLayers(),
-                              texture->GetNumMipLevels(),
-                              TextureSyncInfo{wgpu::TextureUsage::None, wgpu::ShaderStage::None}));
-    TextureSubresourceSyncInfo* passTextureSyncInfo = &it.first->second;
-
-    passTextureSyncInfo->Merge(
+    TextureSubresourceSyncInfo& passTextureSyncInfo = mTextureSyncInfos.GetOrCreate(
+        texture, texture->GetFormat().aspects, texture->GetArrayLayers(),
+        texture->GetNumMipLevels(),
+        TextureSyncInfo{wgpu::TextureUsage::None, wgpu::ShaderStage::None});
+
+    passTextureSyncInfo.Merge(
         textureSyncInfo, [](const SubresourceRange&, TextureSyncInfo* storedSyncInfo,
                             const TextureSyncInfo& addedSyncInfo) {
             DAWN_ASSERT((addedSyncInfo.usage & wgpu::TextureUsage::RenderAttachment) == 0);
@@ -182,27 +177,12 @@ void SyncScopeUsageTracker::AddBindGroup(BindGroupBase* group) {
 
 SyncScopeResourceUsage SyncScopeUsageTracker::AcquireSyncScopeUsage() {
     SyncScopeResourceUsage result;
-    result.buffers.reserve(mBufferSyncInfos.size());
-    result.bufferSyncInfos.reserve(mBufferSyncInfos.size());
-    result.textures.reserve(mTextureSyncInfos.size());
-    result.textureSyncInfos.reserve(mTextureSyncInfos.size());
-
-    for (auto& [buffer, syncInfo] : mBufferSyncInfos) {
-        result.buffers.push_back(buffer);
-        result.bufferSyncInfos.push_back(std::move(syncInfo));
-    }
-
-    for (auto& [texture, syncInfo] : mTextureSyncInfos) {
-        result.textures.push_back(texture);
-        result.textureSyncInfos.push_back(std::move(syncInfo));
-    }
-
-    for (auto* const it : mExternalTextureUsages) {
-        result.externalTextures.push_back(it);
-    }
+    // The flat maps already store the resources and their sync infos in parallel vectors so
+    // they can be moved out directly.
+    mBufferSyncInfos.Acquire(&result.buffers, &result.bufferSyncInfos);
+    mTextureSyncInfos.Acquire(&result.textures, &result.textureSyncInfos);
 
-    mBufferSyncInfos.clear();
-    mTextureSyncInfos.clear();
+    result.externalTextures.assign(mExternalTextureUsages.begin(), mExternalTextureUsages.end());
     mExternalTextureUsages.clear();
 
     return result;
@@ -29,9 +29,9 @@
 #define SRC_DAWN_NATIVE_PASSRESOURCEUSAGETRACKER_H_
 
 #include <map>
-#include <set>
 #include <vector>
 
+#include "dawn/native/FlatResourceSet.h"
 #include "dawn/native/PassResourceUsage.h"
 
 #include "dawn/native/dawn_platform.h"
@@ -75,9 +75,9 @@ class SyncScopeUsageTracker {
     SyncScopeResourceUsage AcquireSyncScopeUsage();
 
   private:
-    std::map<BufferBase*, BufferSyncInfo> mBufferSyncInfos;
-    std::map<TextureBase*, TextureSubresourceSyncInfo> mTextureSyncInfos;
-    std::set<ExternalTextureBase*> mExternalTextureUsages;
+    FlatResourceMap<BufferBase, BufferSyncInfo> mBufferSyncInfos;
+    FlatResourceMap<TextureBase, TextureSubresourceSyncInfo> mTextureSyncInfos;
+    FlatResourceSet<ExternalTextureBase> mExternalTextureUsages;
 };
 
 // Helper class to build ComputePassResourceUsages
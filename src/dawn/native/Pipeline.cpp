@@ -56,6 +56,7 @@ ResultOrError<ShaderModuleEntryPoint> ValidateProgrammableStage(DeviceBase* devi
                                                                 const PipelineLayoutBase* layout,
                                                                 SingleShaderStage stage) {
     DAWN_TRY(device->ValidateObject(module));
+    DAWN_TRY(module->WaitForDeferredParsing());
 
     if (entryPointName) {
         DAWN_INVALID_IF(!module->HasEntryPoint(entryPointName),
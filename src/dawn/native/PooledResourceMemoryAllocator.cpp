@@ -27,6 +27,7 @@
 
 #include "dawn/native/PooledResourceMemoryAllocator.h"
 
+#include <algorithm>
 #include <utility>
 
 #include "dawn/native/Device.h"
@@ -47,6 +48,20 @@ void PooledResourceMemoryAllocator::DestroyPool() {
     }
 
     mPool.clear();
+    mMinPoolSizeSinceTrim = 0;
+}
+
+void PooledResourceMemoryAllocator::TrimPool() {
+    DAWN_ASSERT(mMinPoolSizeSinceTrim <= mPool.size());
+
+    // Heaps are recycled from the front so the ones that weren't reused are at the back.
+    for (size_t i = 0; i < mMinPoolSizeSinceTrim; i++) {
+        DAWN_ASSERT(mPool.back() != nullptr);
+        mHeapAllocator->DeallocateResourceHeap(std::move(mPool.back()));
+        mPool.pop_back();
+    }
+
+    mMinPoolSizeSinceTrim = mPool.size();
 }
 
 ResultOrError<std::unique_ptr<ResourceHeapBase>>
@@ -58,6 +73,7 @@ PooledResourceMemoryAllocator::AllocateResourceHeap(uint64_t size) {
     if (!mPool.empty()) {
         memory = std::move(mPool.front());
         mPool.pop_front();
+        mMinPoolSizeSinceTrim = std::min(mMinPoolSizeSinceTrim, mPool.size());
     }
 
     if (memory == nullptr) {
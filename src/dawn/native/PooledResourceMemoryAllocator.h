@@ -52,6 +52,11 @@ class PooledResourceMemoryAllocator : public ResourceHeapAllocator {
 
     void DestroyPool();
 
+    // Frees the heaps that stayed in the pool since the previous call to TrimPool() without
+    // being reused. Calling it periodically releases the memory of heaps that aren't needed
+    // anymore while heaps that keep getting recycled stay pooled.
+    void TrimPool();
+
     // For testing purposes.
     uint64_t GetPoolSizeForTesting() const;
 
@@ -59,6 +64,10 @@ class PooledResourceMemoryAllocator : public ResourceHeapAllocator {
     ResourceHeapAllocator* mHeapAllocator = nullptr;
 
     std::deque<std::unique_ptr<ResourceHeapBase>> mPool;
+
+    // The smallest size of the pool since the previous TrimPool(). That many heaps at the back
+    // of the pool weren't reused in the meantime.
+    size_t mMinPoolSizeSinceTrim = 0;
 };
 
 }  // namespace dawn::native
@@ -52,6 +52,7 @@
 #include "dawn/native/RenderPipeline.h"
 #include "dawn/native/SystemEvent.h"
 #include "dawn/native/Texture.h"
+#include "dawn/native/TransientBufferAllocator.h"
 #include "dawn/platform/DawnPlatform.h"
 #include "dawn/platform/tracing/TraceEvent.h"
 #include "dawn/webgpu.h"
@@ -244,7 +245,8 @@ void TrackTaskCallback::SetFinishedSerial(ExecutionSerial serial) {
 // QueueBase
 
 QueueBase::QueueBase(DeviceBase* device, const QueueDescriptor* descriptor)
-    : ApiObjectBase(device, descriptor->label) {
+    : ApiObjectBase(device, descriptor->label),
+      mTransientBufferAllocator(std::make_unique<TransientBufferAllocator>(device)) {
     GetObjectTrackingList()->Track(this);
 }
 
@@ -255,7 +257,9 @@ QueueBase::~QueueBase() {
     DAWN_ASSERT(mTasksInFlight->Empty());
 }
 
-void QueueBase::DestroyImpl() {}
+void QueueBase::DestroyImpl() {
+    mTransientBufferAllocator = nullptr;
+}
 
 // static
 QueueBase* QueueBase::MakeError(DeviceBase* device, const char* label) {
@@ -365,6 +369,10 @@ void QueueBase::Tick(ExecutionSerial finishedSerial) {
     TRACE_EVENT1(GetDevice()->GetPlatform(), General, "Queue::Tick", "finishedSerial",
                  uint64_t(finishedSerial));
 
+    if (mTransientBufferAllocator != nullptr) {
+        mTransientBufferAllocator->Deallocate(finishedSerial);
+    }
+
     std::vector<std::unique_ptr<TrackTaskCallback>> tasks;
     mTasksInFlight.Use([&](auto tasksInFlight) {
         for (auto& task : tasksInFlight->IterateUpTo(finishedSerial)) {
@@ -380,6 +388,11 @@ void QueueBase::Tick(ExecutionSerial finishedSerial) {
     }
 }
 
+TransientBufferAllocator* QueueBase::GetTransientBufferAllocator() const {
+    DAWN_ASSERT(mTransientBufferAllocator != nullptr);
+    return mTransientBufferAllocator.get();
+}
+
 void QueueBase::HandleDeviceLoss() {
     mTasksInFlight.Use([&](auto tasksInFlight) {
         for (auto& task : tasksInFlight->IterateAll()) {
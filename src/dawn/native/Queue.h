@@ -46,6 +46,8 @@
 
 namespace dawn::native {
 
+class TransientBufferAllocator;
+
 // For the commands with async callback like 'MapAsync' and 'OnSubmittedWorkDone', we track the
 // execution serials of completion in the queue for them. This implements 'CallbackTask' so that the
 // aysnc callback can be fired by 'CallbackTaskManager' in a unified way. This also caches the
@@ -107,6 +109,9 @@ class QueueBase : public ApiObjectBase, public ExecutionQueueBase {
     void Tick(ExecutionSerial finishedSerial);
     void HandleDeviceLoss();
 
+    // Allocator for the internal buffers that only live until the submit using them completes.
+    TransientBufferAllocator* GetTransientBufferAllocator() const;
+
   protected:
     QueueBase(DeviceBase* device, const QueueDescriptor* descriptor);
     QueueBase(DeviceBase* device, ObjectBase::ErrorTag tag, const char* label);
@@ -148,6 +153,7 @@ class QueueBase : public ApiObjectBase, public ExecutionQueueBase {
     MaybeError SubmitInternal(uint32_t commandCount, CommandBufferBase* const* commands);
 
     MutexProtected<SerialMap<ExecutionSerial, std::unique_ptr<TrackTaskCallback>>> mTasksInFlight;
+    std::unique_ptr<TransientBufferAllocator> mTransientBufferAllocator;
 };
 
 }  // namespace dawn::native
@@ -47,7 +47,7 @@ namespace dawn::native {
 struct RenderBundleDescriptor;
 class RenderBundleEncoder;
 
-class RenderBundleBase final : public ApiObjectBase {
+class RenderBundleBase : public ApiObjectBase {
   public:
     RenderBundleBase(RenderBundleEncoder* encoder,
                      const RenderBundleDescriptor* descriptor,
@@ -74,11 +74,12 @@ class RenderBundleBase final : public ApiObjectBase {
     const RenderPassResourceUsage& GetResourceUsage() const;
     const IndirectDrawMetadata& GetIndirectDrawMetadata();
 
+  protected:
+    void DestroyImpl() override;
+
   private:
     RenderBundleBase(DeviceBase* device, ErrorTag errorTag, const char* label);
 
-    void DestroyImpl() override;
-
     CommandIterator mCommands;
     IndirectDrawMetadata mIndirectDrawMetadata;
     Ref<AttachmentState> mAttachmentState;
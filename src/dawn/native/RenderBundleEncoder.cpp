@@ -180,9 +180,11 @@ ResultOrError<RenderBundleBase*> RenderBundleEncoder::FinishImpl(
         DAWN_TRY(ValidateFinish(usages));
     }
 
-    return new RenderBundleBase(this, descriptor, AcquireAttachmentState(), IsDepthReadOnly(),
-                                IsStencilReadOnly(), std::move(usages),
-                                std::move(mIndirectDrawMetadata));
+    return GetDevice()
+        ->CreateRenderBundle(this, descriptor, AcquireAttachmentState(), IsDepthReadOnly(),
+                             IsStencilReadOnly(), std::move(usages),
+                             std::move(mIndirectDrawMetadata))
+        .Detach();
 }
 
 MaybeError RenderBundleEncoder::ValidateFinish(const RenderPassResourceUsage& usages) const {
@@ -29,18 +29,24 @@
 
 #include <algorithm>
 #include <sstream>
+#include <string_view>
 
 #include "dawn/common/BitSetIterator.h"
 #include "dawn/common/Constants.h"
+#include "dawn/common/HashUtils.h"
+#include "dawn/native/AsyncTask.h"
 #include "dawn/native/BindGroupLayoutInternal.h"
+#include "dawn/native/CacheRequest.h"
 #include "dawn/native/ChainUtils.h"
 #include "dawn/native/CompilationMessages.h"
 #include "dawn/native/Device.h"
-#include "dawn/native/ObjectContentHasher.h"
 #include "dawn/native/Pipeline.h"
 #include "dawn/native/PipelineLayout.h"
 #include "dawn/native/RenderPipeline.h"
 #include "dawn/native/TintUtils.h"
+#include "dawn/native/stream/BlobSource.h"
+#include "dawn/native/stream/ByteVectorSink.h"
+#include "dawn/platform/DawnPlatform.h"
 
 #ifdef DAWN_ENABLE_SPIRV_VALIDATION
 #include "dawn/native/SpirvValidation.h"
@@ -995,6 +1001,14 @@ bool ShaderModuleParseResult::HasParsedShader() const {
     return tintProgram != nullptr;
 }
 
+bool ShaderModuleParseResult::HasCachedReflection() const {
+    return cachedReflection != nullptr;
+}
+
+bool ShaderModuleParseResult::HasDeferredParsing() const {
+    return deferredParsing;
+}
+
 // TintSource is a PIMPL container for a tint::Source::File, which needs to be kept alive for as
 // long as tint diagnostics are inspected / printed.
 class TintSource {
@@ -1005,6 +1019,221 @@ class TintSource {
     tint::Source::File file;
 };
 
+template <>
+void stream::Stream<ShaderModuleSourceKey>::Write(Sink* s, const ShaderModuleSourceKey& t) {
+    StreamIn(s, t.sourceType, t.source, t.allowNonUniformDerivatives);
+}
+
+template <>
+void stream::Stream<BindingSlot>::Write(Sink* s, const BindingSlot& t) {
+    StreamIn(s, t.group, t.binding);
+}
+
+template <>
+MaybeError stream::Stream<BindingSlot>::Read(Source* s, BindingSlot* t) {
+    return StreamOut(s, &t->group, &t->binding);
+}
+
+template <>
+void stream::Stream<ShaderBindingInfo>::Write(Sink* s, const ShaderBindingInfo& t) {
+    StreamIn(s, t.id, t.base_type_id, t.binding, t.bindingType, t.name);
+    StreamIn(s, t.buffer.type, t.buffer.hasDynamicOffset, t.buffer.minBindingSize);
+    StreamIn(s, t.sampler.isComparison);
+    StreamIn(s, t.texture.compatibleSampleTypes, t.texture.viewDimension, t.texture.multisampled);
+    StreamIn(s, t.storageTexture.access, t.storageTexture.format,
+             t.storageTexture.viewDimension);
+}
+
+template <>
+MaybeError stream::Stream<ShaderBindingInfo>::Read(Source* s, ShaderBindingInfo* t) {
+    DAWN_TRY(StreamOut(s, &t->id, &t->base_type_id, &t->binding, &t->bindingType, &t->name));
+    DAWN_TRY(StreamOut(s, &t->buffer.type, &t->buffer.hasDynamicOffset,
+                       &t->buffer.minBindingSize));
+    DAWN_TRY(StreamOut(s, &t->sampler.isComparison));
+    DAWN_TRY(StreamOut(s, &t->texture.compatibleSampleTypes, &t->texture.viewDimension,
+                       &t->texture.multisampled));
+    return StreamOut(s, &t->storageTexture.access, &t->storageTexture.format,
+                     &t->storageTexture.viewDimension);
+}
+
+template <>
+void stream::Stream<EntryPointMetadata::SamplerTexturePair>::Write(
+    Sink* s,
+    const EntryPointMetadata::SamplerTexturePair& t) {
+    StreamIn(s, t.sampler, t.texture);
+}
+
+template <>
+MaybeError stream::Stream<EntryPointMetadata::SamplerTexturePair>::Read(
+    Source* s,
+    EntryPointMetadata::SamplerTexturePair* t) {
+    return StreamOut(s, &t->sampler, &t->texture);
+}
+
+template <>
+void stream::Stream<EntryPointMetadata::FragmentRenderAttachmentInfo>::Write(
+    Sink* s,
+    const EntryPointMetadata::FragmentRenderAttachmentInfo& t) {
+    StreamIn(s, t.baseType, t.componentCount);
+}
+
+template <>
+MaybeError stream::Stream<EntryPointMetadata::FragmentRenderAttachmentInfo>::Read(
+    Source* s,
+    EntryPointMetadata::FragmentRenderAttachmentInfo* t) {
+    return StreamOut(s, &t->baseType, &t->componentCount);
+}
+
+template <>
+void stream::Stream<EntryPointMetadata::InterStageVariableInfo>::Write(
+    Sink* s,
+    const EntryPointMetadata::InterStageVariableInfo& t) {
+    StreamIn(s, t.name, t.baseType, t.componentCount, t.interpolationType,
+             t.interpolationSampling);
+}
+
+template <>
+MaybeError stream::Stream<EntryPointMetadata::InterStageVariableInfo>::Read(
+    Source* s,
+    EntryPointMetadata::InterStageVariableInfo* t) {
+    return StreamOut(s, &t->name, &t->baseType, &t->componentCount, &t->interpolationType,
+                     &t->interpolationSampling);
+}
+
+template <>
+void stream::Stream<EntryPointMetadata::Override>::Write(Sink* s,
+                                                         const EntryPointMetadata::Override& t) {
+    StreamIn(s, t.id, t.type, t.isInitialized);
+}
+
+template <>
+MaybeError stream::Stream<EntryPointMetadata::Override>::Read(Source* s,
+                                                              EntryPointMetadata::Override* t) {
+    return StreamOut(s, &t->id, &t->type, &t->isInitialized);
+}
+
+template <>
+void stream::Stream<EntryPointMetadata>::Write(Sink* s, const EntryPointMetadata& t) {
+    StreamIn(s, t.infringedLimitErrors, t.bindings, t.samplerTexturePairs);
+    StreamIn(s, t.vertexInputBaseTypes, t.usedVertexInputs);
+    StreamIn(s, t.fragmentOutputVariables, t.fragmentOutputMask, t.fragmentInputVariables,
+             t.fragmentInputMask);
+    StreamIn(s, t.usedInterStageVariables, t.interStageVariables,
+             t.totalInterStageShaderComponents);
+    StreamIn(s, t.stage, t.overrides, t.uninitializedOverrides, t.initializedOverrides);
+    StreamIn(s, t.usesPixelLocal, t.pixelLocalBlockSize, t.pixelLocalMembers);
+    StreamIn(s, t.usesFragDepth, t.usesInstanceIndex, t.usesNumWorkgroups,
+             t.usesSampleMaskOutput, t.usesVertexIndex);
+}
+
+template <>
+MaybeError stream::Stream<EntryPointMetadata>::Read(Source* s, EntryPointMetadata* t) {
+    DAWN_TRY(StreamOut(s, &t->infringedLimitErrors, &t->bindings, &t->samplerTexturePairs));
+    DAWN_TRY(StreamOut(s, &t->vertexInputBaseTypes, &t->usedVertexInputs));
+    DAWN_TRY(StreamOut(s, &t->fragmentOutputVariables, &t->fragmentOutputMask,
+                       &t->fragmentInputVariables, &t->fragmentInputMask));
+    DAWN_TRY(StreamOut(s, &t->usedInterStageVariables, &t->interStageVariables,
+                       &t->totalInterStageShaderComponents));
+    DAWN_TRY(StreamOut(s, &t->stage, &t->overrides, &t->uninitializedOverrides,
+                       &t->initializedOverrides));
+    DAWN_TRY(StreamOut(s, &t->usesPixelLocal, &t->pixelLocalBlockSize, &t->pixelLocalMembers));
+    return StreamOut(s, &t->usesFragDepth, &t->usesInstanceIndex, &t->usesNumWorkgroups,
+                     &t->usesSampleMaskOutput, &t->usesVertexIndex);
+}
+
+namespace {
+
+// The reflection only depends on the shader source, on the options used to parse it, and on the
+// device features, toggles and limits. The first two are part of the device cache key, but the
+// limits are not, so the ones read by ReflectEntryPointUsingTint are added to the key explicitly.
+#define SHADER_MODULE_REFLECTION_REQUEST_MEMBERS(X) \
+    X(wgpu::SType, sourceType)                      \
+    X(std::string_view, source)                     \
+    X(bool, allowNonUniformDerivatives)             \
+    X(uint32_t, maxVertexAttributes)                \
+    X(uint32_t, maxInterStageShaderVariables)       \
+    X(uint32_t, maxInterStageShaderComponents)      \
+    X(uint32_t, maxColorAttachments)
+
+DAWN_MAKE_CACHE_REQUEST(ShaderModuleReflectionRequest, SHADER_MODULE_REFLECTION_REQUEST_MEMBERS);
+#undef SHADER_MODULE_REFLECTION_REQUEST_MEMBERS
+
+CacheKey CreateShaderModuleReflectionCacheKey(const DeviceBase* device,
+                                              wgpu::SType sourceType,
+                                              std::string_view source,
+                                              bool allowNonUniformDerivatives) {
+    const Limits& limits = device->GetLimits().v1;
+
+    ShaderModuleReflectionRequest req = {};
+    req.sourceType = sourceType;
+    req.source = source;
+    req.allowNonUniformDerivatives = allowNonUniformDerivatives;
+    req.maxVertexAttributes = limits.maxVertexAttributes;
+    req.maxInterStageShaderVariables = limits.maxInterStageShaderVariables;
+    req.maxInterStageShaderComponents = limits.maxInterStageShaderComponents;
+    req.maxColorAttachments = limits.maxColorAttachments;
+    return req.CreateCacheKey(device);
+}
+
+ResultOrError<std::unique_ptr<ShaderModuleReflection>> ShaderModuleReflectionFromBlob(Blob blob) {
+    stream::BlobSource source(std::move(blob));
+    auto reflection = std::make_unique<ShaderModuleReflection>();
+
+    size_t entryPointCount;
+    DAWN_TRY(StreamOut(&source, &entryPointCount));
+    for (size_t i = 0; i < entryPointCount; ++i) {
+        std::string name;
+        auto metadata = std::make_unique<EntryPointMetadata>();
+        DAWN_TRY(StreamOut(&source, &name, metadata.get()));
+        reflection->entryPoints[name] = std::move(metadata);
+    }
+    DAWN_TRY(StreamOut(&source, &reflection->enabledWGSLExtensions));
+
+    return std::move(reflection);
+}
+
+}  // anonymous namespace
+
+void LoadCachedShaderModuleReflection(DeviceBase* device,
+                                      const UnpackedPtr<ShaderModuleDescriptor>& descriptor,
+                                      ShaderModuleParseResult* parseResult) {
+    DAWN_ASSERT(parseResult != nullptr && !parseResult->HasCachedReflection());
+
+    // Parse the shader as usual when it needs to be dumped.
+    if (device->IsToggleEnabled(Toggle::DumpShaders)) {
+        return;
+    }
+
+    CacheKey key;
+    if (auto* spirvDesc = descriptor.Get<ShaderModuleSPIRVDescriptor>()) {
+        const auto* spirvOptions = descriptor.Get<DawnShaderModuleSPIRVOptionsDescriptor>();
+        std::string_view source(reinterpret_cast<const char*>(spirvDesc->code),
+                                spirvDesc->codeSize * sizeof(uint32_t));
+        key = CreateShaderModuleReflectionCacheKey(
+            device, wgpu::SType::ShaderModuleSPIRVDescriptor, source,
+            spirvOptions != nullptr && spirvOptions->allowNonUniformDerivatives);
+    } else if (auto* wgslDesc = descriptor.Get<ShaderModuleWGSLDescriptor>()) {
+        key = CreateShaderModuleReflectionCacheKey(device, wgpu::SType::ShaderModuleWGSLDescriptor,
+                                                   wgslDesc->code, false);
+    } else {
+        // The descriptor is invalid, let ValidateAndParseShaderModule report it.
+        return;
+    }
+
+    Blob blob = device->GetBlobCache()->Load(key);
+    if (blob.Empty()) {
+        return;
+    }
+
+    ResultOrError<std::unique_ptr<ShaderModuleReflection>> reflection =
+        ShaderModuleReflectionFromBlob(std::move(blob));
+    if (reflection.IsError()) {
+        detail::LogCacheHitError(reflection.AcquireError());
+        return;
+    }
+    parseResult->cachedReflection = reflection.AcquireSuccess();
+}
+
 MaybeError ValidateAndParseShaderModule(DeviceBase* device,
                                         const UnpackedPtr<ShaderModuleDescriptor>& descriptor,
                                         ShaderModuleParseResult* parseResult,
@@ -1026,6 +1255,13 @@ MaybeError ValidateAndParseShaderModule(DeviceBase* device,
 #endif
     DAWN_ASSERT(moduleType != wgpu::SType::Invalid);
 
+    // Only defer the parsing when its errors can be reported by the validation of the pipelines.
+    // Dumped shaders are logged while parsing, so keep doing it synchronously in that case.
+    parseResult->deferredParsing = !parseResult->HasCachedReflection() &&
+                                   device->IsValidationEnabled() &&
+                                   device->IsToggleEnabled(Toggle::AsyncShaderModuleParsing) &&
+                                   !device->IsToggleEnabled(Toggle::DumpShaders);
+
     ScopedTintICEHandler scopedICEHandler(device);
 
     // Multiple paths may use a WGSL descriptor so declare it here now.
@@ -1043,6 +1279,11 @@ MaybeError ValidateAndParseShaderModule(DeviceBase* device,
             const auto* spirvDesc = descriptor.Get<ShaderModuleSPIRVDescriptor>();
             const auto* spirvOptions = descriptor.Get<DawnShaderModuleSPIRVOptionsDescriptor>();
 
+            // The cached reflection is only stored after the shader was successfully parsed.
+            if (parseResult->HasCachedReflection() || parseResult->HasDeferredParsing()) {
+                return {};
+            }
+
             // TODO(dawn:2033): Avoid unnecessary copies of the SPIR-V code.
             std::vector<uint32_t> spirv(spirvDesc->code, spirvDesc->code + spirvDesc->codeSize);
 
@@ -1067,6 +1308,11 @@ MaybeError ValidateAndParseShaderModule(DeviceBase* device,
     }
     DAWN_ASSERT(wgslDesc != nullptr);
 
+    // The cached reflection is only stored after the shader was successfully parsed.
+    if (parseResult->HasCachedReflection() || parseResult->HasDeferredParsing()) {
+        return {};
+    }
+
     auto tintSource = std::make_unique<TintSource>("", wgslDesc->code);
 
     if (device->IsToggleEnabled(Toggle::DumpShaders)) {
@@ -1113,6 +1359,29 @@ ResultOrError<tint::Program> RunTransforms(tint::ast::transform::Manager* transf
     return std::move(result);
 }
 
+ResultOrError<std::optional<tint::Program>> RunTransformsIfNeeded(
+    tint::ast::transform::Manager* transformManager,
+    const tint::Program* program,
+    const tint::ast::transform::DataMap& inputs,
+    tint::ast::transform::DataMap* outputs,
+    OwnedCompilationMessages* outMessages) {
+    DAWN_ASSERT(program != nullptr);
+    tint::ast::transform::DataMap transform_outputs;
+    std::optional<tint::Program> result =
+        transformManager->Apply(*program, inputs, transform_outputs);
+    if (result.has_value()) {
+        if (outMessages != nullptr) {
+            DAWN_TRY(outMessages->AddMessages(result->Diagnostics()));
+        }
+        DAWN_INVALID_IF(!result->IsValid(), "Tint program failure: %s\n",
+                        result->Diagnostics().str());
+    }
+    if (outputs != nullptr) {
+        *outputs = std::move(transform_outputs);
+    }
+    return std::move(result);
+}
+
 MaybeError ValidateCompatibilityWithPipelineLayout(DeviceBase* device,
                                                    const EntryPointMetadata& entryPoint,
                                                    const PipelineLayoutBase* layout) {
@@ -1231,15 +1500,27 @@ ShaderModuleBase::ShaderModuleBase(DeviceBase* device,
                                    const UnpackedPtr<ShaderModuleDescriptor>& descriptor,
                                    ApiObjectBase::UntrackedByDeviceTag tag)
     : ApiObjectBase(device, descriptor->label), mType(Type::Undefined) {
+    std::string_view source;
     if (auto* spirvDesc = descriptor.Get<ShaderModuleSPIRVDescriptor>()) {
         mType = Type::Spirv;
         mOriginalSpirv.assign(spirvDesc->code, spirvDesc->code + spirvDesc->codeSize);
+        source = std::string_view(reinterpret_cast<const char*>(mOriginalSpirv.data()),
+                                  mOriginalSpirv.size() * sizeof(uint32_t));
+        if (auto* spirvOptions = descriptor.Get<DawnShaderModuleSPIRVOptionsDescriptor>()) {
+            mAllowNonUniformDerivatives = spirvOptions->allowNonUniformDerivatives;
+        }
     } else if (auto* wgslDesc = descriptor.Get<ShaderModuleWGSLDescriptor>()) {
         mType = Type::Wgsl;
         mWgsl = std::string(wgslDesc->code);
+        source = mWgsl;
     } else {
         DAWN_ASSERT(false);
     }
+
+    // Hash the raw bytes in one go instead of combining the SPIR-V words one by one. Collisions
+    // are resolved by EqualityFunc so this is only used for the device's shader module cache.
+    mSourceHash = Hash(source);
+    HashCombine(&mSourceHash, mType, source.size(), mAllowNonUniformDerivatives);
 }
 
 ShaderModuleBase::ShaderModuleBase(DeviceBase* device,
@@ -1266,12 +1547,31 @@ ObjectType ShaderModuleBase::GetType() const {
     return ObjectType::ShaderModule;
 }
 
+MaybeError ShaderModuleBase::WaitForDeferredParsing() const {
+    JoinDeferredParsing();
+    if (mDeferredParsingError != nullptr) {
+        // Every use of the shader module reports the error, so report a new error of the same
+        // type each time.
+        return DAWN_MAKE_ERROR(mDeferredParsingError->GetType(),
+                               absl::StrFormat("%s failed to parse: %s", this,
+                                               mDeferredParsingError->GetFormattedMessage()));
+    }
+    return {};
+}
+
 bool ShaderModuleBase::HasEntryPoint(const std::string& entryPoint) const {
+    JoinDeferredParsing();
     return mEntryPoints.count(entryPoint) > 0;
 }
 
+size_t ShaderModuleBase::GetEntryPointCount(SingleShaderStage stage) const {
+    JoinDeferredParsing();
+    return mEntryPointCounts[stage];
+}
+
 ShaderModuleEntryPoint ShaderModuleBase::ReifyEntryPointName(const char* entryPointName,
                                                              SingleShaderStage stage) const {
+    JoinDeferredParsing();
     ShaderModuleEntryPoint entryPoint;
     if (entryPointName) {
         entryPoint.defaulted = false;
@@ -1284,34 +1584,146 @@ ShaderModuleEntryPoint ShaderModuleBase::ReifyEntryPointName(const char* entryPo
 }
 
 const EntryPointMetadata& ShaderModuleBase::GetEntryPoint(const std::string& entryPoint) const {
+    JoinDeferredParsing();
     DAWN_ASSERT(HasEntryPoint(entryPoint));
     return *mEntryPoints.at(entryPoint);
 }
 
 size_t ShaderModuleBase::ComputeContentHash() {
-    ObjectContentHasher recorder;
-    recorder.Record(mType);
-    recorder.Record(mOriginalSpirv);
-    recorder.Record(mWgsl);
-    return recorder.GetContentHash();
+    return mSourceHash;
 }
 
 bool ShaderModuleBase::EqualityFunc::operator()(const ShaderModuleBase* a,
                                                 const ShaderModuleBase* b) const {
-    return a->mType == b->mType && a->mOriginalSpirv == b->mOriginalSpirv && a->mWgsl == b->mWgsl;
+    return a->mType == b->mType && a->mOriginalSpirv == b->mOriginalSpirv && a->mWgsl == b->mWgsl &&
+           a->mAllowNonUniformDerivatives == b->mAllowNonUniformDerivatives;
 }
 
-const tint::Program* ShaderModuleBase::GetTintProgram() const {
-    DAWN_ASSERT(mTintProgram);
+ResultOrError<const tint::Program*> ShaderModuleBase::GetTintProgram() const {
+    JoinDeferredParsing();
+
+    std::lock_guard<std::mutex> lock(mTintProgramMutex);
+    if (mTintProgram == nullptr) {
+        // The shader module was created from cached reflection data. The source was successfully
+        // parsed when that data was stored so no compilation messages are expected here.
+        ScopedTintICEHandler scopedICEHandler(GetDevice());
+        DAWN_TRY(ParseTintProgram(nullptr, false));
+    }
     return mTintProgram.get();
 }
 
+MaybeError ShaderModuleBase::ParseTintProgram(OwnedCompilationMessages* compilationMessages,
+                                              bool validateSpirv) const {
+    DAWN_ASSERT(mTintProgram == nullptr);
+    DeviceBase* device = GetDevice();
+
+    tint::Program program;
+    switch (mType) {
+        case Type::Spirv: {
+#if TINT_BUILD_SPV_READER
+#ifdef DAWN_ENABLE_SPIRV_VALIDATION
+            if (validateSpirv) {
+                DAWN_TRY(ValidateSpirv(device, mOriginalSpirv.data(), mOriginalSpirv.size(),
+                                       false));
+            }
+#endif  // DAWN_ENABLE_SPIRV_VALIDATION
+            DawnShaderModuleSPIRVOptionsDescriptor spirvOptions = {};
+            spirvOptions.allowNonUniformDerivatives = mAllowNonUniformDerivatives;
+            DAWN_TRY_ASSIGN(program, ParseSPIRV(mOriginalSpirv, device->GetWGSLAllowedFeatures(),
+                                                compilationMessages, &spirvOptions));
+#else
+            DAWN_UNREACHABLE();
+#endif  // TINT_BUILD_SPV_READER
+            break;
+        }
+        case Type::Wgsl: {
+            auto tintSource = std::make_unique<TintSource>("", mWgsl);
+            DAWN_TRY_ASSIGN(program, ParseWGSL(&tintSource->file, device->GetWGSLAllowedFeatures(),
+                                               compilationMessages));
+            mTintSource = std::move(tintSource);
+            break;
+        }
+        case Type::Undefined:
+            DAWN_UNREACHABLE();
+    }
+
+    mTintProgram = std::make_unique<tint::Program>(std::move(program));
+    return {};
+}
+
+void ShaderModuleBase::ParseAndReflect() {
+    DeviceBase* device = GetDevice();
+    ScopedTintICEHandler scopedICEHandler(device);
+
+    mDeferredParsingMessages = std::make_unique<OwnedCompilationMessages>();
+    MaybeError maybeError = [&]() -> MaybeError {
+        std::lock_guard<std::mutex> lock(mTintProgramMutex);
+        DAWN_TRY(ParseTintProgram(mDeferredParsingMessages.get(), true));
+        return ReflectShaderUsingTint(device, mTintProgram.get(), mDeferredParsingMessages.get(),
+                                      &mEntryPoints, &mEnabledWGSLExtensions);
+    }();
+    if (maybeError.IsError()) {
+        mDeferredParsingError = maybeError.AcquireError();
+        mEntryPoints.clear();
+        mEnabledWGSLExtensions.clear();
+    }
+    ComputeEntryPointCounts();
+
+    // Same as for shader modules parsed on creation, see DeviceBase::GetOrCreateShaderModule.
+    if (maybeError.IsSuccess() && device->GetAdapter() != nullptr &&
+        !mDeferredParsingMessages->HasMessages()) {
+        StoreReflectionInBlobCache();
+    }
+}
+
+void ShaderModuleBase::JoinDeferredParsing() const {
+    if (!mIsParsingDeferred.load(std::memory_order_acquire)) {
+        return;
+    }
+
+    std::lock_guard<std::mutex> lock(mDeferredParsingMutex);
+    if (mDeferredParsingTask == nullptr) {
+        return;
+    }
+    // Parse on the current thread if no worker thread started to, instead of waiting for one.
+    if (!mDeferredParsingTask->RunNow()) {
+        mDeferredParsingTask->Wait();
+    }
+    mDeferredParsingTask = nullptr;
+
+    // The messages injected on creation are empty since the parsing was skipped then.
+    mCompilationMessages = std::move(mDeferredParsingMessages);
+    EmitCompilationLog();
+    mIsParsingDeferred.store(false, std::memory_order_release);
+}
+
+ShaderModuleSourceKey ShaderModuleBase::GetSourceKey() const {
+    ShaderModuleSourceKey key;
+    switch (mType) {
+        case Type::Spirv:
+            key.sourceType = wgpu::SType::ShaderModuleSPIRVDescriptor;
+            key.source = std::string_view(reinterpret_cast<const char*>(mOriginalSpirv.data()),
+                                          mOriginalSpirv.size() * sizeof(uint32_t));
+            key.allowNonUniformDerivatives = mAllowNonUniformDerivatives;
+            break;
+        case Type::Wgsl:
+            key.sourceType = wgpu::SType::ShaderModuleWGSLDescriptor;
+            key.source = mWgsl;
+            break;
+        case Type::Undefined:
+            DAWN_UNREACHABLE();
+    }
+    return key;
+}
+
 void ShaderModuleBase::APIGetCompilationInfo(wgpu::CompilationInfoCallback callback,
                                              void* userdata) {
     if (callback == nullptr) {
         return;
     }
 
+    JoinDeferredParsing();
+
     callback(WGPUCompilationInfoRequestStatus_Success, mCompilationMessages->GetCompilationInfo(),
              userdata);
 }
@@ -1325,12 +1737,16 @@ void ShaderModuleBase::InjectCompilationMessages(
     // returned from cache rather than newly created, and violate the rule. We just skip the
     // injection in this case for now, but a proper solution including ensure the cache goes
     // before the validation is required.
+    std::lock_guard<std::mutex> lock(mDeferredParsingMutex);
     if (mCompilationMessages != nullptr) {
         return;
     }
     // Move the compilationMessages into the shader module and emit the tint errors and warnings
     mCompilationMessages = std::move(compilationMessages);
+    EmitCompilationLog();
+}
 
+void ShaderModuleBase::EmitCompilationLog() const {
     // Emit the formatted Tint errors and warnings within the moved compilationMessages
     const std::vector<std::string>& formattedTintMessages =
         mCompilationMessages->GetFormattedTintMessages();
@@ -1349,17 +1765,72 @@ void ShaderModuleBase::InjectCompilationMessages(
 }
 
 OwnedCompilationMessages* ShaderModuleBase::GetCompilationMessages() const {
+    JoinDeferredParsing();
     return mCompilationMessages.get();
 }
 
+void ShaderModuleBase::StoreReflectionInBlobCache() const {
+    CacheKey key;
+    switch (mType) {
+        case Type::Spirv:
+            key = CreateShaderModuleReflectionCacheKey(
+                GetDevice(), wgpu::SType::ShaderModuleSPIRVDescriptor,
+                std::string_view(reinterpret_cast<const char*>(mOriginalSpirv.data()),
+                                 mOriginalSpirv.size() * sizeof(uint32_t)),
+                mAllowNonUniformDerivatives);
+            break;
+        case Type::Wgsl:
+            key = CreateShaderModuleReflectionCacheKey(
+                GetDevice(), wgpu::SType::ShaderModuleWGSLDescriptor, mWgsl, false);
+            break;
+        case Type::Undefined:
+            DAWN_UNREACHABLE();
+    }
+
+    stream::ByteVectorSink sink;
+    StreamIn(&sink, mEntryPoints.size());
+    for (const auto& [name, metadata] : mEntryPoints) {
+        StreamIn(&sink, name, *metadata);
+    }
+    StreamIn(&sink, mEnabledWGSLExtensions);
+
+    GetDevice()->GetBlobCache()->Store(key, CreateBlob(std::move(sink)));
+}
+
 MaybeError ShaderModuleBase::InitializeBase(ShaderModuleParseResult* parseResult,
                                             OwnedCompilationMessages* compilationMessages) {
-    mTintProgram = std::move(parseResult->tintProgram);
-    mTintSource = std::move(parseResult->tintSource);
+    if (parseResult->HasCachedReflection()) {
+        // The program is parsed lazily in GetTintProgram if a compilation needs it.
+        mEntryPoints = std::move(parseResult->cachedReflection->entryPoints);
+        mEnabledWGSLExtensions = std::move(parseResult->cachedReflection->enabledWGSLExtensions);
+    } else if (parseResult->HasDeferredParsing()) {
+        // The tasks keep the shader module alive until one of them ran. If the device is
+        // destroyed before the parsing started, the parsing is reported as failed instead.
+        Ref<ShaderModuleBase> self = this;
+        mIsParsingDeferred = true;
+        mDeferredParsingTask = GetDevice()->GetAsyncTaskManager()->PostCancellableTask(
+            [self] { self->ParseAndReflect(); },
+            [self] {
+                self->mDeferredParsingMessages = std::make_unique<OwnedCompilationMessages>();
+                self->mDeferredParsingError =
+                    DAWN_VALIDATION_ERROR("The device was destroyed before it was parsed.");
+                self->ComputeEntryPointCounts();
+            },
+            dawn::platform::TaskPriority::Normal);
+        return {};
+    } else {
+        mTintProgram = std::move(parseResult->tintProgram);
+        mTintSource = std::move(parseResult->tintSource);
 
-    DAWN_TRY(ReflectShaderUsingTint(GetDevice(), mTintProgram.get(), compilationMessages,
-                                    &mEntryPoints, &mEnabledWGSLExtensions));
+        DAWN_TRY(ReflectShaderUsingTint(GetDevice(), mTintProgram.get(), compilationMessages,
+                                        &mEntryPoints, &mEnabledWGSLExtensions));
+    }
 
+    ComputeEntryPointCounts();
+    return {};
+}
+
+void ShaderModuleBase::ComputeEntryPointCounts() {
     for (auto stage : IterateStages(kAllStages)) {
         mEntryPointCounts[stage] = 0;
     }
@@ -1370,8 +1841,6 @@ MaybeError ShaderModuleBase::InitializeBase(ShaderModuleParseResult* parseResult
         }
         mEntryPointCounts[stage]++;
     }
-
-    return {};
 }
 
 }  // namespace dawn::native
@@ -28,10 +28,14 @@
 #ifndef SRC_DAWN_NATIVE_SHADERMODULE_H_
 #define SRC_DAWN_NATIVE_SHADERMODULE_H_
 
+#include <atomic>
 #include <bitset>
 #include <map>
 #include <memory>
+#include <mutex>
+#include <optional>
 #include <string>
+#include <string_view>
 #include <unordered_map>
 #include <unordered_set>
 #include <utility>
@@ -39,6 +43,7 @@
 
 #include "dawn/common/Constants.h"
 #include "dawn/common/ContentLessObjectCacheable.h"
+#include "dawn/common/Ref.h"
 #include "dawn/common/ityp_array.h"
 #include "dawn/native/BindingInfo.h"
 #include "dawn/native/CachedObject.h"
@@ -69,7 +74,9 @@ class VertexPulling;
 namespace dawn::native {
 
 using WGSLExtensionSet = std::unordered_set<std::string>;
+class AsyncTaskHandle;
 struct EntryPointMetadata;
+struct ShaderModuleReflection;
 
 // Base component type of an inter-stage variable
 enum class InterStageComponentType {
@@ -115,9 +122,19 @@ struct ShaderModuleParseResult {
     ShaderModuleParseResult& operator=(ShaderModuleParseResult&& rhs);
 
     bool HasParsedShader() const;
+    bool HasCachedReflection() const;
+    bool HasDeferredParsing() const;
 
     std::unique_ptr<tint::Program> tintProgram;
     std::unique_ptr<TintSource> tintSource;
+
+    // Set instead of the tint::Program when the reflection was loaded from the BlobCache. The
+    // program is then only parsed if a backend compilation misses the cache and needs it.
+    std::unique_ptr<ShaderModuleReflection> cachedReflection;
+
+    // Set instead of the tint::Program when the AsyncShaderModuleParsing toggle is enabled. The
+    // shader module then parses and reflects its source on a worker thread.
+    bool deferredParsing = false;
 };
 
 struct ShaderModuleEntryPoint {
@@ -129,6 +146,12 @@ MaybeError ValidateAndParseShaderModule(DeviceBase* device,
                                         const UnpackedPtr<ShaderModuleDescriptor>& descriptor,
                                         ShaderModuleParseResult* parseResult,
                                         OwnedCompilationMessages* outMessages);
+// Loads the reflection of a shader module with the same source from the BlobCache into
+// `parseResult->cachedReflection`, if present. ValidateAndParseShaderModule then only validates the
+// descriptor and skips the parsing.
+void LoadCachedShaderModuleReflection(DeviceBase* device,
+                                      const UnpackedPtr<ShaderModuleDescriptor>& descriptor,
+                                      ShaderModuleParseResult* parseResult);
 MaybeError ValidateCompatibilityWithPipelineLayout(DeviceBase* device,
                                                    const EntryPointMetadata& entryPoint,
                                                    const PipelineLayoutBase* layout);
@@ -149,6 +172,14 @@ ResultOrError<tint::Program> RunTransforms(tint::ast::transform::Manager* transf
                                            const tint::ast::transform::DataMap& inputs,
                                            tint::ast::transform::DataMap* outputs,
                                            OwnedCompilationMessages* messages);
+// Same as RunTransforms, except that |program| isn't cloned if all the transforms were skipped. The
+// result is then empty and |program| should be used as is.
+ResultOrError<std::optional<tint::Program>> RunTransformsIfNeeded(
+    tint::ast::transform::Manager* transformManager,
+    const tint::Program* program,
+    const tint::ast::transform::DataMap& inputs,
+    tint::ast::transform::DataMap* outputs,
+    OwnedCompilationMessages* messages);
 
 // Mirrors wgpu::SamplerBindingLayout but instead stores a single boolean
 // for isComparison instead of a wgpu::SamplerBindingType enum.
@@ -288,6 +319,20 @@ struct EntryPointMetadata {
     bool usesVertexIndex = false;
 };
 
+// The reflection data of a whole shader module, as stored in the BlobCache.
+struct ShaderModuleReflection {
+    EntryPointMetadataTable entryPoints;
+    WGSLExtensionSet enabledWGSLExtensions;
+};
+
+// The original source of a shader module, with the options used to parse it. Backends stream it
+// into the keys of their compilation requests instead of serializing the tint::Program.
+struct ShaderModuleSourceKey {
+    wgpu::SType sourceType = {};
+    std::string_view source;
+    bool allowNonUniformDerivatives = false;
+};
+
 class ShaderModuleBase : public ApiObjectBase,
                          public CachedObject,
                          public ContentLessObjectCacheable<ShaderModuleBase> {
@@ -302,11 +347,16 @@ class ShaderModuleBase : public ApiObjectBase,
 
     ObjectType GetType() const override;
 
+    // Waits for the parsing of the shader module if it was deferred to a worker thread, and
+    // returns a validation error if the parsing failed. The reflection getters below join on the
+    // parsing as well, but they can't report its errors.
+    MaybeError WaitForDeferredParsing() const;
+
     // Return true iff the program has an entrypoint called `entryPoint`.
     bool HasEntryPoint(const std::string& entryPoint) const;
 
     // Return the number of entry points for a stage.
-    size_t GetEntryPointCount(SingleShaderStage stage) const { return mEntryPointCounts[stage]; }
+    size_t GetEntryPointCount(SingleShaderStage stage) const;
 
     // Return the entry point for a stage. If no entry point name, returns the default one.
     ShaderModuleEntryPoint ReifyEntryPointName(const char* entryPointName,
@@ -323,8 +373,13 @@ class ShaderModuleBase : public ApiObjectBase,
         bool operator()(const ShaderModuleBase* a, const ShaderModuleBase* b) const;
     };
 
-    // This returns tint program before running transforms.
-    const tint::Program* GetTintProgram() const;
+    // This returns tint program before running transforms. If the shader module was created from
+    // reflection data in the BlobCache, the program is parsed on the first call.
+    ResultOrError<const tint::Program*> GetTintProgram() const;
+
+    // Returns the original shader source and the options used to parse it, to key compilation
+    // requests in the BlobCache.
+    ShaderModuleSourceKey GetSourceKey() const;
 
     void APIGetCompilationInfo(wgpu::CompilationInfoCallback callback, void* userdata);
 
@@ -332,6 +387,10 @@ class ShaderModuleBase : public ApiObjectBase,
 
     OwnedCompilationMessages* GetCompilationMessages() const;
 
+    // Stores the reflection data in the BlobCache so that LoadCachedShaderModuleReflection can
+    // find it when a shader module with the same source is created again.
+    void StoreReflectionInBlobCache() const;
+
   protected:
     void DestroyImpl() override;
 
@@ -341,20 +400,43 @@ class ShaderModuleBase : public ApiObjectBase,
   private:
     ShaderModuleBase(DeviceBase* device, ObjectBase::ErrorTag tag, const char* label);
 
+    // Parses the original source into mTintProgram. mTintProgramMutex must be held.
+    MaybeError ParseTintProgram(OwnedCompilationMessages* compilationMessages,
+                                bool validateSpirv) const;
+    void ComputeEntryPointCounts();
+
+    // Deferred parsing, run as a task of the AsyncTaskManager.
+    void ParseAndReflect();
+    void JoinDeferredParsing() const;
+    void EmitCompilationLog() const;
+
     // The original data in the descriptor for caching.
     enum class Type { Undefined, Spirv, Wgsl };
     Type mType;
     std::vector<uint32_t> mOriginalSpirv;
     std::string mWgsl;
+    bool mAllowNonUniformDerivatives = false;
+    // Only used for in-memory hashing, persistent cache keys use the whole source.
+    size_t mSourceHash = 0;
 
     EntryPointMetadataTable mEntryPoints;
     PerStage<std::string> mDefaultEntryPointNames;
     PerStage<size_t> mEntryPointCounts;
     WGSLExtensionSet mEnabledWGSLExtensions;
-    std::unique_ptr<tint::Program> mTintProgram;
-    std::unique_ptr<TintSource> mTintSource;  // Keep the tint::Source::File alive
 
-    std::unique_ptr<OwnedCompilationMessages> mCompilationMessages;
+    // Protects the lazy parsing of the program, which may happen on pipeline compilation threads.
+    mutable std::mutex mTintProgramMutex;
+    mutable std::unique_ptr<tint::Program> mTintProgram;
+    mutable std::unique_ptr<TintSource> mTintSource;  // Keep the tint::Source::File alive
+
+    // Protects the hand-off of the results of the deferred parsing to the getters.
+    mutable std::mutex mDeferredParsingMutex;
+    mutable std::atomic<bool> mIsParsingDeferred = false;
+    mutable Ref<AsyncTaskHandle> mDeferredParsingTask;
+    mutable std::unique_ptr<OwnedCompilationMessages> mDeferredParsingMessages;
+    std::unique_ptr<ErrorData> mDeferredParsingError;
+
+    mutable std::unique_ptr<OwnedCompilationMessages> mCompilationMessages;
 };
 
 }  // namespace dawn::native
@@ -0,0 +1,299 @@
+// Copyright 2024 The Dawn & Tint Authors
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+//
+// 1. Redistributions of source code must retain the above copyright notice, this
+//    list of conditions and the following disclaimer.
+//
+// 2. Redistributions in binary form must reproduce the above copyright notice,
+//    this list of conditions and the following disclaimer in the documentation
+//    and/or other materials provided with the distribution.
+//
+// 3. Neither the name of the copyright holder nor the names of its
+//    contributors may be used to endorse or promote products derived from
+//    this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+// DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+// FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+// DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+// SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+// CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+// OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+// OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+
+#include "dawn/native/TLSFAllocator.h"
+
+#include <algorithm>
+
+#include "dawn/common/Assert.h"
+#include "dawn/common/Math.h"
+
+namespace dawn::native {
+
+namespace {
+
+uint64_t AlignOffset(uint64_t offset, uint64_t alignment) {
+    return (offset + alignment - 1) & ~(alignment - 1);
+}
+
+}  // anonymous namespace
+
+TLSFAllocator::TLSFAllocator(uint64_t maxSize) : mMaxSize(maxSize) {
+    DAWN_ASSERT(maxSize > 0);
+
+    // The first level bitmap is 32 bits, which is enough for ranges of up to 32GB.
+    const size_t firstLevelCount = ComputeSizeClass(maxSize).firstLevel + 1;
+    DAWN_ASSERT(firstLevelCount <= 32);
+    mSecondLevelBitmaps.resize(firstLevelCount, 0);
+    mFreeLists.resize(firstLevelCount);
+    for (auto& lists : mFreeLists) {
+        lists.fill(nullptr);
+    }
+
+    // The whole range starts as a single free block.
+    mFirstBlock = new Block{/*offset*/ 0, maxSize};
+    InsertFreeBlock(mFirstBlock);
+}
+
+TLSFAllocator::~TLSFAllocator() {
+    Block* block = mFirstBlock;
+    while (block != nullptr) {
+        Block* next = block->nextPhysical;
+        delete block;
+        block = next;
+    }
+}
+
+// static
+TLSFAllocator::SizeClass TLSFAllocator::ComputeSizeClass(uint64_t size) {
+    DAWN_ASSERT(size > 0);
+    const uint32_t log2Size = Log2(size);
+
+    // Sizes smaller than kSecondLevelCount are linearly mapped in the first level.
+    if (log2Size < kSecondLevelLog2) {
+        return {0, static_cast<uint32_t>(size)};
+    }
+
+    const uint32_t shift = log2Size - kSecondLevelLog2;
+    return {shift + 1, static_cast<uint32_t>((size >> shift) - kSecondLevelCount)};
+}
+
+TLSFAllocator::Block* TLSFAllocator::FindFreeBlock(uint64_t size, uint64_t alignment) const {
+    // Look for a block big enough to hold the allocation wherever the alignment places it. The
+    // size is rounded up to the start of the next size class so that any block in the lists
+    // found fits.
+    const uint64_t paddedSize = size + alignment - 1;
+    uint64_t searchSize = paddedSize;
+    const uint32_t log2Size = Log2(paddedSize);
+    if (log2Size >= kSecondLevelLog2) {
+        searchSize += (uint64_t(1) << (log2Size - kSecondLevelLog2)) - 1;
+    }
+
+    SizeClass sizeClass = ComputeSizeClass(searchSize);
+    if (sizeClass.firstLevel < mFreeLists.size()) {
+        uint32_t secondLevelMap =
+            mSecondLevelBitmaps[sizeClass.firstLevel] & (~0u << sizeClass.secondLevel);
+        if (secondLevelMap == 0) {
+            // There are no large enough blocks in this first level, use the next non-empty one.
+            uint32_t firstLevelMap = 0;
+            if (sizeClass.firstLevel + 1 < 32) {
+                firstLevelMap = mFirstLevelBitmap & (~0u << (sizeClass.firstLevel + 1));
+            }
+            if (firstLevelMap != 0) {
+                sizeClass.firstLevel = ScanForward(firstLevelMap);
+                secondLevelMap = mSecondLevelBitmaps[sizeClass.firstLevel];
+            }
+        }
+        if (secondLevelMap != 0) {
+            return mFreeLists[sizeClass.firstLevel][ScanForward(secondLevelMap)];
+        }
+    }
+
+    // Blocks in the size classes skipped by the rounding may still fit, for example when the
+    // allocation is almost as large as the whole range.
+    const SizeClass lastSizeClass = ComputeSizeClass(searchSize);
+    const SizeClass firstSizeClass = ComputeSizeClass(size);
+    for (uint32_t firstLevel = firstSizeClass.firstLevel;
+         firstLevel < mFreeLists.size() && firstLevel <= lastSizeClass.firstLevel; ++firstLevel) {
+        uint32_t secondLevel =
+            firstLevel == firstSizeClass.firstLevel ? firstSizeClass.secondLevel : 0;
+        for (; secondLevel < kSecondLevelCount; ++secondLevel) {
+            for (Block* block = mFreeLists[firstLevel][secondLevel]; block != nullptr;
+                 block = block->nextFree) {
+                if (AlignOffset(block->offset, alignment) + size <= block->offset + block->size) {
+                    return block;
+                }
+            }
+        }
+    }
+    return nullptr;
+}
+
+void TLSFAllocator::InsertFreeBlock(Block* block) {
+    DAWN_ASSERT(block->isFree);
+    const SizeClass sizeClass = ComputeSizeClass(block->size);
+    Block*& head = mFreeLists[sizeClass.firstLevel][sizeClass.secondLevel];
+
+    block->prevFree = nullptr;
+    block->nextFree = head;
+    if (head != nullptr) {
+        head->prevFree = block;
+    }
+    head = block;
+
+    mSecondLevelBitmaps[sizeClass.firstLevel] |= 1u << sizeClass.secondLevel;
+    mFirstLevelBitmap |= 1u << sizeClass.firstLevel;
+}
+
+void TLSFAllocator::RemoveFreeBlock(Block* block) {
+    DAWN_ASSERT(block->isFree);
+    const SizeClass sizeClass = ComputeSizeClass(block->size);
+    Block*& head = mFreeLists[sizeClass.firstLevel][sizeClass.secondLevel];
+
+    if (block->prevFree != nullptr) {
+        block->prevFree->nextFree = block->nextFree;
+    } else {
+        DAWN_ASSERT(head == block);
+        head = block->nextFree;
+    }
+    if (block->nextFree != nullptr) {
+        block->nextFree->prevFree = block->prevFree;
+    }
+    block->prevFree = nullptr;
+    block->nextFree = nullptr;
+
+    if (head == nullptr) {
+        mSecondLevelBitmaps[sizeClass.firstLevel] &= ~(1u << sizeClass.secondLevel);
+        if (mSecondLevelBitmaps[sizeClass.firstLevel] == 0) {
+            mFirstLevelBitmap &= ~(1u << sizeClass.firstLevel);
+        }
+    }
+}
+
+uint64_t TLSFAllocator::Allocate(uint64_t allocationSize, uint64_t alignment) {
+    DAWN_ASSERT(alignment > 0 && IsPowerOfTwo(alignment));
+
+    if (allocationSize == 0 || allocationSize > mMaxSize || alignment > mMaxSize) {
+        return kInvalidOffset;
+    }
+
+    Block* block = FindFreeBlock(allocationSize, alignment);
+    if (block == nullptr) {
+        return kInvalidOffset;
+    }
+    RemoveFreeBlock(block);
+
+    // Give the padding required by the alignment back as a free block. The previous block can't
+    // be free since free blocks are always merged, so it doesn't need to be merged.
+    const uint64_t alignedOffset = AlignOffset(block->offset, alignment);
+    if (alignedOffset != block->offset) {
+        Block* padding = new Block{block->offset, alignedOffset - block->offset};
+        padding->prevPhysical = block->prevPhysical;
+        padding->nextPhysical = block;
+        if (block->prevPhysical != nullptr) {
+            block->prevPhysical->nextPhysical = padding;
+        } else {
+            mFirstBlock = padding;
+        }
+        block->prevPhysical = padding;
+        block->offset = alignedOffset;
+        block->size -= padding->size;
+        InsertFreeBlock(padding);
+    }
+
+    // Give the rest of the block back as a free block.
+    DAWN_ASSERT(block->size >= allocationSize);
+    if (block->size > allocationSize) {
+        Block* remainder =
+            new Block{block->offset + allocationSize, block->size - allocationSize};
+        remainder->prevPhysical = block;
+        remainder->nextPhysical = block->nextPhysical;
+        if (block->nextPhysical != nullptr) {
+            block->nextPhysical->prevPhysical = remainder;
+        }
+        block->nextPhysical = remainder;
+        block->size = allocationSize;
+        InsertFreeBlock(remainder);
+    }
+
+    block->isFree = false;
+    mAllocatedBlocks.emplace(block->offset, block);
+    mUsedSize += block->size;
+    return block->offset;
+}
+
+void TLSFAllocator::Deallocate(uint64_t offset) {
+    auto it = mAllocatedBlocks.find(offset);
+    DAWN_ASSERT(it != mAllocatedBlocks.end());
+    Block* block = it->second;
+    mAllocatedBlocks.erase(it);
+
+    mUsedSize -= block->size;
+    block->isFree = true;
+
+    // Merge the block with its free neighbors.
+    Block* prev = block->prevPhysical;
+    if (prev != nullptr && prev->isFree) {
+        RemoveFreeBlock(prev);
+        prev->size += block->size;
+        prev->nextPhysical = block->nextPhysical;
+        if (block->nextPhysical != nullptr) {
+            block->nextPhysical->prevPhysical = prev;
+        }
+        delete block;
+        block = prev;
+    }
+
+    Block* next = block->nextPhysical;
+    if (next != nullptr && next->isFree) {
+        RemoveFreeBlock(next);
+        block->size += next->size;
+        block->nextPhysical = next->nextPhysical;
+        if (next->nextPhysical != nullptr) {
+            next->nextPhysical->prevPhysical = block;
+        }
+        delete next;
+    }
+
+    InsertFreeBlock(block);
+}
+
+uint64_t TLSFAllocator::GetMaxSize() const {
+    return mMaxSize;
+}
+
+uint64_t TLSFAllocator::GetUsedSize() const {
+    return mUsedSize;
+}
+
+uint64_t TLSFAllocator::ComputeLargestFreeBlockSize() const {
+    if (mFirstLevelBitmap == 0) {
+        return 0;
+    }
+
+    // The largest free block is in the last non-empty list, which isn't sorted.
+    const uint32_t firstLevel = Log2(mFirstLevelBitmap);
+    const uint32_t secondLevel = Log2(mSecondLevelBitmaps[firstLevel]);
+    uint64_t largestSize = 0;
+    for (Block* block = mFreeLists[firstLevel][secondLevel]; block != nullptr;
+         block = block->nextFree) {
+        largestSize = std::max(largestSize, block->size);
+    }
+    return largestSize;
+}
+
+uint64_t TLSFAllocator::ComputeTotalNumOfFreeBlocksForTesting() const {
+    uint64_t count = 0;
+    for (Block* block = mFirstBlock; block != nullptr; block = block->nextPhysical) {
+        if (block->isFree) {
+            count++;
+        }
+    }
+    return count;
+}
+
+}  // namespace dawn::native
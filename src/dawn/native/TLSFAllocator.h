@@ -0,0 +1,113 @@
+// Copyright 2024 The Dawn & Tint Authors
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+//
+// 1. Redistributions of source code must retain the above copyright notice, this
+//    list of conditions and the following disclaimer.
+//
+// 2. Redistributions in binary form must reproduce the above copyright notice,
+//    this list of conditions and the following disclaimer in the documentation
+//    and/or other materials provided with the distribution.
+//
+// 3. Neither the name of the copyright holder nor the names of its
+//    contributors may be used to endorse or promote products derived from
+//    this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+// DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+// FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+// DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+// SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+// CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+// OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+// OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+
+#ifndef SRC_DAWN_NATIVE_TLSFALLOCATOR_H_
+#define SRC_DAWN_NATIVE_TLSFALLOCATOR_H_
+
+#include <array>
+#include <cstdint>
+#include <limits>
+#include <unordered_map>
+#include <vector>
+
+namespace dawn::native {
+
+// TLSFAllocator uses the two-level segregated fit technique to satisfy allocation requests in a
+// range of a fixed size. Unlike the buddy allocator, allocations are not rounded up to a
+// power-of-two: a free block is split into exactly the requested size, the remainder and, if
+// needed, the padding required for the alignment. Free blocks are merged with their free
+// neighbors upon deallocation so there are never two adjacent free blocks.
+//
+// Free blocks are kept in lists segregated by size. The first level splits sizes in
+// power-of-two ranges and the second level splits each of these ranges linearly in
+// kSecondLevelCount lists. A bitmap per level records which lists are non-empty so that finding
+// a suitable free block is done in constant time.
+class TLSFAllocator {
+  public:
+    explicit TLSFAllocator(uint64_t maxSize);
+    ~TLSFAllocator();
+
+    TLSFAllocator(const TLSFAllocator&) = delete;
+    TLSFAllocator& operator=(const TLSFAllocator&) = delete;
+
+    // Required methods.
+    uint64_t Allocate(uint64_t allocationSize, uint64_t alignment = 1);
+    void Deallocate(uint64_t offset);
+
+    uint64_t GetMaxSize() const;
+    // The sum of the sizes of the live allocations, excluding alignment padding.
+    uint64_t GetUsedSize() const;
+    uint64_t ComputeLargestFreeBlockSize() const;
+
+    // For testing purposes only.
+    uint64_t ComputeTotalNumOfFreeBlocksForTesting() const;
+
+    static constexpr uint64_t kInvalidOffset = std::numeric_limits<uint64_t>::max();
+
+  private:
+    static constexpr uint32_t kSecondLevelLog2 = 4;
+    static constexpr uint32_t kSecondLevelCount = 1u << kSecondLevelLog2;
+
+    struct Block {
+        uint64_t offset;
+        uint64_t size;
+        bool isFree = true;
+
+        // Neighbors in address order, used to merge free blocks.
+        Block* prevPhysical = nullptr;
+        Block* nextPhysical = nullptr;
+
+        // Links in the free list of the block's size class, only valid when the block is free.
+        Block* prevFree = nullptr;
+        Block* nextFree = nullptr;
+    };
+
+    struct SizeClass {
+        uint32_t firstLevel;
+        uint32_t secondLevel;
+    };
+
+    static SizeClass ComputeSizeClass(uint64_t size);
+
+    Block* FindFreeBlock(uint64_t size, uint64_t alignment) const;
+    void InsertFreeBlock(Block* block);
+    void RemoveFreeBlock(Block* block);
+
+    uint64_t mMaxSize = 0;
+    uint64_t mUsedSize = 0;
+
+    Block* mFirstBlock = nullptr;
+    std::unordered_map<uint64_t, Block*> mAllocatedBlocks;
+
+    uint32_t mFirstLevelBitmap = 0;
+    std::vector<uint32_t> mSecondLevelBitmaps;
+    std::vector<std::array<Block*, kSecondLevelCount>> mFreeLists;
+};
+
+}  // namespace dawn::native
+
+#endif  // SRC_DAWN_NATIVE_TLSFALLOCATOR_H_
@@ -0,0 +1,138 @@
+// Copyright 2024 The Dawn & Tint Authors
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+//
+// 1. Redistributions of source code must retain the above copyright notice, this
+//    list of conditions and the following disclaimer.
+//
+// 2. Redistributions in binary form must reproduce the above copyright notice,
+//    this list of conditions and the following disclaimer in the documentation
+//    and/or other materials provided with the distribution.
+//
+// 3. Neither the name of the copyright holder nor the names of its
+//    contributors may be used to endorse or promote products derived from
+//    this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+// DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+// FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+// DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+// SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+// CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+// OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+// OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+
+#include "dawn/native/TLSFMemoryAllocator.h"
+
+#include <algorithm>
+#include <utility>
+
+#include "dawn/native/ResourceHeapAllocator.h"
+
+namespace dawn::native {
+
+TLSFMemoryAllocator::TLSFMemoryAllocator(uint64_t heapSize, ResourceHeapAllocator* heapAllocator)
+    : mHeapSize(heapSize), mHeapAllocator(heapAllocator) {
+    DAWN_ASSERT(heapSize > 0);
+}
+
+TLSFMemoryAllocator::~TLSFMemoryAllocator() = default;
+
+ResultOrError<ResourceMemoryAllocation> TLSFMemoryAllocator::Allocate(uint64_t allocationSize,
+                                                                      uint64_t alignment) {
+    ResourceMemoryAllocation invalidAllocation = ResourceMemoryAllocation{};
+
+    if (allocationSize == 0 || allocationSize > mHeapSize || alignment > mHeapSize) {
+        return std::move(invalidAllocation);
+    }
+
+    // Use the first heap that has room for the allocation.
+    size_t heapIndex = mTrackedHeaps.size();
+    size_t freeSlot = mTrackedHeaps.size();
+    uint64_t offset = TLSFAllocator::kInvalidOffset;
+    for (size_t i = 0; i < mTrackedHeaps.size(); ++i) {
+        TrackedHeap& trackedHeap = mTrackedHeaps[i];
+        if (trackedHeap.heap == nullptr) {
+            freeSlot = std::min(freeSlot, i);
+            continue;
+        }
+
+        offset = trackedHeap.allocator->Allocate(allocationSize, alignment);
+        if (offset != TLSFAllocator::kInvalidOffset) {
+            heapIndex = i;
+            break;
+        }
+    }
+
+    // Otherwise create a new heap. The allocation always fits at the start of it.
+    if (offset == TLSFAllocator::kInvalidOffset) {
+        std::unique_ptr<ResourceHeapBase> heap;
+        DAWN_TRY_ASSIGN(heap, mHeapAllocator->AllocateResourceHeap(mHeapSize));
+
+        auto allocator = std::make_unique<TLSFAllocator>(mHeapSize);
+        offset = allocator->Allocate(allocationSize, alignment);
+        DAWN_ASSERT(offset == 0);
+
+        if (freeSlot == mTrackedHeaps.size()) {
+            mTrackedHeaps.emplace_back();
+        }
+        heapIndex = freeSlot;
+        mTrackedHeaps[heapIndex] = {/*allocationCount*/ 0, std::move(allocator), std::move(heap)};
+    }
+
+    TrackedHeap& trackedHeap = mTrackedHeaps[heapIndex];
+    trackedHeap.allocationCount++;
+
+    AllocationInfo info;
+    info.mBlockOffset = heapIndex * mHeapSize + offset;
+    info.mMethod = AllocationMethod::kSubAllocated;
+
+    return ResourceMemoryAllocation{info, offset, trackedHeap.heap.get()};
+}
+
+void TLSFMemoryAllocator::Deallocate(const ResourceMemoryAllocation& allocation) {
+    const AllocationInfo info = allocation.GetInfo();
+
+    DAWN_ASSERT(info.mMethod == AllocationMethod::kSubAllocated);
+
+    const size_t heapIndex = static_cast<size_t>(info.mBlockOffset / mHeapSize);
+    DAWN_ASSERT(heapIndex < mTrackedHeaps.size());
+    TrackedHeap& trackedHeap = mTrackedHeaps[heapIndex];
+
+    DAWN_ASSERT(trackedHeap.allocationCount > 0);
+    trackedHeap.allocator->Deallocate(info.mBlockOffset % mHeapSize);
+    trackedHeap.allocationCount--;
+
+    if (trackedHeap.allocationCount == 0) {
+        mHeapAllocator->DeallocateResourceHeap(std::move(trackedHeap.heap));
+        trackedHeap.allocator = nullptr;
+    }
+}
+
+uint64_t TLSFMemoryAllocator::GetHeapSize() const {
+    return mHeapSize;
+}
+
+TLSFMemoryAllocator::Usage TLSFMemoryAllocator::ComputeUsage() const {
+    Usage usage;
+    for (const TrackedHeap& trackedHeap : mTrackedHeaps) {
+        if (trackedHeap.heap == nullptr) {
+            continue;
+        }
+        usage.heapCount++;
+        usage.heapSize += mHeapSize;
+        usage.usedSize += trackedHeap.allocator->GetUsedSize();
+        usage.largestFreeBlockSize = std::max(usage.largestFreeBlockSize,
+                                              trackedHeap.allocator->ComputeLargestFreeBlockSize());
+    }
+    return usage;
+}
+
+uint64_t TLSFMemoryAllocator::ComputeTotalNumOfHeapsForTesting() const {
+    return ComputeUsage().heapCount;
+}
+
+}  // namespace dawn::native
@@ -0,0 +1,93 @@
+// Copyright 2024 The Dawn & Tint Authors
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+//
+// 1. Redistributions of source code must retain the above copyright notice, this
+//    list of conditions and the following disclaimer.
+//
+// 2. Redistributions in binary form must reproduce the above copyright notice,
+//    this list of conditions and the following disclaimer in the documentation
+//    and/or other materials provided with the distribution.
+//
+// 3. Neither the name of the copyright holder nor the names of its
+//    contributors may be used to endorse or promote products derived from
+//    this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+// DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+// FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+// DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+// SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+// CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+// OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+// OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+
+#ifndef SRC_DAWN_NATIVE_TLSFMEMORYALLOCATOR_H_
+#define SRC_DAWN_NATIVE_TLSFMEMORYALLOCATOR_H_
+
+#include <memory>
+#include <vector>
+
+#include "dawn/native/Error.h"
+#include "dawn/native/ResourceMemoryAllocation.h"
+#include "dawn/native/TLSFAllocator.h"
+
+namespace dawn::native {
+
+class ResourceHeapAllocator;
+
+// TLSFMemoryAllocator sub-allocates blocks of device memory created by a ResourceHeapAllocator
+// using one TLSFAllocator per block of memory. Heaps are created when no existing heap has room
+// for an allocation and released as soon as they have no allocations left.
+//
+// Unlike BuddyMemoryAllocator, allocation sizes aren't rounded to a power-of-two so less memory
+// is wasted on allocations with arbitrary sizes, and the heap size doesn't have to be a
+// power-of-two either.
+//
+// The block offset of the allocations is the index of their heap times the heap size plus their
+// offset in that heap, like for the buddy allocator.
+class TLSFMemoryAllocator {
+  public:
+    struct Usage {
+        uint64_t heapCount = 0;
+        // The size of all the heaps.
+        uint64_t heapSize = 0;
+        // The size of the live allocations.
+        uint64_t usedSize = 0;
+        // The size of the largest free block across heaps. Compared to the total free size
+        // (heapSize - usedSize) it tells how fragmented the free memory is.
+        uint64_t largestFreeBlockSize = 0;
+    };
+
+    TLSFMemoryAllocator(uint64_t heapSize, ResourceHeapAllocator* heapAllocator);
+    ~TLSFMemoryAllocator();
+
+    ResultOrError<ResourceMemoryAllocation> Allocate(uint64_t allocationSize, uint64_t alignment);
+    void Deallocate(const ResourceMemoryAllocation& allocation);
+
+    uint64_t GetHeapSize() const;
+    Usage ComputeUsage() const;
+
+    // For testing purposes.
+    uint64_t ComputeTotalNumOfHeapsForTesting() const;
+
+  private:
+    struct TrackedHeap {
+        size_t allocationCount = 0;
+        std::unique_ptr<TLSFAllocator> allocator;
+        std::unique_ptr<ResourceHeapBase> heap;
+    };
+
+    uint64_t mHeapSize = 0;
+    ResourceHeapAllocator* mHeapAllocator;
+
+    // Slots for heaps that have been released are reused for new heaps.
+    std::vector<TrackedHeap> mTrackedHeaps;
+};
+
+}  // namespace dawn::native
+
+#endif  // SRC_DAWN_NATIVE_TLSFMEMORYALLOCATOR_H_
@@ -490,6 +490,36 @@ static constexpr ToggleEnumAndInfoList kToggleNameAndInfoList = {{
      {"polyfill_packed_4x8_dot_product",
       "Always use the polyfill version of dot4I8Packed() and dot4U8Packed().",
       "https://crbug.com/tint/1497", ToggleStage::Device}},
+    {Toggle::VulkanMultithreadedCommandRecording,
+     {"vulkan_multithreaded_command_recording",
+      "Record the command buffers of a submit that don't use resources in common on worker "
+      "threads, each in its own VkCommandBuffer, and submit them in order. Command buffers that "
+      "need lazy clears or use the DynamicUploader are still recorded on the submitting thread.",
+      "https://crbug.com/dawn/1601", ToggleStage::Device}},
+    {Toggle::AsyncShaderModuleParsing,
+     {"async_shader_module_parsing",
+      "Parse and reflect shader modules on worker threads so that createShaderModule returns "
+      "immediately. The parsing is joined by the first use of the shader module that needs its "
+      "reflection, and parsing errors are reported as validation errors of that use.",
+      "https://crbug.com/dawn/1413", ToggleStage::Device}},
+    {Toggle::DeduplicateBindGroups,
+     {"deduplicate_bind_groups",
+      "Return the existing bind group when a bind group is created with the same layout and "
+      "resources as a live one, instead of creating a new backend bind group. The returned bind "
+      "group keeps the label it was first created with. Bind groups that reference a destroyed "
+      "resource or an external texture are never deduplicated.",
+      "https://crbug.com/dawn/855", ToggleStage::Device}},
+    {Toggle::VulkanRecordRenderBundlesInSecondaryCommandBuffers,
+     {"vulkan_record_render_bundles_in_secondary_command_buffers",
+      "Record each render bundle once in secondary command buffers that are executed with "
+      "vkCmdExecuteCommands, instead of encoding the bundle's commands every time it is executed. "
+      "Only used for render passes that do nothing but execute bundles without indirect draws.",
+      "https://crbug.com/dawn/1601", ToggleStage::Device}},
+    {Toggle::DisableGLStateShadowing,
+     {"disable_gl_state_shadowing",
+      "Issue every GL call that sets state, even when the OpenGL backend knows it would not change "
+      "the state of the context. Useful to measure the calls saved by the state shadowing.",
+      "https://crbug.com/dawn/1608", ToggleStage::Device}},
     {Toggle::ExposeWGSLTestingFeatures,
      {"expose_wgsl_testing_features",
       "Make the Instance expose the ChromiumTesting* features for testing of "
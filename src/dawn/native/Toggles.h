@@ -123,6 +123,11 @@ enum class Toggle {
     UseTintIR,
     D3DDisableIEEEStrictness,
     PolyFillPacked4x8DotProduct,
+    VulkanMultithreadedCommandRecording,
+    AsyncShaderModuleParsing,
+    DeduplicateBindGroups,
+    VulkanRecordRenderBundlesInSecondaryCommandBuffers,
+    DisableGLStateShadowing,
     ExposeWGSLTestingFeatures,
     ExposeWGSLExperimentalFeatures,
 
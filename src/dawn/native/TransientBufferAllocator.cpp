@@ -0,0 +1,117 @@
+// Copyright 2024 The Dawn & Tint Authors
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+//
+// 1. Redistributions of source code must retain the above copyright notice, this
+//    list of conditions and the following disclaimer.
+//
+// 2. Redistributions in binary form must reproduce the above copyright notice,
+//    this list of conditions and the following disclaimer in the documentation
+//    and/or other materials provided with the distribution.
+//
+// 3. Neither the name of the copyright holder nor the names of its
+//    contributors may be used to endorse or promote products derived from
+//    this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+// DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+// FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+// DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+// SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+// CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+// OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+// OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+
+#include "dawn/native/TransientBufferAllocator.h"
+
+#include <utility>
+
+#include "dawn/common/Math.h"
+#include "dawn/native/Buffer.h"
+#include "dawn/native/Device.h"
+
+namespace dawn::native {
+
+TransientBufferAllocator::TransientBufferAllocator(DeviceBase* device) : mDevice(device) {}
+
+TransientBufferAllocator::~TransientBufferAllocator() = default;
+
+ResultOrError<Ref<BufferBase>> TransientBufferAllocator::CreateBuffer(uint64_t size) {
+    BufferDescriptor bufferDesc = {};
+    bufferDesc.usage = wgpu::BufferUsage::CopySrc | wgpu::BufferUsage::CopyDst;
+    bufferDesc.size = size;
+    bufferDesc.label = "Dawn_TransientBuffer";
+
+    mStats.createdBufferCount++;
+    IgnoreLazyClearCountScope scope(mDevice);
+    return mDevice->CreateBuffer(&bufferDesc);
+}
+
+ResultOrError<TransientBufferAllocation> TransientBufferAllocator::Allocate(
+    uint64_t allocationSize,
+    ExecutionSerial serial,
+    uint64_t offsetAlignment) {
+    mStats.allocationCount++;
+
+    TransientBufferAllocation allocation;
+
+    // Allocations that don't fit in a block get their own buffer, freed with their serial.
+    if (allocationSize > kBlockSize) {
+        Ref<BufferBase> buffer;
+        DAWN_TRY_ASSIGN(buffer, CreateBuffer(allocationSize));
+        allocation.buffer = buffer.Get();
+        mDedicatedBuffers.Enqueue(std::move(buffer), serial);
+        return allocation;
+    }
+
+    uint64_t offset = Align(mCurrentBlockUsedSize, offsetAlignment);
+    if (mCurrentBlock == nullptr || offset + allocationSize > kBlockSize) {
+        if (mCurrentBlock != nullptr) {
+            mRetiredBlocks.Enqueue(std::move(mCurrentBlock), mCurrentBlockLastUsedSerial);
+        }
+        if (!mFreeBlocks.empty()) {
+            mCurrentBlock = std::move(mFreeBlocks.back());
+            mFreeBlocks.pop_back();
+        } else {
+            DAWN_TRY_ASSIGN(mCurrentBlock, CreateBuffer(kBlockSize));
+        }
+        offset = 0;
+    }
+
+    mCurrentBlockUsedSize = offset + allocationSize;
+    mCurrentBlockLastUsedSerial = serial;
+
+    allocation.buffer = mCurrentBlock.Get();
+    allocation.offset = offset;
+    return allocation;
+}
+
+void TransientBufferAllocator::Deallocate(ExecutionSerial lastCompletedSerial) {
+    mDedicatedBuffers.ClearUpTo(lastCompletedSerial);
+
+    for (Ref<BufferBase>& block : mRetiredBlocks.IterateUpTo(lastCompletedSerial)) {
+        if (mFreeBlocks.size() < kMaxFreeBlockCount) {
+            mFreeBlocks.push_back(std::move(block));
+        }
+    }
+    mRetiredBlocks.ClearUpTo(lastCompletedSerial);
+
+    // Once all the allocations of the blocks are complete, the blocks are freed instead of being
+    // kept for later submits. The allocator only serves workarounds for uncommon copies so
+    // holding on to its memory between them isn't worth it.
+    if (mCurrentBlockLastUsedSerial <= lastCompletedSerial) {
+        DAWN_ASSERT(mRetiredBlocks.Empty());
+        mFreeBlocks.clear();
+        mCurrentBlock = nullptr;
+        mCurrentBlockUsedSize = 0;
+    }
+}
+
+TransientBufferAllocator::Stats TransientBufferAllocator::GetStats() const {
+    return mStats;
+}
+
+}  // namespace dawn::native
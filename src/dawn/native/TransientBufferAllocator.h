@@ -0,0 +1,95 @@
+// Copyright 2024 The Dawn & Tint Authors
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+//
+// 1. Redistributions of source code must retain the above copyright notice, this
+//    list of conditions and the following disclaimer.
+//
+// 2. Redistributions in binary form must reproduce the above copyright notice,
+//    this list of conditions and the following disclaimer in the documentation
+//    and/or other materials provided with the distribution.
+//
+// 3. Neither the name of the copyright holder nor the names of its
+//    contributors may be used to endorse or promote products derived from
+//    this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+// DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+// FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+// DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+// SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+// CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+// OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+// OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+
+#ifndef SRC_DAWN_NATIVE_TRANSIENTBUFFERALLOCATOR_H_
+#define SRC_DAWN_NATIVE_TRANSIENTBUFFERALLOCATOR_H_
+
+#include <vector>
+
+#include "dawn/common/Ref.h"
+#include "dawn/common/SerialQueue.h"
+#include "dawn/native/Error.h"
+#include "dawn/native/Forward.h"
+#include "dawn/native/IntegerTypes.h"
+
+// TransientBufferAllocator is the front-end implementation of a linear allocator for the internal
+// buffers that only live for the duration of a submit. It is used for the temporary buffers of
+// the compressed texture copy workarounds. Allocations are bumped out of large blocks and never
+// freed individually: a block is recycled as a whole once the last serial it was used with
+// completes, and all blocks are freed once none of them is in flight.
+namespace dawn::native {
+
+struct TransientBufferAllocation {
+    BufferBase* buffer = nullptr;
+    uint64_t offset = 0;
+};
+
+class TransientBufferAllocator {
+  public:
+    explicit TransientBufferAllocator(DeviceBase* device);
+    ~TransientBufferAllocator();
+
+    // Returns a range of a CopySrc | CopyDst buffer that can be used by the commands of |serial|.
+    // The range must not be used after |serial| completes.
+    ResultOrError<TransientBufferAllocation> Allocate(uint64_t allocationSize,
+                                                      ExecutionSerial serial,
+                                                      uint64_t offsetAlignment);
+    void Deallocate(ExecutionSerial lastCompletedSerial);
+
+    struct Stats {
+        uint64_t allocationCount = 0;
+        // Number of buffers created, either as blocks or for allocations larger than a block.
+        uint64_t createdBufferCount = 0;
+    };
+    Stats GetStats() const;
+
+    static constexpr uint64_t kBlockSize = 4 * 1024 * 1024;
+    // While newer blocks are in flight, completed blocks are kept for reuse up to this count and
+    // the others are freed.
+    static constexpr size_t kMaxFreeBlockCount = 2;
+
+  private:
+    ResultOrError<Ref<BufferBase>> CreateBuffer(uint64_t size);
+
+    // The block allocations are currently bumped out of.
+    Ref<BufferBase> mCurrentBlock;
+    uint64_t mCurrentBlockUsedSize = 0;
+    ExecutionSerial mCurrentBlockLastUsedSerial = ExecutionSerial(0);
+
+    // Full blocks, and dedicated buffers of large allocations, waiting for their serial to
+    // complete.
+    SerialQueue<ExecutionSerial, Ref<BufferBase>> mRetiredBlocks;
+    SerialQueue<ExecutionSerial, Ref<BufferBase>> mDedicatedBuffers;
+    std::vector<Ref<BufferBase>> mFreeBlocks;
+
+    Stats mStats;
+    DeviceBase* mDevice;
+};
+
+}  // namespace dawn::native
+
+#endif  // SRC_DAWN_NATIVE_TRANSIENTBUFFERALLOCATOR_H_
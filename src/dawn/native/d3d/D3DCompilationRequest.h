@@ -36,6 +36,7 @@
 
 #include "dawn/native/CacheRequest.h"
 #include "dawn/native/Serializable.h"
+#include "dawn/native/ShaderModule.h"
 #include "dawn/native/d3d/d3d_platform.h"
 
 #include "tint/tint.h"
@@ -53,6 +54,10 @@ inline void Stream<pD3DCompile>::Write(Sink*, pD3DCompile const&) {}
 
 }  // namespace dawn::native::stream
 
+namespace dawn::native {
+class ShaderModuleBase;
+}  // namespace dawn::native
+
 namespace dawn::native::d3d {
 
 enum class Compiler { FXC, DXC };
@@ -62,7 +67,8 @@ using AccessControl = std::unordered_map<tint::BindingPoint, tint::core::Access>
 using InterStageShaderVariablesMask = std::bitset<tint::hlsl::writer::kMaxInterStageLocations>;
 
 #define HLSL_COMPILATION_REQUEST_MEMBERS(X)                                                      \
-    X(const tint::Program*, inputProgram)                                                        \
+    X(CacheKey::UnsafeUnkeyedValue<const ShaderModuleBase*>, inputModule)                        \
+    X(ShaderModuleSourceKey, source)                                                             \
     X(std::string_view, entryPointName)                                                          \
     X(SingleShaderStage, stage)                                                                  \
     X(uint32_t, shaderModel)                                                                     \
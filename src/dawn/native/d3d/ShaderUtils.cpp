@@ -32,6 +32,7 @@
 #include <utility>
 #include <vector>
 
+#include "dawn/native/ShaderModule.h"
 #include "dawn/native/d3d/BlobD3D.h"
 #include "dawn/native/d3d/D3DCompilationRequest.h"
 #include "dawn/native/d3d/D3DError.h"
@@ -194,12 +195,17 @@ MaybeError TranslateToHLSL(d3d::HlslCompilationRequest r,
             std::move(r.substituteOverrideConfig).value());
     }
 
+    // Only get the program now: it may need to be parsed if the module was created from cached
+    // reflection data.
+    const tint::Program* inputProgram;
+    DAWN_TRY_ASSIGN(inputProgram, r.inputModule.UnsafeGetValue()->GetTintProgram());
+
     tint::Program transformedProgram;
     tint::ast::transform::DataMap transformOutputs;
     {
         TRACE_EVENT0(tracePlatform.UnsafeGetValue(), General, "RunTransforms");
         DAWN_TRY_ASSIGN(transformedProgram,
-                        RunTransforms(&transformManager, r.inputProgram, transformInputs,
+                        RunTransforms(&transformManager, inputProgram, transformInputs,
                                       &transformOutputs, nullptr));
     }
 
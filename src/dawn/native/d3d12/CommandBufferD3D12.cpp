@@ -37,7 +37,9 @@
 #include "dawn/native/CommandValidation.h"
 #include "dawn/native/DynamicUploader.h"
 #include "dawn/native/Error.h"
+#include "dawn/native/Queue.h"
 #include "dawn/native/RenderBundle.h"
+#include "dawn/native/TransientBufferAllocator.h"
 #include "dawn/native/d3d12/BindGroupD3D12.h"
 #include "dawn/native/d3d12/BindGroupLayoutD3D12.h"
 #include "dawn/native/d3d12/ComputePipelineD3D12.h"
@@ -212,17 +214,20 @@ MaybeError RecordCopyTextureWithTemporaryBuffer(CommandRecordingContext* recordi
     auto tempBufferSize =
         ComputeRequiredBytesInCopy(blockInfo, copySize, bytesPerRow, rowsPerImage);
 
-    BufferDescriptor tempBufferDescriptor;
-    tempBufferDescriptor.usage = wgpu::BufferUsage::CopySrc | wgpu::BufferUsage::CopyDst;
-    tempBufferDescriptor.size = tempBufferSize.AcquireSuccess();
+    // The temporary buffer is sub-allocated from the queue's transient allocator and reclaimed
+    // when this submit completes.
     Device* device = ToBackend(srcCopy.texture->GetDevice());
-    Ref<BufferBase> tempBufferBase;
-    DAWN_TRY_ASSIGN(tempBufferBase, device->CreateBuffer(&tempBufferDescriptor));
-    Ref<Buffer> tempBuffer = ToBackend(std::move(tempBufferBase));
+    QueueBase* queue = device->GetQueue();
+    TransientBufferAllocation tempAllocation;
+    DAWN_TRY_ASSIGN(tempAllocation, queue->GetTransientBufferAllocator()->Allocate(
+                                        tempBufferSize.AcquireSuccess(),
+                                        queue->GetPendingCommandSerial(),
+                                        D3D12_TEXTURE_DATA_PLACEMENT_ALIGNMENT));
+    Buffer* tempBuffer = ToBackend(tempAllocation.buffer);
 
     BufferCopy bufferCopy;
     bufferCopy.buffer = tempBuffer;
-    bufferCopy.offset = 0;
+    bufferCopy.offset = tempAllocation.offset;
     bufferCopy.bytesPerRow = bytesPerRow;
     bufferCopy.rowsPerImage = rowsPerImage;
 
@@ -236,9 +241,6 @@ MaybeError RecordCopyTextureWithTemporaryBuffer(CommandRecordingContext* recordi
     RecordBufferTextureCopy(BufferTextureCopyDirection::B2T, recordingContext->GetCommandList(),
                             bufferCopy, dstCopy, copySize);
 
-    // Save tempBuffer into recordingContext
-    recordingContext->AddToTempBuffers(std::move(tempBuffer));
-
     return {};
 }
 
@@ -271,20 +273,23 @@ MaybeError RecordBufferTextureCopyWithTemporaryBuffer(CommandRecordingContext* r
     auto tempBufferSize = ComputeRequiredBytesInCopy(blockInfo, copySize, bufferCopy.bytesPerRow,
                                                      bufferCopy.rowsPerImage);
 
-    BufferDescriptor tempBufferDescriptor;
-    tempBufferDescriptor.usage = wgpu::BufferUsage::CopySrc | wgpu::BufferUsage::CopyDst;
-    tempBufferDescriptor.size = tempBufferSize.AcquireSuccess();
+    uint64_t tempBufferCopySize = tempBufferSize.AcquireSuccess();
     Device* device = ToBackend(textureCopy.texture->GetDevice());
-    Ref<BufferBase> tempBufferBase;
-    DAWN_TRY_ASSIGN(tempBufferBase, device->CreateBuffer(&tempBufferDescriptor));
-    // D3D12 aligns the entire buffer to at least 64KB, so the virtual address of tempBuffer will
-    // always be aligned to D3D12_TEXTURE_DATA_PLACEMENT_ALIGNMENT (512).
-    Ref<Buffer> tempBuffer = ToBackend(std::move(tempBufferBase));
+    QueueBase* queue = device->GetQueue();
+    TransientBufferAllocation tempAllocation;
+    DAWN_TRY_ASSIGN(tempAllocation, queue->GetTransientBufferAllocator()->Allocate(
+                                        tempBufferCopySize, queue->GetPendingCommandSerial(),
+                                        D3D12_TEXTURE_DATA_PLACEMENT_ALIGNMENT));
+    // D3D12 aligns the entire buffer to at least 64KB, and the offset in the transient buffer is
+    // aligned to D3D12_TEXTURE_DATA_PLACEMENT_ALIGNMENT (512), so the virtual address of the copy
+    // will always be aligned to it as well.
+    Buffer* tempBuffer = ToBackend(tempAllocation.buffer);
     DAWN_ASSERT(tempBuffer->GetVA() % D3D12_TEXTURE_DATA_PLACEMENT_ALIGNMENT == 0);
+    DAWN_ASSERT(tempAllocation.offset % D3D12_TEXTURE_DATA_PLACEMENT_ALIGNMENT == 0);
 
     BufferCopy tempBufferCopy;
     tempBufferCopy.buffer = tempBuffer;
-    tempBufferCopy.offset = 0;
+    tempBufferCopy.offset = tempAllocation.offset;
     tempBufferCopy.bytesPerRow = bufferCopy.bytesPerRow;
     tempBufferCopy.rowsPerImage = bufferCopy.rowsPerImage;
 
@@ -293,9 +298,9 @@ MaybeError RecordBufferTextureCopyWithTemporaryBuffer(CommandRecordingContext* r
     ID3D12GraphicsCommandList* commandList = recordingContext->GetCommandList();
     switch (copyDirection) {
         case BufferTextureCopyDirection::B2T: {
-            commandList->CopyBufferRegion(tempBuffer->GetD3D12Resource(), 0,
+            commandList->CopyBufferRegion(tempBuffer->GetD3D12Resource(), tempAllocation.offset,
                                           ToBackend(bufferCopy.buffer)->GetD3D12Resource(),
-                                          bufferCopy.offset, tempBufferDescriptor.size);
+                                          bufferCopy.offset, tempBufferCopySize);
             tempBuffer->TrackUsageAndTransitionNow(recordingContext, wgpu::BufferUsage::CopySrc);
             RecordBufferTextureCopy(BufferTextureCopyDirection::B2T,
                                     recordingContext->GetCommandList(), tempBufferCopy, textureCopy,
@@ -308,8 +313,8 @@ MaybeError RecordBufferTextureCopyWithTemporaryBuffer(CommandRecordingContext* r
                                     copySize);
             tempBuffer->TrackUsageAndTransitionNow(recordingContext, wgpu::BufferUsage::CopySrc);
             commandList->CopyBufferRegion(ToBackend(bufferCopy.buffer)->GetD3D12Resource(),
-                                          bufferCopy.offset, tempBuffer->GetD3D12Resource(), 0,
-                                          tempBufferDescriptor.size);
+                                          bufferCopy.offset, tempBuffer->GetD3D12Resource(),
+                                          tempAllocation.offset, tempBufferCopySize);
             break;
         }
         default:
@@ -317,9 +322,6 @@ MaybeError RecordBufferTextureCopyWithTemporaryBuffer(CommandRecordingContext* r
             break;
     }
 
-    // Save tempBuffer into recordingContext
-    recordingContext->AddToTempBuffers(std::move(tempBuffer));
-
     return {};
 }
 
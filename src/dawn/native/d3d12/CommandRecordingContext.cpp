@@ -143,7 +143,6 @@ MaybeError CommandRecordingContext::ExecuteCommandList(Device* device,
     mNeedsSubmit = false;
     mSharedTextures.clear();
     mHeapsPendingUsage.clear();
-    mTempBuffers.clear();
 
     return {};
 }
@@ -178,7 +177,6 @@ void CommandRecordingContext::Release() {
     mNeedsSubmit = false;
     mSharedTextures.clear();
     mHeapsPendingUsage.clear();
-    mTempBuffers.clear();
 }
 
 bool CommandRecordingContext::IsOpen() const {
@@ -193,8 +191,4 @@ void CommandRecordingContext::SetNeedsSubmit() {
     mNeedsSubmit = true;
 }
 
-void CommandRecordingContext::AddToTempBuffers(Ref<Buffer> tempBuffer) {
-    mTempBuffers.emplace_back(tempBuffer);
-}
-
 }  // namespace dawn::native::d3d12
@@ -57,8 +57,6 @@ class CommandRecordingContext {
 
     void TrackHeapUsage(Heap* heap, ExecutionSerial serial);
 
-    void AddToTempBuffers(Ref<Buffer> tempBuffer);
-
   private:
     ComPtr<ID3D12GraphicsCommandList> mD3d12CommandList;
     ComPtr<ID3D12GraphicsCommandList4> mD3d12CommandList4;
@@ -66,8 +64,6 @@ class CommandRecordingContext {
     bool mNeedsSubmit = false;
     std::set<Texture*> mSharedTextures;
     std::vector<Heap*> mHeapsPendingUsage;
-
-    std::vector<Ref<Buffer>> mTempBuffers;
 };
 }  // namespace dawn::native::d3d12
 
@@ -54,7 +54,8 @@ using OptionalVertexPullingTransformConfig =
 
 #define MSL_COMPILATION_REQUEST_MEMBERS(X)                                                       \
     X(SingleShaderStage, stage)                                                                  \
-    X(const tint::Program*, inputProgram)                                                        \
+    X(CacheKey::UnsafeUnkeyedValue<const ShaderModuleBase*>, inputModule)                        \
+    X(ShaderModuleSourceKey, source)                                                             \
     X(OptionalVertexPullingTransformConfig, vertexPullingTransformConfig)                        \
     X(std::optional<tint::ast::transform::SubstituteOverride::Config>, substituteOverrideConfig) \
     X(LimitsForCompilationRequest, limits)                                                       \
@@ -252,7 +253,8 @@ ResultOrError<CacheResult<MslCompilation>> TranslateToMSL(
 
     MslCompilationRequest req = {};
     req.stage = stage;
-    req.inputProgram = programmableStage.module->GetTintProgram();
+    req.inputModule = programmableStage.module.Get();
+    req.source = programmableStage.module->GetSourceKey();
     req.vertexPullingTransformConfig = std::move(vertexPullingTransformConfig);
     req.substituteOverrideConfig = std::move(substituteOverrideConfig);
     req.entryPointName = programmableStage.entryPoint.c_str();
@@ -309,12 +311,17 @@ ResultOrError<CacheResult<MslCompilation>> TranslateToMSL(
                     std::move(r.substituteOverrideConfig).value());
             }
 
+            // Only get the program now: it may need to be parsed if the module was created from
+            // cached reflection data.
+            const tint::Program* inputProgram;
+            DAWN_TRY_ASSIGN(inputProgram, r.inputModule.UnsafeGetValue()->GetTintProgram());
+
             tint::Program program;
             tint::ast::transform::DataMap transformOutputs;
             {
                 TRACE_EVENT0(r.platform.UnsafeGetValue(), General, "RunTransforms");
                 DAWN_TRY_ASSIGN(program,
-                                RunTransforms(&transformManager, r.inputProgram, transformInputs,
+                                RunTransforms(&transformManager, inputProgram, transformInputs,
                                               &transformOutputs, nullptr));
             }
 
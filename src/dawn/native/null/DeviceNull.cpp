@@ -468,9 +468,10 @@ MaybeError ComputePipeline::Initialize() {
             BuildSubstituteOverridesTransformConfig(computeStage));
     }
 
-    DAWN_TRY_ASSIGN(transformedProgram,
-                    RunTransforms(&transformManager, computeStage.module->GetTintProgram(),
-                                  transformInputs, nullptr, nullptr));
+    const tint::Program* inputProgram;
+    DAWN_TRY_ASSIGN(inputProgram, computeStage.module->GetTintProgram());
+    DAWN_TRY_ASSIGN(transformedProgram, RunTransforms(&transformManager, inputProgram,
+                                                      transformInputs, nullptr, nullptr));
 
     // Do the workgroup size validation, although different backend will have different
     // fullSubgroups parameter.
@@ -60,7 +60,7 @@ Buffer::Buffer(Device* device, const UnpackedPtr<BufferDescriptor>& descriptor)
     mAllocatedSize = Align(std::max(GetSize(), uint64_t(4u)), uint64_t(4u));
 
     gl.GenBuffers(1, &mBuffer);
-    gl.BindBuffer(GL_ARRAY_BUFFER, mBuffer);
+    device->GetStateCache()->BindBuffer(gl, GL_ARRAY_BUFFER, mBuffer);
 
     // The buffers with mappedAtCreation == true will be initialized in
     // BufferBase::MapAtCreation().
@@ -135,7 +135,7 @@ void Buffer::InitializeToZero() {
     const OpenGLFunctions& gl = device->GetGL();
 
     const std::vector<uint8_t> clearValues(size, 0u);
-    gl.BindBuffer(GL_ARRAY_BUFFER, mBuffer);
+    device->GetStateCache()->BindBuffer(gl, GL_ARRAY_BUFFER, mBuffer);
     gl.BufferSubData(GL_ARRAY_BUFFER, 0, size, clearValues.data());
     device->IncrementLazyClearCountForTesting();
 
@@ -150,14 +150,16 @@ bool Buffer::IsCPUWritableAtCreation() const {
 }
 
 MaybeError Buffer::MapAtCreationImpl() {
-    const OpenGLFunctions& gl = ToBackend(GetDevice())->GetGL();
-    gl.BindBuffer(GL_ARRAY_BUFFER, mBuffer);
+    Device* device = ToBackend(GetDevice());
+    const OpenGLFunctions& gl = device->GetGL();
+    device->GetStateCache()->BindBuffer(gl, GL_ARRAY_BUFFER, mBuffer);
     mMappedData = gl.MapBufferRange(GL_ARRAY_BUFFER, 0, GetSize(), GL_MAP_WRITE_BIT);
     return {};
 }
 
 MaybeError Buffer::MapAsyncImpl(wgpu::MapMode mode, size_t offset, size_t size) {
-    const OpenGLFunctions& gl = ToBackend(GetDevice())->GetGL();
+    Device* device = ToBackend(GetDevice());
+    const OpenGLFunctions& gl = device->GetGL();
 
     // It is an error to map an empty range in OpenGL. We always have at least a 4-byte buffer
     // so we extend the range to be 4 bytes.
@@ -172,7 +174,7 @@ MaybeError Buffer::MapAsyncImpl(wgpu::MapMode mode, size_t offset, size_t size)
 
     // This does GPU->CPU synchronization, we could require a high
     // version of OpenGL that would let us map the buffer unsynchronized.
-    gl.BindBuffer(GL_ARRAY_BUFFER, mBuffer);
+    device->GetStateCache()->BindBuffer(gl, GL_ARRAY_BUFFER, mBuffer);
     void* mappedData = nullptr;
     if (mode & wgpu::MapMode::Read) {
         mappedData = gl.MapBufferRange(GL_ARRAY_BUFFER, offset, size, GL_MAP_READ_BIT);
@@ -194,18 +196,20 @@ void* Buffer::GetMappedPointer() {
 }
 
 void Buffer::UnmapImpl() {
-    const OpenGLFunctions& gl = ToBackend(GetDevice())->GetGL();
+    Device* device = ToBackend(GetDevice());
+    const OpenGLFunctions& gl = device->GetGL();
 
-    gl.BindBuffer(GL_ARRAY_BUFFER, mBuffer);
+    device->GetStateCache()->BindBuffer(gl, GL_ARRAY_BUFFER, mBuffer);
     gl.UnmapBuffer(GL_ARRAY_BUFFER);
     mMappedData = nullptr;
 }
 
 void Buffer::DestroyImpl() {
-    const OpenGLFunctions& gl = ToBackend(GetDevice())->GetGL();
+    Device* device = ToBackend(GetDevice());
+    const OpenGLFunctions& gl = device->GetGL();
 
     BufferBase::DestroyImpl();
-    gl.DeleteBuffers(1, &mBuffer);
+    device->GetStateCache()->DeleteBuffer(gl, mBuffer);
     mBuffer = 0;
 }
 
@@ -42,11 +42,12 @@
 #include "dawn/native/opengl/ComputePipelineGL.h"
 #include "dawn/native/opengl/DeviceGL.h"
 #include "dawn/native/opengl/Forward.h"
-#include "dawn/native/opengl/PersistentPipelineStateGL.h"
+#include "dawn/native/opengl/FramebufferCacheGL.h"
 #include "dawn/native/opengl/PipelineLayoutGL.h"
 #include "dawn/native/opengl/QuerySetGL.h"
 #include "dawn/native/opengl/RenderPipelineGL.h"
 #include "dawn/native/opengl/SamplerGL.h"
+#include "dawn/native/opengl/StateCacheGL.h"
 #include "dawn/native/opengl/TextureGL.h"
 #include "dawn/native/opengl/UtilsGL.h"
 
@@ -185,9 +186,9 @@ class VertexStateBufferBindingTracker {
         mLastPipeline = pipeline;
     }
 
-    void Apply(const OpenGLFunctions& gl) {
+    void Apply(const OpenGLFunctions& gl, StateCache* stateCache) {
         if (mIndexBufferDirty && mIndexBuffer != nullptr) {
-            gl.BindBuffer(GL_ELEMENT_ARRAY_BUFFER, mIndexBuffer->GetHandle());
+            stateCache->BindBuffer(gl, GL_ELEMENT_ARRAY_BUFFER, mIndexBuffer->GetHandle());
             mIndexBufferDirty = false;
         }
 
@@ -206,7 +207,7 @@ class VertexStateBufferBindingTracker {
                 GLenum formatType = VertexFormatType(attribute.format);
 
                 GLboolean normalized = VertexFormatIsNormalized(attribute.format);
-                gl.BindBuffer(GL_ARRAY_BUFFER, buffer);
+                stateCache->BindBuffer(gl, GL_ARRAY_BUFFER, buffer);
                 if (VertexFormatIsInt(attribute.format)) {
                     gl.VertexAttribIPointer(
                         attribIndex, components, formatType, vertexBuffer.arrayStride,
@@ -247,17 +248,18 @@ class BindGroupTracker : public BindGroupTrackerBase<false, uint64_t> {
         ResetInternalUniformDataDirtyRange();
     }
 
-    void Apply(const OpenGLFunctions& gl) {
+    void Apply(const OpenGLFunctions& gl, StateCache* stateCache) {
         BeforeApply();
         for (BindGroupIndex index : IterateBitSet(mDirtyBindGroupsObjectChangedOrIsDynamic)) {
-            ApplyBindGroup(gl, index, mBindGroups[index], mDynamicOffsets[index]);
+            ApplyBindGroup(gl, stateCache, index, mBindGroups[index], mDynamicOffsets[index]);
         }
-        ApplyInternalUniforms(gl);
+        ApplyInternalUniforms(gl, stateCache);
         AfterApply();
     }
 
   private:
     void ApplyBindGroup(const OpenGLFunctions& gl,
+                        StateCache* stateCache,
                         BindGroupIndex groupIndex,
                         BindGroupBase* group,
                         const ityp::vector<BindingIndex, uint64_t>& dynamicOffsets) {
@@ -303,7 +305,7 @@ class BindGroupTracker : public BindGroupTrackerBase<false, uint64_t> {
                             DAWN_UNREACHABLE();
                     }
 
-                    gl.BindBufferRange(target, index, buffer, offset, binding.size);
+                    stateCache->BindBufferRange(gl, target, index, buffer, offset, binding.size);
                     break;
                 }
 
@@ -316,9 +318,10 @@ class BindGroupTracker : public BindGroupTrackerBase<false, uint64_t> {
                         // Only use filtering for certain texture units, because int
                         // and uint texture are only complete without filtering
                         if (unit.shouldUseFiltering) {
-                            gl.BindSampler(unit.unit, sampler->GetFilteringHandle());
+                            stateCache->BindSampler(gl, unit.unit, sampler->GetFilteringHandle());
                         } else {
-                            gl.BindSampler(unit.unit, sampler->GetNonFilteringHandle());
+                            stateCache->BindSampler(gl, unit.unit,
+                                                    sampler->GetNonFilteringHandle());
                         }
                     }
                     break;
@@ -331,8 +334,8 @@ class BindGroupTracker : public BindGroupTrackerBase<false, uint64_t> {
                     GLuint viewIndex = indices[bindingIndex];
 
                     for (auto unit : mPipeline->GetTextureUnitsForTextureView(viewIndex)) {
-                        gl.ActiveTexture(GL_TEXTURE0 + unit);
-                        gl.BindTexture(target, handle);
+                        stateCache->ActiveTexture(gl, GL_TEXTURE0 + unit);
+                        stateCache->BindTexture(gl, target, handle);
                         if (ToBackend(view->GetTexture())->GetGLFormat().format ==
                             GL_DEPTH_STENCIL) {
                             Aspect aspect = view->GetAspects();
@@ -456,7 +459,7 @@ class BindGroupTracker : public BindGroupTrackerBase<false, uint64_t> {
         mDirtyRange = {mInternalUniformBufferData.size(), 0};
     }
 
-    void ApplyInternalUniforms(const OpenGLFunctions& gl) {
+    void ApplyInternalUniforms(const OpenGLFunctions& gl, StateCache* stateCache) {
         const Buffer* internalUniformBuffer = mPipeline->GetInternalUniformBuffer();
         if (!internalUniformBuffer) {
             return;
@@ -468,11 +471,11 @@ class BindGroupTracker : public BindGroupTrackerBase<false, uint64_t> {
             return;
         }
 
-        gl.BindBuffer(GL_UNIFORM_BUFFER, internalUniformBufferHandle);
+        stateCache->BindBuffer(gl, GL_UNIFORM_BUFFER, internalUniformBufferHandle);
         gl.BufferSubData(GL_UNIFORM_BUFFER, mDirtyRange.first,
                          mDirtyRange.second - mDirtyRange.first,
                          mInternalUniformBufferData.data() + mDirtyRange.first);
-        gl.BindBuffer(GL_UNIFORM_BUFFER, 0);
+        stateCache->BindBuffer(gl, GL_UNIFORM_BUFFER, 0);
 
         ResetInternalUniformDataDirtyRange();
     }
@@ -488,38 +491,30 @@ class BindGroupTracker : public BindGroupTrackerBase<false, uint64_t> {
     std::pair<size_t, size_t> mDirtyRange;
 };
 
-void ResolveMultisampledRenderTargets(const OpenGLFunctions& gl,
+void ResolveMultisampledRenderTargets(Device* device,
+                                      const OpenGLFunctions& gl,
                                       const BeginRenderPassCmd* renderPass) {
     DAWN_ASSERT(renderPass != nullptr);
 
-    GLuint readFbo = 0;
-    GLuint writeFbo = 0;
-
+    FramebufferCache* framebufferCache = device->GetFramebufferCache();
     for (auto i : IterateBitSet(renderPass->attachmentState->GetColorAttachmentsMask())) {
         if (renderPass->colorAttachments[i].resolveTarget != nullptr) {
-            if (readFbo == 0) {
-                DAWN_ASSERT(writeFbo == 0);
-                gl.GenFramebuffers(1, &readFbo);
-                gl.GenFramebuffers(1, &writeFbo);
-            }
-
             TextureView* colorView = ToBackend(renderPass->colorAttachments[i].view.Get());
-
-            gl.BindFramebuffer(GL_READ_FRAMEBUFFER, readFbo);
-            colorView->BindToFramebuffer(GL_READ_FRAMEBUFFER, GL_COLOR_ATTACHMENT0);
+            FramebufferCacheQuery readQuery;
+            readQuery.AddAttachment(colorView->GetFramebufferAttachment(GL_COLOR_ATTACHMENT0));
+            framebufferCache->BindFramebuffer(gl, GL_READ_FRAMEBUFFER, readQuery);
 
             TextureView* resolveView =
                 ToBackend(renderPass->colorAttachments[i].resolveTarget.Get());
-            gl.BindFramebuffer(GL_DRAW_FRAMEBUFFER, writeFbo);
-            resolveView->BindToFramebuffer(GL_DRAW_FRAMEBUFFER, GL_COLOR_ATTACHMENT0);
+            FramebufferCacheQuery drawQuery;
+            drawQuery.AddAttachment(resolveView->GetFramebufferAttachment(GL_COLOR_ATTACHMENT0));
+            framebufferCache->BindFramebuffer(gl, GL_DRAW_FRAMEBUFFER, drawQuery);
+
             gl.BlitFramebuffer(0, 0, renderPass->width, renderPass->height, 0, 0, renderPass->width,
                                renderPass->height, GL_COLOR_BUFFER_BIT, GL_NEAREST);
             ToBackend(resolveView->GetTexture())->Touch();
         }
     }
-
-    gl.DeleteFramebuffers(1, &readFbo);
-    gl.DeleteFramebuffers(1, &writeFbo);
 }
 
 // OpenGL SPEC requires the source/destination region must be a region that is contained
@@ -552,6 +547,7 @@ CommandBuffer::CommandBuffer(CommandEncoder* encoder, const CommandBufferDescrip
 
 MaybeError CommandBuffer::Execute() {
     const OpenGLFunctions& gl = ToBackend(GetDevice())->GetGL();
+    StateCache* stateCache = ToBackend(GetDevice())->GetStateCache();
 
     auto LazyClearSyncScope = [](const SyncScopeResourceUsage& scope) -> MaybeError {
         for (size_t i = 0; i < scope.textures.size(); i++) {
@@ -615,13 +611,15 @@ MaybeError CommandBuffer::Execute() {
                 ToBackend(copy->destination)
                     ->EnsureDataInitializedAsDestination(copy->destinationOffset, copy->size);
 
-                gl.BindBuffer(GL_PIXEL_PACK_BUFFER, ToBackend(copy->source)->GetHandle());
-                gl.BindBuffer(GL_PIXEL_UNPACK_BUFFER, ToBackend(copy->destination)->GetHandle());
+                stateCache->BindBuffer(gl, GL_PIXEL_PACK_BUFFER,
+                                       ToBackend(copy->source)->GetHandle());
+                stateCache->BindBuffer(gl, GL_PIXEL_UNPACK_BUFFER,
+                                       ToBackend(copy->destination)->GetHandle());
                 gl.CopyBufferSubData(GL_PIXEL_PACK_BUFFER, GL_PIXEL_UNPACK_BUFFER,
                                      copy->sourceOffset, copy->destinationOffset, copy->size);
 
-                gl.BindBuffer(GL_PIXEL_PACK_BUFFER, 0);
-                gl.BindBuffer(GL_PIXEL_UNPACK_BUFFER, 0);
+                stateCache->BindBuffer(gl, GL_PIXEL_PACK_BUFFER, 0);
+                stateCache->BindBuffer(gl, GL_PIXEL_UNPACK_BUFFER, 0);
 
                 ToBackend(copy->source)->TrackUsage();
                 ToBackend(copy->destination)->TrackUsage();
@@ -648,7 +646,7 @@ MaybeError CommandBuffer::Execute() {
                     DAWN_TRY(ToBackend(dst.texture)->EnsureSubresourceContentInitialized(range));
                 }
 
-                gl.BindBuffer(GL_PIXEL_UNPACK_BUFFER, buffer->GetHandle());
+                stateCache->BindBuffer(gl, GL_PIXEL_UNPACK_BUFFER, buffer->GetHandle());
 
                 TextureDataLayout dataLayout;
                 dataLayout.offset = 0;
@@ -657,7 +655,7 @@ MaybeError CommandBuffer::Execute() {
 
                 DoTexSubImage(gl, dst, reinterpret_cast<void*>(src.offset), dataLayout,
                               copy->copySize);
-                gl.BindBuffer(GL_PIXEL_UNPACK_BUFFER, 0);
+                stateCache->BindBuffer(gl, GL_PIXEL_UNPACK_BUFFER, 0);
                 ToBackend(dst.texture)->Touch();
 
                 buffer->TrackUsage();
@@ -689,17 +687,20 @@ MaybeError CommandBuffer::Execute() {
                 SubresourceRange subresources = GetSubresourcesAffectedByCopy(src, copy->copySize);
                 DAWN_TRY(texture->EnsureSubresourceContentInitialized(subresources));
                 // The only way to move data from a texture to a buffer in GL is via
-                // glReadPixels with a pack buffer. Create a temporary FBO for the copy.
-                gl.BindTexture(target, texture->GetHandle());
+                // glReadPixels with a pack buffer. Use a cached FBO for the copy.
+                stateCache->BindTexture(gl, target, texture->GetHandle());
 
-                GLuint readFBO = 0;
-                gl.GenFramebuffers(1, &readFBO);
-                gl.BindFramebuffer(GL_READ_FRAMEBUFFER, readFBO);
+                FramebufferCache* framebufferCache = ToBackend(GetDevice())->GetFramebufferCache();
+                FramebufferAttachment readAttachment;
+                readAttachment.texture = texture->GetHandle();
+                readAttachment.textarget = target;
+                readAttachment.mipLevel = src.mipLevel;
 
                 const TexelBlockInfo& blockInfo = formatInfo.GetAspectInfo(src.aspect).block;
 
-                gl.BindBuffer(GL_PIXEL_PACK_BUFFER, buffer->GetHandle());
-                gl.PixelStorei(GL_PACK_ROW_LENGTH, dst.bytesPerRow / blockInfo.byteSize);
+                stateCache->BindBuffer(gl, GL_PIXEL_PACK_BUFFER, buffer->GetHandle());
+                stateCache->PixelStorei(gl, GL_PACK_ROW_LENGTH,
+                                        dst.bytesPerRow / blockInfo.byteSize);
 
                 GLenum glAttachment;
                 GLenum glFormat;
@@ -728,14 +729,16 @@ MaybeError CommandBuffer::Execute() {
                     case Aspect::Plane2:
                         DAWN_UNREACHABLE();
                 }
+                readAttachment.attachment = glAttachment;
 
                 uint8_t* offset = reinterpret_cast<uint8_t*>(static_cast<uintptr_t>(dst.offset));
                 switch (texture->GetDimension()) {
                     case wgpu::TextureDimension::e1D:
                     case wgpu::TextureDimension::e2D: {
                         if (texture->GetArrayLayers() == 1) {
-                            gl.FramebufferTexture2D(GL_READ_FRAMEBUFFER, glAttachment, target,
-                                                    texture->GetHandle(), src.mipLevel);
+                            FramebufferCacheQuery query;
+                            query.AddAttachment(readAttachment);
+                            framebufferCache->BindFramebuffer(gl, GL_READ_FRAMEBUFFER, query);
                             gl.ReadPixels(src.origin.x, src.origin.y, copySize.width,
                                           copySize.height, glFormat, glType, offset);
                             break;
@@ -747,9 +750,10 @@ MaybeError CommandBuffer::Execute() {
                     case wgpu::TextureDimension::e3D: {
                         const uint64_t bytesPerImage = dst.bytesPerRow * dst.rowsPerImage;
                         for (uint32_t z = 0; z < copySize.depthOrArrayLayers; ++z) {
-                            gl.FramebufferTextureLayer(GL_READ_FRAMEBUFFER, glAttachment,
-                                                       texture->GetHandle(), src.mipLevel,
-                                                       src.origin.z + z);
+                            readAttachment.arrayLayer = src.origin.z + z;
+                            FramebufferCacheQuery query;
+                            query.AddAttachment(readAttachment);
+                            framebufferCache->BindFramebuffer(gl, GL_READ_FRAMEBUFFER, query);
                             gl.ReadPixels(src.origin.x, src.origin.y, copySize.width,
                                           copySize.height, glFormat, glType, offset);
 
@@ -759,10 +763,12 @@ MaybeError CommandBuffer::Execute() {
                     }
                 }
 
-                gl.PixelStorei(GL_PACK_ROW_LENGTH, 0);
+                stateCache->PixelStorei(gl, GL_PACK_ROW_LENGTH, 0);
 
-                gl.BindBuffer(GL_PIXEL_PACK_BUFFER, 0);
-                gl.DeleteFramebuffers(1, &readFBO);
+                stateCache->BindBuffer(gl, GL_PIXEL_PACK_BUFFER, 0);
+                // Creating the framebuffer in the cache also binds it to GL_DRAW_FRAMEBUFFER, so
+                // reset both binding points.
+                gl.BindFramebuffer(GL_FRAMEBUFFER, 0);
 
                 buffer->TrackUsage();
                 break;
@@ -795,9 +801,10 @@ MaybeError CommandBuffer::Execute() {
                 } else {
                     DAWN_TRY(dstTexture->EnsureSubresourceContentInitialized(dstRange));
                 }
-                CopyImageSubData(gl, src.aspect, srcTexture->GetHandle(), srcTexture->GetGLTarget(),
-                                 src.mipLevel, src.origin, dstTexture->GetHandle(),
-                                 dstTexture->GetGLTarget(), dst.mipLevel, dst.origin, copySize);
+                CopyImageSubData(gl, stateCache, src.aspect, srcTexture->GetHandle(),
+                                 srcTexture->GetGLTarget(), src.mipLevel, src.origin,
+                                 dstTexture->GetHandle(), dstTexture->GetGLTarget(), dst.mipLevel,
+                                 dst.origin, copySize);
                 ToBackend(dst.texture)->Touch();
                 break;
             }
@@ -815,7 +822,7 @@ MaybeError CommandBuffer::Execute() {
 
                 if (!clearedToZero) {
                     const std::vector<uint8_t> clearValues(cmd->size, 0u);
-                    gl.BindBuffer(GL_ARRAY_BUFFER, dstBuffer->GetHandle());
+                    stateCache->BindBuffer(gl, GL_ARRAY_BUFFER, dstBuffer->GetHandle());
                     gl.BufferSubData(GL_ARRAY_BUFFER, cmd->offset, cmd->size, clearValues.data());
                 }
 
@@ -845,7 +852,7 @@ MaybeError CommandBuffer::Execute() {
                     values[i] = value;
                 }
 
-                gl.BindBuffer(GL_ARRAY_BUFFER, destination->GetHandle());
+                stateCache->BindBuffer(gl, GL_ARRAY_BUFFER, destination->GetHandle());
                 gl.BufferSubData(GL_ARRAY_BUFFER, cmd->destinationOffset, size, values.data());
 
                 break;
@@ -876,7 +883,7 @@ MaybeError CommandBuffer::Execute() {
                 uint8_t* data = mCommands.NextData<uint8_t>(size);
                 dstBuffer->EnsureDataInitializedAsDestination(offset, size);
 
-                gl.BindBuffer(GL_ARRAY_BUFFER, dstBuffer->GetHandle());
+                stateCache->BindBuffer(gl, GL_ARRAY_BUFFER, dstBuffer->GetHandle());
                 gl.BufferSubData(GL_ARRAY_BUFFER, offset, size, data);
 
                 dstBuffer->TrackUsage();
@@ -893,6 +900,7 @@ MaybeError CommandBuffer::Execute() {
 
 MaybeError CommandBuffer::ExecuteComputePass() {
     const OpenGLFunctions& gl = ToBackend(GetDevice())->GetGL();
+    StateCache* stateCache = ToBackend(GetDevice())->GetStateCache();
     ComputePipeline* lastPipeline = nullptr;
     BindGroupTracker bindGroupTracker = {};
 
@@ -906,7 +914,7 @@ MaybeError CommandBuffer::ExecuteComputePass() {
 
             case Command::Dispatch: {
                 DispatchCmd* dispatch = mCommands.NextCommand<DispatchCmd>();
-                bindGroupTracker.Apply(gl);
+                bindGroupTracker.Apply(gl, stateCache);
 
                 gl.DispatchCompute(dispatch->x, dispatch->y, dispatch->z);
                 gl.MemoryBarrier(GL_ALL_BARRIER_BITS);
@@ -915,12 +923,13 @@ MaybeError CommandBuffer::ExecuteComputePass() {
 
             case Command::DispatchIndirect: {
                 DispatchIndirectCmd* dispatch = mCommands.NextCommand<DispatchIndirectCmd>();
-                bindGroupTracker.Apply(gl);
+                bindGroupTracker.Apply(gl, stateCache);
 
                 uint64_t indirectBufferOffset = dispatch->indirectOffset;
                 Buffer* indirectBuffer = ToBackend(dispatch->indirectBuffer.Get());
 
-                gl.BindBuffer(GL_DISPATCH_INDIRECT_BUFFER, indirectBuffer->GetHandle());
+                stateCache->BindBuffer(gl, GL_DISPATCH_INDIRECT_BUFFER,
+                                       indirectBuffer->GetHandle());
                 gl.DispatchComputeIndirect(static_cast<GLintptr>(indirectBufferOffset));
                 gl.MemoryBarrier(GL_ALL_BARRIER_BITS);
 
@@ -971,46 +980,30 @@ MaybeError CommandBuffer::ExecuteComputePass() {
 }
 
 MaybeError CommandBuffer::ExecuteRenderPass(BeginRenderPassCmd* renderPass) {
-    const OpenGLFunctions& gl = ToBackend(GetDevice())->GetGL();
-    GLuint fbo = 0;
+    Device* device = ToBackend(GetDevice());
+    const OpenGLFunctions& gl = device->GetGL();
+    StateCache* stateCache = device->GetStateCache();
 
-    // Create the framebuffer used for this render pass and calls the correct glDrawBuffers
+    // Bind the framebuffer used for this render pass. Its draw buffers are its color attachments.
     {
         // TODO(kainino@chromium.org): This is added to possibly work around an issue seen on
         // Windows/Intel. It should break any feedback loop before the clears, even if there
         // shouldn't be any negative effects from this. Investigate whether it's actually
         // needed.
         gl.BindFramebuffer(GL_READ_FRAMEBUFFER, 0);
-        // TODO(kainino@chromium.org): possible future optimization: create these framebuffers
-        // at Framebuffer build time (or maybe CommandBuffer build time) so they don't have to
-        // be created and destroyed at draw time.
-        gl.GenFramebuffers(1, &fbo);
-        gl.BindFramebuffer(GL_DRAW_FRAMEBUFFER, fbo);
-
-        // Mapping from attachmentSlot to GL framebuffer attachment points. Defaults to zero
-        // (GL_NONE).
-        PerColorAttachment<GLenum> drawBuffers = {};
 
-        // Construct GL framebuffer
-
-        ColorAttachmentIndex attachmentCount{};
+        FramebufferCacheQuery query;
         for (auto i : IterateBitSet(renderPass->attachmentState->GetColorAttachmentsMask())) {
             TextureView* textureView = ToBackend(renderPass->colorAttachments[i].view.Get());
             GLenum glAttachment = GL_COLOR_ATTACHMENT0 + static_cast<uint8_t>(i);
-
-            // Attach color buffers.
-            textureView->BindToFramebuffer(GL_DRAW_FRAMEBUFFER, glAttachment,
-                                           renderPass->colorAttachments[i].depthSlice);
-            drawBuffers[i] = glAttachment;
-            attachmentCount = ityp::PlusOne(i);
+            query.AddAttachment(textureView->GetFramebufferAttachment(
+                glAttachment, renderPass->colorAttachments[i].depthSlice));
         }
-        gl.DrawBuffers(static_cast<uint8_t>(attachmentCount), drawBuffers.data());
 
         if (renderPass->attachmentState->HasDepthStencilAttachment()) {
             TextureView* textureView = ToBackend(renderPass->depthStencilAttachment.view.Get());
             const Format& format = textureView->GetTexture()->GetFormat();
 
-            // Attach depth/stencil buffer.
             GLenum glAttachment = 0;
             if (format.aspects == (Aspect::Depth | Aspect::Stencil)) {
                 glAttachment = GL_DEPTH_STENCIL_ATTACHMENT;
@@ -1022,19 +1015,18 @@ MaybeError CommandBuffer::ExecuteRenderPass(BeginRenderPassCmd* renderPass) {
                 DAWN_UNREACHABLE();
             }
 
-            textureView->BindToFramebuffer(GL_DRAW_FRAMEBUFFER, glAttachment);
+            query.AddAttachment(textureView->GetFramebufferAttachment(glAttachment));
         }
-    }
 
-    DAWN_ASSERT(gl.CheckFramebufferStatus(GL_DRAW_FRAMEBUFFER) == GL_FRAMEBUFFER_COMPLETE);
+        device->GetFramebufferCache()->BindFramebuffer(gl, GL_DRAW_FRAMEBUFFER, query);
+    }
 
     // Set defaults for dynamic state before executing clears and commands.
-    PersistentPipelineState persistentPipelineState;
-    persistentPipelineState.SetDefaultState(gl);
-    gl.BlendColor(0, 0, 0, 0);
-    gl.Viewport(0, 0, renderPass->width, renderPass->height);
-    gl.DepthRangef(0.0, 1.0);
-    gl.Scissor(0, 0, renderPass->width, renderPass->height);
+    stateCache->SetStencilReference(gl, 0);
+    stateCache->BlendColor(gl, {0, 0, 0, 0});
+    stateCache->Viewport(gl, 0, 0, renderPass->width, renderPass->height);
+    stateCache->DepthRange(gl, 0.0, 1.0);
+    stateCache->Scissor(gl, 0, 0, renderPass->width, renderPass->height);
 
     // Clear framebuffer attachments as needed
     {
@@ -1044,7 +1036,7 @@ MaybeError CommandBuffer::ExecuteRenderPass(BeginRenderPassCmd* renderPass) {
 
             // Load op - color
             if (attachmentInfo->loadOp == wgpu::LoadOp::Clear) {
-                gl.ColorMask(true, true, true, true);
+                stateCache->ColorMask(gl, true, true, true, true);
 
                 TextureComponentType baseType =
                     attachmentInfo->view->GetFormat().GetAspectInfo(Aspect::Color).baseType;
@@ -1086,10 +1078,11 @@ MaybeError CommandBuffer::ExecuteRenderPass(BeginRenderPassCmd* renderPass) {
                                   (attachmentInfo->stencilLoadOp == wgpu::LoadOp::Clear);
 
             if (doDepthClear) {
-                gl.DepthMask(GL_TRUE);
+                stateCache->DepthMask(gl, GL_TRUE);
             }
             if (doStencilClear) {
-                gl.StencilMask(GetStencilMaskFromStencilFormat(attachmentFormat.format));
+                stateCache->StencilMask(gl,
+                                        GetStencilMaskFromStencilFormat(attachmentFormat.format));
             }
 
             if (doDepthClear && doStencilClear) {
@@ -1116,8 +1109,8 @@ MaybeError CommandBuffer::ExecuteRenderPass(BeginRenderPassCmd* renderPass) {
         switch (type) {
             case Command::Draw: {
                 DrawCmd* draw = iter->NextCommand<DrawCmd>();
-                vertexStateBufferBindingTracker.Apply(gl);
-                bindGroupTracker.Apply(gl);
+                vertexStateBufferBindingTracker.Apply(gl, stateCache);
+                bindGroupTracker.Apply(gl, stateCache);
 
                 if (gl.DrawArraysInstancedBaseInstanceANGLE) {
                     gl.DrawArraysInstancedBaseInstanceANGLE(
@@ -1138,8 +1131,8 @@ MaybeError CommandBuffer::ExecuteRenderPass(BeginRenderPassCmd* renderPass) {
 
             case Command::DrawIndexed: {
                 DrawIndexedCmd* draw = iter->NextCommand<DrawIndexedCmd>();
-                vertexStateBufferBindingTracker.Apply(gl);
-                bindGroupTracker.Apply(gl);
+                vertexStateBufferBindingTracker.Apply(gl, stateCache);
+                bindGroupTracker.Apply(gl, stateCache);
 
                 if (gl.DrawElementsInstancedBaseVertexBaseInstanceANGLE) {
                     gl.DrawElementsInstancedBaseVertexBaseInstanceANGLE(
@@ -1177,13 +1170,13 @@ MaybeError CommandBuffer::ExecuteRenderPass(BeginRenderPassCmd* renderPass) {
 
             case Command::DrawIndirect: {
                 DrawIndirectCmd* draw = iter->NextCommand<DrawIndirectCmd>();
-                vertexStateBufferBindingTracker.Apply(gl);
-                bindGroupTracker.Apply(gl);
+                vertexStateBufferBindingTracker.Apply(gl, stateCache);
+                bindGroupTracker.Apply(gl, stateCache);
 
                 uint64_t indirectBufferOffset = draw->indirectOffset;
                 Buffer* indirectBuffer = ToBackend(draw->indirectBuffer.Get());
 
-                gl.BindBuffer(GL_DRAW_INDIRECT_BUFFER, indirectBuffer->GetHandle());
+                stateCache->BindBuffer(gl, GL_DRAW_INDIRECT_BUFFER, indirectBuffer->GetHandle());
                 gl.DrawArraysIndirect(
                     lastPipeline->GetGLPrimitiveTopology(),
                     reinterpret_cast<void*>(static_cast<intptr_t>(indirectBufferOffset)));
@@ -1194,13 +1187,13 @@ MaybeError CommandBuffer::ExecuteRenderPass(BeginRenderPassCmd* renderPass) {
             case Command::DrawIndexedIndirect: {
                 DrawIndexedIndirectCmd* draw = iter->NextCommand<DrawIndexedIndirectCmd>();
 
-                vertexStateBufferBindingTracker.Apply(gl);
-                bindGroupTracker.Apply(gl);
+                vertexStateBufferBindingTracker.Apply(gl, stateCache);
+                bindGroupTracker.Apply(gl, stateCache);
 
                 Buffer* indirectBuffer = ToBackend(draw->indirectBuffer.Get());
                 DAWN_ASSERT(indirectBuffer != nullptr);
 
-                gl.BindBuffer(GL_DRAW_INDIRECT_BUFFER, indirectBuffer->GetHandle());
+                stateCache->BindBuffer(gl, GL_DRAW_INDIRECT_BUFFER, indirectBuffer->GetHandle());
                 gl.DrawElementsIndirect(
                     lastPipeline->GetGLPrimitiveTopology(), indexBufferFormat,
                     reinterpret_cast<void*>(static_cast<intptr_t>(draw->indirectOffset)));
@@ -1220,7 +1213,7 @@ MaybeError CommandBuffer::ExecuteRenderPass(BeginRenderPassCmd* renderPass) {
             case Command::SetRenderPipeline: {
                 SetRenderPipelineCmd* cmd = iter->NextCommand<SetRenderPipelineCmd>();
                 lastPipeline = ToBackend(cmd->pipeline).Get();
-                lastPipeline->ApplyNow(persistentPipelineState);
+                lastPipeline->ApplyNow();
 
                 vertexStateBufferBindingTracker.OnSetPipeline(lastPipeline);
                 bindGroupTracker.OnSetPipeline(lastPipeline);
@@ -1281,43 +1274,36 @@ MaybeError CommandBuffer::ExecuteRenderPass(BeginRenderPassCmd* renderPass) {
                     ToBackend(textureView->GetTexture())->Touch();
                 }
                 if (renderPass->attachmentState->GetSampleCount() > 1) {
-                    ResolveMultisampledRenderTargets(gl, renderPass);
+                    ResolveMultisampledRenderTargets(device, gl, renderPass);
                 }
-                gl.DeleteFramebuffers(1, &fbo);
+                // The framebuffer is cached, unbind it so that it isn't used by accident.
+                gl.BindFramebuffer(GL_FRAMEBUFFER, 0);
                 return {};
             }
 
             case Command::SetStencilReference: {
                 SetStencilReferenceCmd* cmd = mCommands.NextCommand<SetStencilReferenceCmd>();
-                persistentPipelineState.SetStencilReference(gl, cmd->reference);
+                stateCache->SetStencilReference(gl, cmd->reference);
                 break;
             }
 
             case Command::SetViewport: {
                 SetViewportCmd* cmd = mCommands.NextCommand<SetViewportCmd>();
-                if (gl.IsAtLeastGL(4, 1)) {
-                    gl.ViewportIndexedf(0, cmd->x, cmd->y, cmd->width, cmd->height);
-                } else {
-                    // Floating-point viewport coords are unsupported on OpenGL ES, but
-                    // truncation is ok because other APIs do not guarantee subpixel precision
-                    // either.
-                    gl.Viewport(static_cast<int>(cmd->x), static_cast<int>(cmd->y),
-                                static_cast<int>(cmd->width), static_cast<int>(cmd->height));
-                }
-                gl.DepthRangef(cmd->minDepth, cmd->maxDepth);
+                stateCache->Viewport(gl, cmd->x, cmd->y, cmd->width, cmd->height);
+                stateCache->DepthRange(gl, cmd->minDepth, cmd->maxDepth);
                 break;
             }
 
             case Command::SetScissorRect: {
                 SetScissorRectCmd* cmd = mCommands.NextCommand<SetScissorRectCmd>();
-                gl.Scissor(cmd->x, cmd->y, cmd->width, cmd->height);
+                stateCache->Scissor(gl, cmd->x, cmd->y, cmd->width, cmd->height);
                 break;
             }
 
             case Command::SetBlendConstant: {
                 SetBlendConstantCmd* cmd = mCommands.NextCommand<SetBlendConstantCmd>();
                 const std::array<float, 4> blendColor = ConvertToFloatColor(cmd->color);
-                gl.BlendColor(blendColor[0], blendColor[1], blendColor[2], blendColor[3]);
+                stateCache->BlendColor(gl, blendColor);
                 break;
             }
 
@@ -1371,9 +1357,10 @@ void DoTexSubImage(const OpenGLFunctions& gl,
 
     const GLFormat& format = texture->GetGLFormat();
     GLenum target = texture->GetGLTarget();
+    StateCache* stateCache = ToBackend(texture->GetDevice())->GetStateCache();
     data = static_cast<const uint8_t*>(data) + dataLayout.offset;
-    gl.ActiveTexture(GL_TEXTURE0);
-    gl.BindTexture(target, texture->GetHandle());
+    stateCache->ActiveTexture(gl, GL_TEXTURE0);
+    stateCache->BindTexture(gl, target, texture->GetHandle());
     const TexelBlockInfo& blockInfo = texture->GetFormat().GetAspectInfo(destination.aspect).block;
 
     uint32_t x = destination.origin.x;
@@ -1397,29 +1384,30 @@ void DoTexSubImage(const OpenGLFunctions& gl,
 
             uint32_t height = std::min(copySize.height, virtSize.height - y);
 
-            gl.PixelStorei(GL_UNPACK_ROW_LENGTH,
-                           dataLayout.bytesPerRow / blockInfo.byteSize * blockInfo.width);
-            gl.PixelStorei(GL_UNPACK_COMPRESSED_BLOCK_SIZE, blockInfo.byteSize);
-            gl.PixelStorei(GL_UNPACK_COMPRESSED_BLOCK_WIDTH, blockInfo.width);
-            gl.PixelStorei(GL_UNPACK_COMPRESSED_BLOCK_HEIGHT, blockInfo.height);
-            gl.PixelStorei(GL_UNPACK_COMPRESSED_BLOCK_DEPTH, 1);
+            stateCache->PixelStorei(gl, GL_UNPACK_ROW_LENGTH,
+                                    dataLayout.bytesPerRow / blockInfo.byteSize * blockInfo.width);
+            stateCache->PixelStorei(gl, GL_UNPACK_COMPRESSED_BLOCK_SIZE, blockInfo.byteSize);
+            stateCache->PixelStorei(gl, GL_UNPACK_COMPRESSED_BLOCK_WIDTH, blockInfo.width);
+            stateCache->PixelStorei(gl, GL_UNPACK_COMPRESSED_BLOCK_HEIGHT, blockInfo.height);
+            stateCache->PixelStorei(gl, GL_UNPACK_COMPRESSED_BLOCK_DEPTH, 1);
 
             if (texture->GetArrayLayers() == 1 && Is1DOr2D(texture->GetDimension())) {
                 gl.CompressedTexSubImage2D(target, destination.mipLevel, x, y, width, height,
                                            format.internalFormat, imageSize, data);
             } else {
-                gl.PixelStorei(GL_UNPACK_IMAGE_HEIGHT, dataLayout.rowsPerImage * blockInfo.height);
+                stateCache->PixelStorei(gl, GL_UNPACK_IMAGE_HEIGHT,
+                                        dataLayout.rowsPerImage * blockInfo.height);
                 gl.CompressedTexSubImage3D(target, destination.mipLevel, x, y, z, width, height,
                                            copySize.depthOrArrayLayers, format.internalFormat,
                                            imageSize, data);
-                gl.PixelStorei(GL_UNPACK_IMAGE_HEIGHT, 0);
+                stateCache->PixelStorei(gl, GL_UNPACK_IMAGE_HEIGHT, 0);
             }
 
-            gl.PixelStorei(GL_UNPACK_ROW_LENGTH, 0);
-            gl.PixelStorei(GL_UNPACK_COMPRESSED_BLOCK_SIZE, 0);
-            gl.PixelStorei(GL_UNPACK_COMPRESSED_BLOCK_WIDTH, 0);
-            gl.PixelStorei(GL_UNPACK_COMPRESSED_BLOCK_HEIGHT, 0);
-            gl.PixelStorei(GL_UNPACK_COMPRESSED_BLOCK_DEPTH, 0);
+            stateCache->PixelStorei(gl, GL_UNPACK_ROW_LENGTH, 0);
+            stateCache->PixelStorei(gl, GL_UNPACK_COMPRESSED_BLOCK_SIZE, 0);
+            stateCache->PixelStorei(gl, GL_UNPACK_COMPRESSED_BLOCK_WIDTH, 0);
+            stateCache->PixelStorei(gl, GL_UNPACK_COMPRESSED_BLOCK_HEIGHT, 0);
+            stateCache->PixelStorei(gl, GL_UNPACK_COMPRESSED_BLOCK_DEPTH, 0);
         } else {
             if (texture->GetArrayLayers() == 1 && Is1DOr2D(texture->GetDimension())) {
                 const uint8_t* d = static_cast<const uint8_t*>(data);
@@ -1453,20 +1441,21 @@ void DoTexSubImage(const OpenGLFunctions& gl,
         uint32_t height = copySize.height;
         if (dataLayout.bytesPerRow % blockInfo.byteSize == 0) {
             // Valid values for GL_UNPACK_ALIGNMENT are 1, 2, 4, 8
-            gl.PixelStorei(GL_UNPACK_ALIGNMENT, std::min(8u, blockInfo.byteSize));
-            gl.PixelStorei(GL_UNPACK_ROW_LENGTH,
-                           dataLayout.bytesPerRow / blockInfo.byteSize * blockInfo.width);
+            stateCache->PixelStorei(gl, GL_UNPACK_ALIGNMENT, std::min(8u, blockInfo.byteSize));
+            stateCache->PixelStorei(gl, GL_UNPACK_ROW_LENGTH,
+                                    dataLayout.bytesPerRow / blockInfo.byteSize * blockInfo.width);
             if (texture->GetArrayLayers() == 1 && Is1DOr2D(texture->GetDimension())) {
                 gl.TexSubImage2D(target, destination.mipLevel, x, y, width, height, format.format,
                                  format.type, data);
             } else {
-                gl.PixelStorei(GL_UNPACK_IMAGE_HEIGHT, dataLayout.rowsPerImage * blockInfo.height);
+                stateCache->PixelStorei(gl, GL_UNPACK_IMAGE_HEIGHT,
+                                        dataLayout.rowsPerImage * blockInfo.height);
                 gl.TexSubImage3D(target, destination.mipLevel, x, y, z, width, height,
                                  copySize.depthOrArrayLayers, format.format, format.type, data);
-                gl.PixelStorei(GL_UNPACK_IMAGE_HEIGHT, 0);
+                stateCache->PixelStorei(gl, GL_UNPACK_IMAGE_HEIGHT, 0);
             }
-            gl.PixelStorei(GL_UNPACK_ROW_LENGTH, 0);
-            gl.PixelStorei(GL_UNPACK_ALIGNMENT, 4);  // Reset to default
+            stateCache->PixelStorei(gl, GL_UNPACK_ROW_LENGTH, 0);
+            stateCache->PixelStorei(gl, GL_UNPACK_ALIGNMENT, 4);  // Reset to default
         } else {
             if (texture->GetArrayLayers() == 1 && Is1DOr2D(texture->GetDimension())) {
                 const uint8_t* d = static_cast<const uint8_t*>(data);
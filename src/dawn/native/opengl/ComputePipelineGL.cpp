@@ -42,17 +42,20 @@ ComputePipeline::~ComputePipeline() = default;
 
 void ComputePipeline::DestroyImpl() {
     ComputePipelineBase::DestroyImpl();
-    DeleteProgram(ToBackend(GetDevice())->GetGL());
+    Device* device = ToBackend(GetDevice());
+    DeleteProgram(device->GetGL(), device->GetStateCache());
 }
 
 MaybeError ComputePipeline::Initialize() {
-    DAWN_TRY(
-        InitializeBase(ToBackend(GetDevice())->GetGL(), ToBackend(GetLayout()), GetAllStages()));
+    Device* device = ToBackend(GetDevice());
+    DAWN_TRY(InitializeBase(device->GetGL(), device->GetStateCache(), ToBackend(GetLayout()),
+                            GetAllStages()));
     return {};
 }
 
 void ComputePipeline::ApplyNow() {
-    PipelineGL::ApplyNow(ToBackend(GetDevice())->GetGL());
+    Device* device = ToBackend(GetDevice());
+    PipelineGL::ApplyNow(device->GetGL(), device->GetStateCache());
 }
 
 }  // namespace dawn::native::opengl
@@ -148,6 +148,9 @@ MaybeError Device::Initialize(const UnpackedPtr<DeviceDescriptor>& descriptor) {
     const OpenGLFunctions& gl = mGL;
 
     mFormatTable = BuildGLFormatTable(GetBGRAInternalFormat(gl));
+    mFramebufferCache = std::make_unique<FramebufferCache>();
+    mStateCache =
+        std::make_unique<StateCache>(!IsToggleEnabled(Toggle::DisableGLStateShadowing));
 
     // Use the debug output functionality to get notified about GL errors
     // TODO(crbug.com/dawn/1475): add support for the KHR_debug and ARB_debug_output
@@ -179,22 +182,30 @@ MaybeError Device::Initialize(const UnpackedPtr<DeviceDescriptor>& descriptor) {
     }
 
     // Set initial state.
-    gl.Enable(GL_DEPTH_TEST);
-    gl.Enable(GL_SCISSOR_TEST);
-    gl.Enable(GL_PRIMITIVE_RESTART_FIXED_INDEX);
+    mStateCache->SetEnabled(gl, GL_DEPTH_TEST, true);
+    mStateCache->SetEnabled(gl, GL_SCISSOR_TEST, true);
+    mStateCache->SetEnabled(gl, GL_PRIMITIVE_RESTART_FIXED_INDEX, true);
     if (gl.GetVersion().IsDesktop()) {
         // These are not necessary on GLES. The functionality is enabled by default, and
         // works by specifying sample counts and SRGB textures, respectively.
-        gl.Enable(GL_MULTISAMPLE);
-        gl.Enable(GL_FRAMEBUFFER_SRGB);
+        mStateCache->SetEnabled(gl, GL_MULTISAMPLE, true);
+        mStateCache->SetEnabled(gl, GL_FRAMEBUFFER_SRGB, true);
     }
-    gl.Enable(GL_SAMPLE_MASK);
+    mStateCache->SetEnabled(gl, GL_SAMPLE_MASK, true);
 
     Ref<Queue> queue;
     DAWN_TRY_ASSIGN(queue, Queue::Create(this, &descriptor->defaultQueue));
     return DeviceBase::Initialize(std::move(queue));
 }
 
+FramebufferCache* Device::GetFramebufferCache() {
+    return mFramebufferCache.get();
+}
+
+StateCache* Device::GetStateCache() {
+    return mStateCache.get();
+}
+
 const GLFormat& Device::GetGLFormat(const Format& format) {
     DAWN_ASSERT(format.IsSupported());
     DAWN_ASSERT(format.GetIndex() < mFormatTable.size());
@@ -318,7 +329,7 @@ TextureBase* Device::CreateTextureWrappingEGLImage(const ExternalImageDescriptor
 
     GLuint tex;
     gl.GenTextures(1, &tex);
-    gl.BindTexture(GL_TEXTURE_2D, tex);
+    mStateCache->BindTexture(gl, GL_TEXTURE_2D, tex);
     gl.EGLImageTargetTexture2DOES(GL_TEXTURE_2D, image);
     gl.TexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAX_LEVEL, 0);
 
@@ -329,7 +340,7 @@ TextureBase* Device::CreateTextureWrappingEGLImage(const ExternalImageDescriptor
     if (textureDescriptor->size.width != static_cast<uint32_t>(width) ||
         textureDescriptor->size.height != static_cast<uint32_t>(height) ||
         textureDescriptor->size.depthOrArrayLayers != 1) {
-        gl.DeleteTextures(1, &tex);
+        mStateCache->DeleteTexture(gl, tex);
         HandleError(DAWN_VALIDATION_ERROR(
             "EGLImage size (width: %u, height: %u, depth: 1) doesn't match descriptor size %s.",
             width, height, &textureDescriptor->size));
@@ -364,7 +375,7 @@ TextureBase* Device::CreateTextureWrappingGLTexture(const ExternalImageDescripto
         return nullptr;
     }
 
-    gl.BindTexture(GL_TEXTURE_2D, texture);
+    mStateCache->BindTexture(gl, GL_TEXTURE_2D, texture);
 
     GLint width, height;
     gl.GetTexLevelParameteriv(GL_TEXTURE_2D, 0, GL_TEXTURE_WIDTH, &width);
@@ -407,6 +418,12 @@ MaybeError Device::CopyFromStagingToTextureImpl(const BufferBase* source,
 
 void Device::DestroyImpl() {
     DAWN_ASSERT(GetState() == State::Disconnected);
+
+    // Don't use GetGL() since the queue has already been destroyed.
+    if (mFramebufferCache != nullptr) {
+        mContext->MakeCurrent();
+        mFramebufferCache->Destroy(mGL);
+    }
 }
 
 uint32_t Device::GetOptimalBytesPerRowAlignment() const {
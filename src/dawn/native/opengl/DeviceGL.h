@@ -36,8 +36,10 @@
 #include "dawn/native/Device.h"
 #include "dawn/native/QuerySet.h"
 #include "dawn/native/opengl/Forward.h"
+#include "dawn/native/opengl/FramebufferCacheGL.h"
 #include "dawn/native/opengl/GLFormat.h"
 #include "dawn/native/opengl/OpenGLFunctions.h"
+#include "dawn/native/opengl/StateCacheGL.h"
 
 // Remove windows.h macros after glad's include of windows.h
 #if DAWN_PLATFORM_IS(WINDOWS)
@@ -66,6 +68,10 @@ class Device final : public DeviceBase {
 
     const GLFormat& GetGLFormat(const Format& format);
 
+    FramebufferCache* GetFramebufferCache();
+    // The shadowed state of the context. Must only be used after GetGL() made it current.
+    StateCache* GetStateCache();
+
     MaybeError ValidateTextureCanBeWrapped(const UnpackedPtr<TextureDescriptor>& descriptor);
     TextureBase* CreateTextureWrappingEGLImage(const ExternalImageDescriptor* descriptor,
                                                ::EGLImage image);
@@ -145,6 +151,8 @@ class Device final : public DeviceBase {
     const OpenGLFunctions mGL;
 
     GLFormatTable mFormatTable;
+    std::unique_ptr<FramebufferCache> mFramebufferCache;
+    std::unique_ptr<StateCache> mStateCache;
     std::unique_ptr<Context> mContext = nullptr;
 };
 
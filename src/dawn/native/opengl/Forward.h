@@ -38,7 +38,6 @@ class Buffer;
 class CommandBuffer;
 class ComputePipeline;
 class Device;
-class PersistentPipelineState;
 class PhysicalDevice;
 class PipelineLayout;
 class QuerySet;
@@ -46,6 +45,7 @@ class Queue;
 class RenderPipeline;
 class Sampler;
 class ShaderModule;
+class StateCache;
 class SwapChain;
 class Texture;
 class TextureView;
@@ -0,0 +1,170 @@
+// Copyright 2024 The Dawn & Tint Authors
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+//
+// 1. Redistributions of source code must retain the above copyright notice, this
+//    list of conditions and the following disclaimer.
+//
+// 2. Redistributions in binary form must reproduce the above copyright notice,
+//    this list of conditions and the following disclaimer in the documentation
+//    and/or other materials provided with the distribution.
+//
+// 3. Neither the name of the copyright holder nor the names of its
+//    contributors may be used to endorse or promote products derived from
+//    this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+// DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+// FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+// DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+// SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+// CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+// OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+// OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+
+#include "dawn/native/opengl/FramebufferCacheGL.h"
+
+#include <algorithm>
+
+#include "dawn/common/Assert.h"
+#include "dawn/common/HashUtils.h"
+#include "dawn/native/opengl/OpenGLFunctions.h"
+
+namespace dawn::native::opengl {
+
+void AttachToFramebuffer(const OpenGLFunctions& gl,
+                         GLenum target,
+                         const FramebufferAttachment& attachment) {
+    DAWN_ASSERT(attachment.texture != 0);
+    if (attachment.textarget == GL_TEXTURE_2D_ARRAY || attachment.textarget == GL_TEXTURE_3D ||
+        attachment.textarget == GL_TEXTURE_CUBE_MAP_ARRAY) {
+        gl.FramebufferTextureLayer(target, attachment.attachment, attachment.texture,
+                                   attachment.mipLevel, attachment.arrayLayer);
+    } else if (attachment.textarget == GL_TEXTURE_CUBE_MAP) {
+        gl.FramebufferTexture2D(target, attachment.attachment,
+                                GL_TEXTURE_CUBE_MAP_POSITIVE_X + attachment.arrayLayer,
+                                attachment.texture, attachment.mipLevel);
+    } else {
+        gl.FramebufferTexture2D(target, attachment.attachment, attachment.textarget,
+                                attachment.texture, attachment.mipLevel);
+    }
+}
+
+void FramebufferCacheQuery::AddAttachment(const FramebufferAttachment& attachment) {
+    DAWN_ASSERT(attachmentCount < attachments.size());
+    attachments[attachmentCount++] = attachment;
+}
+
+FramebufferCache::FramebufferCache() = default;
+
+FramebufferCache::~FramebufferCache() {
+    DAWN_ASSERT(mCache.empty());
+}
+
+void FramebufferCache::BindFramebuffer(const OpenGLFunctions& gl,
+                                       GLenum target,
+                                       const FramebufferCacheQuery& query) {
+    GLuint framebuffer;
+    auto it = mCache.find(query);
+    if (it != mCache.end()) {
+        framebuffer = it->second;
+    } else {
+        framebuffer = CreateFramebuffer(gl, query);
+        mCache.emplace(query, framebuffer);
+    }
+
+    gl.BindFramebuffer(target, framebuffer);
+}
+
+GLuint FramebufferCache::CreateFramebuffer(const OpenGLFunctions& gl,
+                                           const FramebufferCacheQuery& query) {
+    GLuint framebuffer = 0;
+    gl.GenFramebuffers(1, &framebuffer);
+
+    // The draw buffers can only be set on the draw framebuffer, so always build the framebuffer
+    // through that binding point.
+    gl.BindFramebuffer(GL_DRAW_FRAMEBUFFER, framebuffer);
+
+    // Mapping from color attachment slot to GL framebuffer attachment points. Defaults to zero
+    // (GL_NONE).
+    std::array<GLenum, kMaxColorAttachments> drawBuffers = {};
+    uint32_t drawBufferCount = 0;
+    for (uint32_t i = 0; i < query.attachmentCount; ++i) {
+        const FramebufferAttachment& attachment = query.attachments[i];
+        AttachToFramebuffer(gl, GL_DRAW_FRAMEBUFFER, attachment);
+
+        if (attachment.attachment >= GL_COLOR_ATTACHMENT0 &&
+            attachment.attachment < GL_COLOR_ATTACHMENT0 + kMaxColorAttachments) {
+            uint32_t slot = attachment.attachment - GL_COLOR_ATTACHMENT0;
+            drawBuffers[slot] = attachment.attachment;
+            drawBufferCount = std::max(drawBufferCount, slot + 1);
+        }
+    }
+    gl.DrawBuffers(drawBufferCount, drawBuffers.data());
+
+    DAWN_ASSERT(gl.CheckFramebufferStatus(GL_DRAW_FRAMEBUFFER) == GL_FRAMEBUFFER_COMPLETE);
+    return framebuffer;
+}
+
+void FramebufferCache::OnTextureDestroyed(const OpenGLFunctions& gl, GLuint texture) {
+    for (auto it = mCache.begin(); it != mCache.end();) {
+        const FramebufferCacheQuery& query = it->first;
+        bool usesTexture = false;
+        for (uint32_t i = 0; i < query.attachmentCount; ++i) {
+            if (query.attachments[i].texture == texture) {
+                usesTexture = true;
+                break;
+            }
+        }
+
+        if (usesTexture) {
+            gl.DeleteFramebuffers(1, &it->second);
+            it = mCache.erase(it);
+        } else {
+            ++it;
+        }
+    }
+}
+
+void FramebufferCache::Destroy(const OpenGLFunctions& gl) {
+    for (auto& [query, framebuffer] : mCache) {
+        gl.DeleteFramebuffers(1, &framebuffer);
+    }
+    mCache.clear();
+}
+
+size_t FramebufferCache::CacheFuncs::operator()(const FramebufferCacheQuery& query) const {
+    size_t hash = Hash(query.attachmentCount);
+    for (uint32_t i = 0; i < query.attachmentCount; ++i) {
+        const FramebufferAttachment& attachment = query.attachments[i];
+        HashCombine(&hash, attachment.attachment, attachment.texture, attachment.textarget,
+                    attachment.mipLevel, attachment.arrayLayer);
+    }
+    return hash;
+}
+
+bool FramebufferCache::CacheFuncs::operator()(const FramebufferCacheQuery& a,
+                                              const FramebufferCacheQuery& b) const {
+    if (a.attachmentCount != b.attachmentCount) {
+        return false;
+    }
+
+    for (uint32_t i = 0; i < a.attachmentCount; ++i) {
+        const FramebufferAttachment& attachmentA = a.attachments[i];
+        const FramebufferAttachment& attachmentB = b.attachments[i];
+        if (attachmentA.attachment != attachmentB.attachment ||
+            attachmentA.texture != attachmentB.texture ||
+            attachmentA.textarget != attachmentB.textarget ||
+            attachmentA.mipLevel != attachmentB.mipLevel ||
+            attachmentA.arrayLayer != attachmentB.arrayLayer) {
+            return false;
+        }
+    }
+
+    return true;
+}
+
+}  // namespace dawn::native::opengl
@@ -0,0 +1,104 @@
+// Copyright 2024 The Dawn & Tint Authors
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+//
+// 1. Redistributions of source code must retain the above copyright notice, this
+//    list of conditions and the following disclaimer.
+//
+// 2. Redistributions in binary form must reproduce the above copyright notice,
+//    this list of conditions and the following disclaimer in the documentation
+//    and/or other materials provided with the distribution.
+//
+// 3. Neither the name of the copyright holder nor the names of its
+//    contributors may be used to endorse or promote products derived from
+//    this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+// DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+// FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+// DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+// SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+// CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+// OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+// OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+
+#ifndef SRC_DAWN_NATIVE_OPENGL_FRAMEBUFFERCACHEGL_H_
+#define SRC_DAWN_NATIVE_OPENGL_FRAMEBUFFERCACHEGL_H_
+
+#include <array>
+#include <unordered_map>
+
+#include "dawn/common/Constants.h"
+#include "dawn/native/opengl/opengl_platform.h"
+
+namespace dawn::native::opengl {
+
+struct OpenGLFunctions;
+
+// A single texture subresource attached to a framebuffer object.
+struct FramebufferAttachment {
+    GLenum attachment = GL_NONE;
+    GLuint texture = 0;
+    GLenum textarget = GL_NONE;
+    GLint mipLevel = 0;
+    GLint arrayLayer = 0;
+};
+
+// Attaches the subresource to the framebuffer currently bound to `target`.
+void AttachToFramebuffer(const OpenGLFunctions& gl,
+                         GLenum target,
+                         const FramebufferAttachment& attachment);
+
+// The key used to query the FramebufferCache: the exact set of attachments of the framebuffer.
+struct FramebufferCacheQuery {
+    void AddAttachment(const FramebufferAttachment& attachment);
+
+    std::array<FramebufferAttachment, kMaxColorAttachments + 1> attachments;
+    uint32_t attachmentCount = 0;
+};
+
+// Framebuffer objects are expensive to create and check for completeness on some drivers, GLES
+// ones in particular. The FramebufferCache keeps the framebuffers used for render passes,
+// multisample resolves and texture readbacks alive so that they are only built once for a given
+// set of attachments. Since framebuffers hold references to the GL textures attached to them,
+// they are deleted as soon as one of these textures is destroyed.
+class FramebufferCache {
+  public:
+    FramebufferCache();
+    ~FramebufferCache();
+
+    // Binds to `target` the framebuffer with exactly the attachments of the query, creating it if
+    // needed. The draw buffers of the framebuffer are its color attachments. Creating a
+    // framebuffer changes the GL_DRAW_FRAMEBUFFER binding even if `target` is
+    // GL_READ_FRAMEBUFFER.
+    void BindFramebuffer(const OpenGLFunctions& gl,
+                         GLenum target,
+                         const FramebufferCacheQuery& query);
+
+    // Deletes all the framebuffers that have `texture` attached. Must be called before the GL
+    // texture is deleted as its name could be reused.
+    void OnTextureDestroyed(const OpenGLFunctions& gl, GLuint texture);
+
+    // Deletes all the framebuffers.
+    void Destroy(const OpenGLFunctions& gl);
+
+  private:
+    GLuint CreateFramebuffer(const OpenGLFunctions& gl, const FramebufferCacheQuery& query);
+
+    // Implements the functors necessary for to use FramebufferCacheQueries as unordered_map
+    // keys.
+    struct CacheFuncs {
+        size_t operator()(const FramebufferCacheQuery& query) const;
+        bool operator()(const FramebufferCacheQuery& a, const FramebufferCacheQuery& b) const;
+    };
+    using Cache = std::unordered_map<FramebufferCacheQuery, GLuint, CacheFuncs, CacheFuncs>;
+
+    Cache mCache;
+};
+
+}  // namespace dawn::native::opengl
+
+#endif  // SRC_DAWN_NATIVE_OPENGL_FRAMEBUFFERCACHEGL_H_
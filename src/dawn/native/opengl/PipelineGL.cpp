@@ -42,6 +42,7 @@
 #include "dawn/native/opengl/PipelineLayoutGL.h"
 #include "dawn/native/opengl/SamplerGL.h"
 #include "dawn/native/opengl/ShaderModuleGL.h"
+#include "dawn/native/opengl/StateCacheGL.h"
 #include "dawn/native/opengl/TextureGL.h"
 
 namespace dawn::native::opengl {
@@ -51,6 +52,7 @@ PipelineGL::PipelineGL() : mProgram(0) {}
 PipelineGL::~PipelineGL() = default;
 
 MaybeError PipelineGL::InitializeBase(const OpenGLFunctions& gl,
+                                      StateCache* stateCache,
                                       const PipelineLayout* layout,
                                       const PerStage<ProgrammableStage>& stages) {
     mProgram = gl.CreateProgram();
@@ -114,7 +116,7 @@ MaybeError PipelineGL::InitializeBase(const OpenGLFunctions& gl,
     }
 
     // Compute links between stages for combined samplers, then bind them to texture units
-    gl.UseProgram(mProgram);
+    stateCache->UseProgram(gl, mProgram);
     const auto& indices = layout->GetBindingIndexInfo();
 
     std::set<CombinedSampler> combinedSamplersSet;
@@ -176,8 +178,8 @@ MaybeError PipelineGL::InitializeBase(const OpenGLFunctions& gl,
     return {};
 }
 
-void PipelineGL::DeleteProgram(const OpenGLFunctions& gl) {
-    gl.DeleteProgram(mProgram);
+void PipelineGL::DeleteProgram(const OpenGLFunctions& gl, StateCache* stateCache) {
+    stateCache->DeleteProgram(gl, mProgram);
 }
 
 const std::vector<PipelineGL::SamplerUnit>& PipelineGL::GetTextureUnitsForSampler(
@@ -195,16 +197,16 @@ GLuint PipelineGL::GetProgramHandle() const {
     return mProgram;
 }
 
-void PipelineGL::ApplyNow(const OpenGLFunctions& gl) {
-    gl.UseProgram(mProgram);
+void PipelineGL::ApplyNow(const OpenGLFunctions& gl, StateCache* stateCache) {
+    stateCache->UseProgram(gl, mProgram);
     for (GLuint unit : mPlaceholderSamplerUnits) {
         DAWN_ASSERT(mPlaceholderSampler.Get() != nullptr);
-        gl.BindSampler(unit, mPlaceholderSampler->GetNonFilteringHandle());
+        stateCache->BindSampler(gl, unit, mPlaceholderSampler->GetNonFilteringHandle());
     }
 
     if (mTextureBuiltinsBuffer.Get() != nullptr) {
-        gl.BindBufferBase(GL_UNIFORM_BUFFER, mInternalUniformBufferBinding,
-                          mTextureBuiltinsBuffer->GetHandle());
+        stateCache->BindBufferBase(gl, GL_UNIFORM_BUFFER, mInternalUniformBufferBinding,
+                                   mTextureBuiltinsBuffer->GetHandle());
     }
 }
 
@@ -47,6 +47,7 @@ namespace dawn::native::opengl {
 struct OpenGLFunctions;
 class PipelineLayout;
 class Sampler;
+class StateCache;
 class Buffer;
 class TextureView;
 
@@ -70,11 +71,12 @@ class PipelineGL {
     GetBindingPointBuiltinDataInfo() const;
 
   protected:
-    void ApplyNow(const OpenGLFunctions& gl);
+    void ApplyNow(const OpenGLFunctions& gl, StateCache* stateCache);
     MaybeError InitializeBase(const OpenGLFunctions& gl,
+                              StateCache* stateCache,
                               const PipelineLayout* layout,
                               const PerStage<ProgrammableStage>& stages);
-    void DeleteProgram(const OpenGLFunctions& gl);
+    void DeleteProgram(const OpenGLFunctions& gl, StateCache* stateCache);
 
   private:
     GLuint mProgram;
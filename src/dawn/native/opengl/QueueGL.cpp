@@ -48,6 +48,10 @@ MaybeError Queue::SubmitImpl(uint32_t commandCount, CommandBufferBase* const* co
         DAWN_TRY(ToBackend(commands[i])->Execute());
     }
     TRACE_EVENT_END0(GetDevice()->GetPlatform(), Recording, "CommandBufferGL::Execute");
+
+    const StateCache::Stats& stats = ToBackend(GetDevice())->GetStateCache()->GetStats();
+    TRACE_COUNTER2(GetDevice()->GetPlatform(), General, "GLStateCalls", "issued",
+                   stats.issuedCalls, "elided", stats.elidedCalls);
     return {};
 }
 
@@ -55,11 +59,12 @@ MaybeError Queue::WriteBufferImpl(BufferBase* buffer,
                                   uint64_t bufferOffset,
                                   const void* data,
                                   size_t size) {
-    const OpenGLFunctions& gl = ToBackend(GetDevice())->GetGL();
+    Device* device = ToBackend(GetDevice());
+    const OpenGLFunctions& gl = device->GetGL();
 
     ToBackend(buffer)->EnsureDataInitializedAsDestination(bufferOffset, size);
 
-    gl.BindBuffer(GL_ARRAY_BUFFER, ToBackend(buffer)->GetHandle());
+    device->GetStateCache()->BindBuffer(gl, GL_ARRAY_BUFFER, ToBackend(buffer)->GetHandle());
     gl.BufferSubData(GL_ARRAY_BUFFER, bufferOffset, size, data);
     buffer->MarkUsedInPendingCommands();
     return {};
@@ -29,7 +29,7 @@
 
 #include "dawn/native/opengl/DeviceGL.h"
 #include "dawn/native/opengl/Forward.h"
-#include "dawn/native/opengl/PersistentPipelineStateGL.h"
+#include "dawn/native/opengl/StateCacheGL.h"
 #include "dawn/native/opengl/UtilsGL.h"
 
 namespace dawn::native::opengl {
@@ -53,20 +53,21 @@ GLenum GLPrimitiveTopology(wgpu::PrimitiveTopology primitiveTopology) {
 }
 
 void ApplyFrontFaceAndCulling(const OpenGLFunctions& gl,
+                              StateCache* stateCache,
                               wgpu::FrontFace face,
                               wgpu::CullMode mode) {
     // Note that we invert winding direction in OpenGL. Because Y axis is up in OpenGL,
     // which is different from WebGPU and other backends (Y axis is down).
     GLenum direction = (face == wgpu::FrontFace::CCW) ? GL_CW : GL_CCW;
-    gl.FrontFace(direction);
+    stateCache->FrontFace(gl, direction);
 
     if (mode == wgpu::CullMode::None) {
-        gl.Disable(GL_CULL_FACE);
+        stateCache->SetEnabled(gl, GL_CULL_FACE, false);
     } else {
-        gl.Enable(GL_CULL_FACE);
+        stateCache->SetEnabled(gl, GL_CULL_FACE, true);
 
         GLenum cullMode = (mode == wgpu::CullMode::Front) ? GL_FRONT : GL_BACK;
-        gl.CullFace(cullMode);
+        stateCache->CullFace(gl, cullMode);
     }
 }
 
@@ -128,42 +129,47 @@ GLenum GLBlendMode(wgpu::BlendOperation operation) {
 }
 
 void ApplyColorState(const OpenGLFunctions& gl,
+                     StateCache* stateCache,
                      ColorAttachmentIndex attachment,
                      const ColorTargetState* state) {
     GLuint colorBuffer = static_cast<GLuint>(static_cast<uint8_t>(attachment));
     if (state->blend != nullptr) {
-        gl.Enablei(GL_BLEND, colorBuffer);
-        gl.BlendEquationSeparatei(colorBuffer, GLBlendMode(state->blend->color.operation),
-                                  GLBlendMode(state->blend->alpha.operation));
-        gl.BlendFuncSeparatei(colorBuffer, GLBlendFactor(state->blend->color.srcFactor, false),
-                              GLBlendFactor(state->blend->color.dstFactor, false),
-                              GLBlendFactor(state->blend->alpha.srcFactor, true),
-                              GLBlendFactor(state->blend->alpha.dstFactor, true));
+        stateCache->SetEnabledi(gl, GL_BLEND, colorBuffer, true);
+        stateCache->BlendEquationSeparatei(gl, colorBuffer,
+                                           GLBlendMode(state->blend->color.operation),
+                                           GLBlendMode(state->blend->alpha.operation));
+        stateCache->BlendFuncSeparatei(gl, colorBuffer,
+                                       GLBlendFactor(state->blend->color.srcFactor, false),
+                                       GLBlendFactor(state->blend->color.dstFactor, false),
+                                       GLBlendFactor(state->blend->alpha.srcFactor, true),
+                                       GLBlendFactor(state->blend->alpha.dstFactor, true));
     } else {
-        gl.Disablei(GL_BLEND, colorBuffer);
+        stateCache->SetEnabledi(gl, GL_BLEND, colorBuffer, false);
     }
-    gl.ColorMaski(colorBuffer, state->writeMask & wgpu::ColorWriteMask::Red,
-                  state->writeMask & wgpu::ColorWriteMask::Green,
-                  state->writeMask & wgpu::ColorWriteMask::Blue,
-                  state->writeMask & wgpu::ColorWriteMask::Alpha);
+    stateCache->ColorMaski(gl, colorBuffer, state->writeMask & wgpu::ColorWriteMask::Red,
+                           state->writeMask & wgpu::ColorWriteMask::Green,
+                           state->writeMask & wgpu::ColorWriteMask::Blue,
+                           state->writeMask & wgpu::ColorWriteMask::Alpha);
 }
 
-void ApplyColorState(const OpenGLFunctions& gl, const ColorTargetState* state) {
+void ApplyColorState(const OpenGLFunctions& gl,
+                     StateCache* stateCache,
+                     const ColorTargetState* state) {
     if (state->blend != nullptr) {
-        gl.Enable(GL_BLEND);
-        gl.BlendEquationSeparate(GLBlendMode(state->blend->color.operation),
-                                 GLBlendMode(state->blend->alpha.operation));
-        gl.BlendFuncSeparate(GLBlendFactor(state->blend->color.srcFactor, false),
-                             GLBlendFactor(state->blend->color.dstFactor, false),
-                             GLBlendFactor(state->blend->alpha.srcFactor, true),
-                             GLBlendFactor(state->blend->alpha.dstFactor, true));
+        stateCache->SetEnabled(gl, GL_BLEND, true);
+        stateCache->BlendEquationSeparate(gl, GLBlendMode(state->blend->color.operation),
+                                          GLBlendMode(state->blend->alpha.operation));
+        stateCache->BlendFuncSeparate(gl, GLBlendFactor(state->blend->color.srcFactor, false),
+                                      GLBlendFactor(state->blend->color.dstFactor, false),
+                                      GLBlendFactor(state->blend->alpha.srcFactor, true),
+                                      GLBlendFactor(state->blend->alpha.dstFactor, true));
     } else {
-        gl.Disable(GL_BLEND);
+        stateCache->SetEnabled(gl, GL_BLEND, false);
     }
-    gl.ColorMask(state->writeMask & wgpu::ColorWriteMask::Red,
-                 state->writeMask & wgpu::ColorWriteMask::Green,
-                 state->writeMask & wgpu::ColorWriteMask::Blue,
-                 state->writeMask & wgpu::ColorWriteMask::Alpha);
+    stateCache->ColorMask(gl, state->writeMask & wgpu::ColorWriteMask::Red,
+                          state->writeMask & wgpu::ColorWriteMask::Green,
+                          state->writeMask & wgpu::ColorWriteMask::Blue,
+                          state->writeMask & wgpu::ColorWriteMask::Alpha);
 }
 
 bool Equal(const BlendComponent& lhs, const BlendComponent& rhs) {
@@ -194,43 +200,41 @@ GLuint OpenGLStencilOperation(wgpu::StencilOperation stencilOperation) {
 }
 
 void ApplyDepthStencilState(const OpenGLFunctions& gl,
-                            const DepthStencilState* descriptor,
-                            PersistentPipelineState* persistentPipelineState) {
+                            StateCache* stateCache,
+                            const DepthStencilState* descriptor) {
     // Depth writes only occur if depth is enabled
     if (descriptor->depthCompare == wgpu::CompareFunction::Always &&
         !descriptor->depthWriteEnabled) {
-        gl.Disable(GL_DEPTH_TEST);
+        stateCache->SetEnabled(gl, GL_DEPTH_TEST, false);
     } else {
-        gl.Enable(GL_DEPTH_TEST);
+        stateCache->SetEnabled(gl, GL_DEPTH_TEST, true);
     }
 
     if (descriptor->depthWriteEnabled) {
-        gl.DepthMask(GL_TRUE);
+        stateCache->DepthMask(gl, GL_TRUE);
     } else {
-        gl.DepthMask(GL_FALSE);
+        stateCache->DepthMask(gl, GL_FALSE);
     }
 
-    gl.DepthFunc(ToOpenGLCompareFunction(descriptor->depthCompare));
+    stateCache->DepthFunc(gl, ToOpenGLCompareFunction(descriptor->depthCompare));
 
-    if (StencilTestEnabled(descriptor)) {
-        gl.Enable(GL_STENCIL_TEST);
-    } else {
-        gl.Disable(GL_STENCIL_TEST);
-    }
+    stateCache->SetEnabled(gl, GL_STENCIL_TEST, StencilTestEnabled(descriptor));
 
     GLenum backCompareFunction = ToOpenGLCompareFunction(descriptor->stencilBack.compare);
     GLenum frontCompareFunction = ToOpenGLCompareFunction(descriptor->stencilFront.compare);
-    persistentPipelineState->SetStencilFuncsAndMask(gl, backCompareFunction, frontCompareFunction,
-                                                    descriptor->stencilReadMask);
-
-    gl.StencilOpSeparate(GL_BACK, OpenGLStencilOperation(descriptor->stencilBack.failOp),
-                         OpenGLStencilOperation(descriptor->stencilBack.depthFailOp),
-                         OpenGLStencilOperation(descriptor->stencilBack.passOp));
-    gl.StencilOpSeparate(GL_FRONT, OpenGLStencilOperation(descriptor->stencilFront.failOp),
-                         OpenGLStencilOperation(descriptor->stencilFront.depthFailOp),
-                         OpenGLStencilOperation(descriptor->stencilFront.passOp));
-
-    gl.StencilMask(descriptor->stencilWriteMask);
+    stateCache->SetStencilFuncsAndMask(gl, backCompareFunction, frontCompareFunction,
+                                       descriptor->stencilReadMask);
+
+    stateCache->StencilOpSeparate(gl, GL_BACK,
+                                  OpenGLStencilOperation(descriptor->stencilBack.failOp),
+                                  OpenGLStencilOperation(descriptor->stencilBack.depthFailOp),
+                                  OpenGLStencilOperation(descriptor->stencilBack.passOp));
+    stateCache->StencilOpSeparate(gl, GL_FRONT,
+                                  OpenGLStencilOperation(descriptor->stencilFront.failOp),
+                                  OpenGLStencilOperation(descriptor->stencilFront.depthFailOp),
+                                  OpenGLStencilOperation(descriptor->stencilFront.passOp));
+
+    stateCache->StencilMask(gl, descriptor->stencilWriteMask);
 }
 
 }  // anonymous namespace
@@ -249,8 +253,9 @@ RenderPipeline::RenderPipeline(Device* device,
       mGlPrimitiveTopology(GLPrimitiveTopology(GetPrimitiveTopology())) {}
 
 MaybeError RenderPipeline::Initialize() {
-    DAWN_TRY(
-        InitializeBase(ToBackend(GetDevice())->GetGL(), ToBackend(GetLayout()), GetAllStages()));
+    Device* device = ToBackend(GetDevice());
+    DAWN_TRY(InitializeBase(device->GetGL(), device->GetStateCache(), ToBackend(GetLayout()),
+                            GetAllStages()));
     CreateVAOForVertexState();
     return {};
 }
@@ -259,10 +264,11 @@ RenderPipeline::~RenderPipeline() = default;
 
 void RenderPipeline::DestroyImpl() {
     RenderPipelineBase::DestroyImpl();
-    const OpenGLFunctions& gl = ToBackend(GetDevice())->GetGL();
-    gl.DeleteVertexArrays(1, &mVertexArrayObject);
-    gl.BindVertexArray(0);
-    DeleteProgram(gl);
+    Device* device = ToBackend(GetDevice());
+    const OpenGLFunctions& gl = device->GetGL();
+    device->GetStateCache()->DeleteVertexArray(gl, mVertexArrayObject);
+    device->GetStateCache()->BindVertexArray(gl, 0);
+    DeleteProgram(gl, device->GetStateCache());
 }
 
 GLenum RenderPipeline::GetGLPrimitiveTopology() const {
@@ -275,10 +281,11 @@ VertexAttributeMask RenderPipeline::GetAttributesUsingVertexBuffer(VertexBufferS
 }
 
 void RenderPipeline::CreateVAOForVertexState() {
-    const OpenGLFunctions& gl = ToBackend(GetDevice())->GetGL();
+    Device* device = ToBackend(GetDevice());
+    const OpenGLFunctions& gl = device->GetGL();
 
     gl.GenVertexArrays(1, &mVertexArrayObject);
-    gl.BindVertexArray(mVertexArrayObject);
+    device->GetStateCache()->BindVertexArray(gl, mVertexArrayObject);
 
     for (VertexAttributeLocation location : IterateBitSet(GetAttributeLocationsUsed())) {
         const auto& attribute = GetAttribute(location);
@@ -306,47 +313,41 @@ void RenderPipeline::CreateVAOForVertexState() {
     }
 }
 
-void RenderPipeline::ApplyNow(PersistentPipelineState& persistentPipelineState) {
-    const OpenGLFunctions& gl = ToBackend(GetDevice())->GetGL();
-    PipelineGL::ApplyNow(gl);
+void RenderPipeline::ApplyNow() {
+    Device* device = ToBackend(GetDevice());
+    const OpenGLFunctions& gl = device->GetGL();
+    StateCache* stateCache = device->GetStateCache();
+    PipelineGL::ApplyNow(gl, stateCache);
 
     DAWN_ASSERT(mVertexArrayObject);
-    gl.BindVertexArray(mVertexArrayObject);
+    stateCache->BindVertexArray(gl, mVertexArrayObject);
 
-    ApplyFrontFaceAndCulling(gl, GetFrontFace(), GetCullMode());
+    ApplyFrontFaceAndCulling(gl, stateCache, GetFrontFace(), GetCullMode());
 
-    ApplyDepthStencilState(gl, GetDepthStencilState(), &persistentPipelineState);
+    ApplyDepthStencilState(gl, stateCache, GetDepthStencilState());
 
-    gl.SampleMaski(0, GetSampleMask());
-    if (IsAlphaToCoverageEnabled()) {
-        gl.Enable(GL_SAMPLE_ALPHA_TO_COVERAGE);
-    } else {
-        gl.Disable(GL_SAMPLE_ALPHA_TO_COVERAGE);
-    }
+    stateCache->SampleMask(gl, GetSampleMask());
+    stateCache->SetEnabled(gl, GL_SAMPLE_ALPHA_TO_COVERAGE, IsAlphaToCoverageEnabled());
 
     if (IsDepthBiasEnabled()) {
-        gl.Enable(GL_POLYGON_OFFSET_FILL);
+        stateCache->SetEnabled(gl, GL_POLYGON_OFFSET_FILL, true);
         float depthBias = GetDepthBias();
         float slopeScale = GetDepthBiasSlopeScale();
-        if (gl.PolygonOffsetClamp != nullptr) {
-            gl.PolygonOffsetClamp(slopeScale, depthBias, GetDepthBiasClamp());
-        } else {
-            gl.PolygonOffset(slopeScale, depthBias);
-        }
+        stateCache->PolygonOffset(gl, slopeScale, depthBias, GetDepthBiasClamp());
     } else {
-        gl.Disable(GL_POLYGON_OFFSET_FILL);
+        stateCache->SetEnabled(gl, GL_POLYGON_OFFSET_FILL, false);
     }
 
     if (!GetDevice()->IsToggleEnabled(Toggle::DisableIndexedDrawBuffers)) {
         for (auto attachmentSlot : IterateBitSet(GetColorAttachmentsMask())) {
-            ApplyColorState(gl, attachmentSlot, GetColorTargetState(attachmentSlot));
+            ApplyColorState(gl, stateCache, attachmentSlot, GetColorTargetState(attachmentSlot));
         }
     } else {
         const ColorTargetState* prevDescriptor = nullptr;
         for (auto attachmentSlot : IterateBitSet(GetColorAttachmentsMask())) {
             const ColorTargetState* descriptor = GetColorTargetState(attachmentSlot);
             if (!prevDescriptor) {
-                ApplyColorState(gl, descriptor);
+                ApplyColorState(gl, stateCache, descriptor);
                 prevDescriptor = descriptor;
             } else if ((descriptor->blend == nullptr) != (prevDescriptor->blend == nullptr)) {
                 // TODO(crbug.com/dawn/582): GLES < 3.2 does not support different blend states
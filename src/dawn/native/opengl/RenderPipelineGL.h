@@ -38,7 +38,6 @@
 namespace dawn::native::opengl {
 
 class Device;
-class PersistentPipelineState;
 
 class RenderPipeline final : public RenderPipelineBase, public PipelineGL {
   public:
@@ -49,7 +48,7 @@ class RenderPipeline final : public RenderPipelineBase, public PipelineGL {
     GLenum GetGLPrimitiveTopology() const;
     VertexAttributeMask GetAttributesUsingVertexBuffer(VertexBufferSlot slot) const;
 
-    void ApplyNow(PersistentPipelineState& persistentPipelineState);
+    void ApplyNow();
 
     MaybeError Initialize() override;
 
@@ -93,9 +93,10 @@ Sampler::~Sampler() = default;
 
 void Sampler::DestroyImpl() {
     SamplerBase::DestroyImpl();
-    const OpenGLFunctions& gl = ToBackend(GetDevice())->GetGL();
-    gl.DeleteSamplers(1, &mFilteringHandle);
-    gl.DeleteSamplers(1, &mNonFilteringHandle);
+    Device* device = ToBackend(GetDevice());
+    const OpenGLFunctions& gl = device->GetGL();
+    device->GetStateCache()->DeleteSampler(gl, mFilteringHandle);
+    device->GetStateCache()->DeleteSampler(gl, mNonFilteringHandle);
 }
 
 void Sampler::SetupGLSampler(GLuint sampler,
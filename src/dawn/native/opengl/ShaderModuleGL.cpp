@@ -87,7 +87,8 @@ opengl::CombinedSampler* AppendCombinedSampler(opengl::CombinedSamplerInfo* info
 using InterstageLocationAndName = std::pair<uint32_t, std::string>;
 
 #define GLSL_COMPILATION_REQUEST_MEMBERS(X)                                                      \
-    X(const tint::Program*, inputProgram)                                                        \
+    X(CacheKey::UnsafeUnkeyedValue<const ShaderModuleBase*>, inputModule)                        \
+    X(ShaderModuleSourceKey, source)                                                             \
     X(std::string, entryPointName)                                                               \
     X(SingleShaderStage, stage)                                                                  \
     X(std::optional<tint::ast::transform::SubstituteOverride::Config>, substituteOverrideConfig) \
@@ -241,7 +242,8 @@ ResultOrError<GLuint> ShaderModule::CompileShader(
 
     const CombinedLimits& limits = GetDevice()->GetLimits();
 
-    req.inputProgram = GetTintProgram();
+    req.inputModule = this;
+    req.source = GetSourceKey();
     req.stage = stage;
     req.entryPointName = programmableStage.entryPoint;
     req.substituteOverrideConfig = std::move(substituteOverrideConfig);
@@ -271,7 +273,11 @@ ResultOrError<GLuint> ShaderModule::CompileShader(
     BindingPoint placeholderBindingPoint{static_cast<uint32_t>(kMaxBindGroupsTyped), 0};
 
     *needsPlaceholderSampler = false;
-    tint::inspector::Inspector inspector(*req.inputProgram);
+    // The GLSL backend always needs to inspect the program, so get it eagerly. It may need to be
+    // parsed if the module was created from cached reflection data.
+    const tint::Program* inputProgram;
+    DAWN_TRY_ASSIGN(inputProgram, GetTintProgram());
+    tint::inspector::Inspector inspector(*inputProgram);
     // Find all the sampler/texture pairs for this entry point, and create
     // CombinedSamplers for them. CombinedSampler records the binding points
     // of the original texture and sampler, and generates a unique name. The
@@ -352,10 +358,13 @@ ResultOrError<GLuint> ShaderModule::CompileShader(
                     std::move(r.substituteOverrideConfig).value());
             }
 
+            const tint::Program* inputProgram;
+            DAWN_TRY_ASSIGN(inputProgram, r.inputModule.UnsafeGetValue()->GetTintProgram());
+
             tint::Program program;
             tint::ast::transform::DataMap transformOutputs;
-            DAWN_TRY_ASSIGN(program, RunTransforms(&transformManager, r.inputProgram,
-                                                   transformInputs, &transformOutputs, nullptr));
+            DAWN_TRY_ASSIGN(program, RunTransforms(&transformManager, inputProgram, transformInputs,
+                                                   &transformOutputs, nullptr));
 
             // Get the entry point name after the renamer pass.
             // TODO(dawn:2180): refactor out.
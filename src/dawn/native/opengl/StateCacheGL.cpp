@@ -0,0 +1,475 @@
+// Copyright 2017 The Dawn & Tint Authors
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+//
+// 1. Redistributions of source code must retain the above copyright notice, this
+//    list of conditions and the following disclaimer.
+//
+// 2. Redistributions in binary form must reproduce the above copyright notice,
+//    this list of conditions and the following disclaimer in the documentation
+//    and/or other materials provided with the distribution.
+//
+// 3. Neither the name of the copyright holder nor the names of its
+//    contributors may be used to endorse or promote products derived from
+//    this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+// DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+// FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+// DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+// SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+// CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+// OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+// OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+
+#include "dawn/native/opengl/StateCacheGL.h"
+
+#include <algorithm>
+
+#include "dawn/common/Assert.h"
+#include "dawn/native/opengl/OpenGLFunctions.h"
+
+namespace dawn::native::opengl {
+
+StateCache::StateCache(bool enabled) : mEnabled(enabled) {}
+
+StateCache::~StateCache() = default;
+
+const StateCache::Stats& StateCache::GetStats() const {
+    return mStats;
+}
+
+template <typename T>
+bool StateCache::Update(std::optional<T>* state, const T& value) {
+    if (mEnabled && *state == value) {
+        mStats.elidedCalls++;
+        return false;
+    }
+
+    *state = value;
+    CountIssuedCall();
+    return true;
+}
+
+template <typename T>
+bool StateCache::UpdateKeyed(std::vector<std::pair<GLenum, T>>* states,
+                             GLenum key,
+                             const T& value) {
+    for (auto& [stateKey, state] : *states) {
+        if (stateKey != key) {
+            continue;
+        }
+        if (mEnabled && state == value) {
+            mStats.elidedCalls++;
+            return false;
+        }
+        state = value;
+        CountIssuedCall();
+        return true;
+    }
+
+    states->emplace_back(key, value);
+    CountIssuedCall();
+    return true;
+}
+
+template <typename T>
+void StateCache::SetKeyed(std::vector<std::pair<GLenum, T>>* states, GLenum key, const T& value) {
+    for (auto& [stateKey, state] : *states) {
+        if (stateKey == key) {
+            state = value;
+            return;
+        }
+    }
+    states->emplace_back(key, value);
+}
+
+template <typename T>
+bool StateCache::UpdateAll(PerColorAttachment<std::optional<T>>* states, const T& value) {
+    bool allEqual = true;
+    for (const std::optional<T>& state : *states) {
+        allEqual = allEqual && state == value;
+    }
+    if (mEnabled && allEqual) {
+        mStats.elidedCalls++;
+        return false;
+    }
+
+    states->fill(value);
+    CountIssuedCall();
+    return true;
+}
+
+void StateCache::CountIssuedCall() {
+    mStats.issuedCalls++;
+}
+
+void StateCache::SetEnabled(const OpenGLFunctions& gl, GLenum cap, bool enabled) {
+    bool changed = cap == GL_BLEND ? UpdateAll(&mBlendEnabled, enabled)
+                                   : UpdateKeyed(&mCapabilities, cap, enabled);
+    if (!changed) {
+        return;
+    }
+
+    if (enabled) {
+        gl.Enable(cap);
+    } else {
+        gl.Disable(cap);
+    }
+}
+
+void StateCache::SetEnabledi(const OpenGLFunctions& gl, GLenum cap, GLuint index, bool enabled) {
+    DAWN_ASSERT(cap == GL_BLEND);
+    if (!Update(&mBlendEnabled[ColorAttachmentIndex(static_cast<uint8_t>(index))], enabled)) {
+        return;
+    }
+
+    if (enabled) {
+        gl.Enablei(cap, index);
+    } else {
+        gl.Disablei(cap, index);
+    }
+}
+
+void StateCache::BindBuffer(const OpenGLFunctions& gl, GLenum target, GLuint buffer) {
+    if (UpdateKeyed(&mBufferBindings, target, buffer)) {
+        gl.BindBuffer(target, buffer);
+    }
+}
+
+void StateCache::BindBufferBase(const OpenGLFunctions& gl,
+                                GLenum target,
+                                GLuint index,
+                                GLuint buffer) {
+    // The indexed binding points aren't shadowed so the call is always issued, but binding to
+    // them also changes the generic binding point of the target.
+    SetKeyed(&mBufferBindings, target, buffer);
+    CountIssuedCall();
+    gl.BindBufferBase(target, index, buffer);
+}
+
+void StateCache::BindBufferRange(const OpenGLFunctions& gl,
+                                 GLenum target,
+                                 GLuint index,
+                                 GLuint buffer,
+                                 GLintptr offset,
+                                 GLsizeiptr size) {
+    SetKeyed(&mBufferBindings, target, buffer);
+    CountIssuedCall();
+    gl.BindBufferRange(target, index, buffer, offset, size);
+}
+
+void StateCache::ActiveTexture(const OpenGLFunctions& gl, GLenum texture) {
+    if (Update(&mActiveTextureUnit, GLuint(texture - GL_TEXTURE0))) {
+        gl.ActiveTexture(texture);
+    }
+}
+
+void StateCache::BindTexture(const OpenGLFunctions& gl, GLenum target, GLuint texture) {
+    if (!mActiveTextureUnit.has_value()) {
+        CountIssuedCall();
+        gl.BindTexture(target, texture);
+        return;
+    }
+
+    GLuint unit = *mActiveTextureUnit;
+    if (unit >= mTextureBindings.size()) {
+        mTextureBindings.resize(unit + 1);
+    }
+    if (UpdateKeyed(&mTextureBindings[unit], target, texture)) {
+        gl.BindTexture(target, texture);
+    }
+}
+
+void StateCache::BindSampler(const OpenGLFunctions& gl, GLuint unit, GLuint sampler) {
+    if (unit >= mSamplerBindings.size()) {
+        mSamplerBindings.resize(unit + 1);
+    }
+    if (Update(&mSamplerBindings[unit], sampler)) {
+        gl.BindSampler(unit, sampler);
+    }
+}
+
+void StateCache::UseProgram(const OpenGLFunctions& gl, GLuint program) {
+    if (Update(&mProgram, program)) {
+        gl.UseProgram(program);
+    }
+}
+
+void StateCache::BindVertexArray(const OpenGLFunctions& gl, GLuint vertexArray) {
+    if (!Update(&mVertexArray, vertexArray)) {
+        return;
+    }
+
+    gl.BindVertexArray(vertexArray);
+    ForgetElementArrayBufferBinding();
+}
+
+void StateCache::ForgetElementArrayBufferBinding() {
+    // The element array buffer binding is part of the vertex array state.
+    mBufferBindings.erase(std::remove_if(mBufferBindings.begin(), mBufferBindings.end(),
+                                         [](const std::pair<GLenum, GLuint>& binding) {
+                                             return binding.first == GL_ELEMENT_ARRAY_BUFFER;
+                                         }),
+                          mBufferBindings.end());
+}
+
+void StateCache::DeleteBuffer(const OpenGLFunctions& gl, GLuint buffer) {
+    gl.DeleteBuffers(1, &buffer);
+    for (auto& [target, binding] : mBufferBindings) {
+        if (binding == buffer) {
+            binding = 0;
+        }
+    }
+}
+
+void StateCache::DeleteTexture(const OpenGLFunctions& gl, GLuint texture) {
+    gl.DeleteTextures(1, &texture);
+    for (auto& unitBindings : mTextureBindings) {
+        for (auto& [target, binding] : unitBindings) {
+            if (binding == texture) {
+                binding = 0;
+            }
+        }
+    }
+}
+
+void StateCache::DeleteSampler(const OpenGLFunctions& gl, GLuint sampler) {
+    gl.DeleteSamplers(1, &sampler);
+    for (std::optional<GLuint>& binding : mSamplerBindings) {
+        if (binding == sampler) {
+            binding = 0;
+        }
+    }
+}
+
+void StateCache::DeleteProgram(const OpenGLFunctions& gl, GLuint program) {
+    gl.DeleteProgram(program);
+    // A program that is in use is only deleted once it is no longer used, so UseProgram() must not
+    // be skipped for a program that could later get the same name.
+    if (mProgram == program) {
+        mProgram.reset();
+    }
+}
+
+void StateCache::DeleteVertexArray(const OpenGLFunctions& gl, GLuint vertexArray) {
+    gl.DeleteVertexArrays(1, &vertexArray);
+    if (mVertexArray == vertexArray) {
+        mVertexArray = 0;
+        ForgetElementArrayBufferBinding();
+    }
+}
+
+void StateCache::PixelStorei(const OpenGLFunctions& gl, GLenum pname, GLint param) {
+    if (UpdateKeyed(&mPixelStore, pname, param)) {
+        gl.PixelStorei(pname, param);
+    }
+}
+
+void StateCache::Viewport(const OpenGLFunctions& gl,
+                          float x,
+                          float y,
+                          float width,
+                          float height) {
+    if (!Update(&mViewport, {x, y, width, height})) {
+        return;
+    }
+
+    if (gl.IsAtLeastGL(4, 1)) {
+        gl.ViewportIndexedf(0, x, y, width, height);
+    } else {
+        // Floating-point viewport coords are unsupported on OpenGL ES, but truncation is ok
+        // because other APIs do not guarantee subpixel precision either.
+        gl.Viewport(static_cast<int>(x), static_cast<int>(y), static_cast<int>(width),
+                    static_cast<int>(height));
+    }
+}
+
+void StateCache::DepthRange(const OpenGLFunctions& gl, float nearVal, float farVal) {
+    if (Update(&mDepthRange, {nearVal, farVal})) {
+        gl.DepthRangef(nearVal, farVal);
+    }
+}
+
+void StateCache::Scissor(const OpenGLFunctions& gl,
+                         GLint x,
+                         GLint y,
+                         GLsizei width,
+                         GLsizei height) {
+    if (Update(&mScissor, {x, y, width, height})) {
+        gl.Scissor(x, y, width, height);
+    }
+}
+
+void StateCache::FrontFace(const OpenGLFunctions& gl, GLenum mode) {
+    if (Update(&mFrontFace, mode)) {
+        gl.FrontFace(mode);
+    }
+}
+
+void StateCache::CullFace(const OpenGLFunctions& gl, GLenum mode) {
+    if (Update(&mCullFace, mode)) {
+        gl.CullFace(mode);
+    }
+}
+
+void StateCache::PolygonOffset(const OpenGLFunctions& gl, float factor, float units, float clamp) {
+    if (!Update(&mPolygonOffset, {factor, units, clamp})) {
+        return;
+    }
+
+    if (gl.PolygonOffsetClamp != nullptr) {
+        gl.PolygonOffsetClamp(factor, units, clamp);
+    } else {
+        gl.PolygonOffset(factor, units);
+    }
+}
+
+void StateCache::SampleMask(const OpenGLFunctions& gl, GLbitfield mask) {
+    if (Update(&mSampleMask, mask)) {
+        gl.SampleMaski(0, mask);
+    }
+}
+
+void StateCache::DepthFunc(const OpenGLFunctions& gl, GLenum func) {
+    if (Update(&mDepthFunc, func)) {
+        gl.DepthFunc(func);
+    }
+}
+
+void StateCache::DepthMask(const OpenGLFunctions& gl, GLboolean flag) {
+    if (Update(&mDepthMask, flag)) {
+        gl.DepthMask(flag);
+    }
+}
+
+void StateCache::SetStencilFuncsAndMask(const OpenGLFunctions& gl,
+                                        GLenum stencilBackCompareFunction,
+                                        GLenum stencilFrontCompareFunction,
+                                        uint32_t stencilReadMask) {
+    if (mEnabled && mStencilFuncKnown &&
+        mStencilBackCompareFunction == stencilBackCompareFunction &&
+        mStencilFrontCompareFunction == stencilFrontCompareFunction &&
+        mStencilReadMask == stencilReadMask) {
+        mStats.elidedCalls += 2;
+        return;
+    }
+
+    mStencilBackCompareFunction = stencilBackCompareFunction;
+    mStencilFrontCompareFunction = stencilFrontCompareFunction;
+    mStencilReadMask = stencilReadMask;
+    CallGLStencilFunc(gl);
+}
+
+void StateCache::SetStencilReference(const OpenGLFunctions& gl, uint32_t stencilReference) {
+    if (mEnabled && mStencilFuncKnown && mStencilReference == stencilReference) {
+        mStats.elidedCalls += 2;
+        return;
+    }
+
+    mStencilReference = stencilReference;
+    CallGLStencilFunc(gl);
+}
+
+void StateCache::CallGLStencilFunc(const OpenGLFunctions& gl) {
+    // The state is set with one call per face.
+    CountIssuedCall();
+    CountIssuedCall();
+    mStencilFuncKnown = true;
+    gl.StencilFuncSeparate(GL_BACK, mStencilBackCompareFunction, mStencilReference,
+                           mStencilReadMask);
+    gl.StencilFuncSeparate(GL_FRONT, mStencilFrontCompareFunction, mStencilReference,
+                           mStencilReadMask);
+}
+
+void StateCache::StencilOpSeparate(const OpenGLFunctions& gl,
+                                   GLenum face,
+                                   GLenum sfail,
+                                   GLenum dpfail,
+                                   GLenum dppass) {
+    DAWN_ASSERT(face == GL_BACK || face == GL_FRONT);
+    std::optional<std::array<GLenum, 3>>* state =
+        face == GL_BACK ? &mStencilOpBack : &mStencilOpFront;
+    if (Update(state, {sfail, dpfail, dppass})) {
+        gl.StencilOpSeparate(face, sfail, dpfail, dppass);
+    }
+}
+
+void StateCache::StencilMask(const OpenGLFunctions& gl, GLuint mask) {
+    if (Update(&mStencilMask, mask)) {
+        gl.StencilMask(mask);
+    }
+}
+
+void StateCache::BlendColor(const OpenGLFunctions& gl, const std::array<float, 4>& color) {
+    if (Update(&mBlendColor, color)) {
+        gl.BlendColor(color[0], color[1], color[2], color[3]);
+    }
+}
+
+void StateCache::BlendEquationSeparate(const OpenGLFunctions& gl,
+                                       GLenum modeRGB,
+                                       GLenum modeAlpha) {
+    if (UpdateAll(&mBlendEquation, {modeRGB, modeAlpha})) {
+        gl.BlendEquationSeparate(modeRGB, modeAlpha);
+    }
+}
+
+void StateCache::BlendEquationSeparatei(const OpenGLFunctions& gl,
+                                        GLuint buf,
+                                        GLenum modeRGB,
+                                        GLenum modeAlpha) {
+    if (Update(&mBlendEquation[ColorAttachmentIndex(static_cast<uint8_t>(buf))],
+               {modeRGB, modeAlpha})) {
+        gl.BlendEquationSeparatei(buf, modeRGB, modeAlpha);
+    }
+}
+
+void StateCache::BlendFuncSeparate(const OpenGLFunctions& gl,
+                                   GLenum srcRGB,
+                                   GLenum dstRGB,
+                                   GLenum srcAlpha,
+                                   GLenum dstAlpha) {
+    if (UpdateAll(&mBlendFunc, {srcRGB, dstRGB, srcAlpha, dstAlpha})) {
+        gl.BlendFuncSeparate(srcRGB, dstRGB, srcAlpha, dstAlpha);
+    }
+}
+
+void StateCache::BlendFuncSeparatei(const OpenGLFunctions& gl,
+                                    GLuint buf,
+                                    GLenum srcRGB,
+                                    GLenum dstRGB,
+                                    GLenum srcAlpha,
+                                    GLenum dstAlpha) {
+    if (Update(&mBlendFunc[ColorAttachmentIndex(static_cast<uint8_t>(buf))],
+               {srcRGB, dstRGB, srcAlpha, dstAlpha})) {
+        gl.BlendFuncSeparatei(buf, srcRGB, dstRGB, srcAlpha, dstAlpha);
+    }
+}
+
+void StateCache::ColorMask(const OpenGLFunctions& gl,
+                           bool red,
+                           bool green,
+                           bool blue,
+                           bool alpha) {
+    if (UpdateAll(&mColorMask, {red, green, blue, alpha})) {
+        gl.ColorMask(red, green, blue, alpha);
+    }
+}
+
+void StateCache::ColorMaski(const OpenGLFunctions& gl,
+                            GLuint buf,
+                            bool red,
+                            bool green,
+                            bool blue,
+                            bool alpha) {
+    if (Update(&mColorMask[ColorAttachmentIndex(static_cast<uint8_t>(buf))],
+               {red, green, blue, alpha})) {
+        gl.ColorMaski(buf, red, green, blue, alpha);
+    }
+}
+
+}  // namespace dawn::native::opengl
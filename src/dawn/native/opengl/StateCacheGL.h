@@ -0,0 +1,202 @@
+// Copyright 2017 The Dawn & Tint Authors
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+//
+// 1. Redistributions of source code must retain the above copyright notice, this
+//    list of conditions and the following disclaimer.
+//
+// 2. Redistributions in binary form must reproduce the above copyright notice,
+//    this list of conditions and the following disclaimer in the documentation
+//    and/or other materials provided with the distribution.
+//
+// 3. Neither the name of the copyright holder nor the names of its
+//    contributors may be used to endorse or promote products derived from
+//    this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+// DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+// FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+// DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+// SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+// CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+// OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+// OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+
+#ifndef SRC_DAWN_NATIVE_OPENGL_STATECACHEGL_H_
+#define SRC_DAWN_NATIVE_OPENGL_STATECACHEGL_H_
+
+#include <array>
+#include <optional>
+#include <utility>
+#include <vector>
+
+#include "dawn/native/IntegerTypes.h"
+#include "dawn/native/dawn_platform.h"
+#include "dawn/native/opengl/opengl_platform.h"
+
+namespace dawn::native::opengl {
+
+struct OpenGLFunctions;
+
+// Shadows the state of the device's GL context so that calls which would not change it are
+// skipped. All the state starts unknown so the first call setting each piece of state is always
+// issued. All the code changing the shadowed state must go through the cache, and objects that
+// may be bound must be deleted through the cache since GL implicitly unbinds deleted objects and
+// can then reuse their names.
+class StateCache {
+  public:
+    struct Stats {
+        uint64_t issuedCalls = 0;
+        uint64_t elidedCalls = 0;
+    };
+
+    // When disabled the cache still tracks the state but issues every call.
+    explicit StateCache(bool enabled);
+    ~StateCache();
+
+    // The number of GL calls issued and skipped through the cache.
+    const Stats& GetStats() const;
+
+    // Capabilities. GL_BLEND is tracked per draw buffer.
+    void SetEnabled(const OpenGLFunctions& gl, GLenum cap, bool enabled);
+    void SetEnabledi(const OpenGLFunctions& gl, GLenum cap, GLuint index, bool enabled);
+
+    // Object bindings.
+    void BindBuffer(const OpenGLFunctions& gl, GLenum target, GLuint buffer);
+    void BindBufferBase(const OpenGLFunctions& gl, GLenum target, GLuint index, GLuint buffer);
+    void BindBufferRange(const OpenGLFunctions& gl,
+                         GLenum target,
+                         GLuint index,
+                         GLuint buffer,
+                         GLintptr offset,
+                         GLsizeiptr size);
+    void ActiveTexture(const OpenGLFunctions& gl, GLenum texture);
+    void BindTexture(const OpenGLFunctions& gl, GLenum target, GLuint texture);
+    void BindSampler(const OpenGLFunctions& gl, GLuint unit, GLuint sampler);
+    void UseProgram(const OpenGLFunctions& gl, GLuint program);
+    void BindVertexArray(const OpenGLFunctions& gl, GLuint vertexArray);
+
+    void DeleteBuffer(const OpenGLFunctions& gl, GLuint buffer);
+    void DeleteTexture(const OpenGLFunctions& gl, GLuint texture);
+    void DeleteSampler(const OpenGLFunctions& gl, GLuint sampler);
+    void DeleteProgram(const OpenGLFunctions& gl, GLuint program);
+    void DeleteVertexArray(const OpenGLFunctions& gl, GLuint vertexArray);
+
+    void PixelStorei(const OpenGLFunctions& gl, GLenum pname, GLint param);
+
+    // Viewport state. The viewport is set with glViewportIndexedf when it is available and is
+    // truncated to integers otherwise.
+    void Viewport(const OpenGLFunctions& gl, float x, float y, float width, float height);
+    void DepthRange(const OpenGLFunctions& gl, float nearVal, float farVal);
+    void Scissor(const OpenGLFunctions& gl, GLint x, GLint y, GLsizei width, GLsizei height);
+
+    // Rasterization and per-fragment state.
+    void FrontFace(const OpenGLFunctions& gl, GLenum mode);
+    void CullFace(const OpenGLFunctions& gl, GLenum mode);
+    void PolygonOffset(const OpenGLFunctions& gl, float factor, float units, float clamp);
+    void SampleMask(const OpenGLFunctions& gl, GLbitfield mask);
+    void DepthFunc(const OpenGLFunctions& gl, GLenum func);
+    void DepthMask(const OpenGLFunctions& gl, GLboolean flag);
+    void SetStencilFuncsAndMask(const OpenGLFunctions& gl,
+                                GLenum stencilBackCompareFunction,
+                                GLenum stencilFrontCompareFunction,
+                                uint32_t stencilReadMask);
+    void SetStencilReference(const OpenGLFunctions& gl, uint32_t stencilReference);
+    void StencilOpSeparate(const OpenGLFunctions& gl,
+                           GLenum face,
+                           GLenum sfail,
+                           GLenum dpfail,
+                           GLenum dppass);
+    void StencilMask(const OpenGLFunctions& gl, GLuint mask);
+    void BlendColor(const OpenGLFunctions& gl, const std::array<float, 4>& color);
+    void BlendEquationSeparate(const OpenGLFunctions& gl, GLenum modeRGB, GLenum modeAlpha);
+    void BlendEquationSeparatei(const OpenGLFunctions& gl,
+                                GLuint buf,
+                                GLenum modeRGB,
+                                GLenum modeAlpha);
+    void BlendFuncSeparate(const OpenGLFunctions& gl,
+                           GLenum srcRGB,
+                           GLenum dstRGB,
+                           GLenum srcAlpha,
+                           GLenum dstAlpha);
+    void BlendFuncSeparatei(const OpenGLFunctions& gl,
+                            GLuint buf,
+                            GLenum srcRGB,
+                            GLenum dstRGB,
+                            GLenum srcAlpha,
+                            GLenum dstAlpha);
+    void ColorMask(const OpenGLFunctions& gl, bool red, bool green, bool blue, bool alpha);
+    void ColorMaski(const OpenGLFunctions& gl,
+                    GLuint buf,
+                    bool red,
+                    bool green,
+                    bool blue,
+                    bool alpha);
+
+  private:
+    // Records `value` as the current value of `state`. Returns whether the call setting it must
+    // be issued, which is the case unless the value is known to already be set.
+    template <typename T>
+    bool Update(std::optional<T>* state, const T& value);
+    // Same as Update() but for state that is indexed by a GLenum, like buffer binding points.
+    template <typename T>
+    bool UpdateKeyed(std::vector<std::pair<GLenum, T>>* states, GLenum key, const T& value);
+    // Records `value` as the current value of `states[key]` for calls that are always issued.
+    template <typename T>
+    void SetKeyed(std::vector<std::pair<GLenum, T>>* states, GLenum key, const T& value);
+    // Same as Update() for state set for all draw buffers at once.
+    template <typename T>
+    bool UpdateAll(PerColorAttachment<std::optional<T>>* states, const T& value);
+    void CountIssuedCall();
+    void ForgetElementArrayBufferBinding();
+
+    void CallGLStencilFunc(const OpenGLFunctions& gl);
+
+    bool mEnabled;
+    Stats mStats;
+
+    std::vector<std::pair<GLenum, bool>> mCapabilities;
+    std::vector<std::pair<GLenum, GLuint>> mBufferBindings;
+    std::optional<GLuint> mActiveTextureUnit;
+    // The texture bindings of each texture unit, per texture target.
+    std::vector<std::vector<std::pair<GLenum, GLuint>>> mTextureBindings;
+    std::vector<std::optional<GLuint>> mSamplerBindings;
+    std::optional<GLuint> mProgram;
+    std::optional<GLuint> mVertexArray;
+    std::vector<std::pair<GLenum, GLint>> mPixelStore;
+
+    std::optional<std::array<float, 4>> mViewport;
+    std::optional<std::array<float, 2>> mDepthRange;
+    std::optional<std::array<GLint, 4>> mScissor;
+
+    std::optional<GLenum> mFrontFace;
+    std::optional<GLenum> mCullFace;
+    std::optional<std::array<float, 3>> mPolygonOffset;
+    std::optional<GLbitfield> mSampleMask;
+    std::optional<GLenum> mDepthFunc;
+    std::optional<GLboolean> mDepthMask;
+
+    // The stencil functions and reference are set together, so the last values are kept even
+    // when the GL state is unknown.
+    GLenum mStencilBackCompareFunction = GL_ALWAYS;
+    GLenum mStencilFrontCompareFunction = GL_ALWAYS;
+    GLuint mStencilReadMask = 0xffffffff;
+    GLuint mStencilReference = 0;
+    bool mStencilFuncKnown = false;
+    std::optional<std::array<GLenum, 3>> mStencilOpBack;
+    std::optional<std::array<GLenum, 3>> mStencilOpFront;
+    std::optional<GLuint> mStencilMask;
+
+    std::optional<std::array<float, 4>> mBlendColor;
+    PerColorAttachment<std::optional<bool>> mBlendEnabled;
+    PerColorAttachment<std::optional<std::array<GLenum, 2>>> mBlendEquation;
+    PerColorAttachment<std::optional<std::array<GLenum, 4>>> mBlendFunc;
+    PerColorAttachment<std::optional<std::array<bool, 4>>> mColorMask;
+};
+
+}  // namespace dawn::native::opengl
+
+#endif  // SRC_DAWN_NATIVE_OPENGL_STATECACHEGL_H_
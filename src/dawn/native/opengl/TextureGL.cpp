@@ -204,7 +204,7 @@ Texture::Texture(Device* device, const UnpackedPtr<TextureDescriptor>& descripto
 
     const GLFormat& glFormat = GetGLFormat();
 
-    gl.BindTexture(mTarget, mHandle);
+    device->GetStateCache()->BindTexture(gl, mTarget, mHandle);
 
     AllocateTexture(gl, mTarget, GetSampleCount(), levels, glFormat.internalFormat, GetBaseSize());
 
@@ -230,9 +230,17 @@ Texture::~Texture() {}
 
 void Texture::DestroyImpl() {
     TextureBase::DestroyImpl();
+    if (mHandle == 0) {
+        return;
+    }
+
+    // Cached framebuffers are dropped even when the handle is not ours since its owner may delete
+    // it and GL could then reuse the name for another texture.
+    Device* device = ToBackend(GetDevice());
+    const OpenGLFunctions& gl = device->GetGL();
+    device->GetFramebufferCache()->OnTextureDestroyed(gl, mHandle);
     if (mOwnsHandle) {
-        const OpenGLFunctions& gl = ToBackend(GetDevice())->GetGL();
-        gl.DeleteTextures(1, &mHandle);
+        device->GetStateCache()->DeleteTexture(gl, mHandle);
         mHandle = 0;
     }
 }
@@ -253,6 +261,7 @@ MaybeError Texture::ClearTexture(const SubresourceRange& range,
                                  TextureBase::ClearValue clearValue) {
     Device* device = ToBackend(GetDevice());
     const OpenGLFunctions& gl = device->GetGL();
+    StateCache* stateCache = device->GetStateCache();
 
     uint8_t clearColor = (clearValue == TextureBase::ClearValue::Zero) ? 0 : 1;
     float fClearColor = (clearValue == TextureBase::ClearValue::Zero) ? 0.f : 1.f;
@@ -262,10 +271,10 @@ MaybeError Texture::ClearTexture(const SubresourceRange& range,
             GLfloat depth = fClearColor;
             GLint stencil = clearColor;
             if (range.aspects & Aspect::Depth) {
-                gl.DepthMask(GL_TRUE);
+                stateCache->DepthMask(gl, GL_TRUE);
             }
             if (range.aspects & Aspect::Stencil) {
-                gl.StencilMask(GetStencilMaskFromStencilFormat(GetFormat().format));
+                stateCache->StencilMask(gl, GetStencilMaskFromStencilFormat(GetFormat().format));
             }
 
             auto DoClear = [&](Aspect aspects) {
@@ -283,7 +292,7 @@ MaybeError Texture::ClearTexture(const SubresourceRange& range,
             GLuint framebuffer = 0;
             gl.GenFramebuffers(1, &framebuffer);
             gl.BindFramebuffer(GL_DRAW_FRAMEBUFFER, framebuffer);
-            gl.Disable(GL_SCISSOR_TEST);
+            stateCache->SetEnabled(gl, GL_SCISSOR_TEST, false);
 
             GLenum attachment;
             if (range.aspects == (Aspect::Depth | Aspect::Stencil)) {
@@ -351,7 +360,7 @@ MaybeError Texture::ClearTexture(const SubresourceRange& range,
                 }
             }
 
-            gl.Enable(GL_SCISSOR_TEST);
+            stateCache->SetEnabled(gl, GL_SCISSOR_TEST, true);
             gl.DeleteFramebuffers(1, &framebuffer);
         } else {
             DAWN_ASSERT(range.aspects == Aspect::Color);
@@ -410,8 +419,8 @@ MaybeError Texture::ClearTexture(const SubresourceRange& range,
                     GLenum attachment = GL_COLOR_ATTACHMENT0;
                     gl.DrawBuffers(1, &attachment);
 
-                    gl.Disable(GL_SCISSOR_TEST);
-                    gl.ColorMask(true, true, true, true);
+                    stateCache->SetEnabled(gl, GL_SCISSOR_TEST, false);
+                    stateCache->ColorMask(gl, true, true, true, true);
 
                     auto DoClear = [&] {
                         switch (baseType) {
@@ -467,7 +476,7 @@ MaybeError Texture::ClearTexture(const SubresourceRange& range,
                         DoClear();
                     }
 
-                    gl.Enable(GL_SCISSOR_TEST);
+                    stateCache->SetEnabled(gl, GL_SCISSOR_TEST, true);
                     gl.DeleteFramebuffers(1, &framebuffer);
                     gl.BindFramebuffer(GL_DRAW_FRAMEBUFFER, 0);
                 }
@@ -511,7 +520,7 @@ MaybeError Texture::ClearTexture(const SubresourceRange& range,
         memset(srcBuffer->GetMappedRange(0, bufferSize), clearColor, bufferSize);
         DAWN_TRY(srcBuffer->Unmap());
 
-        gl.BindBuffer(GL_PIXEL_UNPACK_BUFFER, srcBuffer->GetHandle());
+        stateCache->BindBuffer(gl, GL_PIXEL_UNPACK_BUFFER, srcBuffer->GetHandle());
         for (uint32_t level = range.baseMipLevel; level < range.baseMipLevel + range.levelCount;
              ++level) {
             TextureCopy textureCopy;
@@ -540,7 +549,7 @@ MaybeError Texture::ClearTexture(const SubresourceRange& range,
                 DoTexSubImage(gl, textureCopy, 0, dataLayout, mipSize);
             }
         }
-        gl.BindBuffer(GL_PIXEL_UNPACK_BUFFER, 0);
+        stateCache->BindBuffer(gl, GL_PIXEL_UNPACK_BUFFER, 0);
     }
     if (clearValue == TextureBase::ClearValue::Zero) {
         SetIsSubresourceContentInitialized(true, range);
@@ -596,8 +605,10 @@ TextureView::~TextureView() {}
 void TextureView::DestroyImpl() {
     TextureViewBase::DestroyImpl();
     if (mOwnsHandle) {
-        const OpenGLFunctions& gl = ToBackend(GetDevice())->GetGL();
-        gl.DeleteTextures(1, &mHandle);
+        Device* device = ToBackend(GetDevice());
+        const OpenGLFunctions& gl = device->GetGL();
+        device->GetFramebufferCache()->OnTextureDestroyed(gl, mHandle);
+        device->GetStateCache()->DeleteTexture(gl, mHandle);
     }
 }
 
@@ -610,43 +621,39 @@ GLenum TextureView::GetGLTarget() const {
     return mTarget;
 }
 
-void TextureView::BindToFramebuffer(GLenum target, GLenum attachment, GLuint depthSlice) {
+FramebufferAttachment TextureView::GetFramebufferAttachment(GLenum attachment,
+                                                           GLuint depthSlice) const {
     DAWN_ASSERT(depthSlice <
                 static_cast<GLuint>(GetSingleSubresourceVirtualSize().depthOrArrayLayers));
 
-    const OpenGLFunctions& gl = ToBackend(GetDevice())->GetGL();
-
     // Use the base texture where possible to minimize the amount of copying required on GLES.
     bool useOwnView = GetFormat().format != GetTexture()->GetFormat().format &&
                       !GetTexture()->GetFormat().HasDepthOrStencil();
 
-    GLuint handle, textarget, mipLevel, arrayLayer;
+    FramebufferAttachment result;
+    result.attachment = attachment;
     if (useOwnView) {
         // Use our own texture handle and target which points to a subset of the texture's
         // subresources.
-        handle = GetHandle();
-        textarget = GetGLTarget();
-        mipLevel = 0;
-        arrayLayer = 0;
+        result.texture = GetHandle();
+        result.textarget = GetGLTarget();
+        result.mipLevel = 0;
+        result.arrayLayer = 0;
     } else {
         // Use the texture's handle and target, with the view's base mip level and base array
 
-        handle = ToBackend(GetTexture())->GetHandle();
-        textarget = ToBackend(GetTexture())->GetGLTarget();
-        mipLevel = GetBaseMipLevel();
+        result.texture = ToBackend(GetTexture())->GetHandle();
+        result.textarget = ToBackend(GetTexture())->GetGLTarget();
+        result.mipLevel = GetBaseMipLevel();
         // We have validated that the depthSlice in render pass's colorAttachments must be undefined
         // for 2d RTVs, which value is set to 0. For 3d RTVs, the baseArrayLayer must be 0. So here
         // we can simply use baseArrayLayer + depthSlice to specify the slice in RTVs without
         // checking the view's dimension.
-        arrayLayer = GetBaseArrayLayer() + depthSlice;
+        result.arrayLayer = GetBaseArrayLayer() + depthSlice;
     }
 
-    DAWN_ASSERT(handle != 0);
-    if (textarget == GL_TEXTURE_2D_ARRAY || textarget == GL_TEXTURE_3D) {
-        gl.FramebufferTextureLayer(target, attachment, handle, mipLevel, arrayLayer);
-    } else {
-        gl.FramebufferTexture2D(target, attachment, textarget, handle, mipLevel);
-    }
+    DAWN_ASSERT(result.texture != 0);
+    return result;
 }
 
 void TextureView::CopyIfNeeded() {
@@ -670,7 +677,7 @@ void TextureView::CopyIfNeeded() {
 
     if (mHandle == 0) {
         gl.GenTextures(1, &mHandle);
-        gl.BindTexture(mTarget, mHandle);
+        device->GetStateCache()->BindTexture(gl, mTarget, mHandle);
         AllocateTexture(gl, mTarget, texture->GetSampleCount(), numLevels, GetInternalFormat(),
                         size);
         mOwnsHandle = true;
@@ -679,8 +686,9 @@ void TextureView::CopyIfNeeded() {
     Origin3D src{0, 0, GetBaseArrayLayer()};
     Origin3D dst{0, 0, 0};
     for (GLuint level = 0; level < numLevels; ++level) {
-        CopyImageSubData(gl, GetAspects(), texture->GetHandle(), texture->GetGLTarget(),
-                         srcLevel + level, src, mHandle, mTarget, level, dst, size);
+        CopyImageSubData(gl, device->GetStateCache(), GetAspects(), texture->GetHandle(),
+                         texture->GetGLTarget(), srcLevel + level, src, mHandle, mTarget, level,
+                         dst, size);
     }
 
     mGenID = texture->GetGenID();
@@ -30,6 +30,7 @@
 
 #include "dawn/native/Texture.h"
 
+#include "dawn/native/opengl/FramebufferCacheGL.h"
 #include "dawn/native/opengl/opengl_platform.h"
 
 namespace dawn::native::opengl {
@@ -70,7 +71,7 @@ class TextureView final : public TextureViewBase {
 
     GLuint GetHandle() const;
     GLenum GetGLTarget() const;
-    void BindToFramebuffer(GLenum target, GLenum attachment, GLuint depthLayer = 0);
+    FramebufferAttachment GetFramebufferAttachment(GLenum attachment, GLuint depthSlice = 0) const;
     void CopyIfNeeded();
 
   private:
@@ -30,6 +30,7 @@
 #include "dawn/common/Assert.h"
 #include "dawn/native/EnumMaskIterator.h"
 #include "dawn/native/opengl/OpenGLFunctions.h"
+#include "dawn/native/opengl/StateCacheGL.h"
 
 namespace dawn::native::opengl {
 
@@ -71,6 +72,7 @@ GLint GetStencilMaskFromStencilFormat(wgpu::TextureFormat depthStencilFormat) {
 }
 
 void CopyImageSubData(const OpenGLFunctions& gl,
+                      StateCache* stateCache,
                       Aspect srcAspects,
                       GLuint srcHandle,
                       GLenum srcTarget,
@@ -100,7 +102,7 @@ void CopyImageSubData(const OpenGLFunctions& gl,
     gl.BindFramebuffer(GL_DRAW_FRAMEBUFFER, drawFBO);
 
     // Reset state that may affect glBlitFramebuffer().
-    gl.Disable(GL_SCISSOR_TEST);
+    stateCache->SetEnabled(gl, GL_SCISSOR_TEST, false);
     GLenum blitMask = 0;
     if (srcAspects & Aspect::Color) {
         blitMask |= GL_COLOR_BUFFER_BIT;
@@ -156,7 +158,7 @@ void CopyImageSubData(const OpenGLFunctions& gl,
         gl.BlitFramebuffer(src.x, src.y, src.x + size.width, src.y + size.height, dst.x, dst.y,
                            dst.x + size.width, dst.y + size.height, blitMask, GL_NEAREST);
     }
-    gl.Enable(GL_SCISSOR_TEST);
+    stateCache->SetEnabled(gl, GL_SCISSOR_TEST, true);
     gl.DeleteFramebuffers(1, &readFBO);
     gl.DeleteFramebuffers(1, &drawFBO);
     gl.BindFramebuffer(GL_READ_FRAMEBUFFER, prevReadFBO);
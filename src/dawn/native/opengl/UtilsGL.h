@@ -34,10 +34,12 @@
 
 namespace dawn::native::opengl {
 struct OpenGLFunctions;
+class StateCache;
 
 GLuint ToOpenGLCompareFunction(wgpu::CompareFunction compareFunction);
 GLint GetStencilMaskFromStencilFormat(wgpu::TextureFormat depthStencilFormat);
 void CopyImageSubData(const OpenGLFunctions& gl,
+                      StateCache* stateCache,
                       Aspect srcAspects,
                       GLuint srcHandle,
                       GLenum srcTarget,
@@ -32,7 +32,9 @@
 #include <bitset>
 #include <functional>
 #include <limits>
+#include <map>
 #include <unordered_map>
+#include <unordered_set>
 #include <utility>
 #include <vector>
 
@@ -45,6 +47,8 @@
 #include "dawn/native/stream/Source.h"
 
 namespace dawn::ityp {
+template <typename Index, typename Value, size_t Size>
+class array;
 template <typename Index, size_t N>
 class bitset;
 }  // namespace dawn::ityp
@@ -173,6 +177,23 @@ class Stream<ityp::bitset<Index, N>> {
     }
 };
 
+// Stream specialization for ityp::array.
+template <typename Index, typename Value, size_t Size>
+class Stream<ityp::array<Index, Value, Size>> {
+  public:
+    static void Write(Sink* s, const ityp::array<Index, Value, Size>& v) {
+        for (const Value& it : v) {
+            StreamIn(s, it);
+        }
+    }
+    static MaybeError Read(Source* s, ityp::array<Index, Value, Size>* v) {
+        for (Value& it : *v) {
+            DAWN_TRY(StreamOut(s, &it));
+        }
+        return {};
+    }
+};
+
 // Stream specialization for enums.
 template <typename T>
 class Stream<T, std::enable_if_t<std::is_enum_v<T>>> {
@@ -344,6 +365,55 @@ class Stream<std::unordered_map<K, V>> {
     }
 };
 
+// Stream specialization for std::map<K, V>. Entries are already ordered by key.
+template <typename K, typename V>
+class Stream<std::map<K, V>> {
+  public:
+    static void Write(stream::Sink* sink, const std::map<K, V>& m) {
+        StreamIn(sink, m.size());
+        for (const auto& [key, value] : m) {
+            StreamIn(sink, key, value);
+        }
+    }
+    static MaybeError Read(Source* s, std::map<K, V>* m) {
+        using SizeT = decltype(std::declval<std::map<K, V>>().size());
+        SizeT size;
+        DAWN_TRY(StreamOut(s, &size));
+        *m = {};
+        for (SizeT i = 0; i < size; ++i) {
+            std::pair<K, V> p;
+            DAWN_TRY(StreamOut(s, &p));
+            m->insert(m->end(), std::move(p));
+        }
+        return {};
+    }
+};
+
+// Stream specialization for std::unordered_set<T> which sorts the elements
+// to provide a stable ordering.
+template <typename T>
+class Stream<std::unordered_set<T>> {
+  public:
+    static void Write(stream::Sink* sink, const std::unordered_set<T>& set) {
+        std::vector<T> ordered(set.begin(), set.end());
+        std::sort(ordered.begin(), ordered.end());
+        StreamIn(sink, ordered);
+    }
+    static MaybeError Read(Source* s, std::unordered_set<T>* set) {
+        using SizeT = decltype(std::declval<std::vector<T>>().size());
+        SizeT size;
+        DAWN_TRY(StreamOut(s, &size));
+        *set = {};
+        set->reserve(size);
+        for (SizeT i = 0; i < size; ++i) {
+            T el;
+            DAWN_TRY(StreamOut(s, &el));
+            set->insert(std::move(el));
+        }
+        return {};
+    }
+};
+
 // Helper class to contain the begin/end iterators of an iterable.
 namespace detail {
 template <typename Iterator>
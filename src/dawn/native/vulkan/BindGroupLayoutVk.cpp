@@ -135,6 +135,44 @@ MaybeError BindGroupLayout::Initialize() {
                                                                  nullptr, &*mHandle),
                             "CreateDescriptorSetLayout"));
 
+    // Bind groups are created a lot more often than their layouts, so precompute a template
+    // that writes all the descriptors of a set from a flat array of DescriptorInfo.
+    if (GetBindingCount() > BindingIndex(0) &&
+        device->GetDeviceInfo().HasExt(DeviceExt::DescriptorUpdateTemplate)) {
+        ityp::vector<BindingIndex, VkDescriptorUpdateTemplateEntry> entries;
+        entries.reserve(GetBindingCount());
+
+        for (BindingIndex bindingIndex{0}; bindingIndex < GetBindingCount(); ++bindingIndex) {
+            VkDescriptorUpdateTemplateEntry entry;
+            entry.dstBinding = static_cast<uint32_t>(bindingIndex);
+            entry.dstArrayElement = 0;
+            entry.descriptorCount = 1;
+            entry.descriptorType = VulkanDescriptorType(GetBindingInfo(bindingIndex));
+            entry.offset = static_cast<uint32_t>(bindingIndex) * sizeof(DescriptorInfo);
+            entry.stride = sizeof(DescriptorInfo);
+
+            entries.emplace_back(entry);
+        }
+
+        VkDescriptorUpdateTemplateCreateInfo templateCreateInfo;
+        templateCreateInfo.sType = VK_STRUCTURE_TYPE_DESCRIPTOR_UPDATE_TEMPLATE_CREATE_INFO;
+        templateCreateInfo.pNext = nullptr;
+        templateCreateInfo.flags = 0;
+        templateCreateInfo.descriptorUpdateEntryCount = static_cast<uint32_t>(entries.size());
+        templateCreateInfo.pDescriptorUpdateEntries = entries.data();
+        templateCreateInfo.templateType = VK_DESCRIPTOR_UPDATE_TEMPLATE_TYPE_DESCRIPTOR_SET;
+        templateCreateInfo.descriptorSetLayout = mHandle;
+        // The remaining members are only used for push descriptors.
+        templateCreateInfo.pipelineBindPoint = VK_PIPELINE_BIND_POINT_GRAPHICS;
+        templateCreateInfo.pipelineLayout = VK_NULL_HANDLE;
+        templateCreateInfo.set = 0;
+
+        DAWN_TRY(CheckVkSuccess(
+            device->fn.CreateDescriptorUpdateTemplate(device->GetVkDevice(), &templateCreateInfo,
+                                                      nullptr, &*mUpdateTemplate),
+            "CreateDescriptorUpdateTemplate"));
+    }
+
     // Compute the size of descriptor pools used for this layout.
     std::map<VkDescriptorType, uint32_t> descriptorCountPerType;
 
@@ -176,6 +214,12 @@ void BindGroupLayout::DestroyImpl() {
         device->fn.DestroyDescriptorSetLayout(device->GetVkDevice(), mHandle, nullptr);
         mHandle = VK_NULL_HANDLE;
     }
+    // Same for the update template which is only used on the host.
+    if (mUpdateTemplate != VK_NULL_HANDLE) {
+        device->fn.DestroyDescriptorUpdateTemplate(device->GetVkDevice(), mUpdateTemplate,
+                                                   nullptr);
+        mUpdateTemplate = VK_NULL_HANDLE;
+    }
     mDescriptorSetAllocator = nullptr;
 }
 
@@ -183,6 +227,10 @@ VkDescriptorSetLayout BindGroupLayout::GetHandle() const {
     return mHandle;
 }
 
+VkDescriptorUpdateTemplate BindGroupLayout::GetUpdateTemplate() const {
+    return mUpdateTemplate;
+}
+
 ResultOrError<Ref<BindGroup>> BindGroupLayout::AllocateBindGroup(
     Device* device,
     const BindGroupDescriptor* descriptor) {
@@ -198,6 +246,10 @@ void BindGroupLayout::DeallocateBindGroup(BindGroup* bindGroup,
     mBindGroupAllocator->Deallocate(bindGroup);
 }
 
+DescriptorSetAllocator::Stats BindGroupLayout::GetDescriptorSetAllocatorStats() const {
+    return mDescriptorSetAllocator->GetStats();
+}
+
 void BindGroupLayout::SetLabelImpl() {
     SetDebugName(ToBackend(GetDevice()), mHandle, "Dawn_BindGroupLayout", GetLabel());
 }
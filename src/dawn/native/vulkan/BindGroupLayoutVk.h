@@ -35,6 +35,7 @@
 #include "dawn/common/vulkan_platform.h"
 #include "dawn/native/BindGroupLayoutInternal.h"
 #include "dawn/native/vulkan/BindGroupVk.h"
+#include "dawn/native/vulkan/DescriptorSetAllocator.h"
 
 namespace dawn::native {
 class CacheKey;
@@ -43,11 +44,17 @@ class CacheKey;
 namespace dawn::native::vulkan {
 
 struct DescriptorSetAllocation;
-class DescriptorSetAllocator;
 class Device;
 
 VkDescriptorType VulkanDescriptorType(const BindingInfo& bindingInfo);
 
+// The information written for a single binding of a descriptor set. The descriptor update template
+// of a BindGroupLayout reads an array of these, indexed by BindingIndex.
+union DescriptorInfo {
+    VkDescriptorBufferInfo buffer;
+    VkDescriptorImageInfo image;
+};
+
 // In Vulkan descriptor pools have to be sized to an exact number of descriptors. This means
 // it's hard to have something where we can mix different types of descriptor sets because
 // we don't know if their vector of number of descriptors will be similar.
@@ -56,10 +63,10 @@ VkDescriptorType VulkanDescriptorType(const BindingInfo& bindingInfo);
 // VkDescriptorSets for its bindgroups, the layout also acts as an allocator for the descriptor
 // sets.
 //
-// The allocations is done with one pool per descriptor set, which is inefficient, but at least
-// the pools are reused when no longer used. Minimizing the number of descriptor pool allocation
-// is important because creating them can incur GPU memory allocation which is usually an
-// expensive syscall.
+// The allocations are done linearly in pools that grow geometrically and that are reset and reused
+// once all their sets are no longer used. Minimizing the number of descriptor pool allocation is
+// important because creating them can incur GPU memory allocation which is usually an expensive
+// syscall.
 class BindGroupLayout final : public BindGroupLayoutInternalBase {
   public:
     static ResultOrError<Ref<BindGroupLayout>> Create(Device* device,
@@ -68,12 +75,16 @@ class BindGroupLayout final : public BindGroupLayoutInternalBase {
     BindGroupLayout(DeviceBase* device, const BindGroupLayoutDescriptor* descriptor);
 
     VkDescriptorSetLayout GetHandle() const;
+    // Returns VK_NULL_HANDLE if descriptor update templates aren't supported.
+    VkDescriptorUpdateTemplate GetUpdateTemplate() const;
 
     ResultOrError<Ref<BindGroup>> AllocateBindGroup(Device* device,
                                                     const BindGroupDescriptor* descriptor);
     void DeallocateBindGroup(BindGroup* bindGroup,
                              DescriptorSetAllocation* descriptorSetAllocation);
 
+    DescriptorSetAllocator::Stats GetDescriptorSetAllocatorStats() const;
+
   private:
     ~BindGroupLayout() override;
     MaybeError Initialize();
@@ -83,6 +94,7 @@ class BindGroupLayout final : public BindGroupLayoutInternalBase {
     void SetLabelImpl() override;
 
     VkDescriptorSetLayout mHandle = VK_NULL_HANDLE;
+    VkDescriptorUpdateTemplate mUpdateTemplate = VK_NULL_HANDLE;
 
     MutexProtected<SlabAllocator<BindGroup>> mBindGroupAllocator;
     MutexProtected<Ref<DescriptorSetAllocator>> mDescriptorSetAllocator;
@@ -41,6 +41,56 @@
 
 namespace dawn::native::vulkan {
 
+namespace {
+
+using DescriptorInfos = ityp::stack_vec<BindingIndex, DescriptorInfo, kMaxOptimalBindingsPerGroup>;
+
+// Does a write of a single descriptor set with all the bindings that don't reference a destroyed
+// resource, without using a descriptor update template.
+void WriteDescriptorSet(Device* device,
+                        VkDescriptorSet set,
+                        const BindGroupLayout* layout,
+                        const DescriptorInfos& descriptorInfos) {
+    const BindingIndex bindingCount = layout->GetBindingCount();
+    ityp::stack_vec<uint32_t, VkWriteDescriptorSet, kMaxOptimalBindingsPerGroup> writes(
+        static_cast<uint32_t>(bindingCount));
+
+    uint32_t numWrites = 0;
+    for (BindingIndex bindingIndex{0}; bindingIndex < bindingCount; ++bindingIndex) {
+        const BindingInfo& bindingInfo = layout->GetBindingInfo(bindingIndex);
+        const DescriptorInfo& info = descriptorInfos[bindingIndex];
+
+        auto& write = writes[numWrites];
+        write.sType = VK_STRUCTURE_TYPE_WRITE_DESCRIPTOR_SET;
+        write.pNext = nullptr;
+        write.dstSet = set;
+        write.dstBinding = static_cast<uint32_t>(bindingIndex);
+        write.dstArrayElement = 0;
+        write.descriptorCount = 1;
+        write.descriptorType = VulkanDescriptorType(bindingInfo);
+
+        if (bindingInfo.bindingType == BindingInfoType::Buffer) {
+            if (info.buffer.buffer == VK_NULL_HANDLE) {
+                continue;
+            }
+            write.pBufferInfo = &info.buffer;
+        } else {
+            if (bindingInfo.bindingType != BindingInfoType::Sampler &&
+                info.image.imageView == VK_NULL_HANDLE) {
+                continue;
+            }
+            write.pImageInfo = &info.image;
+        }
+
+        numWrites++;
+    }
+
+    // TODO(crbug.com/dawn/855): Batch these updates
+    device->fn.UpdateDescriptorSets(device->GetVkDevice(), numWrites, writes.data(), 0, nullptr);
+}
+
+}  // anonymous namespace
+
 // static
 ResultOrError<Ref<BindGroup>> BindGroup::Create(Device* device,
                                                 const BindGroupDescriptor* descriptor) {
@@ -52,96 +102,64 @@ BindGroup::BindGroup(Device* device,
                      const BindGroupDescriptor* descriptor,
                      DescriptorSetAllocation descriptorSetAllocation)
     : BindGroupBase(this, device, descriptor), mDescriptorSetAllocation(descriptorSetAllocation) {
-    // Now do a write of a single descriptor set with all possible chained data allocated on the
-    // stack.
-    const uint32_t bindingCount = static_cast<uint32_t>((GetLayout()->GetBindingCount()));
-    ityp::stack_vec<uint32_t, VkWriteDescriptorSet, kMaxOptimalBindingsPerGroup> writes(
-        bindingCount);
-    ityp::stack_vec<uint32_t, VkDescriptorBufferInfo, kMaxOptimalBindingsPerGroup> writeBufferInfo(
-        bindingCount);
-    ityp::stack_vec<uint32_t, VkDescriptorImageInfo, kMaxOptimalBindingsPerGroup> writeImageInfo(
-        bindingCount);
+    const BindGroupLayout* layout = ToBackend(GetLayout());
+    const BindingIndex bindingCount = layout->GetBindingCount();
 
-    uint32_t numWrites = 0;
-    for (const auto [_, bindingIndex] : GetLayout()->GetBindingMap()) {
-        const BindingInfo& bindingInfo = GetLayout()->GetBindingInfo(bindingIndex);
+    // Gather the descriptors of all the bindings in a flat array indexed by BindingIndex, which
+    // is the format expected by the descriptor update template of the layout.
+    DescriptorInfos descriptorInfos(bindingCount);
+    // Bindings of destroyed resources have a VK_NULL_HANDLE and aren't written since it would
+    // be a Vulkan Validation Layers error. This bind group won't be used as it is an error to
+    // submit a command buffer that references destroyed resources.
+    bool hasDestroyedResource = false;
 
-        auto& write = writes[numWrites];
-        write.sType = VK_STRUCTURE_TYPE_WRITE_DESCRIPTOR_SET;
-        write.pNext = nullptr;
-        write.dstSet = GetHandle();
-        write.dstBinding = static_cast<uint32_t>(bindingIndex);
-        write.dstArrayElement = 0;
-        write.descriptorCount = 1;
-        write.descriptorType = VulkanDescriptorType(bindingInfo);
+    for (BindingIndex bindingIndex{0}; bindingIndex < bindingCount; ++bindingIndex) {
+        const BindingInfo& bindingInfo = layout->GetBindingInfo(bindingIndex);
+        DescriptorInfo& info = descriptorInfos[bindingIndex];
 
         switch (bindingInfo.bindingType) {
             case BindingInfoType::Buffer: {
                 BufferBinding binding = GetBindingAsBufferBinding(bindingIndex);
 
-                VkBuffer handle = ToBackend(binding.buffer)->GetHandle();
-                if (handle == VK_NULL_HANDLE) {
-                    // The Buffer was destroyed. Skip this descriptor write since it would be
-                    // a Vulkan Validation Layers error. This bind group won't be used as it
-                    // is an error to submit a command buffer that references destroyed
-                    // resources.
-                    continue;
-                }
-                writeBufferInfo[numWrites].buffer = handle;
-                writeBufferInfo[numWrites].offset = binding.offset;
-                writeBufferInfo[numWrites].range = binding.size;
-                write.pBufferInfo = &writeBufferInfo[numWrites];
+                info.buffer.buffer = ToBackend(binding.buffer)->GetHandle();
+                info.buffer.offset = binding.offset;
+                info.buffer.range = binding.size;
+                hasDestroyedResource |= info.buffer.buffer == VK_NULL_HANDLE;
                 break;
             }
 
             case BindingInfoType::Sampler: {
                 Sampler* sampler = ToBackend(GetBindingAsSampler(bindingIndex));
-                writeImageInfo[numWrites].sampler = sampler->GetHandle();
-                write.pImageInfo = &writeImageInfo[numWrites];
+                info.image.sampler = sampler->GetHandle();
+                info.image.imageView = VK_NULL_HANDLE;
+                info.image.imageLayout = VK_IMAGE_LAYOUT_UNDEFINED;
                 break;
             }
 
             case BindingInfoType::Texture: {
                 TextureView* view = ToBackend(GetBindingAsTextureView(bindingIndex));
 
-                VkImageView handle = view->GetHandle();
-                if (handle == VK_NULL_HANDLE) {
-                    // The Texture was destroyed before the TextureView was created.
-                    // Skip this descriptor write since it would be
-                    // a Vulkan Validation Layers error. This bind group won't be used as it
-                    // is an error to submit a command buffer that references destroyed
-                    // resources.
-                    continue;
-                }
-                writeImageInfo[numWrites].imageView = handle;
-                writeImageInfo[numWrites].imageLayout = VulkanImageLayout(
-                    view->GetTexture()->GetFormat(), wgpu::TextureUsage::TextureBinding);
-
-                write.pImageInfo = &writeImageInfo[numWrites];
+                // The handle is VK_NULL_HANDLE if the Texture was destroyed before the
+                // TextureView was created.
+                info.image.sampler = VK_NULL_HANDLE;
+                info.image.imageView = view->GetHandle();
+                info.image.imageLayout = VulkanImageLayout(view->GetTexture()->GetFormat(),
+                                                           wgpu::TextureUsage::TextureBinding);
+                hasDestroyedResource |= info.image.imageView == VK_NULL_HANDLE;
                 break;
             }
 
             case BindingInfoType::StorageTexture: {
                 TextureView* view = ToBackend(GetBindingAsTextureView(bindingIndex));
 
-                VkImageView handle = VK_NULL_HANDLE;
+                info.image.sampler = VK_NULL_HANDLE;
                 if (view->GetTexture()->GetFormat().format == wgpu::TextureFormat::BGRA8Unorm) {
-                    handle = view->GetHandleForBGRA8UnormStorage();
+                    info.image.imageView = view->GetHandleForBGRA8UnormStorage();
                 } else {
-                    handle = view->GetHandle();
-                }
-                if (handle == VK_NULL_HANDLE) {
-                    // The Texture was destroyed before the TextureView was created.
-                    // Skip this descriptor write since it would be
-                    // a Vulkan Validation Layers error. This bind group won't be used as it
-                    // is an error to submit a command buffer that references destroyed
-                    // resources.
-                    continue;
+                    info.image.imageView = view->GetHandle();
                 }
-                writeImageInfo[numWrites].imageView = handle;
-                writeImageInfo[numWrites].imageLayout = VK_IMAGE_LAYOUT_GENERAL;
-
-                write.pImageInfo = &writeImageInfo[numWrites];
+                info.image.imageLayout = VK_IMAGE_LAYOUT_GENERAL;
+                hasDestroyedResource |= info.image.imageView == VK_NULL_HANDLE;
                 break;
             }
 
@@ -149,12 +167,15 @@ BindGroup::BindGroup(Device* device,
                 DAWN_UNREACHABLE();
                 break;
         }
-
-        numWrites++;
     }
 
-    // TODO(crbug.com/dawn/855): Batch these updates
-    device->fn.UpdateDescriptorSets(device->GetVkDevice(), numWrites, writes.data(), 0, nullptr);
+    VkDescriptorUpdateTemplate updateTemplate = layout->GetUpdateTemplate();
+    if (updateTemplate != VK_NULL_HANDLE && !hasDestroyedResource) {
+        device->fn.UpdateDescriptorSetWithTemplate(device->GetVkDevice(), GetHandle(),
+                                                   updateTemplate, descriptorInfos.data());
+    } else {
+        WriteDescriptorSet(device, GetHandle(), layout, descriptorInfos);
+    }
 
     SetLabelImpl();
 }
@@ -37,6 +37,7 @@
 #include "dawn/native/DynamicUploader.h"
 #include "dawn/native/EnumMaskIterator.h"
 #include "dawn/native/RenderBundle.h"
+#include "dawn/native/TransientBufferAllocator.h"
 #include "dawn/native/vulkan/BindGroupVk.h"
 #include "dawn/native/vulkan/BufferVk.h"
 #include "dawn/native/vulkan/CommandRecordingContext.h"
@@ -47,6 +48,7 @@
 #include "dawn/native/vulkan/PipelineLayoutVk.h"
 #include "dawn/native/vulkan/QuerySetVk.h"
 #include "dawn/native/vulkan/QueueVk.h"
+#include "dawn/native/vulkan/RenderBundleVk.h"
 #include "dawn/native/vulkan/RenderPassCache.h"
 #include "dawn/native/vulkan/RenderPipelineVk.h"
 #include "dawn/native/vulkan/TextureVk.h"
@@ -149,18 +151,17 @@ class DescriptorSetTracker : public BindGroupTrackerBase<true, uint32_t> {
   public:
     DescriptorSetTracker() = default;
 
-    void Apply(Device* device,
-               CommandRecordingContext* recordingContext,
-               VkPipelineBindPoint bindPoint) {
+    void Apply(Device* device, VkCommandBuffer commands, VkPipelineBindPoint bindPoint) {
         BeforeApply();
         for (BindGroupIndex dirtyIndex : IterateBitSet(mDirtyBindGroupsObjectChangedOrIsDynamic)) {
             VkDescriptorSet set = ToBackend(mBindGroups[dirtyIndex])->GetHandle();
             uint32_t count = static_cast<uint32_t>(mDynamicOffsets[dirtyIndex].size());
             const uint32_t* dynamicOffset =
                 count > 0 ? mDynamicOffsets[dirtyIndex].data() : nullptr;
-            device->fn.CmdBindDescriptorSets(
-                recordingContext->commandBuffer, bindPoint, ToBackend(mPipelineLayout)->GetHandle(),
-                static_cast<uint32_t>(dirtyIndex), 1, &*set, count, dynamicOffset);
+            device->fn.CmdBindDescriptorSets(commands, bindPoint,
+                                             ToBackend(mPipelineLayout)->GetHandle(),
+                                             static_cast<uint32_t>(dirtyIndex), 1, &*set, count,
+                                             dynamicOffset);
         }
         AfterApply();
     }
@@ -354,11 +355,297 @@ void RecordResolveQuerySetCmd(VkCommandBuffer commands,
     }
 }
 
+// The state tracked while encoding the commands that render passes and render bundles share.
+struct RenderCommandState {
+    DescriptorSetTracker descriptorSets = {};
+    RenderPipeline* lastPipeline = nullptr;
+
+    // Tracking for the push constants needed by the ClampFragDepth transform.
+    // TODO(dawn:1125): Avoid the need for this when the depthClamp feature is available, but doing
+    // so would require fixing issue dawn:1576 first to have more dynamic push constant usage. (and
+    // also additional tests that the dirtying logic here is correct so with a Toggle we can test it
+    // on our infra).
+    ClampFragDepthArgs clampFragDepthArgs = {0.0f, 1.0f};
+    bool clampFragDepthArgsDirty = true;
+};
+
+void ApplyClampFragDepthArgs(Device* device, VkCommandBuffer commands, RenderCommandState* state) {
+    if (!state->clampFragDepthArgsDirty || state->lastPipeline == nullptr) {
+        return;
+    }
+    device->fn.CmdPushConstants(commands, ToBackend(state->lastPipeline->GetLayout())->GetHandle(),
+                                VK_SHADER_STAGE_FRAGMENT_BIT, kClampFragDepthArgsOffset,
+                                kClampFragDepthArgsSize, &state->clampFragDepthArgs);
+    state->clampFragDepthArgsDirty = false;
+}
+
+void EncodeRenderBundleCommand(Device* device,
+                               VkCommandBuffer commands,
+                               RenderCommandState* state,
+                               CommandIterator* iter,
+                               Command type) {
+    switch (type) {
+        case Command::Draw: {
+            DrawCmd* draw = iter->NextCommand<DrawCmd>();
+
+            state->descriptorSets.Apply(device, commands, VK_PIPELINE_BIND_POINT_GRAPHICS);
+            device->fn.CmdDraw(commands, draw->vertexCount, draw->instanceCount,
+                               draw->firstVertex, draw->firstInstance);
+            break;
+        }
+
+        case Command::DrawIndexed: {
+            DrawIndexedCmd* draw = iter->NextCommand<DrawIndexedCmd>();
+
+            state->descriptorSets.Apply(device, commands, VK_PIPELINE_BIND_POINT_GRAPHICS);
+            device->fn.CmdDrawIndexed(commands, draw->indexCount, draw->instanceCount,
+                                      draw->firstIndex, draw->baseVertex, draw->firstInstance);
+            break;
+        }
+
+        case Command::DrawIndirect: {
+            DrawIndirectCmd* draw = iter->NextCommand<DrawIndirectCmd>();
+            Buffer* buffer = ToBackend(draw->indirectBuffer.Get());
+
+            state->descriptorSets.Apply(device, commands, VK_PIPELINE_BIND_POINT_GRAPHICS);
+            device->fn.CmdDrawIndirect(commands, buffer->GetHandle(),
+                                       static_cast<VkDeviceSize>(draw->indirectOffset), 1, 0);
+            break;
+        }
+
+        case Command::DrawIndexedIndirect: {
+            DrawIndexedIndirectCmd* draw = iter->NextCommand<DrawIndexedIndirectCmd>();
+            Buffer* buffer = ToBackend(draw->indirectBuffer.Get());
+            DAWN_ASSERT(buffer != nullptr);
+
+            state->descriptorSets.Apply(device, commands, VK_PIPELINE_BIND_POINT_GRAPHICS);
+            device->fn.CmdDrawIndexedIndirect(commands, buffer->GetHandle(),
+                                              static_cast<VkDeviceSize>(draw->indirectOffset),
+                                              1, 0);
+            break;
+        }
+
+        case Command::InsertDebugMarker: {
+            if (device->GetGlobalInfo().HasExt(InstanceExt::DebugUtils)) {
+                InsertDebugMarkerCmd* cmd = iter->NextCommand<InsertDebugMarkerCmd>();
+                const char* label = iter->NextData<char>(cmd->length + 1);
+                VkDebugUtilsLabelEXT utilsLabel;
+                utilsLabel.sType = VK_STRUCTURE_TYPE_DEBUG_UTILS_LABEL_EXT;
+                utilsLabel.pNext = nullptr;
+                utilsLabel.pLabelName = label;
+                // Default color to black
+                utilsLabel.color[0] = 0.0;
+                utilsLabel.color[1] = 0.0;
+                utilsLabel.color[2] = 0.0;
+                utilsLabel.color[3] = 1.0;
+                device->fn.CmdInsertDebugUtilsLabelEXT(commands, &utilsLabel);
+            } else {
+                SkipCommand(iter, Command::InsertDebugMarker);
+            }
+            break;
+        }
+
+        case Command::PopDebugGroup: {
+            if (device->GetGlobalInfo().HasExt(InstanceExt::DebugUtils)) {
+                iter->NextCommand<PopDebugGroupCmd>();
+                device->fn.CmdEndDebugUtilsLabelEXT(commands);
+            } else {
+                SkipCommand(iter, Command::PopDebugGroup);
+            }
+            break;
+        }
+
+        case Command::PushDebugGroup: {
+            if (device->GetGlobalInfo().HasExt(InstanceExt::DebugUtils)) {
+                PushDebugGroupCmd* cmd = iter->NextCommand<PushDebugGroupCmd>();
+                const char* label = iter->NextData<char>(cmd->length + 1);
+                VkDebugUtilsLabelEXT utilsLabel;
+                utilsLabel.sType = VK_STRUCTURE_TYPE_DEBUG_UTILS_LABEL_EXT;
+                utilsLabel.pNext = nullptr;
+                utilsLabel.pLabelName = label;
+                // Default color to black
+                utilsLabel.color[0] = 0.0;
+                utilsLabel.color[1] = 0.0;
+                utilsLabel.color[2] = 0.0;
+                utilsLabel.color[3] = 1.0;
+                device->fn.CmdBeginDebugUtilsLabelEXT(commands, &utilsLabel);
+            } else {
+                SkipCommand(iter, Command::PushDebugGroup);
+            }
+            break;
+        }
+
+        case Command::SetBindGroup: {
+            SetBindGroupCmd* cmd = iter->NextCommand<SetBindGroupCmd>();
+            BindGroup* bindGroup = ToBackend(cmd->group.Get());
+            uint32_t* dynamicOffsets = nullptr;
+            if (cmd->dynamicOffsetCount > 0) {
+                dynamicOffsets = iter->NextData<uint32_t>(cmd->dynamicOffsetCount);
+            }
+
+            state->descriptorSets.OnSetBindGroup(cmd->index, bindGroup, cmd->dynamicOffsetCount,
+                                                 dynamicOffsets);
+            break;
+        }
+
+        case Command::SetIndexBuffer: {
+            SetIndexBufferCmd* cmd = iter->NextCommand<SetIndexBufferCmd>();
+            VkBuffer indexBuffer = ToBackend(cmd->buffer)->GetHandle();
+
+            device->fn.CmdBindIndexBuffer(commands, indexBuffer, cmd->offset,
+                                          VulkanIndexType(cmd->format));
+            break;
+        }
+
+        case Command::SetRenderPipeline: {
+            SetRenderPipelineCmd* cmd = iter->NextCommand<SetRenderPipelineCmd>();
+            RenderPipeline* pipeline = ToBackend(cmd->pipeline).Get();
+
+            device->fn.CmdBindPipeline(commands, VK_PIPELINE_BIND_POINT_GRAPHICS,
+                                       pipeline->GetHandle());
+            state->lastPipeline = pipeline;
+
+            state->descriptorSets.OnSetPipeline(pipeline);
+
+            // Apply the deferred min/maxDepth push constants update if needed.
+            ApplyClampFragDepthArgs(device, commands, state);
+            break;
+        }
+
+        case Command::SetVertexBuffer: {
+            SetVertexBufferCmd* cmd = iter->NextCommand<SetVertexBufferCmd>();
+            VkBuffer buffer = ToBackend(cmd->buffer)->GetHandle();
+            VkDeviceSize offset = static_cast<VkDeviceSize>(cmd->offset);
+
+            device->fn.CmdBindVertexBuffers(commands, static_cast<uint8_t>(cmd->slot), 1,
+                                            &*buffer, &offset);
+            break;
+        }
+
+        default:
+            DAWN_UNREACHABLE();
+            break;
+    }
+}
+
+// Sets the default value for the dynamic state of a render pass of |width| x |height|.
+void RecordDefaultDynamicState(Device* device,
+                               VkCommandBuffer commands,
+                               uint32_t width,
+                               uint32_t height) {
+    device->fn.CmdSetLineWidth(commands, 1.0f);
+    device->fn.CmdSetDepthBounds(commands, 0.0f, 1.0f);
+
+    device->fn.CmdSetStencilReference(commands, VK_STENCIL_FRONT_AND_BACK, 0);
+
+    float blendConstants[4] = {
+        0.0f,
+        0.0f,
+        0.0f,
+        0.0f,
+    };
+    device->fn.CmdSetBlendConstants(commands, blendConstants);
+
+    // The viewport and scissor default to cover all of the attachments
+    VkViewport viewport;
+    viewport.x = 0.0f;
+    viewport.y = static_cast<float>(height);
+    viewport.width = static_cast<float>(width);
+    viewport.height = -static_cast<float>(height);
+    viewport.minDepth = 0.0f;
+    viewport.maxDepth = 1.0f;
+    device->fn.CmdSetViewport(commands, 0, 1, &viewport);
+
+    VkRect2D scissorRect;
+    scissorRect.offset.x = 0;
+    scissorRect.offset.y = 0;
+    scissorRect.extent.width = width;
+    scissorRect.extent.height = height;
+    device->fn.CmdSetScissor(commands, 0, 1, &scissorRect);
+}
+
+// Skips the commands of a render pass up to and including its EndRenderPass, and returns whether
+// the pass only executes render bundles that can all be recorded in secondary command buffers.
+bool SkipRenderPassAndCheckItOnlyExecutesBundles(CommandIterator* commands) {
+    bool onlyExecutesBundles = true;
+    bool executesBundles = false;
+
+    Command type;
+    while (commands->NextCommandId(&type)) {
+        switch (type) {
+            case Command::EndRenderPass: {
+                commands->NextCommand<EndRenderPassCmd>();
+                return onlyExecutesBundles && executesBundles;
+            }
+
+            case Command::ExecuteBundles: {
+                ExecuteBundlesCmd* cmd = commands->NextCommand<ExecuteBundlesCmd>();
+                auto bundles = commands->NextData<Ref<RenderBundleBase>>(cmd->count);
+                for (uint32_t i = 0; i < cmd->count; ++i) {
+                    RenderBundle* bundle = static_cast<RenderBundle*>(bundles[i].Get());
+                    onlyExecutesBundles &= bundle->CanUseSecondaryCommandBuffers();
+                }
+                executesBundles |= cmd->count > 0;
+                break;
+            }
+
+            default: {
+                onlyExecutesBundles = false;
+                SkipCommand(commands, type);
+                break;
+            }
+        }
+    }
+
+    // EndRenderPass should have been called
+    DAWN_UNREACHABLE();
+}
+
+// Executes render bundles in a render pass that was begun with
+// VK_SUBPASS_CONTENTS_SECONDARY_COMMAND_BUFFERS, recording their secondary command buffers the
+// first time they are executed in a pass of this size.
+MaybeError ExecuteBundlesInSecondaryCommandBuffers(Device* device,
+                                                   VkCommandBuffer commands,
+                                                   const BeginRenderPassCmd* renderPass,
+                                                   Ref<RenderBundleBase>* bundles,
+                                                   uint32_t count) {
+    std::vector<VkCommandBuffer> secondaryCommandBuffers;
+    secondaryCommandBuffers.reserve(count);
+
+    for (uint32_t i = 0; i < count; ++i) {
+        RenderBundle* bundle = static_cast<RenderBundle*>(bundles[i].Get());
+        auto RecordBundle = [&](VkCommandBuffer bundleCommands) -> MaybeError {
+            RecordDefaultDynamicState(device, bundleCommands, renderPass->width,
+                                      renderPass->height);
+
+            // Bundles start with no state set so they get their own tracking.
+            RenderCommandState state;
+            CommandIterator* iter = bundle->GetCommands();
+            iter->Reset();
+            Command type;
+            while (iter->NextCommandId(&type)) {
+                EncodeRenderBundleCommand(device, bundleCommands, &state, iter, type);
+            }
+            return {};
+        };
+
+        VkCommandBuffer secondaryCommandBuffer;
+        DAWN_TRY_ASSIGN(secondaryCommandBuffer,
+                        bundle->GetOrRecordSecondaryCommandBuffer(
+                            renderPass->width, renderPass->height, RecordBundle));
+        secondaryCommandBuffers.push_back(secondaryCommandBuffer);
+    }
+
+    device->fn.CmdExecuteCommands(commands, count, secondaryCommandBuffers.data());
+    return {};
+}
+
 }  // anonymous namespace
 
 MaybeError RecordBeginRenderPass(CommandRecordingContext* recordingContext,
                                  Device* device,
-                                 BeginRenderPassCmd* renderPass) {
+                                 BeginRenderPassCmd* renderPass,
+                                 VkSubpassContents contents) {
     VkCommandBuffer commands = recordingContext->commandBuffer;
 
     // Query a VkRenderPass from the cache
@@ -497,7 +784,7 @@ MaybeError RecordBeginRenderPass(CommandRecordingContext* recordingContext,
     beginInfo.clearValueCount = attachmentCount;
     beginInfo.pClearValues = clearValues.data();
 
-    device->fn.CmdBeginRenderPass(commands, &beginInfo, VK_SUBPASS_CONTENTS_INLINE);
+    device->fn.CmdBeginRenderPass(commands, &beginInfo, contents);
 
     return {};
 }
@@ -509,7 +796,96 @@ Ref<CommandBuffer> CommandBuffer::Create(CommandEncoder* encoder,
 }
 
 CommandBuffer::CommandBuffer(CommandEncoder* encoder, const CommandBufferDescriptor* descriptor)
-    : CommandBufferBase(encoder, descriptor) {}
+    : CommandBufferBase(encoder, descriptor) {
+    Device* device = ToBackend(GetDevice());
+    bool findCommandsRequiringSubmitThread =
+        device->IsToggleEnabled(Toggle::VulkanMultithreadedCommandRecording);
+    bool findRenderPassesOnlyExecutingBundles =
+        device->IsToggleEnabled(Toggle::VulkanRecordRenderBundlesInSecondaryCommandBuffers);
+    if (!findCommandsRequiringSubmitThread && !findRenderPassesOnlyExecutingBundles) {
+        return;
+    }
+
+    // Look for commands that allocate from device-wide objects when recorded: WriteBuffer uses
+    // the DynamicUploader, the compressed texture-to-texture copy workaround creates buffers and
+    // the split of the command buffer on compute passes after render passes begins a new
+    // VkCommandBuffer from the queue. Also look for render passes that can be begun with
+    // VK_SUBPASS_CONTENTS_SECONDARY_COMMAND_BUFFERS, which has to be decided before the pass's
+    // commands are recorded.
+    bool useTemporaryBufferForCompressedCopies =
+        device->IsToggleEnabled(Toggle::UseTemporaryBufferInCompressedTextureToTextureCopy);
+    bool splitOnComputePassAfterRenderPass =
+        device->IsToggleEnabled(Toggle::VulkanSplitCommandBufferOnComputePassAfterRenderPass);
+    bool hasRenderPass = false;
+    Command type;
+    while (mCommands.NextCommandId(&type)) {
+        if (findCommandsRequiringSubmitThread &&
+            (type == Command::WriteBuffer ||
+             (type == Command::CopyTextureToTexture && useTemporaryBufferForCompressedCopies) ||
+             (type == Command::BeginComputePass && hasRenderPass &&
+              splitOnComputePassAfterRenderPass))) {
+            mHasCommandsRequiringSubmitThread = true;
+            if (!findRenderPassesOnlyExecutingBundles) {
+                break;
+            }
+        }
+        if (type == Command::BeginRenderPass) {
+            hasRenderPass = true;
+            if (findRenderPassesOnlyExecutingBundles) {
+                mCommands.NextCommand<BeginRenderPassCmd>();
+                mRenderPassesOnlyExecutingBundles.push_back(
+                    SkipRenderPassAndCheckItOnlyExecutesBundles(&mCommands));
+                continue;
+            }
+        }
+        SkipCommand(&mCommands, type);
+    }
+    mCommands.Reset();
+}
+
+bool CommandBuffer::CanRecordCommandsConcurrently() const {
+    if (mHasCommandsRequiringSubmitThread) {
+        return false;
+    }
+
+    // Lazy clears of textures can use the DynamicUploader, so only resources that are already
+    // initialized can be used. Render attachments are the exception since they are cleared with
+    // the load operation of the render pass.
+    auto IsTextureInitialized = [](TextureBase* texture) {
+        return texture->IsSubresourceContentInitialized(texture->GetAllSubresources());
+    };
+    auto IsBufferInitialized = [](BufferBase* buffer) { return !buffer->NeedsInitialization(); };
+
+    const CommandBufferResourceUsage& usages = GetResourceUsages();
+    for (const RenderPassResourceUsage& pass : usages.renderPasses) {
+        if (!std::all_of(pass.buffers.begin(), pass.buffers.end(), IsBufferInitialized)) {
+            return false;
+        }
+        for (size_t i = 0; i < pass.textures.size(); ++i) {
+            bool needsLazyClear = false;
+            pass.textureSyncInfos[i].Iterate(
+                [&](const SubresourceRange& range, const TextureSyncInfo& syncInfo) {
+                    needsLazyClear |= (syncInfo.usage & ~wgpu::TextureUsage::RenderAttachment) &&
+                                      !pass.textures[i]->IsSubresourceContentInitialized(range);
+                });
+            if (needsLazyClear) {
+                return false;
+            }
+        }
+    }
+    for (const ComputePassResourceUsage& pass : usages.computePasses) {
+        if (!std::all_of(pass.referencedBuffers.begin(), pass.referencedBuffers.end(),
+                         IsBufferInitialized) ||
+            !std::all_of(pass.referencedTextures.begin(), pass.referencedTextures.end(),
+                         IsTextureInitialized)) {
+            return false;
+        }
+    }
+    return std::all_of(usages.topLevelBuffers.begin(), usages.topLevelBuffers.end(),
+                       IsBufferInitialized) &&
+           std::all_of(usages.topLevelTextures.begin(), usages.topLevelTextures.end(),
+                       IsTextureInitialized);
+}
 
 MaybeError CommandBuffer::RecordCopyImageWithTemporaryBuffer(
     CommandRecordingContext* recordingContext,
@@ -525,23 +901,26 @@ MaybeError CommandBuffer::RecordCopyImageWithTemporaryBuffer(
     DAWN_ASSERT(copySize.height % blockInfo.height == 0);
     uint32_t heightInBlocks = copySize.height / blockInfo.height;
 
-    // Create the temporary buffer. Note that We don't need to respect WebGPU's 256 alignment
-    // because it isn't a hard constraint in Vulkan.
+    // Allocate the temporary buffer from the queue's transient allocator, it is reclaimed when
+    // this submit completes. Note that we don't need to respect WebGPU's 256 alignment because
+    // it isn't a hard constraint in Vulkan, the offset only has to be a multiple of 4 and of the
+    // texel block size.
     uint64_t tempBufferSize =
         widthInBlocks * heightInBlocks * copySize.depthOrArrayLayers * blockInfo.byteSize;
-    BufferDescriptor tempBufferDescriptor;
-    tempBufferDescriptor.size = tempBufferSize;
-    tempBufferDescriptor.usage = wgpu::BufferUsage::CopySrc | wgpu::BufferUsage::CopyDst;
+    constexpr uint64_t kTempBufferOffsetAlignment = 16;
 
     Device* device = ToBackend(GetDevice());
-    Ref<BufferBase> tempBufferBase;
-    DAWN_TRY_ASSIGN(tempBufferBase, device->CreateBuffer(&tempBufferDescriptor));
-    Buffer* tempBuffer = ToBackend(tempBufferBase.Get());
+    QueueBase* queue = device->GetQueue();
+    TransientBufferAllocation tempAllocation;
+    DAWN_TRY_ASSIGN(tempAllocation, queue->GetTransientBufferAllocator()->Allocate(
+                                        tempBufferSize, queue->GetPendingCommandSerial(),
+                                        kTempBufferOffsetAlignment));
+    Buffer* tempBuffer = ToBackend(tempAllocation.buffer);
 
     BufferCopy tempBufferCopy;
     tempBufferCopy.buffer = tempBuffer;
     tempBufferCopy.rowsPerImage = heightInBlocks;
-    tempBufferCopy.offset = 0;
+    tempBufferCopy.offset = tempAllocation.offset;
     tempBufferCopy.bytesPerRow = copySize.width / blockInfo.width * blockInfo.byteSize;
 
     VkCommandBuffer commands = recordingContext->commandBuffer;
@@ -566,8 +945,6 @@ MaybeError CommandBuffer::RecordCopyImageWithTemporaryBuffer(
                                     VK_IMAGE_LAYOUT_TRANSFER_DST_OPTIMAL, 1,
                                     &tempBufferToDstRegion);
 
-    recordingContext->tempBuffers.emplace_back(tempBuffer);
-
     return {};
 }
 
@@ -807,7 +1184,11 @@ MaybeError CommandBuffer::RecordCommands(CommandRecordingContext* recordingConte
                     GetResourceUsages().renderPasses[nextRenderPassNumber]));
 
                 LazyClearRenderPassAttachments(cmd);
-                DAWN_TRY(RecordRenderPass(recordingContext, cmd));
+                bool executeBundlesInSecondaryCommandBuffers =
+                    nextRenderPassNumber < mRenderPassesOnlyExecutingBundles.size() &&
+                    mRenderPassesOnlyExecutingBundles[nextRenderPassNumber];
+                DAWN_TRY(RecordRenderPass(recordingContext, cmd,
+                                          executeBundlesInSecondaryCommandBuffers));
 
                 recordingContext->hasRecordedRenderPass = true;
                 nextRenderPassNumber++;
@@ -1010,7 +1391,7 @@ MaybeError CommandBuffer::RecordComputePass(CommandRecordingContext* recordingCo
 
                 DAWN_TRY(TransitionAndClearForSyncScope(
                     device, recordingContext, resourceUsages.dispatchUsages[currentDispatch]));
-                descriptorSets.Apply(device, recordingContext, VK_PIPELINE_BIND_POINT_COMPUTE);
+                descriptorSets.Apply(device, commands, VK_PIPELINE_BIND_POINT_COMPUTE);
 
                 device->fn.CmdDispatch(commands, dispatch->x, dispatch->y, dispatch->z);
                 currentDispatch++;
@@ -1023,7 +1404,7 @@ MaybeError CommandBuffer::RecordComputePass(CommandRecordingContext* recordingCo
 
                 DAWN_TRY(TransitionAndClearForSyncScope(
                     device, recordingContext, resourceUsages.dispatchUsages[currentDispatch]));
-                descriptorSets.Apply(device, recordingContext, VK_PIPELINE_BIND_POINT_COMPUTE);
+                descriptorSets.Apply(device, commands, VK_PIPELINE_BIND_POINT_COMPUTE);
 
                 device->fn.CmdDispatchIndirect(commands, indirectBuffer,
                                                static_cast<VkDeviceSize>(dispatch->indirectOffset));
@@ -1123,7 +1504,8 @@ MaybeError CommandBuffer::RecordComputePass(CommandRecordingContext* recordingCo
 }
 
 MaybeError CommandBuffer::RecordRenderPass(CommandRecordingContext* recordingContext,
-                                           BeginRenderPassCmd* renderPassCmd) {
+                                           BeginRenderPassCmd* renderPassCmd,
+                                           bool executeBundlesInSecondaryCommandBuffers) {
     Device* device = ToBackend(GetDevice());
     VkCommandBuffer commands = recordingContext->commandBuffer;
 
@@ -1137,205 +1519,17 @@ MaybeError CommandBuffer::RecordRenderPass(CommandRecordingContext* recordingCon
                                 VK_PIPELINE_STAGE_TOP_OF_PIPE_BIT);
     }
 
-    DAWN_TRY(RecordBeginRenderPass(recordingContext, device, renderPassCmd));
-
-    // Set the default value for the dynamic state
-    {
-        device->fn.CmdSetLineWidth(commands, 1.0f);
-        device->fn.CmdSetDepthBounds(commands, 0.0f, 1.0f);
-
-        device->fn.CmdSetStencilReference(commands, VK_STENCIL_FRONT_AND_BACK, 0);
-
-        float blendConstants[4] = {
-            0.0f,
-            0.0f,
-            0.0f,
-            0.0f,
-        };
-        device->fn.CmdSetBlendConstants(commands, blendConstants);
-
-        // The viewport and scissor default to cover all of the attachments
-        VkViewport viewport;
-        viewport.x = 0.0f;
-        viewport.y = static_cast<float>(renderPassCmd->height);
-        viewport.width = static_cast<float>(renderPassCmd->width);
-        viewport.height = -static_cast<float>(renderPassCmd->height);
-        viewport.minDepth = 0.0f;
-        viewport.maxDepth = 1.0f;
-        device->fn.CmdSetViewport(commands, 0, 1, &viewport);
-
-        VkRect2D scissorRect;
-        scissorRect.offset.x = 0;
-        scissorRect.offset.y = 0;
-        scissorRect.extent.width = renderPassCmd->width;
-        scissorRect.extent.height = renderPassCmd->height;
-        device->fn.CmdSetScissor(commands, 0, 1, &scissorRect);
+    // The subpass of a pass that only executes bundles contains nothing but vkCmdExecuteCommands.
+    // The secondary command buffers set their own dynamic state since it isn't inherited.
+    if (executeBundlesInSecondaryCommandBuffers) {
+        DAWN_TRY(RecordBeginRenderPass(recordingContext, device, renderPassCmd,
+                                       VK_SUBPASS_CONTENTS_SECONDARY_COMMAND_BUFFERS));
+    } else {
+        DAWN_TRY(RecordBeginRenderPass(recordingContext, device, renderPassCmd));
+        RecordDefaultDynamicState(device, commands, renderPassCmd->width, renderPassCmd->height);
     }
 
-    DescriptorSetTracker descriptorSets = {};
-    RenderPipeline* lastPipeline = nullptr;
-
-    // Tracking for the push constants needed by the ClampFragDepth transform.
-    // TODO(dawn:1125): Avoid the need for this when the depthClamp feature is available, but doing
-    // so would require fixing issue dawn:1576 first to have more dynamic push constant usage. (and
-    // also additional tests that the dirtying logic here is correct so with a Toggle we can test it
-    // on our infra).
-    ClampFragDepthArgs clampFragDepthArgs = {0.0f, 1.0f};
-    bool clampFragDepthArgsDirty = true;
-    auto ApplyClampFragDepthArgs = [&] {
-        if (!clampFragDepthArgsDirty || lastPipeline == nullptr) {
-            return;
-        }
-        device->fn.CmdPushConstants(commands, ToBackend(lastPipeline->GetLayout())->GetHandle(),
-                                    VK_SHADER_STAGE_FRAGMENT_BIT, kClampFragDepthArgsOffset,
-                                    kClampFragDepthArgsSize, &clampFragDepthArgs);
-        clampFragDepthArgsDirty = false;
-    };
-
-    auto EncodeRenderBundleCommand = [&](CommandIterator* iter, Command type) {
-        switch (type) {
-            case Command::Draw: {
-                DrawCmd* draw = iter->NextCommand<DrawCmd>();
-
-                descriptorSets.Apply(device, recordingContext, VK_PIPELINE_BIND_POINT_GRAPHICS);
-                device->fn.CmdDraw(commands, draw->vertexCount, draw->instanceCount,
-                                   draw->firstVertex, draw->firstInstance);
-                break;
-            }
-
-            case Command::DrawIndexed: {
-                DrawIndexedCmd* draw = iter->NextCommand<DrawIndexedCmd>();
-
-                descriptorSets.Apply(device, recordingContext, VK_PIPELINE_BIND_POINT_GRAPHICS);
-                device->fn.CmdDrawIndexed(commands, draw->indexCount, draw->instanceCount,
-                                          draw->firstIndex, draw->baseVertex, draw->firstInstance);
-                break;
-            }
-
-            case Command::DrawIndirect: {
-                DrawIndirectCmd* draw = iter->NextCommand<DrawIndirectCmd>();
-                Buffer* buffer = ToBackend(draw->indirectBuffer.Get());
-
-                descriptorSets.Apply(device, recordingContext, VK_PIPELINE_BIND_POINT_GRAPHICS);
-                device->fn.CmdDrawIndirect(commands, buffer->GetHandle(),
-                                           static_cast<VkDeviceSize>(draw->indirectOffset), 1, 0);
-                break;
-            }
-
-            case Command::DrawIndexedIndirect: {
-                DrawIndexedIndirectCmd* draw = iter->NextCommand<DrawIndexedIndirectCmd>();
-                Buffer* buffer = ToBackend(draw->indirectBuffer.Get());
-                DAWN_ASSERT(buffer != nullptr);
-
-                descriptorSets.Apply(device, recordingContext, VK_PIPELINE_BIND_POINT_GRAPHICS);
-                device->fn.CmdDrawIndexedIndirect(commands, buffer->GetHandle(),
-                                                  static_cast<VkDeviceSize>(draw->indirectOffset),
-                                                  1, 0);
-                break;
-            }
-
-            case Command::InsertDebugMarker: {
-                if (device->GetGlobalInfo().HasExt(InstanceExt::DebugUtils)) {
-                    InsertDebugMarkerCmd* cmd = iter->NextCommand<InsertDebugMarkerCmd>();
-                    const char* label = iter->NextData<char>(cmd->length + 1);
-                    VkDebugUtilsLabelEXT utilsLabel;
-                    utilsLabel.sType = VK_STRUCTURE_TYPE_DEBUG_UTILS_LABEL_EXT;
-                    utilsLabel.pNext = nullptr;
-                    utilsLabel.pLabelName = label;
-                    // Default color to black
-                    utilsLabel.color[0] = 0.0;
-                    utilsLabel.color[1] = 0.0;
-                    utilsLabel.color[2] = 0.0;
-                    utilsLabel.color[3] = 1.0;
-                    device->fn.CmdInsertDebugUtilsLabelEXT(commands, &utilsLabel);
-                } else {
-                    SkipCommand(iter, Command::InsertDebugMarker);
-                }
-                break;
-            }
-
-            case Command::PopDebugGroup: {
-                if (device->GetGlobalInfo().HasExt(InstanceExt::DebugUtils)) {
-                    iter->NextCommand<PopDebugGroupCmd>();
-                    device->fn.CmdEndDebugUtilsLabelEXT(commands);
-                } else {
-                    SkipCommand(iter, Command::PopDebugGroup);
-                }
-                break;
-            }
-
-            case Command::PushDebugGroup: {
-                if (device->GetGlobalInfo().HasExt(InstanceExt::DebugUtils)) {
-                    PushDebugGroupCmd* cmd = iter->NextCommand<PushDebugGroupCmd>();
-                    const char* label = iter->NextData<char>(cmd->length + 1);
-                    VkDebugUtilsLabelEXT utilsLabel;
-                    utilsLabel.sType = VK_STRUCTURE_TYPE_DEBUG_UTILS_LABEL_EXT;
-                    utilsLabel.pNext = nullptr;
-                    utilsLabel.pLabelName = label;
-                    // Default color to black
-                    utilsLabel.color[0] = 0.0;
-                    utilsLabel.color[1] = 0.0;
-                    utilsLabel.color[2] = 0.0;
-                    utilsLabel.color[3] = 1.0;
-                    device->fn.CmdBeginDebugUtilsLabelEXT(commands, &utilsLabel);
-                } else {
-                    SkipCommand(iter, Command::PushDebugGroup);
-                }
-                break;
-            }
-
-            case Command::SetBindGroup: {
-                SetBindGroupCmd* cmd = iter->NextCommand<SetBindGroupCmd>();
-                BindGroup* bindGroup = ToBackend(cmd->group.Get());
-                uint32_t* dynamicOffsets = nullptr;
-                if (cmd->dynamicOffsetCount > 0) {
-                    dynamicOffsets = iter->NextData<uint32_t>(cmd->dynamicOffsetCount);
-                }
-
-                descriptorSets.OnSetBindGroup(cmd->index, bindGroup, cmd->dynamicOffsetCount,
-                                              dynamicOffsets);
-                break;
-            }
-
-            case Command::SetIndexBuffer: {
-                SetIndexBufferCmd* cmd = iter->NextCommand<SetIndexBufferCmd>();
-                VkBuffer indexBuffer = ToBackend(cmd->buffer)->GetHandle();
-
-                device->fn.CmdBindIndexBuffer(commands, indexBuffer, cmd->offset,
-                                              VulkanIndexType(cmd->format));
-                break;
-            }
-
-            case Command::SetRenderPipeline: {
-                SetRenderPipelineCmd* cmd = iter->NextCommand<SetRenderPipelineCmd>();
-                RenderPipeline* pipeline = ToBackend(cmd->pipeline).Get();
-
-                device->fn.CmdBindPipeline(commands, VK_PIPELINE_BIND_POINT_GRAPHICS,
-                                           pipeline->GetHandle());
-                lastPipeline = pipeline;
-
-                descriptorSets.OnSetPipeline(pipeline);
-
-                // Apply the deferred min/maxDepth push constants update if needed.
-                ApplyClampFragDepthArgs();
-                break;
-            }
-
-            case Command::SetVertexBuffer: {
-                SetVertexBufferCmd* cmd = iter->NextCommand<SetVertexBufferCmd>();
-                VkBuffer buffer = ToBackend(cmd->buffer)->GetHandle();
-                VkDeviceSize offset = static_cast<VkDeviceSize>(cmd->offset);
-
-                device->fn.CmdBindVertexBuffers(commands, static_cast<uint8_t>(cmd->slot), 1,
-                                                &*buffer, &offset);
-                break;
-            }
-
-            default:
-                DAWN_UNREACHABLE();
-                break;
-        }
-    };
+    RenderCommandState state;
 
     Command type;
     while (mCommands.NextCommandId(&type)) {
@@ -1397,9 +1591,9 @@ MaybeError CommandBuffer::RecordRenderPass(CommandRecordingContext* recordingCon
 
                 // Try applying the push constants that contain min/maxDepth immediately. This can
                 // be deferred if no pipeline is currently bound.
-                clampFragDepthArgs = {viewport.minDepth, viewport.maxDepth};
-                clampFragDepthArgsDirty = true;
-                ApplyClampFragDepthArgs();
+                state.clampFragDepthArgs = {viewport.minDepth, viewport.maxDepth};
+                state.clampFragDepthArgsDirty = true;
+                ApplyClampFragDepthArgs(device, commands, &state);
                 break;
             }
 
@@ -1419,11 +1613,17 @@ MaybeError CommandBuffer::RecordRenderPass(CommandRecordingContext* recordingCon
                 ExecuteBundlesCmd* cmd = mCommands.NextCommand<ExecuteBundlesCmd>();
                 auto bundles = mCommands.NextData<Ref<RenderBundleBase>>(cmd->count);
 
+                if (executeBundlesInSecondaryCommandBuffers) {
+                    DAWN_TRY(ExecuteBundlesInSecondaryCommandBuffers(
+                        device, commands, renderPassCmd, bundles, cmd->count));
+                    break;
+                }
+
                 for (uint32_t i = 0; i < cmd->count; ++i) {
                     CommandIterator* iter = bundles[i]->GetCommands();
                     iter->Reset();
                     while (iter->NextCommandId(&type)) {
-                        EncodeRenderBundleCommand(iter, type);
+                        EncodeRenderBundleCommand(device, commands, &state, iter, type);
                     }
                 }
                 break;
@@ -1454,7 +1654,7 @@ MaybeError CommandBuffer::RecordRenderPass(CommandRecordingContext* recordingCon
             }
 
             default: {
-                EncodeRenderBundleCommand(&mCommands, type);
+                EncodeRenderBundleCommand(device, commands, &state, &mCommands, type);
                 break;
             }
         }
@@ -29,6 +29,7 @@
 #define SRC_DAWN_NATIVE_VULKAN_COMMANDBUFFERVK_H_
 
 #include <set>
+#include <vector>
 
 #include "dawn/native/CommandBuffer.h"
 #include "dawn/native/Error.h"
@@ -48,7 +49,8 @@ class Device;
 
 MaybeError RecordBeginRenderPass(CommandRecordingContext* recordingContext,
                                  Device* device,
-                                 BeginRenderPassCmd* renderPass);
+                                 BeginRenderPassCmd* renderPass,
+                                 VkSubpassContents contents = VK_SUBPASS_CONTENTS_INLINE);
 
 class CommandBuffer final : public CommandBufferBase {
   public:
@@ -57,6 +59,13 @@ class CommandBuffer final : public CommandBufferBase {
 
     MaybeError RecordCommands(CommandRecordingContext* recordingContext);
 
+    // Returns true if the commands can be recorded on a thread other than the one submitting
+    // them, concurrently with other command buffers that don't use any of the same resources.
+    // This is not the case when recording would use device-wide state that isn't thread-safe, like
+    // the DynamicUploader used by WriteBuffer and by some lazy clears, or the queue's command pools
+    // used to split the command buffer on compute passes after render passes.
+    bool CanRecordCommandsConcurrently() const;
+
   private:
     CommandBuffer(CommandEncoder* encoder, const CommandBufferDescriptor* descriptor);
 
@@ -64,11 +73,19 @@ class CommandBuffer final : public CommandBufferBase {
                                  BeginComputePassCmd* computePass,
                                  const ComputePassResourceUsage& resourceUsages);
     MaybeError RecordRenderPass(CommandRecordingContext* recordingContext,
-                                BeginRenderPassCmd* renderPass);
+                                BeginRenderPassCmd* renderPass,
+                                bool executeBundlesInSecondaryCommandBuffers);
     MaybeError RecordCopyImageWithTemporaryBuffer(CommandRecordingContext* recordingContext,
                                                   const TextureCopy& srcCopy,
                                                   const TextureCopy& dstCopy,
                                                   const Extent3D& copySize);
+
+    // Whether the commands contain any that must be recorded on the submitting thread.
+    bool mHasCommandsRequiringSubmitThread = false;
+    // For each render pass, whether it only executes render bundles, in which case they are
+    // executed from secondary command buffers. Empty unless
+    // VulkanRecordRenderBundlesInSecondaryCommandBuffers is enabled.
+    std::vector<bool> mRenderPassesOnlyExecutingBundles;
 };
 
 }  // namespace dawn::native::vulkan
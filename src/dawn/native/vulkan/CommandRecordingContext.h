@@ -54,10 +54,6 @@ struct CommandRecordingContext {
     std::vector<VkSemaphore> waitSemaphores = {};
     std::vector<VkSemaphore> signalSemaphores = {};
 
-    // The internal buffers used in the workaround of texture-to-texture copies with compressed
-    // formats.
-    std::vector<Ref<Buffer>> tempBuffers;
-
     // External textures that will be eagerly transitioned just before VkSubmit. The textures are
     // kept alive by the CommandBuffer so they don't need to be Ref-ed.
     std::set<Texture*> externalTexturesForEagerTransition;
@@ -36,7 +36,6 @@ namespace dawn::native::vulkan {
 struct DescriptorSetAllocation {
     VkDescriptorSet set = VK_NULL_HANDLE;
     uint32_t poolIndex;
-    uint16_t setIndex;
 };
 
 }  // namespace dawn::native::vulkan
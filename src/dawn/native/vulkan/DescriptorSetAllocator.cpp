@@ -27,6 +27,8 @@
 
 #include "dawn/native/vulkan/DescriptorSetAllocator.h"
 
+#include <algorithm>
+#include <limits>
 #include <utility>
 
 #include "dawn/native/vulkan/BindGroupLayoutVk.h"
@@ -36,8 +38,10 @@
 
 namespace dawn::native::vulkan {
 
-// TODO(enga): Figure out this value.
-static constexpr uint32_t kMaxDescriptorsPerPool = 512;
+// Pools start small so that layouts with few bind groups don't reserve many descriptors, and
+// grow geometrically so that bursts of bind group creation create few pools.
+static constexpr uint32_t kMinDescriptorsPerPool = 64;
+static constexpr uint32_t kMaxDescriptorsPerPool = 4096;
 
 // static
 Ref<DescriptorSetAllocator> DescriptorSetAllocator::Create(
@@ -54,39 +58,43 @@ DescriptorSetAllocator::DescriptorSetAllocator(
 
     // Compute the total number of descriptors for this layout.
     uint32_t totalDescriptorCount = 0;
-    mPoolSizes.reserve(descriptorCountPerType.size());
+    mDescriptorCountsPerSet.reserve(descriptorCountPerType.size());
     for (const auto& [type, count] : descriptorCountPerType) {
         DAWN_ASSERT(count > 0);
         totalDescriptorCount += count;
-        mPoolSizes.push_back(VkDescriptorPoolSize{type, count});
+        mDescriptorCountsPerSet.push_back(VkDescriptorPoolSize{type, count});
     }
 
     if (totalDescriptorCount == 0) {
         // Vulkan requires that valid usage of vkCreateDescriptorPool must have a non-zero
         // number of pools, each of which has non-zero descriptor counts.
-        // Since the descriptor set layout is empty, we should be able to allocate
-        // |kMaxDescriptorsPerPool| sets from this 1-sized descriptor pool.
+        // Since the descriptor set layout is empty, we should be able to allocate any number of
+        // sets from a 1-sized descriptor pool. AllocateDescriptorPool doesn't scale the
+        // descriptor count for empty layouts.
         // The type of this descriptor pool doesn't matter because it is never used.
-        mPoolSizes.push_back(VkDescriptorPoolSize{VK_DESCRIPTOR_TYPE_UNIFORM_BUFFER, 1});
-        mMaxSets = kMaxDescriptorsPerPool;
+        mDescriptorCountsPerSet.push_back(
+            VkDescriptorPoolSize{VK_DESCRIPTOR_TYPE_UNIFORM_BUFFER, 1});
+        mIsEmptyLayout = true;
+        mMinSetsPerPool = kMinDescriptorsPerPool;
+        mMaxSetsPerPool = kMaxDescriptorsPerPool;
     } else {
         DAWN_ASSERT(totalDescriptorCount <= kMaxBindingsPerPipelineLayout);
         static_assert(kMaxBindingsPerPipelineLayout <= kMaxDescriptorsPerPool);
 
-        // Compute the total number of descriptors sets that fits given the max.
-        mMaxSets = kMaxDescriptorsPerPool / totalDescriptorCount;
-        DAWN_ASSERT(mMaxSets > 0);
-
-        // Grow the number of desciptors in the pool to fit the computed |mMaxSets|.
-        for (auto& poolSize : mPoolSizes) {
-            poolSize.descriptorCount *= mMaxSets;
-        }
+        // Compute the number of descriptors sets that fit in the smallest and largest pools.
+        mMinSetsPerPool =
+            static_cast<SetIndex>(std::max(1u, kMinDescriptorsPerPool / totalDescriptorCount));
+        mMaxSetsPerPool = static_cast<SetIndex>(kMaxDescriptorsPerPool / totalDescriptorCount);
+        DAWN_ASSERT(mMaxSetsPerPool >= mMinSetsPerPool);
     }
+    static_assert(kMaxDescriptorsPerPool <= std::numeric_limits<SetIndex>::max());
+
+    mNextPoolSetCount = mMinSetsPerPool;
 }
 
 DescriptorSetAllocator::~DescriptorSetAllocator() {
     for (auto& pool : mDescriptorPools) {
-        DAWN_ASSERT(pool.freeSetIndices.size() == mMaxSets);
+        DAWN_ASSERT(pool.liveSets == 0);
         if (pool.vkPool != VK_NULL_HANDLE) {
             Device* device = ToBackend(GetDevice());
             device->GetFencedDeleter()->DeleteWhenUnused(pool.vkPool);
@@ -95,25 +103,43 @@ DescriptorSetAllocator::~DescriptorSetAllocator() {
 }
 
 ResultOrError<DescriptorSetAllocation> DescriptorSetAllocator::Allocate() {
-    if (mAvailableDescriptorPoolIndices.empty()) {
-        DAWN_TRY(AllocateDescriptorPool());
+    if (!mCurrentPoolIndex.has_value() ||
+        mDescriptorPools[*mCurrentPoolIndex].allocatedSets ==
+            mDescriptorPools[*mCurrentPoolIndex].maxSets) {
+        // The current pool is full; it will be reset once all its sets are deallocated. Switch to
+        // an empty pool, preferably one that's already created.
+        if (!mEmptyDescriptorPoolIndices.empty()) {
+            mCurrentPoolIndex = mEmptyDescriptorPoolIndices.back();
+            mEmptyDescriptorPoolIndices.pop_back();
+        } else {
+            DAWN_TRY(AllocateDescriptorPool());
+        }
     }
 
-    DAWN_ASSERT(!mAvailableDescriptorPoolIndices.empty());
-
-    const PoolIndex poolIndex = mAvailableDescriptorPoolIndices.back();
+    const PoolIndex poolIndex = *mCurrentPoolIndex;
     DescriptorPool* pool = &mDescriptorPools[poolIndex];
+    DAWN_ASSERT(pool->allocatedSets < pool->maxSets);
 
-    DAWN_ASSERT(!pool->freeSetIndices.empty());
+    VkDescriptorSetLayout layout = mLayout->GetHandle();
 
-    SetIndex setIndex = pool->freeSetIndices.back();
-    pool->freeSetIndices.pop_back();
+    VkDescriptorSetAllocateInfo allocateInfo;
+    allocateInfo.sType = VK_STRUCTURE_TYPE_DESCRIPTOR_SET_ALLOCATE_INFO;
+    allocateInfo.pNext = nullptr;
+    allocateInfo.descriptorPool = pool->vkPool;
+    allocateInfo.descriptorSetCount = 1;
+    allocateInfo.pSetLayouts = &*layout;
 
-    if (pool->freeSetIndices.empty()) {
-        mAvailableDescriptorPoolIndices.pop_back();
-    }
+    Device* device = ToBackend(GetDevice());
 
-    return DescriptorSetAllocation{pool->sets[setIndex], poolIndex, setIndex};
+    VkDescriptorSet set;
+    DAWN_TRY(CheckVkSuccess(
+        device->fn.AllocateDescriptorSets(device->GetVkDevice(), &allocateInfo, &*set),
+        "AllocateDescriptorSets"));
+
+    pool->allocatedSets++;
+    pool->liveSets++;
+
+    return DescriptorSetAllocation{set, poolIndex};
 }
 
 void DescriptorSetAllocator::Deallocate(DescriptorSetAllocation* allocationInfo) {
@@ -125,7 +151,7 @@ void DescriptorSetAllocator::Deallocate(DescriptorSetAllocation* allocationInfo)
     // host execution of the command and the end of the draw/dispatch.
     Device* device = ToBackend(GetDevice());
     const ExecutionSerial serial = device->GetPendingCommandSerial();
-    mPendingDeallocations.Enqueue({allocationInfo->poolIndex, allocationInfo->setIndex}, serial);
+    mPendingDeallocations.Enqueue(allocationInfo->poolIndex, serial);
 
     if (mLastDeallocationSerial != serial) {
         device->EnqueueDeferredDeallocation(this);
@@ -137,26 +163,56 @@ void DescriptorSetAllocator::Deallocate(DescriptorSetAllocation* allocationInfo)
 }
 
 void DescriptorSetAllocator::FinishDeallocation(ExecutionSerial completedSerial) {
-    for (const Deallocation& dealloc : mPendingDeallocations.IterateUpTo(completedSerial)) {
-        DAWN_ASSERT(dealloc.poolIndex < mDescriptorPools.size());
-
-        auto& freeSetIndices = mDescriptorPools[dealloc.poolIndex].freeSetIndices;
-        if (freeSetIndices.empty()) {
-            mAvailableDescriptorPoolIndices.emplace_back(dealloc.poolIndex);
+    for (PoolIndex poolIndex : mPendingDeallocations.IterateUpTo(completedSerial)) {
+        DAWN_ASSERT(poolIndex < mDescriptorPools.size());
+
+        DescriptorPool* pool = &mDescriptorPools[poolIndex];
+        DAWN_ASSERT(pool->liveSets > 0);
+        pool->liveSets--;
+        if (pool->liveSets == 0) {
+            ResetDescriptorPool(poolIndex);
         }
-        freeSetIndices.emplace_back(dealloc.setIndex);
     }
     mPendingDeallocations.ClearUpTo(completedSerial);
+
+    // FinishDeallocation is called from the device's Tick, which is when pools that became idle
+    // are released.
+    TrimEmptyDescriptorPools();
+}
+
+DescriptorSetAllocator::Stats DescriptorSetAllocator::GetStats() const {
+    Stats stats;
+    for (const DescriptorPool& pool : mDescriptorPools) {
+        if (pool.vkPool == VK_NULL_HANDLE) {
+            continue;
+        }
+        stats.poolCount++;
+        stats.setCapacity += pool.maxSets;
+        stats.setsInUse += pool.liveSets;
+        stats.fragmentedSets += pool.allocatedSets - pool.liveSets;
+    }
+    return stats;
 }
 
 MaybeError DescriptorSetAllocator::AllocateDescriptorPool() {
+    const SetIndex maxSets = mNextPoolSetCount;
+
+    // Scale the per-set descriptor counts to the size of the pool, except for empty layouts
+    // whose placeholder descriptor is never used.
+    std::vector<VkDescriptorPoolSize> poolSizes = mDescriptorCountsPerSet;
+    if (!mIsEmptyLayout) {
+        for (auto& poolSize : poolSizes) {
+            poolSize.descriptorCount *= maxSets;
+        }
+    }
+
     VkDescriptorPoolCreateInfo createInfo;
     createInfo.sType = VK_STRUCTURE_TYPE_DESCRIPTOR_POOL_CREATE_INFO;
     createInfo.pNext = nullptr;
     createInfo.flags = 0;
-    createInfo.maxSets = mMaxSets;
-    createInfo.poolSizeCount = static_cast<PoolIndex>(mPoolSizes.size());
-    createInfo.pPoolSizes = mPoolSizes.data();
+    createInfo.maxSets = maxSets;
+    createInfo.poolSizeCount = static_cast<uint32_t>(poolSizes.size());
+    createInfo.pPoolSizes = poolSizes.data();
 
     Device* device = ToBackend(GetDevice());
 
@@ -165,38 +221,66 @@ MaybeError DescriptorSetAllocator::AllocateDescriptorPool() {
                                                             nullptr, &*descriptorPool),
                             "CreateDescriptorPool"));
 
-    std::vector<VkDescriptorSetLayout> layouts(mMaxSets, mLayout->GetHandle());
-
-    VkDescriptorSetAllocateInfo allocateInfo;
-    allocateInfo.sType = VK_STRUCTURE_TYPE_DESCRIPTOR_SET_ALLOCATE_INFO;
-    allocateInfo.pNext = nullptr;
-    allocateInfo.descriptorPool = descriptorPool;
-    allocateInfo.descriptorSetCount = mMaxSets;
-    allocateInfo.pSetLayouts = AsVkArray(layouts.data());
-
-    std::vector<VkDescriptorSet> sets(mMaxSets);
-    MaybeError result =
-        CheckVkSuccess(device->fn.AllocateDescriptorSets(device->GetVkDevice(), &allocateInfo,
-                                                         AsVkArray(sets.data())),
-                       "AllocateDescriptorSets");
-    if (result.IsError()) {
-        // On an error we can destroy the pool immediately because no command references it.
-        device->fn.DestroyDescriptorPool(device->GetVkDevice(), descriptorPool, nullptr);
-        DAWN_TRY(std::move(result));
+    PoolIndex poolIndex;
+    if (!mFreeDescriptorPoolSlots.empty()) {
+        poolIndex = mFreeDescriptorPoolSlots.back();
+        mFreeDescriptorPoolSlots.pop_back();
+    } else {
+        poolIndex = static_cast<PoolIndex>(mDescriptorPools.size());
+        mDescriptorPools.emplace_back();
     }
+    mDescriptorPools[poolIndex] = DescriptorPool{descriptorPool, maxSets, 0, 0};
+    mCurrentPoolIndex = poolIndex;
 
-    std::vector<SetIndex> freeSetIndices;
-    freeSetIndices.reserve(mMaxSets);
+    mNextPoolSetCount =
+        static_cast<SetIndex>(std::min<uint32_t>(uint32_t(maxSets) * 2, mMaxSetsPerPool));
 
-    for (SetIndex i = 0; i < mMaxSets; ++i) {
-        freeSetIndices.push_back(i);
+    return {};
+}
+
+void DescriptorSetAllocator::ResetDescriptorPool(PoolIndex poolIndex) {
+    DescriptorPool* pool = &mDescriptorPools[poolIndex];
+    DAWN_ASSERT(pool->liveSets == 0);
+
+    // All the sets of the pool were deallocated and the GPU is done with them so they can be
+    // returned to the pool at once. The only possible return value is VK_SUCCESS.
+    Device* device = ToBackend(GetDevice());
+    device->fn.ResetDescriptorPool(device->GetVkDevice(), pool->vkPool, 0);
+    pool->allocatedSets = 0;
+
+    // The current pool keeps being allocated from, others wait to be reused.
+    if (poolIndex != mCurrentPoolIndex) {
+        mEmptyDescriptorPoolIndices.push_back(poolIndex);
     }
+}
 
-    mAvailableDescriptorPoolIndices.push_back(mDescriptorPools.size());
-    mDescriptorPools.emplace_back(
-        DescriptorPool{descriptorPool, std::move(sets), std::move(freeSetIndices)});
+void DescriptorSetAllocator::TrimEmptyDescriptorPools() {
+    if (mEmptyDescriptorPoolIndices.size() <= 1) {
+        return;
+    }
 
-    return {};
+    // Keep the largest empty pool to absorb the next burst of allocations and destroy the other
+    // ones. Their sets are all deallocated and no longer used by the GPU so they can be destroyed
+    // immediately.
+    auto largest = std::max_element(
+        mEmptyDescriptorPoolIndices.begin(), mEmptyDescriptorPoolIndices.end(),
+        [&](PoolIndex a, PoolIndex b) {
+            return mDescriptorPools[a].maxSets < mDescriptorPools[b].maxSets;
+        });
+    std::swap(*largest, mEmptyDescriptorPoolIndices.front());
+
+    Device* device = ToBackend(GetDevice());
+    for (size_t i = 1; i < mEmptyDescriptorPoolIndices.size(); ++i) {
+        PoolIndex poolIndex = mEmptyDescriptorPoolIndices[i];
+        device->fn.DestroyDescriptorPool(device->GetVkDevice(), mDescriptorPools[poolIndex].vkPool,
+                                         nullptr);
+        mDescriptorPools[poolIndex] = {};
+        mFreeDescriptorPoolSlots.push_back(poolIndex);
+
+        // Fewer sets are needed than what was created, so grow more slowly next time.
+        mNextPoolSetCount = std::max<SetIndex>(mNextPoolSetCount / 2u, mMinSetsPerPool);
+    }
+    mEmptyDescriptorPoolIndices.resize(1);
 }
 
 }  // namespace dawn::native::vulkan
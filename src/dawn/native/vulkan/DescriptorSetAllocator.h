@@ -29,6 +29,7 @@
 #define SRC_DAWN_NATIVE_VULKAN_DESCRIPTORSETALLOCATOR_H_
 
 #include <map>
+#include <optional>
 #include <vector>
 
 #include "dawn/common/SerialQueue.h"
@@ -55,32 +56,60 @@ class DescriptorSetAllocator : public ObjectBase {
     void Deallocate(DescriptorSetAllocation* allocationInfo);
     void FinishDeallocation(ExecutionSerial completedSerial);
 
+    struct Stats {
+        // The number of VkDescriptorPools currently alive.
+        uint32_t poolCount = 0;
+        // The total number of descriptor sets the alive pools can hold.
+        uint64_t setCapacity = 0;
+        // The number of descriptor sets that weren't deallocated yet, or whose deallocation is
+        // still waiting on the GPU.
+        uint64_t setsInUse = 0;
+        // The number of descriptor sets that were deallocated but can't be reused until every
+        // other set of their pool is deallocated too and the pool is reset.
+        uint64_t fragmentedSets = 0;
+    };
+    Stats GetStats() const;
+
   private:
     DescriptorSetAllocator(BindGroupLayout* layout,
                            std::map<VkDescriptorType, uint32_t> descriptorCountPerType);
     ~DescriptorSetAllocator() override;
 
     MaybeError AllocateDescriptorPool();
+    void ResetDescriptorPool(PoolIndex poolIndex);
+    void TrimEmptyDescriptorPools();
 
     const BindGroupLayout* mLayout;
 
-    std::vector<VkDescriptorPoolSize> mPoolSizes;
-    SetIndex mMaxSets;
-
+    // The number of descriptors of each type needed for a single set.
+    std::vector<VkDescriptorPoolSize> mDescriptorCountsPerSet;
+    bool mIsEmptyLayout = false;
+    SetIndex mMinSetsPerPool;
+    SetIndex mMaxSetsPerPool;
+    // The size of the next pool created, which doubles at each creation until it reaches
+    // |mMaxSetsPerPool| and halves when pools are trimmed.
+    SetIndex mNextPoolSetCount;
+
+    // Sets are allocated linearly from a pool and are never individually freed. Instead the pool
+    // is reset when all of its sets have been deallocated.
     struct DescriptorPool {
-        VkDescriptorPool vkPool;
-        std::vector<VkDescriptorSet> sets;
-        std::vector<SetIndex> freeSetIndices;
+        VkDescriptorPool vkPool = VK_NULL_HANDLE;
+        SetIndex maxSets = 0;
+        SetIndex allocatedSets = 0;
+        // The number of allocated sets whose deallocation hasn't completed yet.
+        SetIndex liveSets = 0;
     };
 
-    std::vector<PoolIndex> mAvailableDescriptorPoolIndices;
+    // Pools are referenced by index from DescriptorSetAllocations so the slot of a trimmed pool
+    // stays in |mDescriptorPools| with a null handle until a new pool reuses it.
     std::vector<DescriptorPool> mDescriptorPools;
+    std::vector<PoolIndex> mFreeDescriptorPoolSlots;
+    // Pools that were reset and are waiting to be reused or trimmed.
+    std::vector<PoolIndex> mEmptyDescriptorPoolIndices;
+    // The pool sets are currently allocated from, if any.
+    std::optional<PoolIndex> mCurrentPoolIndex;
 
-    struct Deallocation {
-        PoolIndex poolIndex;
-        SetIndex setIndex;
-    };
-    SerialQueue<ExecutionSerial, Deallocation> mPendingDeallocations;
+    SerialQueue<ExecutionSerial, PoolIndex> mPendingDeallocations;
     ExecutionSerial mLastDeallocationSerial = ExecutionSerial(0);
 };
 
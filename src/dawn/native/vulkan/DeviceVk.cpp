@@ -27,6 +27,8 @@
 
 #include "dawn/native/vulkan/DeviceVk.h"
 
+#include <utility>
+
 #include "dawn/common/Log.h"
 #include "dawn/common/NonCopyable.h"
 #include "dawn/common/Platform.h"
@@ -49,6 +51,7 @@
 #include "dawn/native/vulkan/PipelineLayoutVk.h"
 #include "dawn/native/vulkan/QuerySetVk.h"
 #include "dawn/native/vulkan/QueueVk.h"
+#include "dawn/native/vulkan/RenderBundleVk.h"
 #include "dawn/native/vulkan/RenderPassCache.h"
 #include "dawn/native/vulkan/RenderPipelineVk.h"
 #include "dawn/native/vulkan/ResourceMemoryAllocatorVk.h"
@@ -168,6 +171,17 @@ ResultOrError<Ref<CommandBufferBase>> Device::CreateCommandBuffer(
     const CommandBufferDescriptor* descriptor) {
     return CommandBuffer::Create(encoder, descriptor);
 }
+Ref<RenderBundleBase> Device::CreateRenderBundle(RenderBundleEncoder* encoder,
+                                                 const RenderBundleDescriptor* descriptor,
+                                                 Ref<AttachmentState> attachmentState,
+                                                 bool depthReadOnly,
+                                                 bool stencilReadOnly,
+                                                 RenderPassResourceUsage resourceUsage,
+                                                 IndirectDrawMetadata indirectDrawMetadata) {
+    return AcquireRef(new RenderBundle(encoder, descriptor, std::move(attachmentState),
+                                       depthReadOnly, stencilReadOnly, std::move(resourceUsage),
+                                       std::move(indirectDrawMetadata)));
+}
 Ref<ComputePipelineBase> Device::CreateUninitializedComputePipelineImpl(
     const UnpackedPtr<ComputePipelineDescriptor>& descriptor) {
     return ComputePipeline::CreateUninitialized(this, descriptor);
@@ -570,31 +584,11 @@ MaybeError Device::CopyFromStagingToBufferImpl(BufferBase* source,
                                                BufferBase* destination,
                                                uint64_t destinationOffset,
                                                uint64_t size) {
-    // It is a validation error to do a 0-sized copy in Vulkan, check it is skipped prior to
-    // calling this function.
-    DAWN_ASSERT(size != 0);
-
-    CommandRecordingContext* recordingContext =
-        GetPendingRecordingContext(DeviceBase::SubmitMode::Passive);
-
-    ToBackend(destination)
-        ->EnsureDataInitializedAsDestination(recordingContext, destinationOffset, size);
-
-    // There is no need of a barrier to make host writes available and visible to the copy
-    // operation for HOST_COHERENT memory. The Vulkan spec for vkQueueSubmit describes that it
-    // does an implicit availability, visibility and domain operation.
-
-    // Insert pipeline barrier to ensure correct ordering with previous memory operations on the
-    // buffer.
-    ToBackend(destination)->TransitionUsageNow(recordingContext, wgpu::BufferUsage::CopyDst);
-
-    VkBufferCopy copy;
-    copy.srcOffset = sourceOffset;
-    copy.dstOffset = destinationOffset;
-    copy.size = size;
-
-    this->fn.CmdCopyBuffer(recordingContext->commandBuffer, ToBackend(source)->GetHandle(),
-                           ToBackend(destination)->GetHandle(), 1, &copy);
+    // The copy is batched with the other writes to the destination and recorded the next time
+    // commands are recorded in the pending recording context.
+    ToBackend(GetQueue())
+        ->EnqueueBufferWrite(ToBackend(source), sourceOffset, ToBackend(destination),
+                             destinationOffset, size);
 
     return {};
 }
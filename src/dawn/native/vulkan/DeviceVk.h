@@ -99,6 +99,13 @@ class Device final : public DeviceBase {
     ResultOrError<Ref<CommandBufferBase>> CreateCommandBuffer(
         CommandEncoder* encoder,
         const CommandBufferDescriptor* descriptor) override;
+    Ref<RenderBundleBase> CreateRenderBundle(RenderBundleEncoder* encoder,
+                                             const RenderBundleDescriptor* descriptor,
+                                             Ref<AttachmentState> attachmentState,
+                                             bool depthReadOnly,
+                                             bool stencilReadOnly,
+                                             RenderPassResourceUsage resourceUsage,
+                                             IndirectDrawMetadata indirectDrawMetadata) override;
 
     MaybeError TickImpl() override;
 
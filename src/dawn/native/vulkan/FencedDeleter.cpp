@@ -35,6 +35,7 @@ FencedDeleter::FencedDeleter(Device* device) : mDevice(device) {}
 
 FencedDeleter::~FencedDeleter() {
     DAWN_ASSERT(mBuffersToDelete.Empty());
+    DAWN_ASSERT(mCommandPoolsToDelete.Empty());
     DAWN_ASSERT(mDescriptorPoolsToDelete.Empty());
     DAWN_ASSERT(mFramebuffersToDelete.Empty());
     DAWN_ASSERT(mImagesToDelete.Empty());
@@ -55,6 +56,10 @@ void FencedDeleter::DeleteWhenUnused(VkBuffer buffer) {
     mBuffersToDelete.Enqueue(buffer, mDevice->GetPendingCommandSerial());
 }
 
+void FencedDeleter::DeleteWhenUnused(VkCommandPool pool) {
+    mCommandPoolsToDelete.Enqueue(pool, mDevice->GetPendingCommandSerial());
+}
+
 void FencedDeleter::DeleteWhenUnused(VkDescriptorPool pool) {
     mDescriptorPoolsToDelete.Enqueue(pool, mDevice->GetPendingCommandSerial());
 }
@@ -146,6 +151,12 @@ void FencedDeleter::Tick(ExecutionSerial completedSerial) {
     }
     mFramebuffersToDelete.ClearUpTo(completedSerial);
 
+    // Destroying a command pool frees the command buffers allocated from it.
+    for (VkCommandPool pool : mCommandPoolsToDelete.IterateUpTo(completedSerial)) {
+        mDevice->fn.DestroyCommandPool(vkDevice, pool, nullptr);
+    }
+    mCommandPoolsToDelete.ClearUpTo(completedSerial);
+
     for (VkImageView view : mImageViewsToDelete.IterateUpTo(completedSerial)) {
         mDevice->fn.DestroyImageView(vkDevice, view, nullptr);
     }
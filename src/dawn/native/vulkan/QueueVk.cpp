@@ -27,11 +27,17 @@
 
 #include "dawn/native/vulkan/QueueVk.h"
 
+#include <algorithm>
+#include <memory>
+#include <unordered_set>
+
 #include "dawn/common/Math.h"
+#include "dawn/native/AsyncTask.h"
 #include "dawn/native/Buffer.h"
 #include "dawn/native/CommandValidation.h"
 #include "dawn/native/Commands.h"
 #include "dawn/native/DynamicUploader.h"
+#include "dawn/native/vulkan/BufferVk.h"
 #include "dawn/native/vulkan/CommandBufferVk.h"
 #include "dawn/native/vulkan/CommandRecordingContext.h"
 #include "dawn/native/vulkan/DeviceVk.h"
@@ -85,6 +91,31 @@ void DestroyCommandPoolAndBuffer(const VulkanFunctions& fn,
     }
 }
 
+// Adds [start, end) to the disjoint ranges, merging it with adjacent ranges. Returns false without
+// modifying the ranges if it overlaps one of them.
+bool AddDisjointRange(std::map<uint64_t, uint64_t>* ranges, uint64_t start, uint64_t end) {
+    auto next = ranges->lower_bound(start);
+    if (next != ranges->end() && next->first < end) {
+        return false;
+    }
+    if (next != ranges->begin()) {
+        auto previous = std::prev(next);
+        if (previous->second > start) {
+            return false;
+        }
+        if (previous->second == start) {
+            start = previous->first;
+            ranges->erase(previous);
+        }
+    }
+    if (next != ranges->end() && next->first == end) {
+        end = next->second;
+        ranges->erase(next);
+    }
+    ranges->emplace(start, end);
+    return true;
+}
+
 }  // anonymous namespace
 
 // static
@@ -112,10 +143,19 @@ MaybeError Queue::Initialize() {
 }
 
 MaybeError Queue::SubmitImpl(uint32_t commandCount, CommandBufferBase* const* commands) {
+    // The command buffers recorded concurrently are appended after the pending commands so the
+    // writes they depend on must be recorded first.
+    FlushPendingBufferWrites();
+
     TRACE_EVENT_BEGIN0(GetDevice()->GetPlatform(), Recording, "CommandBufferVk::RecordCommands");
-    CommandRecordingContext* recordingContext = GetPendingRecordingContext();
-    for (uint32_t i = 0; i < commandCount; ++i) {
-        DAWN_TRY(ToBackend(commands[i])->RecordCommands(recordingContext));
+    if (commandCount > 1 &&
+        GetDevice()->IsToggleEnabled(Toggle::VulkanMultithreadedCommandRecording)) {
+        DAWN_TRY(RecordCommandsConcurrently(commandCount, commands));
+    } else {
+        CommandRecordingContext* recordingContext = GetPendingRecordingContext();
+        for (uint32_t i = 0; i < commandCount; ++i) {
+            DAWN_TRY(ToBackend(commands[i])->RecordCommands(recordingContext));
+        }
     }
     TRACE_EVENT_END0(GetDevice()->GetPlatform(), Recording, "CommandBufferVk::RecordCommands");
 
@@ -124,6 +164,174 @@ MaybeError Queue::SubmitImpl(uint32_t commandCount, CommandBufferBase* const* co
     return {};
 }
 
+// The command buffers are split in consecutive groups in which no two command buffers use the
+// same buffer or texture, and the groups are recorded one after the other. The state tracking of a
+// resource, and the barriers computed from it in TransitionAndClearForSyncScope, only depend on
+// the previous uses of that resource. Recording the command buffers of a group concurrently thus
+// produces the same barriers as recording them serially.
+MaybeError Queue::RecordCommandsConcurrently(uint32_t commandCount,
+                                             CommandBufferBase* const* commands) {
+    std::vector<CommandBuffer*> group;
+    std::unordered_set<BufferBase*> groupBuffers;
+    std::unordered_set<TextureBase*> groupTextures;
+
+    auto FlushGroup = [&]() -> MaybeError {
+        DAWN_TRY(RecordCommandBufferGroup(group));
+        group.clear();
+        groupBuffers.clear();
+        groupTextures.clear();
+        return {};
+    };
+
+    std::vector<BufferBase*> buffers;
+    std::vector<TextureBase*> textures;
+    for (uint32_t i = 0; i < commandCount; ++i) {
+        CommandBuffer* commandBuffer = ToBackend(commands[i]);
+
+        buffers.clear();
+        textures.clear();
+        const CommandBufferResourceUsage& usages = commandBuffer->GetResourceUsages();
+        for (const RenderPassResourceUsage& pass : usages.renderPasses) {
+            buffers.insert(buffers.end(), pass.buffers.begin(), pass.buffers.end());
+            textures.insert(textures.end(), pass.textures.begin(), pass.textures.end());
+        }
+        for (const ComputePassResourceUsage& pass : usages.computePasses) {
+            buffers.insert(buffers.end(), pass.referencedBuffers.begin(),
+                           pass.referencedBuffers.end());
+            textures.insert(textures.end(), pass.referencedTextures.begin(),
+                            pass.referencedTextures.end());
+        }
+        buffers.insert(buffers.end(), usages.topLevelBuffers.begin(), usages.topLevelBuffers.end());
+        textures.insert(textures.end(), usages.topLevelTextures.begin(),
+                        usages.topLevelTextures.end());
+
+        bool usesGroupResources =
+            std::any_of(buffers.begin(), buffers.end(),
+                        [&](BufferBase* buffer) { return groupBuffers.count(buffer) != 0; }) ||
+            std::any_of(textures.begin(), textures.end(),
+                        [&](TextureBase* texture) { return groupTextures.count(texture) != 0; });
+        if (usesGroupResources) {
+            DAWN_TRY(FlushGroup());
+        }
+
+        // This must be checked after the previous uses of the resources are recorded since they
+        // can change whether the resources are initialized.
+        if (!commandBuffer->CanRecordCommandsConcurrently()) {
+            DAWN_TRY(FlushGroup());
+            DAWN_TRY(commandBuffer->RecordCommands(GetPendingRecordingContext()));
+            continue;
+        }
+
+        group.push_back(commandBuffer);
+        groupBuffers.insert(buffers.begin(), buffers.end());
+        groupTextures.insert(textures.begin(), textures.end());
+    }
+
+    return FlushGroup();
+}
+
+MaybeError Queue::RecordCommandBufferGroup(const std::vector<CommandBuffer*>& group) {
+    if (group.empty()) {
+        return {};
+    }
+    if (group.size() == 1) {
+        return group[0]->RecordCommands(GetPendingRecordingContext());
+    }
+
+    Device* device = ToBackend(GetDevice());
+
+    // Command pools must be externally synchronized, so each command buffer is recorded in a
+    // VkCommandBuffer allocated from its own pool.
+    std::vector<CommandRecordingContext> contexts(group.size());
+    auto RecycleCommands = [&] {
+        for (CommandRecordingContext& context : contexts) {
+            if (context.commandPool != VK_NULL_HANDLE) {
+                mUnusedCommands.push_back({context.commandPool, context.commandBuffer});
+            }
+        }
+    };
+    for (CommandRecordingContext& context : contexts) {
+        CommandPoolAndBuffer commands;
+        DAWN_TRY_ASSIGN_WITH_CLEANUP(commands, BeginVkCommandBuffer(), { RecycleCommands(); });
+        context.commandBuffer = commands.commandBuffer;
+        context.commandPool = commands.pool;
+        context.used = true;
+    }
+
+    // The first command buffer is recorded on the current thread, which then helps with the
+    // command buffers that no worker started recording yet.
+    std::vector<MaybeError> results(group.size());
+    std::vector<Ref<AsyncTaskHandle>> tasks;
+    for (size_t i = 1; i < group.size(); ++i) {
+        tasks.push_back(device->GetAsyncTaskManager()->PostTask(
+            [&, i] { results[i] = group[i]->RecordCommands(&contexts[i]); },
+            dawn::platform::TaskPriority::High));
+    }
+    results[0] = group[0]->RecordCommands(&contexts[0]);
+    for (Ref<AsyncTaskHandle>& task : tasks) {
+        if (!task->RunNow()) {
+            task->Wait();
+        }
+    }
+
+    std::unique_ptr<ErrorData> error;
+    for (MaybeError& result : results) {
+        if (result.IsError()) {
+            std::unique_ptr<ErrorData> resultError = result.AcquireError();
+            if (error == nullptr) {
+                error = std::move(resultError);
+            }
+        }
+    }
+    if (error != nullptr) {
+        RecycleCommands();
+        return std::move(error);
+    }
+
+    for (CommandRecordingContext& context : contexts) {
+        // Command buffers that would split their recording context can't be recorded
+        // concurrently, so each context still has a single VkCommandBuffer.
+        DAWN_ASSERT(context.commandBufferList.empty());
+        DAWN_TRY_WITH_CLEANUP(CheckVkSuccess(device->fn.EndCommandBuffer(context.commandBuffer),
+                                             "vkEndCommandBuffer"),
+                              { RecycleCommands(); });
+    }
+
+    // Append the group's command buffers after the commands already pending, and start a new
+    // command buffer for the commands recorded after the group.
+    CommandRecordingContext* recordingContext = GetPendingRecordingContext();
+    DAWN_TRY_WITH_CLEANUP(
+        CheckVkSuccess(device->fn.EndCommandBuffer(recordingContext->commandBuffer),
+                       "vkEndCommandBuffer"),
+        { RecycleCommands(); });
+    for (CommandRecordingContext& context : contexts) {
+        recordingContext->commandBufferList.push_back(context.commandBuffer);
+        recordingContext->commandPoolList.push_back(context.commandPool);
+
+        recordingContext->waitSemaphores.insert(recordingContext->waitSemaphores.end(),
+                                                context.waitSemaphores.begin(),
+                                                context.waitSemaphores.end());
+        recordingContext->signalSemaphores.insert(recordingContext->signalSemaphores.end(),
+                                                  context.signalSemaphores.begin(),
+                                                  context.signalSemaphores.end());
+        recordingContext->externalTexturesForEagerTransition.insert(
+            context.externalTexturesForEagerTransition.begin(),
+            context.externalTexturesForEagerTransition.end());
+        recordingContext->mappableBuffersForEagerTransition.insert(
+            context.mappableBuffersForEagerTransition.begin(),
+            context.mappableBuffersForEagerTransition.end());
+    }
+
+    CommandPoolAndBuffer commands;
+    DAWN_TRY_ASSIGN(commands, BeginVkCommandBuffer());
+    recordingContext->commandBuffer = commands.commandBuffer;
+    recordingContext->commandPool = commands.pool;
+    recordingContext->commandBufferList.push_back(commands.commandBuffer);
+    recordingContext->commandPoolList.push_back(commands.pool);
+
+    return {};
+}
+
 void Queue::SetLabelImpl() {
     Device* device = ToBackend(GetDevice());
     // TODO(crbug.com/dawn/1344): When we start using multiple queues this needs to be adjusted
@@ -170,10 +378,13 @@ ResultOrError<ExecutionSerial> Queue::CheckAndUpdateCompletedSerials() {
 }
 
 void Queue::ForceEventualFlushOfCommands() {
-    mRecordingContext.needsSubmit |= mRecordingContext.used;
+    mRecordingContext.needsSubmit |= mRecordingContext.used || HasPendingBufferWrites();
 }
 
 MaybeError Queue::WaitForIdleForDestruction() {
+    mPendingBufferWrites.clear();
+    mPendingBufferWriteIndices.clear();
+
     // Immediately tag the recording context as unused so we don't try to submit it in Tick.
     // Move the mRecordingContext.used to mUnusedCommands so it can be cleaned up in
     // ShutDownImpl
@@ -230,6 +441,8 @@ MaybeError Queue::WaitForIdleForDestruction() {
 
 CommandRecordingContext* Queue::GetPendingRecordingContext(Device::SubmitMode submitMode) {
     DAWN_ASSERT(mRecordingContext.commandBuffer != VK_NULL_HANDLE);
+    // Commands recorded by the caller might depend on the pending writes.
+    FlushPendingBufferWrites();
     mRecordingContext.needsSubmit |= (submitMode == DeviceBase::SubmitMode::Normal);
     mRecordingContext.used = true;
     return &mRecordingContext;
@@ -334,7 +547,113 @@ void Queue::RecycleCompletedCommands(ExecutionSerial completedSerial) {
     mCommandsInFlight.ClearUpTo(completedSerial);
 }
 
+void Queue::EnqueueBufferWrite(Buffer* source,
+                               uint64_t sourceOffset,
+                               Buffer* destination,
+                               uint64_t destinationOffset,
+                               uint64_t size) {
+    // It is a validation error to do a 0-sized copy in Vulkan, check it is skipped prior to
+    // calling this function.
+    DAWN_ASSERT(size != 0);
+
+    auto [indexIt, inserted] =
+        mPendingBufferWriteIndices.try_emplace(destination, mPendingBufferWrites.size());
+    if (inserted) {
+        mPendingBufferWrites.push_back({destination, {}, {}});
+    }
+    PendingBufferWrites* writes = &mPendingBufferWrites[indexIt->second];
+
+    // The regions of a vkCmdCopyBuffer are copied in no particular order, so a write overlapping
+    // a pending one can't be batched with it. Record the pending writes first instead.
+    uint64_t destinationEnd = destinationOffset + size;
+    if (!AddDisjointRange(&writes->writtenRanges, destinationOffset, destinationEnd)) {
+        FlushPendingBufferWrites(writes);
+        [[maybe_unused]] bool added =
+            AddDisjointRange(&writes->writtenRanges, destinationOffset, destinationEnd);
+        DAWN_ASSERT(added);
+    }
+
+    auto sourceIt = std::find_if(writes->copies.rbegin(), writes->copies.rend(),
+                                 [&](const auto& copies) { return copies.first.Get() == source; });
+    if (sourceIt == writes->copies.rend()) {
+        writes->copies.emplace_back(source, std::vector<VkBufferCopy>());
+        sourceIt = writes->copies.rbegin();
+    }
+
+    std::vector<VkBufferCopy>* regions = &sourceIt->second;
+    if (!regions->empty()) {
+        VkBufferCopy* last = &regions->back();
+        if (last->srcOffset + last->size == sourceOffset &&
+            last->dstOffset + last->size == destinationOffset) {
+            last->size += size;
+            return;
+        }
+    }
+
+    VkBufferCopy copy;
+    copy.srcOffset = sourceOffset;
+    copy.dstOffset = destinationOffset;
+    copy.size = size;
+    regions->push_back(copy);
+}
+
+bool Queue::HasPendingBufferWrites() const {
+    return !mPendingBufferWrites.empty();
+}
+
+void Queue::FlushPendingBufferWrites() {
+    if (mPendingBufferWrites.empty()) {
+        return;
+    }
+
+    for (PendingBufferWrites& writes : mPendingBufferWrites) {
+        FlushPendingBufferWrites(&writes);
+    }
+    mPendingBufferWrites.clear();
+    mPendingBufferWriteIndices.clear();
+}
+
+void Queue::FlushPendingBufferWrites(PendingBufferWrites* writes) {
+    Buffer* destination = writes->destination.Get();
+    // The destination might have been destroyed after the writes were enqueued.
+    if (writes->copies.empty() || destination->GetHandle() == VK_NULL_HANDLE) {
+        writes->copies.clear();
+        writes->writtenRanges.clear();
+        return;
+    }
+
+    Device* device = ToBackend(GetDevice());
+    DAWN_ASSERT(mRecordingContext.commandBuffer != VK_NULL_HANDLE);
+    // The writes are recorded directly instead of with GetPendingRecordingContext so that they
+    // don't make the pending commands need a submit, like other staging copies.
+    CommandRecordingContext* recordingContext = &mRecordingContext;
+    recordingContext->used = true;
+
+    for (const auto& [start, end] : writes->writtenRanges) {
+        destination->EnsureDataInitializedAsDestination(recordingContext, start, end - start);
+    }
+
+    // There is no need of a barrier to make host writes available and visible to the copy
+    // operation for HOST_COHERENT memory. The Vulkan spec for vkQueueSubmit describes that it
+    // does an implicit availability, visibility and domain operation.
+
+    // Insert pipeline barrier to ensure correct ordering with previous memory operations on the
+    // buffer. The regions are disjoint so no barrier is needed between the copies.
+    destination->TransitionUsageNow(recordingContext, wgpu::BufferUsage::CopyDst);
+
+    for (const auto& [source, regions] : writes->copies) {
+        device->fn.CmdCopyBuffer(recordingContext->commandBuffer, source->GetHandle(),
+                                 destination->GetHandle(), static_cast<uint32_t>(regions.size()),
+                                 regions.data());
+    }
+
+    writes->copies.clear();
+    writes->writtenRanges.clear();
+}
+
 MaybeError Queue::SubmitPendingCommands() {
+    FlushPendingBufferWrites();
+
     if (!mRecordingContext.needsSubmit) {
         return {};
     }
@@ -484,6 +803,9 @@ void Queue::DestroyImpl() {
     Device* device = ToBackend(GetDevice());
     VkDevice vkDevice = device->GetVkDevice();
 
+    mPendingBufferWrites.clear();
+    mPendingBufferWriteIndices.clear();
+
     // Immediately tag the recording context as unused so we don't try to submit it in Tick.
     mRecordingContext.needsSubmit = false;
     if (mRecordingContext.commandPool != VK_NULL_HANDLE) {
@@ -29,6 +29,8 @@
 #define SRC_DAWN_NATIVE_VULKAN_QUEUEVK_H_
 
 #include <deque>
+#include <map>
+#include <unordered_map>
 #include <utility>
 #include <vector>
 
@@ -40,6 +42,8 @@
 
 namespace dawn::native::vulkan {
 
+class Buffer;
+class CommandBuffer;
 class Device;
 
 class Queue final : public QueueBase {
@@ -57,6 +61,16 @@ class Queue final : public QueueBase {
 
     void RecycleCompletedCommands(ExecutionSerial completedSerial);
 
+    // Defers a copy from a staging buffer until commands are next recorded in the pending
+    // recording context, so that all the pending writes to a buffer are done with a single
+    // barrier and as few vkCmdCopyBuffer as possible.
+    void EnqueueBufferWrite(Buffer* source,
+                            uint64_t sourceOffset,
+                            Buffer* destination,
+                            uint64_t destinationOffset,
+                            uint64_t size);
+    bool HasPendingBufferWrites() const;
+
     ResultOrError<bool> WaitForQueueSerial(ExecutionSerial serial, Nanoseconds timeout) override;
 
   private:
@@ -89,6 +103,29 @@ class Queue final : public QueueBase {
     MaybeError PrepareRecordingContext();
     ResultOrError<CommandPoolAndBuffer> BeginVkCommandBuffer();
 
+    // Used instead of recording all the command buffers serially in the pending recording context
+    // when the VulkanMultithreadedCommandRecording toggle is enabled.
+    MaybeError RecordCommandsConcurrently(uint32_t commandCount,
+                                          CommandBufferBase* const* commands);
+    // Records command buffers that don't use any resource in common, each in its own
+    // VkCommandBuffer on a worker thread, then appends them in order to the pending commands.
+    MaybeError RecordCommandBufferGroup(const std::vector<CommandBuffer*>& group);
+
+    struct PendingBufferWrites {
+        Ref<Buffer> destination;
+        // The copies from each staging buffer. Copies contiguous in both the staging buffer and
+        // the destination are merged into a single region.
+        std::vector<std::pair<Ref<Buffer>, std::vector<VkBufferCopy>>> copies;
+        // The disjoint ranges of the destination written by the copies, as [start, end) indexed
+        // by their start. Adjacent ranges are merged.
+        std::map<uint64_t, uint64_t> writtenRanges;
+    };
+    void FlushPendingBufferWrites();
+    void FlushPendingBufferWrites(PendingBufferWrites* writes);
+
+    std::vector<PendingBufferWrites> mPendingBufferWrites;
+    std::unordered_map<Buffer*, size_t> mPendingBufferWriteIndices;
+
     SerialQueue<ExecutionSerial, CommandPoolAndBuffer> mCommandsInFlight;
     // Command pools in the unused list haven't been reset yet.
     std::vector<CommandPoolAndBuffer> mUnusedCommands;
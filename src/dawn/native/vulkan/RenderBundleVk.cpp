@@ -0,0 +1,230 @@
+// Copyright 2024 The Dawn & Tint Authors
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+//
+// 1. Redistributions of source code must retain the above copyright notice, this
+//    list of conditions and the following disclaimer.
+//
+// 2. Redistributions in binary form must reproduce the above copyright notice,
+//    this list of conditions and the following disclaimer in the documentation
+//    and/or other materials provided with the distribution.
+//
+// 3. Neither the name of the copyright holder nor the names of its
+//    contributors may be used to endorse or promote products derived from
+//    this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+// DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+// FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+// DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+// SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+// CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+// OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+// OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+
+#include "dawn/native/vulkan/RenderBundleVk.h"
+
+#include <algorithm>
+#include <utility>
+
+#include "dawn/common/BitSetIterator.h"
+#include "dawn/native/Commands.h"
+#include "dawn/native/vulkan/DeviceVk.h"
+#include "dawn/native/vulkan/FencedDeleter.h"
+#include "dawn/native/vulkan/QueueVk.h"
+#include "dawn/native/vulkan/RenderPassCache.h"
+#include "dawn/native/vulkan/VulkanError.h"
+
+namespace dawn::native::vulkan {
+
+namespace {
+
+// Bundles are usually executed in render passes of a single size, but keep a few command buffers
+// so that alternating between sizes, for example for a shadow map and the main pass, doesn't
+// re-record them every time.
+constexpr size_t kMaxSecondaryCommandBuffersPerBundle = 4;
+
+}  // anonymous namespace
+
+RenderBundle::RenderBundle(RenderBundleEncoder* encoder,
+                           const RenderBundleDescriptor* descriptor,
+                           Ref<AttachmentState> attachmentState,
+                           bool depthReadOnly,
+                           bool stencilReadOnly,
+                           RenderPassResourceUsage resourceUsage,
+                           IndirectDrawMetadata indirectDrawMetadata)
+    : RenderBundleBase(encoder,
+                       descriptor,
+                       std::move(attachmentState),
+                       depthReadOnly,
+                       stencilReadOnly,
+                       std::move(resourceUsage),
+                       std::move(indirectDrawMetadata)) {
+    if (!GetDevice()->IsToggleEnabled(
+            Toggle::VulkanRecordRenderBundlesInSecondaryCommandBuffers)) {
+        mCanUseSecondaryCommandBuffers = false;
+        return;
+    }
+
+    CommandIterator* commands = GetCommands();
+    Command type;
+    while (commands->NextCommandId(&type)) {
+        if (type == Command::DrawIndirect || type == Command::DrawIndexedIndirect) {
+            mCanUseSecondaryCommandBuffers = false;
+            break;
+        }
+        SkipCommand(commands, type);
+    }
+    commands->Reset();
+}
+
+RenderBundle::~RenderBundle() = default;
+
+void RenderBundle::DestroyImpl() {
+    RenderBundleBase::DestroyImpl();
+
+    mSecondaryCommandBuffers.Use([&](auto buffers) {
+        // Destroying the pool frees all the command buffers allocated from it, including the
+        // evicted ones that are still pending.
+        if (buffers->pool != VK_NULL_HANDLE) {
+            ToBackend(GetDevice())->GetFencedDeleter()->DeleteWhenUnused(buffers->pool);
+            buffers->pool = VK_NULL_HANDLE;
+        }
+        buffers->recorded.clear();
+        buffers->evicted.Clear();
+    });
+}
+
+bool RenderBundle::CanUseSecondaryCommandBuffers() const {
+    return mCanUseSecondaryCommandBuffers;
+}
+
+ResultOrError<VkCommandBuffer> RenderBundle::GetOrRecordSecondaryCommandBuffer(
+    uint32_t width,
+    uint32_t height,
+    const RecordFn& record) {
+    DAWN_ASSERT(mCanUseSecondaryCommandBuffers);
+
+    Device* device = ToBackend(GetDevice());
+    VkDevice vkDevice = device->GetVkDevice();
+
+    // Look for the render pass compatible with the bundle before locking since it can't change.
+    VkRenderPass renderPass;
+    DAWN_TRY_ASSIGN(renderPass, GetCompatibleRenderPass());
+
+    return mSecondaryCommandBuffers.Use([&](auto buffers) -> ResultOrError<VkCommandBuffer> {
+        // Free the evicted command buffers that the GPU is done with.
+        ExecutionSerial completedSerial =
+            ToBackend(device->GetQueue())->GetCompletedCommandSerial();
+        for (VkCommandBuffer commands : buffers->evicted.IterateUpTo(completedSerial)) {
+            device->fn.FreeCommandBuffers(vkDevice, buffers->pool, 1, &commands);
+        }
+        buffers->evicted.ClearUpTo(completedSerial);
+
+        auto it = std::find_if(buffers->recorded.begin(), buffers->recorded.end(),
+                               [&](const SecondaryCommandBuffer& recorded) {
+                                   return recorded.width == width && recorded.height == height;
+                               });
+        if (it != buffers->recorded.end()) {
+            SecondaryCommandBuffer found = *it;
+            buffers->recorded.erase(it);
+            buffers->recorded.push_back(found);
+            return found.commands;
+        }
+
+        if (buffers->pool == VK_NULL_HANDLE) {
+            // The pool isn't transient since its command buffers are executed many times.
+            VkCommandPoolCreateInfo createInfo;
+            createInfo.sType = VK_STRUCTURE_TYPE_COMMAND_POOL_CREATE_INFO;
+            createInfo.pNext = nullptr;
+            createInfo.flags = 0;
+            createInfo.queueFamilyIndex = device->GetGraphicsQueueFamily();
+
+            DAWN_TRY(CheckVkSuccess(
+                device->fn.CreateCommandPool(vkDevice, &createInfo, nullptr, &*buffers->pool),
+                "vkCreateCommandPool"));
+        }
+
+        if (buffers->recorded.size() == kMaxSecondaryCommandBuffersPerBundle) {
+            // The least recently used command buffer may still be used by commands that are
+            // submitted or currently being recorded.
+            buffers->evicted.Enqueue(buffers->recorded.front().commands,
+                                     device->GetPendingCommandSerial());
+            buffers->recorded.erase(buffers->recorded.begin());
+        }
+
+        VkCommandBufferAllocateInfo allocateInfo;
+        allocateInfo.sType = VK_STRUCTURE_TYPE_COMMAND_BUFFER_ALLOCATE_INFO;
+        allocateInfo.pNext = nullptr;
+        allocateInfo.commandPool = buffers->pool;
+        allocateInfo.level = VK_COMMAND_BUFFER_LEVEL_SECONDARY;
+        allocateInfo.commandBufferCount = 1;
+
+        VkCommandBuffer commands;
+        DAWN_TRY(
+            CheckVkSuccess(device->fn.AllocateCommandBuffers(vkDevice, &allocateInfo, &commands),
+                           "vkAllocateCommandBuffers"));
+
+        VkCommandBufferInheritanceInfo inheritanceInfo;
+        inheritanceInfo.sType = VK_STRUCTURE_TYPE_COMMAND_BUFFER_INHERITANCE_INFO;
+        inheritanceInfo.pNext = nullptr;
+        inheritanceInfo.renderPass = renderPass;
+        inheritanceInfo.subpass = 0;
+        inheritanceInfo.framebuffer = VK_NULL_HANDLE;
+        inheritanceInfo.occlusionQueryEnable = VK_FALSE;
+        inheritanceInfo.queryFlags = 0;
+        inheritanceInfo.pipelineStatistics = 0;
+
+        // The same command buffer can be executed by several pending primary command buffers, or
+        // several times in the same one.
+        VkCommandBufferBeginInfo beginInfo;
+        beginInfo.sType = VK_STRUCTURE_TYPE_COMMAND_BUFFER_BEGIN_INFO;
+        beginInfo.pNext = nullptr;
+        beginInfo.flags = VK_COMMAND_BUFFER_USAGE_RENDER_PASS_CONTINUE_BIT |
+                          VK_COMMAND_BUFFER_USAGE_SIMULTANEOUS_USE_BIT;
+        beginInfo.pInheritanceInfo = &inheritanceInfo;
+
+        MaybeError result = CheckVkSuccess(device->fn.BeginCommandBuffer(commands, &beginInfo),
+                                           "vkBeginCommandBuffer");
+        if (!result.IsError()) {
+            result = record(commands);
+        }
+        if (!result.IsError()) {
+            result = CheckVkSuccess(device->fn.EndCommandBuffer(commands), "vkEndCommandBuffer");
+        }
+        if (result.IsError()) {
+            // The command buffer was never executed so it can be freed immediately.
+            device->fn.FreeCommandBuffers(vkDevice, buffers->pool, 1, &commands);
+            DAWN_TRY(std::move(result));
+        }
+
+        buffers->recorded.push_back({width, height, commands});
+        return commands;
+    });
+}
+
+ResultOrError<VkRenderPass> RenderBundle::GetCompatibleRenderPass() const {
+    // Render passes with a single subpass are compatible as long as their attachments have the
+    // same formats and sample counts, regardless of their load and store operations, layouts and
+    // resolve attachments. Query the same render pass as RenderPipeline does.
+    const AttachmentState* attachmentState = GetAttachmentState();
+
+    RenderPassCacheQuery query;
+    for (auto i : IterateBitSet(attachmentState->GetColorAttachmentsMask())) {
+        query.SetColor(i, attachmentState->GetColorAttachmentFormat(i), wgpu::LoadOp::Load,
+                       wgpu::StoreOp::Store, false);
+    }
+    if (attachmentState->HasDepthStencilAttachment()) {
+        query.SetDepthStencil(attachmentState->GetDepthStencilFormat(), wgpu::LoadOp::Load,
+                              wgpu::StoreOp::Store, false, wgpu::LoadOp::Load,
+                              wgpu::StoreOp::Store, false);
+    }
+    query.SetSampleCount(attachmentState->GetSampleCount());
+
+    return ToBackend(GetDevice())->GetRenderPassCache()->GetRenderPass(query);
+}
+
+}  // namespace dawn::native::vulkan
@@ -0,0 +1,104 @@
+// Copyright 2024 The Dawn & Tint Authors
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+//
+// 1. Redistributions of source code must retain the above copyright notice, this
+//    list of conditions and the following disclaimer.
+//
+// 2. Redistributions in binary form must reproduce the above copyright notice,
+//    this list of conditions and the following disclaimer in the documentation
+//    and/or other materials provided with the distribution.
+//
+// 3. Neither the name of the copyright holder nor the names of its
+//    contributors may be used to endorse or promote products derived from
+//    this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+// DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+// FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+// DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+// SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+// CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+// OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+// OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+
+#ifndef SRC_DAWN_NATIVE_VULKAN_RENDERBUNDLEVK_H_
+#define SRC_DAWN_NATIVE_VULKAN_RENDERBUNDLEVK_H_
+
+#include <functional>
+#include <vector>
+
+#include "dawn/common/MutexProtected.h"
+#include "dawn/common/SerialQueue.h"
+#include "dawn/common/vulkan_platform.h"
+#include "dawn/native/Error.h"
+#include "dawn/native/IntegerTypes.h"
+#include "dawn/native/RenderBundle.h"
+
+namespace dawn::native::vulkan {
+
+class Device;
+
+// Render bundles are encoded in the frontend. When the
+// VulkanRecordRenderBundlesInSecondaryCommandBuffers toggle is enabled, the Vulkan backend also
+// records their commands once in secondary command buffers that are executed with
+// vkCmdExecuteCommands, instead of encoding the commands again every time the bundle is executed.
+class RenderBundle final : public RenderBundleBase {
+  public:
+    RenderBundle(RenderBundleEncoder* encoder,
+                 const RenderBundleDescriptor* descriptor,
+                 Ref<AttachmentState> attachmentState,
+                 bool depthReadOnly,
+                 bool stencilReadOnly,
+                 RenderPassResourceUsage resourceUsage,
+                 IndirectDrawMetadata indirectDrawMetadata);
+
+    // Indirect draws can't be recorded ahead of time because their indirect buffer is replaced
+    // with the output of the indirect draw validation every time the bundle is executed.
+    bool CanUseSecondaryCommandBuffers() const;
+
+    // Records the bundle's commands, including the default dynamic state of a render pass with
+    // the given size, in the secondary command buffer |commands|.
+    using RecordFn = std::function<MaybeError(VkCommandBuffer commands)>;
+
+    // Returns a secondary command buffer with the bundle's commands that can be executed in render
+    // passes of |width| x |height| that are compatible with the bundle's AttachmentState. The
+    // command buffer is recorded with |record| the first time, then reused.
+    ResultOrError<VkCommandBuffer> GetOrRecordSecondaryCommandBuffer(uint32_t width,
+                                                                     uint32_t height,
+                                                                     const RecordFn& record);
+
+  private:
+    ~RenderBundle() override;
+
+    void DestroyImpl() override;
+
+    ResultOrError<VkRenderPass> GetCompatibleRenderPass() const;
+
+    bool mCanUseSecondaryCommandBuffers = true;
+
+    // The secondary command buffers depend on the size of the render pass because the default
+    // viewport and scissor are recorded in them, since dynamic state isn't inherited from the
+    // primary command buffer.
+    struct SecondaryCommandBuffer {
+        uint32_t width;
+        uint32_t height;
+        VkCommandBuffer commands;
+    };
+    struct SecondaryCommandBuffers {
+        VkCommandPool pool = VK_NULL_HANDLE;
+        // Sorted from the least to the most recently used.
+        std::vector<SecondaryCommandBuffer> recorded;
+        // Command buffers evicted from |recorded| that are freed once the GPU is done with them.
+        SerialQueue<ExecutionSerial, VkCommandBuffer> evicted;
+    };
+    // Command buffers that contain the bundle can be recorded concurrently.
+    MutexProtected<SecondaryCommandBuffers> mSecondaryCommandBuffers;
+};
+
+}  // namespace dawn::native::vulkan
+
+#endif  // SRC_DAWN_NATIVE_VULKAN_RENDERBUNDLEVK_H_
@@ -391,13 +391,29 @@ MaybeError RenderPipeline::Initialize() {
         return {};
     };
 
+    bool hasFragmentStage = GetStageMask() & wgpu::ShaderStage::Fragment;
+    bool clampFragDepth = hasFragmentStage && UsesFragDepth() && !HasUnclippedDepth();
+
+    // When both stages come from the same shader module, compile them in parallel first so that
+    // AddShaderStage only has to look them up in the module's cache.
+    if (hasFragmentStage && GetStage(SingleShaderStage::Vertex).module.Get() ==
+                                GetStage(SingleShaderStage::Fragment).module.Get()) {
+        std::vector<ShaderModule::HandleAndSpirvRequest> requests = {
+            {SingleShaderStage::Vertex, &GetStage(SingleShaderStage::Vertex), layout,
+             /*clampFragDepth*/ false, /* fullSubgroups */ {}},
+            {SingleShaderStage::Fragment, &GetStage(SingleShaderStage::Fragment), layout,
+             clampFragDepth, /* fullSubgroups */ {}},
+        };
+        DAWN_TRY(ToBackend(GetStage(SingleShaderStage::Vertex).module)
+                     ->PrepareHandlesAndSpirv(requests));
+    }
+
     // Add the vertex stage that's always present.
     DAWN_TRY(AddShaderStage(SingleShaderStage::Vertex, VK_SHADER_STAGE_VERTEX_BIT,
                             /*clampFragDepth*/ false));
 
     // Add the fragment stage if present.
-    if (GetStageMask() & wgpu::ShaderStage::Fragment) {
-        bool clampFragDepth = UsesFragDepth() && !HasUnclippedDepth();
+    if (hasFragmentStage) {
         DAWN_TRY(AddShaderStage(SingleShaderStage::Fragment, VK_SHADER_STAGE_FRAGMENT_BIT,
                                 clampFragDepth));
     }
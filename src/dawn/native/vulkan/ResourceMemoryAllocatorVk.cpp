@@ -30,26 +30,42 @@
 #include <algorithm>
 #include <utility>
 
-#include "dawn/common/Math.h"
-#include "dawn/native/BuddyMemoryAllocator.h"
 #include "dawn/native/ResourceHeapAllocator.h"
+#include "dawn/native/TLSFMemoryAllocator.h"
 #include "dawn/native/vulkan/DeviceVk.h"
 #include "dawn/native/vulkan/FencedDeleter.h"
 #include "dawn/native/vulkan/ResourceHeapVk.h"
 #include "dawn/native/vulkan/VulkanError.h"
+#include "dawn/platform/DawnPlatform.h"
+#include "dawn/platform/tracing/TraceEvent.h"
 
 namespace dawn::native::vulkan {
 
 namespace {
 
-// TODO(crbug.com/dawn/849): This is a hardcoded heurstic to choose when to
-// suballocate but it should ideally depend on the size of the memory heaps and other
-// factors.
-constexpr uint64_t kMaxSizeForSubAllocation = 4ull * 1024ull * 1024ull;  // 4MiB
+constexpr uint64_t kMiB = 1024ull * 1024ull;
+constexpr uint64_t kGiB = 1024ull * kMiB;
+
+// The heaps resources are sub-allocated in are pooled when they become empty so that they can be
+// recycled without calling vkAllocateMemory again. Heaps that weren't reused for this many
+// completed serials are freed so that a past peak of memory usage doesn't stay allocated forever.
+constexpr ExecutionSerial kPooledHeapTrimInterval = ExecutionSerial(16);
+
+// TODO(crbug.com/dawn/849): This is a hardcoded heuristic to choose the size of the heaps
+// resources are sub-allocated in, based only on the size of the memory heap. Adapters with a lot
+// of memory use larger heaps so that fewer vkAllocateMemory calls are made and larger resources
+// can be sub-allocated.
+VkDeviceSize ComputeSubAllocationHeapSize(VkDeviceSize memoryHeapSize) {
+    VkDeviceSize heapSize = 8 * kMiB;
+    if (memoryHeapSize >= 8 * kGiB) {
+        heapSize = 256 * kMiB;
+    } else if (memoryHeapSize >= 2 * kGiB) {
+        heapSize = 64 * kMiB;
+    }
 
-// Have each bucket of the buddy system allocate at least some resource of the maximum
-// size
-constexpr uint64_t kBuddyHeapsSize = 2 * kMaxSizeForSubAllocation;
+    // Take the min in the very unlikely case the memory heap is tiny.
+    return std::min(heapSize, memoryHeapSize);
+}
 
 bool IsMemoryKindMappable(MemoryKind memoryKind) {
     switch (memoryKind) {
@@ -69,7 +85,7 @@ bool IsMemoryKindMappable(MemoryKind memoryKind) {
 
 }  // anonymous namespace
 
-// SingleTypeAllocator is a combination of a BuddyMemoryAllocator and its client and can
+// SingleTypeAllocator is a combination of a TLSFMemoryAllocator and its client and can
 // service suballocation requests, but for a single Vulkan memory type.
 
 class ResourceMemoryAllocator::SingleTypeAllocator : public ResourceHeapAllocator {
@@ -79,28 +95,47 @@ class ResourceMemoryAllocator::SingleTypeAllocator : public ResourceHeapAllocato
           mMemoryTypeIndex(memoryTypeIndex),
           mMemoryHeapSize(memoryHeapSize),
           mPooledMemoryAllocator(this),
-          mBuddySystem(
-              // Round down to a power of 2 that's <= mMemoryHeapSize. This will always
-              // be a multiple of kBuddyHeapsSize because kBuddyHeapsSize is a power of 2.
-              uint64_t(1) << Log2(mMemoryHeapSize),
-              // Take the min in the very unlikely case the memory heap is tiny.
-              std::min(uint64_t(1) << Log2(mMemoryHeapSize), kBuddyHeapsSize),
-              &mPooledMemoryAllocator) {
-        DAWN_ASSERT(IsPowerOfTwo(kBuddyHeapsSize));
-    }
+          mSubAllocator(ComputeSubAllocationHeapSize(memoryHeapSize), &mPooledMemoryAllocator) {}
     ~SingleTypeAllocator() override = default;
 
     void DestroyPool() { mPooledMemoryAllocator.DestroyPool(); }
+    void TrimPool() { mPooledMemoryAllocator.TrimPool(); }
+
+    // Have each heap hold at least two resources of the maximum size so that the space left
+    // after one of them isn't always wasted.
+    uint64_t GetMaxSizeForSubAllocation() const { return mSubAllocator.GetHeapSize() / 2; }
 
     ResultOrError<ResourceMemoryAllocation> AllocateMemory(uint64_t size, uint64_t alignment) {
-        return mBuddySystem.Allocate(size, alignment);
+        mUsageChanged = true;
+        return mSubAllocator.Allocate(size, alignment);
     }
 
     void DeallocateMemory(const ResourceMemoryAllocation& allocation) {
-        mBuddySystem.Deallocate(allocation);
+        mUsageChanged = true;
+        mSubAllocator.Deallocate(allocation);
+    }
+
+    // Records the size of the heaps, how much of them is used and how fragmented the rest is as
+    // trace counters for this memory type.
+    void ReportUsageIfChanged() {
+        if (!mUsageChanged) {
+            return;
+        }
+        mUsageChanged = false;
+
+        const TLSFMemoryAllocator::Usage usage = mSubAllocator.ComputeUsage();
+        const uint64_t freeSize = usage.heapSize - usage.usedSize;
+        const uint64_t fragmentationPercent =
+            freeSize == 0 ? 0 : 100 - usage.largestFreeBlockSize * 100 / freeSize;
+
+        dawn::platform::Platform* platform = mDevice->GetPlatform();
+        TRACE_COUNTER_ID2(platform, General, "VulkanSubAllocatedMemoryKiB", mMemoryTypeIndex,
+                          "heaps", usage.heapSize / 1024, "used", usage.usedSize / 1024);
+        TRACE_COUNTER_ID1(platform, General, "VulkanSubAllocatedMemoryFragmentation",
+                          mMemoryTypeIndex, fragmentationPercent);
     }
 
-    // Implementation of the MemoryAllocator interface to be a client of BuddyMemoryAllocator
+    // Implementation of the MemoryAllocator interface to be a client of TLSFMemoryAllocator
 
     ResultOrError<std::unique_ptr<ResourceHeapBase>> AllocateResourceHeap(uint64_t size) override {
         if (size > mMemoryHeapSize) {
@@ -134,7 +169,8 @@ class ResourceMemoryAllocator::SingleTypeAllocator : public ResourceHeapAllocato
     size_t mMemoryTypeIndex;
     VkDeviceSize mMemoryHeapSize;
     PooledResourceMemoryAllocator mPooledMemoryAllocator;
-    BuddyMemoryAllocator mBuddySystem;
+    TLSFMemoryAllocator mSubAllocator;
+    bool mUsageChanged = false;
 };
 
 // Implementation of ResourceMemoryAllocator
@@ -164,7 +200,8 @@ ResultOrError<ResourceMemoryAllocation> ResourceMemoryAllocator::Allocate(
     // Sub-allocate non-mappable resources because at the moment the mapped pointer
     // is part of the resource and not the heap, which doesn't match the Vulkan model.
     // TODO(crbug.com/dawn/849): allow sub-allocating mappable resources, maybe.
-    if (!forceDisableSubAllocation && requirements.size < kMaxSizeForSubAllocation &&
+    if (!forceDisableSubAllocation &&
+        requirements.size <= mAllocatorsPerType[memoryType]->GetMaxSizeForSubAllocation() &&
         !IsMemoryKindMappable(kind) &&
         !mDevice->IsToggleEnabled(Toggle::DisableResourceSuballocation)) {
         // When sub-allocating, Vulkan requires that we respect bufferImageGranularity. Some
@@ -255,6 +292,19 @@ void ResourceMemoryAllocator::Tick(ExecutionSerial completedSerial) {
     }
 
     mSubAllocationsToDelete.ClearUpTo(completedSerial);
+
+    bool trimPools = completedSerial > mLastPoolTrimSerial &&
+                     completedSerial - mLastPoolTrimSerial >= kPooledHeapTrimInterval;
+    if (trimPools) {
+        mLastPoolTrimSerial = completedSerial;
+    }
+
+    for (auto& allocator : mAllocatorsPerType) {
+        if (trimPools) {
+            allocator->TrimPool();
+        }
+        allocator->ReportUsageIfChanged();
+    }
 }
 
 int ResourceMemoryAllocator::FindBestTypeIndex(VkMemoryRequirements requirements, MemoryKind kind) {
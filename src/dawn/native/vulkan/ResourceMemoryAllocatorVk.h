@@ -75,6 +75,7 @@ class ResourceMemoryAllocator {
     std::vector<std::unique_ptr<SingleTypeAllocator>> mAllocatorsPerType;
 
     SerialQueue<ExecutionSerial, ResourceMemoryAllocation> mSubAllocationsToDelete;
+    ExecutionSerial mLastPoolTrimSerial = ExecutionSerial(0);
 };
 
 }  // namespace dawn::native::vulkan
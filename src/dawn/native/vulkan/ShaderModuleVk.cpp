@@ -31,6 +31,7 @@
 #include <string>
 #include <vector>
 
+#include "dawn/native/AsyncTask.h"
 #include "dawn/native/CacheRequest.h"
 #include "dawn/native/PhysicalDevice.h"
 #include "dawn/native/Serializable.h"
@@ -187,7 +188,8 @@ ShaderModule::~ShaderModule() = default;
 
 #define SPIRV_COMPILATION_REQUEST_MEMBERS(X)                                                     \
     X(SingleShaderStage, stage)                                                                  \
-    X(const tint::Program*, inputProgram)                                                        \
+    X(CacheKey::UnsafeUnkeyedValue<const ShaderModuleBase*>, inputModule)                        \
+    X(ShaderModuleSourceKey, source)                                                             \
     X(std::optional<tint::ast::transform::SubstituteOverride::Config>, substituteOverrideConfig) \
     X(LimitsForCompilationRequest, limits)                                                       \
     X(std::string_view, entryPointName)                                                          \
@@ -202,6 +204,65 @@ DAWN_MAKE_CACHE_REQUEST(SpirvCompilationRequest, SPIRV_COMPILATION_REQUEST_MEMBE
 
 #endif  // TINT_BUILD_SPV_WRITER
 
+MaybeError ShaderModule::PrepareHandlesAndSpirv(
+    const std::vector<HandleAndSpirvRequest>& requests) {
+    TRACE_EVENT0(GetDevice()->GetPlatform(), General, "ShaderModuleVk::PrepareHandlesAndSpirv");
+
+    // Don't post tasks for the requests that are already in the cache.
+    std::vector<const HandleAndSpirvRequest*> missingRequests;
+    for (const HandleAndSpirvRequest& request : requests) {
+        auto cacheKey = TransformedShaderModuleCacheKey{
+            request.layout, request.programmableStage->entryPoint.c_str(),
+            request.programmableStage->constants, request.maxSubgroupSizeForFullSubgroups};
+        if (!mTransformedShaderModuleCache->Find(cacheKey).has_value()) {
+            missingRequests.push_back(&request);
+        }
+    }
+    if (missingRequests.empty()) {
+        return {};
+    }
+
+    // GetHandleAndSpirv stores its results in the caches, only the errors need to be returned.
+    auto Prepare = [this](const HandleAndSpirvRequest& request) -> std::unique_ptr<ErrorData> {
+        ResultOrError<ModuleAndSpirv> result =
+            GetHandleAndSpirv(request.stage, *request.programmableStage, request.layout,
+                              request.clampFragDepth, request.maxSubgroupSizeForFullSubgroups);
+        if (result.IsError()) {
+            return result.AcquireError();
+        }
+        return nullptr;
+    };
+
+    // The first request is compiled on the current thread while the others are compiled on the
+    // worker threads. Each task writes to its own error slot so no synchronization is needed.
+    std::vector<std::unique_ptr<ErrorData>> errors(missingRequests.size());
+    std::vector<Ref<AsyncTaskHandle>> tasks;
+    tasks.reserve(missingRequests.size() - 1);
+    AsyncTaskManager* taskManager = GetDevice()->GetAsyncTaskManager();
+    for (size_t i = 1; i < missingRequests.size(); ++i) {
+        tasks.push_back(taskManager->PostTask(
+            [Prepare, request = missingRequests[i], error = &errors[i]] {
+                *error = Prepare(*request);
+            }));
+    }
+    errors[0] = Prepare(*missingRequests[0]);
+
+    // Steal the tasks that no worker thread started yet instead of waiting for them to be
+    // scheduled.
+    for (Ref<AsyncTaskHandle>& task : tasks) {
+        if (!task->RunNow()) {
+            task->Wait();
+        }
+    }
+
+    for (std::unique_ptr<ErrorData>& error : errors) {
+        if (error != nullptr) {
+            return std::move(error);
+        }
+    }
+    return {};
+}
+
 ResultOrError<ShaderModule::ModuleAndSpirv> ShaderModule::GetHandleAndSpirv(
     SingleShaderStage stage,
     const ProgrammableStage& programmableStage,
@@ -311,7 +372,8 @@ ResultOrError<ShaderModule::ModuleAndSpirv> ShaderModule::GetHandleAndSpirv(
 
     SpirvCompilationRequest req = {};
     req.stage = stage;
-    req.inputProgram = GetTintProgram();
+    req.inputModule = this;
+    req.source = GetSourceKey();
     req.entryPointName = programmableStage.entryPoint;
     req.disableSymbolRenaming = GetDevice()->IsToggleEnabled(Toggle::DisableSymbolRenaming);
     req.platform = UnsafeUnkeyedValue(GetDevice()->GetPlatform());
@@ -378,14 +440,24 @@ ResultOrError<ShaderModule::ModuleAndSpirv> ShaderModule::GetHandleAndSpirv(
                     std::move(r.substituteOverrideConfig).value());
             }
 
-            tint::Program program;
+            // Only get the program now: it may need to be parsed if the module was created from
+            // cached reflection data.
+            const tint::Program* inputProgram;
+            DAWN_TRY_ASSIGN(inputProgram, r.inputModule.UnsafeGetValue()->GetTintProgram());
+
+            // The transforms are skipped when they wouldn't change the program, for example for
+            // shader modules with a single entry point and no renaming, and the input program is
+            // then used directly instead of a clone of it.
+            std::optional<tint::Program> transformedProgram;
             tint::ast::transform::DataMap transformOutputs;
             {
                 TRACE_EVENT0(r.platform.UnsafeGetValue(), General, "RunTransforms");
-                DAWN_TRY_ASSIGN(program,
-                                RunTransforms(&transformManager, r.inputProgram, transformInputs,
-                                              &transformOutputs, nullptr));
+                DAWN_TRY_ASSIGN(transformedProgram,
+                                RunTransformsIfNeeded(&transformManager, inputProgram,
+                                                      transformInputs, &transformOutputs, nullptr));
             }
+            const tint::Program& program =
+                transformedProgram.has_value() ? *transformedProgram : *inputProgram;
 
             // Get the entry point name after the renamer pass.
             // TODO(dawn:2180): refactor out.
@@ -34,6 +34,7 @@
 #include <string>
 #include <unordered_map>
 #include <utility>
+#include <vector>
 
 #include "dawn/common/HashUtils.h"
 #include "dawn/common/vulkan_platform.h"
@@ -71,6 +72,15 @@ class ShaderModule final : public ShaderModuleBase {
         const char* remappedEntryPoint;
     };
 
+    // The arguments of a call to GetHandleAndSpirv, used to compile several entry points at once.
+    struct HandleAndSpirvRequest {
+        SingleShaderStage stage;
+        const ProgrammableStage* programmableStage;
+        const PipelineLayout* layout;
+        bool clampFragDepth = false;
+        std::optional<uint32_t> maxSubgroupSizeForFullSubgroups;
+    };
+
     static ResultOrError<Ref<ShaderModule>> Create(
         Device* device,
         const UnpackedPtr<ShaderModuleDescriptor>& descriptor,
@@ -84,6 +94,11 @@ class ShaderModule final : public ShaderModuleBase {
         bool clampFragDepth,
         std::optional<uint32_t> maxSubgroupSizeForFullSubgroups);
 
+    // Compiles the handles and SPIR-V of the requests in parallel on the worker threads and adds
+    // them to the caches, so that the following calls to GetHandleAndSpirv with the same arguments
+    // return immediately. Returns the first error encountered.
+    MaybeError PrepareHandlesAndSpirv(const std::vector<HandleAndSpirvRequest>& requests);
+
   private:
     ShaderModule(Device* device, const UnpackedPtr<ShaderModuleDescriptor>& descriptor);
     ~ShaderModule() override;
@@ -149,6 +149,7 @@ static constexpr std::array<DeviceExtInfo, kDeviceExtCount> sDeviceExtInfos{{
     {DeviceExt::Maintenance1, "VK_KHR_maintenance1", VulkanVersion_1_1},
     {DeviceExt::Maintenance2, "VK_KHR_maintenance2", VulkanVersion_1_1},
     {DeviceExt::Maintenance3, "VK_KHR_maintenance3", VulkanVersion_1_1},
+    {DeviceExt::DescriptorUpdateTemplate, "VK_KHR_descriptor_update_template", VulkanVersion_1_1},
     {DeviceExt::StorageBufferStorageClass, "VK_KHR_storage_buffer_storage_class",
      VulkanVersion_1_1},
     {DeviceExt::GetPhysicalDeviceProperties2, "VK_KHR_get_physical_device_properties2",
@@ -230,6 +231,7 @@ DeviceExtSet EnsureDependencies(const DeviceExtSet& advertisedExts,
             case DeviceExt::GetMemoryRequirements2:
             case DeviceExt::Maintenance1:
             case DeviceExt::Maintenance2:
+            case DeviceExt::DescriptorUpdateTemplate:
             case DeviceExt::ImageFormatList:
             case DeviceExt::StorageBufferStorageClass:
                 hasDependencies = true;
@@ -91,6 +91,7 @@ enum class DeviceExt {
     Maintenance1,
     Maintenance2,
     Maintenance3,
+    DescriptorUpdateTemplate,
     StorageBufferStorageClass,
     GetPhysicalDeviceProperties2,
     GetMemoryRequirements2,
@@ -234,14 +234,17 @@ MaybeError VulkanFunctions::LoadInstanceProcs(VkInstance instance,
     return {};
 }
 
-#define GET_DEVICE_PROC(name)                                                        \
-    do {                                                                             \
-        name = AsVkFn<PFN_vk##name>(GetDeviceProcAddr(device, "vk" #name));          \
-        if (name == nullptr) {                                                       \
-            return DAWN_INTERNAL_ERROR(std::string("Couldn't get proc vk") + #name); \
-        }                                                                            \
+#define GET_DEVICE_PROC_BASE(name, procName)                                             \
+    do {                                                                                 \
+        name = AsVkFn<PFN_vk##name>(GetDeviceProcAddr(device, "vk" #procName));          \
+        if (name == nullptr) {                                                           \
+            return DAWN_INTERNAL_ERROR(std::string("Couldn't get proc vk") + #procName); \
+        }                                                                                \
     } while (0)
 
+#define GET_DEVICE_PROC(name) GET_DEVICE_PROC_BASE(name, name)
+#define GET_DEVICE_PROC_VENDOR(name, vendor) GET_DEVICE_PROC_BASE(name, name##vendor)
+
 MaybeError VulkanFunctions::LoadDeviceProcs(VkDevice device, const VulkanDeviceInfo& deviceInfo) {
     GET_DEVICE_PROC(AllocateCommandBuffers);
     GET_DEVICE_PROC(AllocateDescriptorSets);
@@ -385,6 +388,16 @@ MaybeError VulkanFunctions::LoadDeviceProcs(VkDevice device, const VulkanDeviceI
         GET_DEVICE_PROC(QueuePresentKHR);
     }
 
+    if (deviceInfo.properties.apiVersion >= VK_API_VERSION_1_1) {
+        GET_DEVICE_PROC(CreateDescriptorUpdateTemplate);
+        GET_DEVICE_PROC(DestroyDescriptorUpdateTemplate);
+        GET_DEVICE_PROC(UpdateDescriptorSetWithTemplate);
+    } else if (deviceInfo.HasExt(DeviceExt::DescriptorUpdateTemplate)) {
+        GET_DEVICE_PROC_VENDOR(CreateDescriptorUpdateTemplate, KHR);
+        GET_DEVICE_PROC_VENDOR(DestroyDescriptorUpdateTemplate, KHR);
+        GET_DEVICE_PROC_VENDOR(UpdateDescriptorSetWithTemplate, KHR);
+    }
+
     if (deviceInfo.HasExt(DeviceExt::GetMemoryRequirements2)) {
         GET_DEVICE_PROC(GetBufferMemoryRequirements2);
         GET_DEVICE_PROC(GetImageMemoryRequirements2);
@@ -38,6 +38,30 @@ CachingInterface::CachingInterface() = default;
 
 CachingInterface::~CachingInterface() = default;
 
+bool CachingInterface::LoadDataView(const void* key, size_t keySize, CachedDataView* viewOut) {
+    size_t size = LoadData(key, keySize, nullptr, 0);
+    if (size == 0) {
+        return false;
+    }
+    uint8_t* data = new uint8_t[size];
+    if (LoadData(key, keySize, data, size) != size) {
+        delete[] data;
+        return false;
+    }
+    viewOut->data = data;
+    viewOut->size = size;
+    viewOut->release = [](void* userdata) { delete[] static_cast<uint8_t*>(userdata); };
+    viewOut->userdata = data;
+    return true;
+}
+
+std::unique_ptr<WaitableEvent> WorkerTaskPool::PostWorkerTaskWithPriority(
+    PostWorkerTaskCallback callback,
+    void* userdata,
+    TaskPriority priority) {
+    return PostWorkerTask(callback, userdata);
+}
+
 Platform::Platform() = default;
 
 Platform::~Platform() = default;
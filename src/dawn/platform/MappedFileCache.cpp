@@ -0,0 +1,565 @@
+// Copyright 2024 The Dawn & Tint Authors
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+//
+// 1. Redistributions of source code must retain the above copyright notice, this
+//    list of conditions and the following disclaimer.
+//
+// 2. Redistributions in binary form must reproduce the above copyright notice,
+//    this list of conditions and the following disclaimer in the documentation
+//    and/or other materials provided with the distribution.
+//
+// 3. Neither the name of the copyright holder nor the names of its
+//    contributors may be used to endorse or promote products derived from
+//    this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+// DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+// FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+// DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+// SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+// CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+// OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+// OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+
+#include "dawn/platform/MappedFileCache.h"
+
+#include <algorithm>
+#include <cstring>
+#include <utility>
+#include <vector>
+
+#include "dawn/common/Assert.h"
+#include "dawn/common/Math.h"
+#include "dawn/common/Platform.h"
+
+#if DAWN_PLATFORM_IS(POSIX)
+#include <fcntl.h>
+#include <sys/file.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#include <cerrno>
+#endif
+
+namespace dawn::platform {
+
+namespace {
+
+constexpr uint32_t kFileMagic = 0x4346'4d44;    // "DMFC"
+constexpr uint32_t kFileVersion = 2;
+constexpr uint32_t kRecordMagic = 0x5246'4d44;     // "DMFR"
+constexpr uint32_t kTombstoneMagic = 0x5446'4d44;  // "DMFT"
+constexpr size_t kRecordAlignment = 8;
+
+struct FileHeader {
+    uint32_t magic;
+    uint32_t version;
+    uint64_t reserved;
+};
+
+// Followed by the key, the value, and padding up to kRecordAlignment. The value is also aligned to
+// kRecordAlignment so that views of it can be used directly, for example as SPIR-V. Tombstone
+// records, that mark the eviction of the entry for their key, have no value.
+struct RecordHeader {
+    uint32_t magic;
+    uint32_t keySize;
+    uint64_t valueSize;
+    uint64_t checksum;
+};
+
+static_assert(sizeof(FileHeader) % kRecordAlignment == 0);
+static_assert(sizeof(RecordHeader) % kRecordAlignment == 0);
+
+uint64_t GetValueOffset(uint64_t keySize) {
+    return Align(sizeof(RecordHeader) + keySize, kRecordAlignment);
+}
+
+uint64_t GetRecordSize(uint64_t keySize, uint64_t valueSize) {
+    return Align(GetValueOffset(keySize) + valueSize, kRecordAlignment);
+}
+
+// FNV-1a of the key followed by the value, used to detect records that were only partially written.
+uint64_t ComputeChecksum(const char* key, size_t keySize, const char* value, size_t valueSize) {
+    uint64_t hash = 0xcbf2'9ce4'8422'2325ull;
+    auto Update = [&hash](const char* data, size_t size) {
+        for (size_t i = 0; i < size; ++i) {
+            hash ^= static_cast<uint8_t>(data[i]);
+            hash *= 0x0000'0100'0000'01b3ull;
+        }
+    };
+    Update(key, keySize);
+    Update(value, valueSize);
+    return hash;
+}
+
+#if DAWN_PLATFORM_IS(POSIX)
+bool WriteAll(int fd, const void* data, size_t size, uint64_t offset) {
+    const char* bytes = static_cast<const char*>(data);
+    while (size > 0) {
+        ssize_t written = pwrite(fd, bytes, size, static_cast<off_t>(offset));
+        if (written < 0) {
+            if (errno == EINTR) {
+                continue;
+            }
+            return false;
+        }
+        bytes += written;
+        size -= static_cast<size_t>(written);
+        offset += static_cast<uint64_t>(written);
+    }
+    return true;
+}
+
+bool ReadAll(int fd, void* data, size_t size, uint64_t offset) {
+    char* bytes = static_cast<char*>(data);
+    while (size > 0) {
+        ssize_t bytesRead = pread(fd, bytes, size, static_cast<off_t>(offset));
+        if (bytesRead < 0 && errno == EINTR) {
+            continue;
+        }
+        if (bytesRead <= 0) {
+            return false;
+        }
+        bytes += bytesRead;
+        size -= static_cast<size_t>(bytesRead);
+        offset += static_cast<uint64_t>(bytesRead);
+    }
+    return true;
+}
+
+// Opens |path| and locks it so that no other process or cache can use it at the same time.
+int OpenAndLock(const std::string& path, int flags) {
+    int fd = open(path.c_str(), flags | O_RDWR | O_CREAT | O_CLOEXEC, S_IRUSR | S_IWUSR);
+    if (fd < 0) {
+        return -1;
+    }
+    if (flock(fd, LOCK_EX | LOCK_NB) != 0) {
+        close(fd);
+        return -1;
+    }
+    return fd;
+}
+#endif  // DAWN_PLATFORM_IS(POSIX)
+
+}  // anonymous namespace
+
+// A mapping of the log. Views returned by LoadDataView keep it alive after the log is compacted or
+// the cache is destroyed.
+class MappedFileCachingInterface::Mapping : public RefCounted {
+  public:
+    Mapping(char* data, size_t size) : mData(data), mSize(size) {}
+
+    char* GetData() const { return mData; }
+    size_t GetSize() const { return mSize; }
+
+  private:
+    ~Mapping() override {
+#if DAWN_PLATFORM_IS(POSIX)
+        munmap(mData, mSize);
+#endif
+    }
+
+    char* const mData;
+    const size_t mSize;
+};
+
+// static
+std::unique_ptr<MappedFileCachingInterface> MappedFileCachingInterface::Create(
+    const std::string& path,
+    size_t maxSize) {
+#if DAWN_PLATFORM_IS(POSIX)
+    if (path.empty() || maxSize == 0) {
+        return nullptr;
+    }
+
+    // Leave room for as many bytes of dead records as there are of live ones before having to
+    // compact the log.
+    size_t pageSize = static_cast<size_t>(sysconf(_SC_PAGESIZE));
+    size_t mappingSize = Align(sizeof(FileHeader) + 2 * maxSize, pageSize);
+
+    std::unique_ptr<MappedFileCachingInterface> cache(
+        new MappedFileCachingInterface(path, maxSize, mappingSize));
+    if (!cache->OpenLog()) {
+        return nullptr;
+    }
+    return cache;
+#else
+    return nullptr;
+#endif
+}
+
+MappedFileCachingInterface::MappedFileCachingInterface(std::string path,
+                                                       size_t maxSize,
+                                                       size_t mappingSize)
+    : mPath(std::move(path)), mMaxSize(maxSize), mMinMappingSize(mappingSize) {}
+
+MappedFileCachingInterface::~MappedFileCachingInterface() {
+    mIndex.clear();
+    CloseLog();
+}
+
+size_t MappedFileCachingInterface::LoadData(const void* key,
+                                            size_t keySize,
+                                            void* valueOut,
+                                            size_t valueSize) {
+    std::lock_guard<std::mutex> lock(mMutex);
+    auto it = mIndex.find(std::string_view(static_cast<const char*>(key), keySize));
+    if (it == mIndex.end()) {
+        return 0;
+    }
+
+    // Loading an entry makes it the most recently used.
+    mEntries.splice(mEntries.begin(), mEntries, it->second);
+
+    const Entry& entry = *it->second;
+    if (valueOut != nullptr && valueSize >= entry.valueSize) {
+        memcpy(valueOut, GetValue(entry), entry.valueSize);
+    }
+    return entry.valueSize;
+}
+
+bool MappedFileCachingInterface::LoadDataView(const void* key,
+                                              size_t keySize,
+                                              CachedDataView* viewOut) {
+    std::lock_guard<std::mutex> lock(mMutex);
+    auto it = mIndex.find(std::string_view(static_cast<const char*>(key), keySize));
+    if (it == mIndex.end()) {
+        return false;
+    }
+    mEntries.splice(mEntries.begin(), mEntries, it->second);
+
+    // Records are never modified once written, so the view stays valid as long as the mapping.
+    const Entry& entry = *it->second;
+    mMapping->Reference();
+    viewOut->data = GetValue(entry);
+    viewOut->size = entry.valueSize;
+    viewOut->release = [](void* userdata) { static_cast<Mapping*>(userdata)->Release(); };
+    viewOut->userdata = mMapping.Get();
+    return true;
+}
+
+void MappedFileCachingInterface::StoreData(const void* key,
+                                           size_t keySize,
+                                           const void* value,
+                                           size_t valueSize) {
+#if DAWN_PLATFORM_IS(POSIX)
+    if (keySize == 0 || keySize > UINT32_MAX || valueSize > mMaxSize) {
+        return;
+    }
+    uint64_t recordSize = GetRecordSize(keySize, valueSize);
+    if (recordSize > mMaxSize) {
+        return;
+    }
+
+    std::lock_guard<std::mutex> lock(mMutex);
+    if (mFd < 0) {
+        return;
+    }
+
+    // When the log is full, evict enough entries for the new one to fit under the size limit and
+    // drop the dead records to make space for it.
+    if (mFileSize + recordSize > mMappingSize) {
+        EvictUntil(mMaxSize - recordSize);
+        if (!CompactLocked() || mFileSize + recordSize > mMappingSize) {
+            return;
+        }
+    }
+
+    uint64_t offset = mFileSize;
+    if (!AppendRecord(kRecordMagic, key, keySize, value, valueSize)) {
+        return;
+    }
+    AddEntry({offset, static_cast<uint32_t>(keySize), valueSize, recordSize});
+    EvictUntil(mMaxSize);
+#endif
+}
+
+bool MappedFileCachingInterface::Compact() {
+    std::lock_guard<std::mutex> lock(mMutex);
+    return CompactLocked();
+}
+
+size_t MappedFileCachingInterface::GetEntryCount() {
+    std::lock_guard<std::mutex> lock(mMutex);
+    return mEntries.size();
+}
+
+size_t MappedFileCachingInterface::GetLiveSize() {
+    std::lock_guard<std::mutex> lock(mMutex);
+    return mLiveSize;
+}
+
+size_t MappedFileCachingInterface::GetFileSize() {
+    std::lock_guard<std::mutex> lock(mMutex);
+    return mFileSize;
+}
+
+bool MappedFileCachingInterface::OpenLog() {
+#if DAWN_PLATFORM_IS(POSIX)
+    int fd = OpenAndLock(mPath, 0);
+    if (fd < 0) {
+        return false;
+    }
+
+    // Remove the temporary file of a compaction that didn't complete. This is only safe once the
+    // lock is held, since it could otherwise belong to a compaction still in progress.
+    unlink((mPath + ".tmp").c_str());
+
+    struct stat stats;
+    if (fstat(fd, &stats) != 0) {
+        close(fd);
+        return false;
+    }
+    uint64_t fileSize = static_cast<uint64_t>(stats.st_size);
+
+    // Start a new log if the file is new or was written by an incompatible version.
+    FileHeader header = {};
+    if (fileSize < sizeof(FileHeader) || !ReadAll(fd, &header, sizeof(header), 0) ||
+        header.magic != kFileMagic || header.version != kFileVersion) {
+        header = {kFileMagic, kFileVersion, 0};
+        if (ftruncate(fd, 0) != 0 || !WriteAll(fd, &header, sizeof(header), 0)) {
+            close(fd);
+            return false;
+        }
+        fileSize = sizeof(header);
+    }
+
+    if (!MapLog(fd, fileSize)) {
+        close(fd);
+        return false;
+    }
+    return LoadIndex();
+#else
+    return false;
+#endif
+}
+
+bool MappedFileCachingInterface::MapLog(int fd, uint64_t fileSize) {
+#if DAWN_PLATFORM_IS(POSIX)
+    // The mapping is larger than the file so that appended records can be read without remapping.
+    // Only the pages that are backed by the file are ever accessed.
+    size_t pageSize = static_cast<size_t>(sysconf(_SC_PAGESIZE));
+    size_t mappingSize = std::max(mMinMappingSize, Align(static_cast<size_t>(fileSize), pageSize));
+    void* mapping = mmap(nullptr, mappingSize, PROT_READ, MAP_SHARED, fd, 0);
+    if (mapping == MAP_FAILED) {
+        return false;
+    }
+
+    mFd = fd;
+    mMapping = AcquireRef(new Mapping(static_cast<char*>(mapping), mappingSize));
+    mMappingSize = mappingSize;
+    mFileSize = fileSize;
+    return true;
+#else
+    return false;
+#endif
+}
+
+void MappedFileCachingInterface::CloseLog() {
+#if DAWN_PLATFORM_IS(POSIX)
+    DAWN_ASSERT(mIndex.empty());
+    // The mapping is only unmapped once all the views of it are released.
+    mMapping = nullptr;
+    if (mFd >= 0) {
+        // Also releases the lock on the file.
+        close(mFd);
+        mFd = -1;
+    }
+    mEntries.clear();
+    mLiveSize = 0;
+    mFileSize = 0;
+#endif
+}
+
+bool MappedFileCachingInterface::LoadIndex() {
+#if DAWN_PLATFORM_IS(POSIX)
+    uint64_t offset = sizeof(FileHeader);
+    while (mFileSize - offset >= sizeof(RecordHeader)) {
+        RecordHeader header;
+        const char* record = mMapping->GetData() + offset;
+        memcpy(&header, record, sizeof(header));
+
+        uint64_t available = mFileSize - offset;
+        bool isTombstone = header.magic == kTombstoneMagic && header.valueSize == 0;
+        if ((header.magic != kRecordMagic && !isTombstone) || header.keySize == 0 ||
+            header.keySize > available - sizeof(RecordHeader)) {
+            break;
+        }
+        uint64_t valueOffset = GetValueOffset(header.keySize);
+        if (valueOffset > available || header.valueSize > available - valueOffset ||
+            GetRecordSize(header.keySize, header.valueSize) > available) {
+            break;
+        }
+        uint64_t recordSize = GetRecordSize(header.keySize, header.valueSize);
+        const char* key = record + sizeof(RecordHeader);
+        if (ComputeChecksum(key, header.keySize, record + valueOffset, header.valueSize) !=
+            header.checksum) {
+            break;
+        }
+
+        if (isTombstone) {
+            auto it = mIndex.find(std::string_view(key, header.keySize));
+            if (it != mIndex.end()) {
+                RemoveEntry(it);
+            }
+        } else {
+            AddEntry({offset, header.keySize, header.valueSize, recordSize});
+        }
+        offset += recordSize;
+    }
+
+    // Drop the record that was being appended when the process stopped. Nothing after it can be
+    // trusted either, since records are only ever appended.
+    if (offset != mFileSize) {
+        if (ftruncate(mFd, static_cast<off_t>(offset)) != 0) {
+            mIndex.clear();
+            CloseLog();
+            return false;
+        }
+        mFileSize = offset;
+    }
+
+    EvictUntil(mMaxSize);
+    return true;
+#else
+    return false;
+#endif
+}
+
+std::string_view MappedFileCachingInterface::GetKey(const Entry& entry) const {
+    return std::string_view(mMapping->GetData() + entry.offset + sizeof(RecordHeader),
+                            entry.keySize);
+}
+
+const char* MappedFileCachingInterface::GetValue(const Entry& entry) const {
+    return mMapping->GetData() + entry.offset + GetValueOffset(entry.keySize);
+}
+
+void MappedFileCachingInterface::AddEntry(const Entry& entry) {
+    auto it = mIndex.find(GetKey(entry));
+    if (it != mIndex.end()) {
+        RemoveEntry(it);
+    }
+    mEntries.push_front(entry);
+    mIndex.emplace(GetKey(entry), mEntries.begin());
+    mLiveSize += entry.recordSize;
+}
+
+void MappedFileCachingInterface::RemoveEntry(Index::iterator it) {
+    mLiveSize -= it->second->recordSize;
+    mEntries.erase(it->second);
+    mIndex.erase(it);
+}
+
+void MappedFileCachingInterface::EvictUntil(uint64_t liveSize) {
+    while (mLiveSize > liveSize) {
+        DAWN_ASSERT(!mEntries.empty());
+        std::string_view key = GetKey(mEntries.back());
+        // Record the eviction so that the entry doesn't come back when the log is loaded again.
+        // This is best effort: when the log is full, the next compaction drops the record anyway.
+        AppendRecord(kTombstoneMagic, key.data(), key.size(), nullptr, 0);
+        RemoveEntry(mIndex.find(key));
+    }
+}
+
+bool MappedFileCachingInterface::AppendRecord(uint32_t magic,
+                                              const void* key,
+                                              size_t keySize,
+                                              const void* value,
+                                              size_t valueSize) {
+#if DAWN_PLATFORM_IS(POSIX)
+    uint64_t recordSize = GetRecordSize(keySize, valueSize);
+    if (mFd < 0 || mFileSize + recordSize > mMappingSize) {
+        return false;
+    }
+
+    RecordHeader header;
+    header.magic = magic;
+    header.keySize = static_cast<uint32_t>(keySize);
+    header.valueSize = valueSize;
+    header.checksum = ComputeChecksum(static_cast<const char*>(key), keySize,
+                                      static_cast<const char*>(value), valueSize);
+
+    std::vector<char> record(recordSize, 0);
+    memcpy(record.data(), &header, sizeof(header));
+    memcpy(record.data() + sizeof(header), key, keySize);
+    if (valueSize > 0) {
+        memcpy(record.data() + GetValueOffset(keySize), value, valueSize);
+    }
+
+    if (!WriteAll(mFd, record.data(), record.size(), mFileSize)) {
+        // Don't leave a partial record behind, it would hide the records appended after it.
+        (void)ftruncate(mFd, static_cast<off_t>(mFileSize));
+        return false;
+    }
+    // The mapping is shared with the file, so the record can be read from it right away.
+    mFileSize += recordSize;
+    return true;
+#else
+    return false;
+#endif
+}
+
+bool MappedFileCachingInterface::CompactLocked() {
+#if DAWN_PLATFORM_IS(POSIX)
+    if (mFd < 0) {
+        return false;
+    }
+
+    // Write the live records to a temporary file that replaces the log only once it is complete
+    // and durable, so that a crash leaves either the old or the new log in place.
+    std::string tmpPath = mPath + ".tmp";
+    int fd = OpenAndLock(tmpPath, O_TRUNC);
+    if (fd < 0) {
+        return false;
+    }
+
+    FileHeader header = {kFileMagic, kFileVersion, 0};
+    bool success = WriteAll(fd, &header, sizeof(header), 0);
+
+    // The records are written from the least to the most recently used, which is the order in
+    // which LoadIndex() expects them.
+    uint64_t fileSize = sizeof(FileHeader);
+    for (auto it = mEntries.rbegin(); success && it != mEntries.rend(); ++it) {
+        success = WriteAll(fd, mMapping->GetData() + it->offset, it->recordSize, fileSize);
+        fileSize += it->recordSize;
+    }
+    success = success && fsync(fd) == 0 && rename(tmpPath.c_str(), mPath.c_str()) == 0;
+    if (!success) {
+        close(fd);
+        unlink(tmpPath.c_str());
+        return false;
+    }
+
+    // The keys of the index point into the old mapping, rebuild it with the new offsets.
+    mIndex.clear();
+    EntryList entries = std::move(mEntries);
+    uint64_t liveSize = mLiveSize;
+    CloseLog();
+    if (!MapLog(fd, fileSize)) {
+        close(fd);
+        return false;
+    }
+
+    uint64_t offset = sizeof(FileHeader);
+    for (auto it = entries.rbegin(); it != entries.rend(); ++it) {
+        it->offset = offset;
+        offset += it->recordSize;
+    }
+    DAWN_ASSERT(offset == fileSize);
+    mEntries = std::move(entries);
+    for (auto it = mEntries.begin(); it != mEntries.end(); ++it) {
+        mIndex.emplace(GetKey(*it), it);
+    }
+    mLiveSize = liveSize;
+    return true;
+#else
+    return false;
+#endif
+}
+
+}  // namespace dawn::platform
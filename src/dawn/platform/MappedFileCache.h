@@ -0,0 +1,142 @@
+// Copyright 2024 The Dawn & Tint Authors
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+//
+// 1. Redistributions of source code must retain the above copyright notice, this
+//    list of conditions and the following disclaimer.
+//
+// 2. Redistributions in binary form must reproduce the above copyright notice,
+//    this list of conditions and the following disclaimer in the documentation
+//    and/or other materials provided with the distribution.
+//
+// 3. Neither the name of the copyright holder nor the names of its
+//    contributors may be used to endorse or promote products derived from
+//    this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+// DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+// FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+// DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+// SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+// CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+// OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+// OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+
+#ifndef SRC_DAWN_PLATFORM_MAPPEDFILECACHE_H_
+#define SRC_DAWN_PLATFORM_MAPPEDFILECACHE_H_
+
+#include <cstddef>
+#include <cstdint>
+#include <list>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <string_view>
+#include <unordered_map>
+
+#include "dawn/common/NonCopyable.h"
+#include "dawn/common/Ref.h"
+#include "dawn/platform/DawnPlatform.h"
+#include "dawn/platform/dawn_platform_export.h"
+
+namespace dawn::platform {
+
+// A reference CachingInterface that persists the cache to a single file on disk.
+//
+// The file is an append-only log of records, each holding a key, a value and a checksum, and is
+// memory-mapped for reading. An in-memory hash index maps the keys to their latest record, so
+// loading a cached value doesn't make any syscall, and LoadDataView() doesn't copy it either.
+// Storing a value appends a record to the log; older records for the same key and records of
+// evicted entries become dead space.
+//
+// When the entries take more than |maxSize| bytes, the least recently used ones are evicted. When
+// the log runs out of space, it is compacted: the live records are written to a temporary file
+// that atomically replaces the log once it is complete. A crash at any point leaves either the old
+// or the new log in place, and records that were only partially written when the process died
+// are detected by their checksum and dropped when the log is opened again.
+//
+// The file must only be used by one MappedFileCachingInterface at a time: Create() fails if
+// another one, possibly in another process, has it open. Only POSIX platforms are supported.
+class DAWN_PLATFORM_EXPORT MappedFileCachingInterface : public CachingInterface,
+                                                        public NonCopyable {
+  public:
+    // Opens the cache at |path|, creating it if needed. Returns nullptr on failure or on platforms
+    // that aren't supported.
+    static std::unique_ptr<MappedFileCachingInterface> Create(const std::string& path,
+                                                              size_t maxSize);
+
+    ~MappedFileCachingInterface() override;
+
+    size_t LoadData(const void* key, size_t keySize, void* valueOut, size_t valueSize) override;
+    void StoreData(const void* key, size_t keySize, const void* value, size_t valueSize) override;
+    // The views point directly into the mapped file, their values are aligned to 8 bytes.
+    bool LoadDataView(const void* key, size_t keySize, CachedDataView* viewOut) override;
+
+    // Rewrites the log with only the live records. Returns false if the log couldn't be replaced,
+    // in which case the cache keeps using the old one.
+    bool Compact();
+
+    size_t GetEntryCount();
+    // The size of the records of the entries currently in the cache.
+    size_t GetLiveSize();
+    // The size of the log, including the dead records.
+    size_t GetFileSize();
+
+  private:
+    class Mapping;
+
+    struct Entry {
+        uint64_t offset;
+        uint32_t keySize;
+        uint64_t valueSize;
+        uint64_t recordSize;
+    };
+    // Ordered from the most to the least recently used.
+    using EntryList = std::list<Entry>;
+    // The keys point to the records in the mapping.
+    using Index = std::unordered_map<std::string_view, EntryList::iterator>;
+
+    MappedFileCachingInterface(std::string path, size_t maxSize, size_t mappingSize);
+
+    bool OpenLog();
+    bool MapLog(int fd, uint64_t fileSize);
+    // Unmaps and closes the log. The index must be cleared first.
+    void CloseLog();
+    // Reads the records of the log into the index and drops the ones after the first invalid one.
+    bool LoadIndex();
+
+    std::string_view GetKey(const Entry& entry) const;
+    const char* GetValue(const Entry& entry) const;
+    void AddEntry(const Entry& entry);
+    void RemoveEntry(Index::iterator it);
+    void EvictUntil(uint64_t liveSize);
+    // Appends a record at the end of the log. Returns false if it doesn't fit in the mapping or
+    // couldn't be written.
+    bool AppendRecord(uint32_t magic,
+                      const void* key,
+                      size_t keySize,
+                      const void* value,
+                      size_t valueSize);
+    bool CompactLocked();
+
+    const std::string mPath;
+    const uint64_t mMaxSize;
+    const size_t mMinMappingSize;
+
+    // Protects all the members below.
+    std::mutex mMutex;
+    int mFd = -1;
+    Ref<Mapping> mMapping;
+    size_t mMappingSize = 0;
+    uint64_t mFileSize = 0;
+    uint64_t mLiveSize = 0;
+    EntryList mEntries;
+    Index mIndex;
+};
+
+}  // namespace dawn::platform
+
+#endif  // SRC_DAWN_PLATFORM_MAPPEDFILECACHE_H_
@@ -27,77 +27,217 @@
 
 #include "dawn/platform/WorkerThread.h"
 
-#include <condition_variable>
-#include <functional>
-#include <thread>
+#include <algorithm>
+#include <utility>
 
 #include "dawn/common/Assert.h"
 
+namespace dawn::platform {
+
 namespace {
 
-class AsyncWaitableEventImpl {
-  public:
-    AsyncWaitableEventImpl() : mIsComplete(false) {}
+// Don't start more threads than this by default: pipeline compilation is the main user of the pool
+// and past this point the workers mostly contend on the device and the driver.
+constexpr uint32_t kMaxDefaultWorkerCount = 16;
 
-    void Wait() {
-        std::unique_lock<std::mutex> lock(mMutex);
-        mCondition.wait(lock, [this] { return mIsComplete; });
-    }
+// The pool and the index of the worker running on the current thread, used to push tasks posted
+// from a worker to its own deque.
+thread_local const AsyncWorkerThreadPool* tlCurrentPool = nullptr;
+thread_local uint32_t tlWorkerIndex = 0;
 
-    bool IsComplete() {
-        std::lock_guard<std::mutex> lock(mMutex);
-        return mIsComplete;
-    }
+}  // anonymous namespace
+
+// Signals the completion of tasks to the events waiting on them. It is shared by all the tasks of a
+// pool so that posting a task doesn't need to create a mutex and condition variable each time.
+struct AsyncWorkerThreadPool::CompletionSignal {
+    std::mutex mutex;
+    std::condition_variable condition;
+};
+
+struct AsyncWorkerThreadPool::Task {
+    Task(PostWorkerTaskCallback callback,
+         void* userdata,
+         std::shared_ptr<CompletionSignal> completionSignal)
+        : callback(callback), userdata(userdata), signal(std::move(completionSignal)) {}
 
-    void MarkAsComplete() {
+    void Run() {
+        callback(userdata);
         {
-            std::lock_guard<std::mutex> lock(mMutex);
-            mIsComplete = true;
+            std::lock_guard<std::mutex> lock(signal->mutex);
+            isComplete.store(true, std::memory_order_release);
         }
-        mCondition.notify_all();
+        signal->condition.notify_all();
     }
 
-  private:
-    std::mutex mMutex;
-    std::condition_variable mCondition;
-    bool mIsComplete;
+    PostWorkerTaskCallback callback;
+    void* userdata;
+    std::atomic<bool> isComplete = false;
+    // Keeps the signal alive if the event outlives the pool.
+    std::shared_ptr<CompletionSignal> signal;
 };
 
-class AsyncWaitableEvent final : public dawn::platform::WaitableEvent {
-  public:
-    AsyncWaitableEvent() : mWaitableEventImpl(std::make_shared<AsyncWaitableEventImpl>()) {}
-
-    void Wait() override { mWaitableEventImpl->Wait(); }
+namespace {
 
-    bool IsComplete() override { return mWaitableEventImpl->IsComplete(); }
+template <typename TaskT>
+class AsyncWaitableEvent final : public WaitableEvent {
+  public:
+    explicit AsyncWaitableEvent(std::shared_ptr<TaskT> task) : mTask(std::move(task)) {}
 
-    std::shared_ptr<AsyncWaitableEventImpl> GetWaitableEventImpl() const {
-        return mWaitableEventImpl;
+    void Wait() override {
+        if (IsComplete()) {
+            return;
+        }
+        std::unique_lock<std::mutex> lock(mTask->signal->mutex);
+        mTask->signal->condition.wait(lock, [this] { return IsComplete(); });
     }
 
+    bool IsComplete() override { return mTask->isComplete.load(std::memory_order_acquire); }
+
   private:
-    std::shared_ptr<AsyncWaitableEventImpl> mWaitableEventImpl;
+    std::shared_ptr<TaskT> mTask;
 };
 
 }  // anonymous namespace
 
-namespace dawn::platform {
+AsyncWorkerThreadPool::AsyncWorkerThreadPool(uint32_t maxWorkerCount)
+    : mCompletionSignal(std::make_shared<CompletionSignal>()) {
+    if (maxWorkerCount == 0) {
+        maxWorkerCount =
+            std::clamp(std::thread::hardware_concurrency(), 1u, kMaxDefaultWorkerCount);
+    }
+    mWorkers.reserve(maxWorkerCount);
+    for (uint32_t i = 0; i < maxWorkerCount; ++i) {
+        mWorkers.push_back(std::make_unique<Worker>());
+    }
+    mThreads.reserve(maxWorkerCount);
+}
+
+AsyncWorkerThreadPool::~AsyncWorkerThreadPool() {
+    {
+        std::lock_guard<std::mutex> lock(mMutex);
+        mIsShuttingDown = true;
+    }
+    mCondition.notify_all();
+
+    // Workers drain all the queued tasks before exiting, so none of the events are left pending.
+    for (std::thread& thread : mThreads) {
+        thread.join();
+    }
+    DAWN_ASSERT(mQueuedTaskCount.load() == 0);
+}
 
-std::unique_ptr<dawn::platform::WaitableEvent> AsyncWorkerThreadPool::PostWorkerTask(
-    dawn::platform::PostWorkerTaskCallback callback,
+std::unique_ptr<WaitableEvent> AsyncWorkerThreadPool::PostWorkerTask(
+    PostWorkerTaskCallback callback,
     void* userdata) {
-    std::unique_ptr<AsyncWaitableEvent> waitableEvent = std::make_unique<AsyncWaitableEvent>();
+    return PostWorkerTaskWithPriority(callback, userdata, TaskPriority::Normal);
+}
 
-    std::function<void()> doTask = [callback, userdata,
-                                    waitableEventImpl = waitableEvent->GetWaitableEventImpl()] {
-        callback(userdata);
-        waitableEventImpl->MarkAsComplete();
-    };
+std::unique_ptr<WaitableEvent> AsyncWorkerThreadPool::PostWorkerTaskWithPriority(
+    PostWorkerTaskCallback callback,
+    void* userdata,
+    TaskPriority priority) {
+    std::shared_ptr<Task> task = std::make_shared<Task>(callback, userdata, mCompletionSignal);
+
+    std::unique_lock<std::mutex> lock(mMutex);
+
+    // A running task may post more work while the pool is being destroyed. The workers may already
+    // be exiting and no new one can be started, so run the task on the current thread instead.
+    if (mIsShuttingDown) {
+        lock.unlock();
+        task->Run();
+        return std::make_unique<AsyncWaitableEvent<Task>>(std::move(task));
+    }
+
+    // Start a new worker when the queued tasks already outnumber the idle workers.
+    if (mThreads.size() < mWorkers.size() && mQueuedTaskCount.load() >= mIdleWorkerCount) {
+        uint32_t workerIndex = static_cast<uint32_t>(mThreads.size());
+        mThreads.emplace_back([this, workerIndex] { WorkerLoop(workerIndex); });
+    }
+
+    // Tasks posted by a worker go to its own deque, the others are spread round-robin between the
+    // started workers.
+    uint32_t workerIndex;
+    if (tlCurrentPool == this) {
+        workerIndex = tlWorkerIndex;
+    } else {
+        workerIndex = mNextWorker;
+        mNextWorker = (mNextWorker + 1) % mThreads.size();
+    }
+
+    {
+        Worker* worker = mWorkers[workerIndex].get();
+        std::lock_guard<std::mutex> workerLock(worker->mutex);
+        worker->queues[static_cast<size_t>(priority)].push_back(task);
+        mQueuedTaskCount.fetch_add(1);
+    }
+    lock.unlock();
+    mCondition.notify_one();
+
+    return std::make_unique<AsyncWaitableEvent<Task>>(std::move(task));
+}
 
-    std::thread thread(doTask);
-    thread.detach();
+uint32_t AsyncWorkerThreadPool::GetMaxWorkerCount() const {
+    return static_cast<uint32_t>(mWorkers.size());
+}
+
+uint32_t AsyncWorkerThreadPool::GetStartedWorkerCount() {
+    std::lock_guard<std::mutex> lock(mMutex);
+    return static_cast<uint32_t>(mThreads.size());
+}
+
+std::shared_ptr<AsyncWorkerThreadPool::Task> AsyncWorkerThreadPool::TryPopTask(
+    uint32_t workerIndex) {
+    size_t workerCount = mWorkers.size();
+    for (size_t priority = 0; priority < kPriorityCount; ++priority) {
+        // The owner takes its tasks in FIFO order, thieves take them from the other end to reduce
+        // contention with the owner. Tasks are coarse (pipeline compiles) so the order mostly
+        // matters for latency.
+        for (size_t i = 0; i < workerCount; ++i) {
+            bool isOwner = i == 0;
+            Worker* worker = mWorkers[(workerIndex + i) % workerCount].get();
+
+            std::lock_guard<std::mutex> lock(worker->mutex);
+            std::deque<std::shared_ptr<Task>>& queue = worker->queues[priority];
+            if (queue.empty()) {
+                continue;
+            }
+
+            std::shared_ptr<Task> task;
+            if (isOwner) {
+                task = std::move(queue.front());
+                queue.pop_front();
+            } else {
+                task = std::move(queue.back());
+                queue.pop_back();
+            }
+            mQueuedTaskCount.fetch_sub(1);
+            return task;
+        }
+    }
+    return nullptr;
+}
+
+void AsyncWorkerThreadPool::WorkerLoop(uint32_t workerIndex) {
+    tlCurrentPool = this;
+    tlWorkerIndex = workerIndex;
+
+    while (true) {
+        if (std::shared_ptr<Task> task = TryPopTask(workerIndex)) {
+            task->Run();
+            continue;
+        }
+
+        std::unique_lock<std::mutex> lock(mMutex);
+        mIdleWorkerCount++;
+        mCondition.wait(lock,
+                        [this] { return mIsShuttingDown || mQueuedTaskCount.load() != 0; });
+        mIdleWorkerCount--;
+        if (mIsShuttingDown && mQueuedTaskCount.load() == 0) {
+            break;
+        }
+    }
 
-    return waitableEvent;
+    tlCurrentPool = nullptr;
 }
 
 }  // namespace dawn::platform
@@ -28,18 +28,67 @@
 #ifndef SRC_DAWN_PLATFORM_WORKERTHREAD_H_
 #define SRC_DAWN_PLATFORM_WORKERTHREAD_H_
 
+#include <array>
+#include <atomic>
+#include <condition_variable>
+#include <cstdint>
+#include <deque>
 #include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
 
 #include "dawn/common/NonCopyable.h"
 #include "dawn/platform/DawnPlatform.h"
+#include "dawn/platform/dawn_platform_export.h"
 
 namespace dawn::platform {
 
-class AsyncWorkerThreadPool : public dawn::platform::WorkerTaskPool, public NonCopyable {
+// A fixed-size pool of worker threads. Each worker owns one deque per TaskPriority and idle
+// workers steal from the other workers' deques, always starting higher priority tasks first.
+// Worker threads are started lazily, only when no idle worker can pick up a newly posted task, so
+// pools that only ever see a few tasks at a time stay small.
+class DAWN_PLATFORM_EXPORT AsyncWorkerThreadPool : public WorkerTaskPool, public NonCopyable {
   public:
-    std::unique_ptr<dawn::platform::WaitableEvent> PostWorkerTask(
-        dawn::platform::PostWorkerTaskCallback callback,
-        void* userdata) override;
+    // A |maxWorkerCount| of 0 picks a count based on the hardware concurrency.
+    explicit AsyncWorkerThreadPool(uint32_t maxWorkerCount = 0);
+    ~AsyncWorkerThreadPool() override;
+
+    std::unique_ptr<WaitableEvent> PostWorkerTask(PostWorkerTaskCallback callback,
+                                                  void* userdata) override;
+    std::unique_ptr<WaitableEvent> PostWorkerTaskWithPriority(PostWorkerTaskCallback callback,
+                                                              void* userdata,
+                                                              TaskPriority priority) override;
+
+    uint32_t GetMaxWorkerCount() const;
+    // Number of worker threads started so far. It never exceeds GetMaxWorkerCount().
+    uint32_t GetStartedWorkerCount();
+
+  private:
+    struct CompletionSignal;
+    struct Task;
+    static constexpr size_t kPriorityCount = static_cast<size_t>(TaskPriority::Normal) + 1;
+
+    struct Worker {
+        std::mutex mutex;
+        std::array<std::deque<std::shared_ptr<Task>>, kPriorityCount> queues;
+    };
+
+    void WorkerLoop(uint32_t workerIndex);
+    std::shared_ptr<Task> TryPopTask(uint32_t workerIndex);
+
+    // Allocated upfront so that thieves can walk them without synchronizing with thread startup.
+    std::vector<std::unique_ptr<Worker>> mWorkers;
+    std::atomic<size_t> mQueuedTaskCount = 0;
+    std::shared_ptr<CompletionSignal> mCompletionSignal;
+
+    // Protects the members below, and is used to put idle workers to sleep.
+    std::mutex mMutex;
+    std::condition_variable mCondition;
+    std::vector<std::thread> mThreads;
+    uint32_t mIdleWorkerCount = 0;
+    uint32_t mNextWorker = 0;
+    bool mIsShuttingDown = false;
 };
 
 }  // namespace dawn::platform
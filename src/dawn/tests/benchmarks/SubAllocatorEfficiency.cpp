@@ -0,0 +1,213 @@
+// Copyright 2024 The Dawn & Tint Authors
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+//
+// 1. Redistributions of source code must retain the above copyright notice, this
+//    list of conditions and the following disclaimer.
+//
+// 2. Redistributions in binary form must reproduce the above copyright notice,
+//    this list of conditions and the following disclaimer in the documentation
+//    and/or other materials provided with the distribution.
+//
+// 3. Neither the name of the copyright holder nor the names of its
+//    contributors may be used to endorse or promote products derived from
+//    this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+// DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+// FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+// DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+// SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+// CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+// OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+// OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+
+#include <benchmark/benchmark.h>
+#include <algorithm>
+#include <memory>
+#include <random>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+#include "dawn/common/Assert.h"
+#include "dawn/native/BuddyMemoryAllocator.h"
+#include "dawn/native/PooledResourceMemoryAllocator.h"
+#include "dawn/native/ResourceHeapAllocator.h"
+#include "dawn/native/TLSFMemoryAllocator.h"
+
+namespace dawn {
+namespace {
+
+using native::ResourceHeapBase;
+using native::ResourceMemoryAllocation;
+
+constexpr uint64_t kKiB = 1024;
+constexpr uint64_t kMiB = 1024 * kKiB;
+
+// Counts the heaps created, which are the vkAllocateMemory calls in the Vulkan backend.
+class CountingHeapAllocator : public native::ResourceHeapAllocator {
+  public:
+    native::ResultOrError<std::unique_ptr<ResourceHeapBase>> AllocateResourceHeap(
+        uint64_t size) override {
+        mHeapCount++;
+        return std::make_unique<ResourceHeapBase>();
+    }
+    void DeallocateResourceHeap(std::unique_ptr<ResourceHeapBase> allocation) override {}
+
+    uint64_t GetHeapCount() const { return mHeapCount; }
+
+  private:
+    uint64_t mHeapCount = 0;
+};
+
+struct TraceEntry {
+    // The allocation to free, or a new allocation when size isn't 0.
+    uint32_t id;
+    uint64_t size;
+    uint64_t alignment;
+};
+
+// Builds an allocation trace like the ones recorded while loading and streaming a scene: mostly
+// odd-sized vertex and index buffers, some uniform buffers and a few textures, freed in a
+// different order than they were allocated. Sizes are kept under the 4MiB limit sub-allocations
+// had with the buddy allocator so that both allocators see the same allocations. The trace is
+// seeded so that every run replays the same allocations.
+const std::vector<TraceEntry>& GetTrace() {
+    static const std::vector<TraceEntry> trace = [] {
+        constexpr uint32_t kAllocationCount = 20000;
+        constexpr size_t kMaxLiveAllocations = 1500;
+
+        std::mt19937_64 rng(1234);
+        auto uniform = [&](uint64_t min, uint64_t max) {
+            return std::uniform_int_distribution<uint64_t>(min, max)(rng);
+        };
+
+        std::vector<TraceEntry> entries;
+        std::vector<uint32_t> live;
+        for (uint32_t id = 0; id < kAllocationCount; ++id) {
+            // Free random allocations once the scene is loaded to emulate streaming.
+            while (live.size() >= uniform(kMaxLiveAllocations / 2, kMaxLiveAllocations)) {
+                size_t index = uniform(0, live.size() - 1);
+                entries.push_back({live[index], 0, 0});
+                live[index] = live.back();
+                live.pop_back();
+            }
+
+            uint64_t kind = uniform(0, 99);
+            TraceEntry entry = {id, 0, 256};
+            if (kind < 55) {
+                // Vertex buffers, with a stride that's a multiple of 4 bytes.
+                entry.size = uniform(1 * kKiB, 768 * kKiB) / 12 * 12;
+            } else if (kind < 75) {
+                // Index buffers.
+                entry.size = uniform(256, 256 * kKiB) / 2 * 2;
+            } else if (kind < 95) {
+                // Uniform buffers.
+                entry.size = uniform(1, 64) * 256;
+            } else {
+                // Textures, whose size is a multiple of their alignment.
+                entry.alignment = 64 * kKiB;
+                entry.size = uniform(1, 63) * 64 * kKiB;
+            }
+            entries.push_back(entry);
+            live.push_back(id);
+        }
+        for (uint32_t id : live) {
+            entries.push_back({id, 0, 0});
+        }
+        return entries;
+    }();
+    return trace;
+}
+
+// Replays the trace and reports the memory wasted by the allocator, that's the memory in heaps
+// that isn't used by allocations, averaged over the trace and at the peak heap size.
+template <typename Allocator, typename ComputeHeapSize>
+void ReplayTrace(benchmark::State& state,
+                 Allocator* allocator,
+                 ComputeHeapSize computeHeapSize,
+                 CountingHeapAllocator* heapAllocator) {
+    const std::vector<TraceEntry>& trace = GetTrace();
+
+    std::unordered_map<uint32_t, std::pair<ResourceMemoryAllocation, uint64_t>> live;
+    uint64_t liveSize = 0;
+    uint64_t peakHeapSize = 0;
+    uint64_t peakLiveSize = 0;
+    double wasteRatioSum = 0;
+    uint64_t failedAllocations = 0;
+
+    for (auto _ : state) {
+        wasteRatioSum = 0;
+        failedAllocations = 0;
+        for (const TraceEntry& entry : trace) {
+            if (entry.size == 0) {
+                auto it = live.find(entry.id);
+                if (it != live.end()) {
+                    allocator->Deallocate(it->second.first);
+                    liveSize -= it->second.second;
+                    live.erase(it);
+                }
+            } else {
+                ResourceMemoryAllocation allocation =
+                    allocator->Allocate(entry.size, entry.alignment).AcquireSuccess();
+                if (allocation.GetInfo().mMethod != native::AllocationMethod::kSubAllocated) {
+                    failedAllocations++;
+                    continue;
+                }
+                live.emplace(entry.id, std::make_pair(allocation, entry.size));
+                liveSize += entry.size;
+            }
+
+            uint64_t heapSize = computeHeapSize();
+            if (heapSize > peakHeapSize) {
+                peakHeapSize = heapSize;
+                peakLiveSize = liveSize;
+            }
+            if (heapSize > 0) {
+                wasteRatioSum += static_cast<double>(heapSize - liveSize) / heapSize;
+            }
+        }
+        DAWN_ASSERT(live.empty());
+    }
+
+    state.counters["avg_waste_pct"] = 100.0 * wasteRatioSum / trace.size();
+    state.counters["peak_heap_MiB"] = static_cast<double>(peakHeapSize) / kMiB;
+    state.counters["peak_waste_MiB"] = static_cast<double>(peakHeapSize - peakLiveSize) / kMiB;
+    state.counters["heaps_created"] = heapAllocator->GetHeapCount();
+    state.counters["failed_allocations"] = failedAllocations;
+}
+
+// The allocator used by the Vulkan backend before TLSFMemoryAllocator, with 8MiB heaps.
+void BM_BuddyMemoryAllocator(benchmark::State& state) {
+    constexpr uint64_t kHeapSize = 8 * kMiB;
+    CountingHeapAllocator heapAllocator;
+    native::PooledResourceMemoryAllocator pooledAllocator(&heapAllocator);
+    native::BuddyMemoryAllocator allocator(64 * 1024 * kMiB, kHeapSize, &pooledAllocator);
+
+    ReplayTrace(
+        state, &allocator,
+        [&] { return allocator.ComputeTotalNumOfHeapsForTesting() * kHeapSize; },
+        &heapAllocator);
+    pooledAllocator.DestroyPool();
+}
+
+// The argument is the heap size in MiB.
+void BM_TLSFMemoryAllocator(benchmark::State& state) {
+    CountingHeapAllocator heapAllocator;
+    native::PooledResourceMemoryAllocator pooledAllocator(&heapAllocator);
+    native::TLSFMemoryAllocator allocator(state.range(0) * kMiB, &pooledAllocator);
+
+    ReplayTrace(
+        state, &allocator, [&] { return allocator.ComputeUsage().heapSize; }, &heapAllocator);
+    pooledAllocator.DestroyPool();
+}
+
+BENCHMARK(BM_BuddyMemoryAllocator);
+BENCHMARK(BM_TLSFMemoryAllocator)->ArgName("heap_MiB")->Arg(8)->Arg(64)->Arg(256);
+
+}  // anonymous namespace
+}  // namespace dawn
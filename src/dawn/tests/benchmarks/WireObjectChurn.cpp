@@ -0,0 +1,108 @@
+// Copyright 2024 The Dawn & Tint Authors
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+//
+// 1. Redistributions of source code must retain the above copyright notice, this
+//    list of conditions and the following disclaimer.
+//
+// 2. Redistributions in binary form must reproduce the above copyright notice,
+//    this list of conditions and the following disclaimer in the documentation
+//    and/or other materials provided with the distribution.
+//
+// 3. Neither the name of the copyright holder nor the names of its
+//    contributors may be used to endorse or promote products derived from
+//    this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+// DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+// FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+// DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+// SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+// CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+// OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+// OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+
+#include <benchmark/benchmark.h>
+#include <memory>
+#include <vector>
+
+#include "dawn/wire/client/ObjectStore.h"
+#include "dawn/wire/server/ObjectStorage.h"
+
+namespace dawn {
+namespace {
+
+using wire::ObjectHandle;
+using wire::ObjectId;
+using wire::client::ObjectBase;
+using wire::client::ObjectStore;
+
+class ChurnObject : public ObjectBase {
+  public:
+    explicit ChurnObject(ObjectHandle handle) : ObjectBase({nullptr, handle}) {}
+};
+
+// Each thread repeatedly creates a batch of transient objects, looks them up like the handling of
+// server replies would, and frees them, all in the same ObjectStore.
+void BM_ClientObjectStoreChurn(benchmark::State& state) {
+    static ObjectStore* store = nullptr;
+    if (state.thread_index() == 0) {
+        store = new ObjectStore();
+    }
+
+    LinkedList<ObjectBase> objects;
+    std::vector<ObjectBase*> batch(state.range(0));
+    for (auto _ : state) {
+        for (ObjectBase*& object : batch) {
+            object = new ChurnObject(store->ReserveHandle());
+            objects.Append(object);
+            store->Insert(std::unique_ptr<ObjectBase>(object));
+        }
+        for (ObjectBase* object : batch) {
+            benchmark::DoNotOptimize(store->Get(object->GetWireHandle()));
+        }
+        for (ObjectBase* object : batch) {
+            store->Free(object);
+        }
+    }
+    state.SetItemsProcessed(state.iterations() * state.range(0));
+
+    if (state.thread_index() == 0) {
+        delete store;
+        store = nullptr;
+    }
+}
+BENCHMARK(BM_ClientObjectStoreChurn)->Arg(16)->Arg(256)->ThreadRange(1, 8)->UseRealTime();
+
+// The server stores the ID of each object it creates and removes it when the object is destroyed.
+// Lookups happen when sending replies to the client.
+void BM_ServerObjectIdLookupTableChurn(benchmark::State& state) {
+    // The number of long-lived objects in the table.
+    std::vector<int> liveObjects(state.range(0));
+    std::vector<int> transientObjects(64);
+
+    wire::server::ObjectIdLookupTable<int*> table;
+    for (size_t i = 0; i < liveObjects.size(); ++i) {
+        table.Store(&liveObjects[i], ObjectId(i + 1));
+    }
+
+    for (auto _ : state) {
+        for (size_t i = 0; i < transientObjects.size(); ++i) {
+            table.Store(&transientObjects[i], ObjectId(liveObjects.size() + i + 1));
+        }
+        for (int& object : transientObjects) {
+            benchmark::DoNotOptimize(table.Get(&object));
+        }
+        for (int& object : transientObjects) {
+            table.Remove(&object);
+        }
+    }
+    state.SetItemsProcessed(state.iterations() * transientObjects.size());
+}
+BENCHMARK(BM_ServerObjectIdLookupTableChurn)->Arg(0)->Arg(1024)->Arg(65536);
+
+}  // anonymous namespace
+}  // namespace dawn
@@ -0,0 +1,123 @@
+// Copyright 2024 The Dawn & Tint Authors
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+//
+// 1. Redistributions of source code must retain the above copyright notice, this
+//    list of conditions and the following disclaimer.
+//
+// 2. Redistributions in binary form must reproduce the above copyright notice,
+//    this list of conditions and the following disclaimer in the documentation
+//    and/or other materials provided with the distribution.
+//
+// 3. Neither the name of the copyright holder nor the names of its
+//    contributors may be used to endorse or promote products derived from
+//    this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+// DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+// FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+// DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+// SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+// CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+// OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+// OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+
+#include <benchmark/benchmark.h>
+#include <atomic>
+#include <cstring>
+#include <memory>
+#include <thread>
+
+#include "dawn/common/Assert.h"
+#include "dawn/utils/SharedMemoryRingBuffer.h"
+#include "dawn/utils/TerribleCommandBuffer.h"
+#include "dawn/wire/Wire.h"
+
+namespace dawn {
+namespace {
+
+constexpr size_t kCommandsPerFlush = 64;
+constexpr size_t kRingCapacity = 1 << 20;
+
+// Reads all the command data like a deserializer would, without doing anything with it.
+class ReadingHandler : public wire::CommandHandler {
+  public:
+    const volatile char* HandleCommands(const volatile char* commands, size_t size) override {
+        uint64_t checksum = 0;
+        for (size_t i = 0; i < size; i += sizeof(uint64_t)) {
+            checksum += *reinterpret_cast<const volatile uint64_t*>(commands + i);
+        }
+        benchmark::DoNotOptimize(checksum);
+        return commands + size;
+    }
+};
+
+// Serializes kCommandsPerFlush commands of state.range(0) bytes, then flushes.
+void SerializeAndFlush(benchmark::State& state, wire::CommandSerializer* serializer) {
+    size_t commandSize = static_cast<size_t>(state.range(0));
+    for (auto _ : state) {
+        for (size_t i = 0; i < kCommandsPerFlush; ++i) {
+            void* command = serializer->GetCmdSpace(commandSize);
+            DAWN_ASSERT(command != nullptr);
+            memset(command, static_cast<int>(i), commandSize);
+        }
+        bool success = serializer->Flush();
+        DAWN_ASSERT(success);
+    }
+    state.SetBytesProcessed(state.iterations() * kCommandsPerFlush * commandSize);
+}
+
+// The transport used by WireHelper so far: a fixed array that is handled synchronously on Flush.
+void BM_TerribleCommandBuffer(benchmark::State& state) {
+    ReadingHandler handler;
+    auto buffer = std::make_unique<utils::TerribleCommandBuffer>(&handler);
+    SerializeAndFlush(state, buffer.get());
+}
+BENCHMARK(BM_TerribleCommandBuffer)->Arg(64)->Arg(1024)->Arg(16384);
+
+// The shared memory ring with the consumer on the same thread, as used by WireHelper.
+void BM_SharedMemoryRingLocal(benchmark::State& state) {
+    auto buffer = utils::SharedMemoryCommandBuffer::Create(kRingCapacity);
+    if (buffer == nullptr) {
+        state.SkipWithError("Shared memory is not supported");
+        return;
+    }
+    ReadingHandler handler;
+    buffer->SetHandler(&handler);
+    SerializeAndFlush(state, buffer.get());
+}
+BENCHMARK(BM_SharedMemoryRingLocal)->Arg(64)->Arg(1024)->Arg(16384);
+
+// The shared memory ring with the consumer polling on another thread, like it would in another
+// process, so serialization and deserialization are pipelined.
+void BM_SharedMemoryRingThreaded(benchmark::State& state) {
+    auto ring = utils::SharedMemoryRingBuffer::Create(kRingCapacity);
+    if (ring == nullptr) {
+        state.SkipWithError("Shared memory is not supported");
+        return;
+    }
+    ReadingHandler handler;
+    utils::SharedMemoryCommandSerializer serializer(ring.get());
+    utils::SharedMemoryCommandReceiver receiver(ring.get(), &handler);
+
+    std::thread consumer([&] {
+        while (!ring->IsClosed()) {
+            if (!receiver.ProcessCommands()) {
+                return;
+            }
+            std::this_thread::yield();
+        }
+    });
+
+    SerializeAndFlush(state, &serializer);
+
+    ring->Close();
+    consumer.join();
+}
+BENCHMARK(BM_SharedMemoryRingThreaded)->Arg(64)->Arg(1024)->Arg(16384)->UseRealTime();
+
+}  // anonymous namespace
+}  // namespace dawn
@@ -0,0 +1,143 @@
+// Copyright 2024 The Dawn & Tint Authors
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+//
+// 1. Redistributions of source code must retain the above copyright notice, this
+//    list of conditions and the following disclaimer.
+//
+// 2. Redistributions in binary form must reproduce the above copyright notice,
+//    this list of conditions and the following disclaimer in the documentation
+//    and/or other materials provided with the distribution.
+//
+// 3. Neither the name of the copyright holder nor the names of its
+//    contributors may be used to endorse or promote products derived from
+//    this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+// DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+// FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+// DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+// SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+// CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+// OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+// OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+
+#include <benchmark/benchmark.h>
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <memory>
+#include <thread>
+#include <vector>
+
+#include "dawn/platform/WorkerThread.h"
+
+namespace dawn {
+namespace {
+
+using platform::WaitableEvent;
+
+// Tracks how many tasks run concurrently, which for ThreadPerTaskPool is also the number of live
+// worker threads.
+struct TaskStats {
+    std::atomic<uint32_t> runningTasks = 0;
+    std::atomic<uint32_t> peakRunningTasks = 0;
+    std::chrono::microseconds taskDuration;
+};
+
+void DoTask(void* userdata) {
+    TaskStats* stats = static_cast<TaskStats*>(userdata);
+    uint32_t running = stats->runningTasks.fetch_add(1) + 1;
+    uint32_t peak = stats->peakRunningTasks.load();
+    while (running > peak && !stats->peakRunningTasks.compare_exchange_weak(peak, running)) {
+    }
+
+    // Busy-wait to emulate CPU-bound work like shader compilation.
+    auto end = std::chrono::steady_clock::now() + stats->taskDuration;
+    while (std::chrono::steady_clock::now() < end) {
+    }
+    stats->runningTasks.fetch_sub(1);
+}
+
+// The previous implementation of AsyncWorkerThreadPool, which started a detached thread per task.
+class ThreadPerTaskPool : public platform::WorkerTaskPool {
+  public:
+    std::unique_ptr<WaitableEvent> PostWorkerTask(platform::PostWorkerTaskCallback callback,
+                                                  void* userdata) override {
+        auto event = std::make_unique<Event>();
+        std::shared_ptr<std::atomic<bool>> isComplete = event->isComplete;
+        std::thread([callback, userdata, isComplete] {
+            callback(userdata);
+            isComplete->store(true);
+        }).detach();
+        return event;
+    }
+
+  private:
+    struct Event : WaitableEvent {
+        void Wait() override {
+            while (!IsComplete()) {
+                std::this_thread::yield();
+            }
+        }
+        bool IsComplete() override { return isComplete->load(); }
+
+        std::shared_ptr<std::atomic<bool>> isComplete = std::make_shared<std::atomic<bool>>(false);
+    };
+};
+
+// Posts a burst of tasks like the ones CreateRenderPipelineAsync creates while warming up
+// pipelines and waits for all of them.
+void RunBurst(benchmark::State& state, platform::WorkerTaskPool* pool) {
+    TaskStats stats;
+    stats.taskDuration = std::chrono::microseconds(state.range(1));
+    int64_t taskCount = state.range(0);
+
+    std::vector<std::unique_ptr<WaitableEvent>> events;
+    events.reserve(taskCount);
+    for (auto _ : state) {
+        for (int64_t i = 0; i < taskCount; ++i) {
+            events.push_back(pool->PostWorkerTask(DoTask, &stats));
+        }
+        for (std::unique_ptr<WaitableEvent>& event : events) {
+            event->Wait();
+        }
+        events.clear();
+    }
+
+    state.SetItemsProcessed(state.iterations() * taskCount);
+    state.counters["peak_concurrent_tasks"] = stats.peakRunningTasks.load();
+}
+
+void BM_ThreadPerTask(benchmark::State& state) {
+    ThreadPerTaskPool pool;
+    RunBurst(state, &pool);
+    // Every task gets its own thread.
+    state.counters["peak_threads"] = state.counters["peak_concurrent_tasks"];
+}
+
+void BM_AsyncWorkerThreadPool(benchmark::State& state) {
+    platform::AsyncWorkerThreadPool pool;
+    RunBurst(state, &pool);
+    state.counters["peak_threads"] = pool.GetStartedWorkerCount();
+}
+
+// Arguments are the number of tasks in the burst and the duration of each task in microseconds.
+void BurstArguments(benchmark::internal::Benchmark* b) {
+    b->ArgNames({"tasks", "task_us"});
+    for (int64_t taskCount : {16, 256, 1024}) {
+        for (int64_t taskDuration : {0, 50, 500}) {
+            b->Args({taskCount, taskDuration});
+        }
+    }
+    b->UseRealTime();
+}
+
+BENCHMARK(BM_ThreadPerTask)->Apply(BurstArguments);
+BENCHMARK(BM_AsyncWorkerThreadPool)->Apply(BurstArguments);
+
+}  // anonymous namespace
+}  // namespace dawn
@@ -93,7 +93,7 @@ TEST_P(D3D12CachingTests, SameShaderNoCache) {
 
 // Test creating a pipeline from two entrypoints in multiple stages will cache the correct number
 // of HLSL shaders. WGSL shader should result into caching 2 HLSL shaders (stage x
-// entrypoints)
+// entrypoints), in addition to the reflection of the shader module.
 TEST_P(D3D12CachingTests, ReuseShaderWithMultipleEntryPointsPerStage) {
     wgpu::ShaderModule module = utils::CreateShaderModule(device, R"(
         @vertex fn vertex_main() -> @builtin(position) vec4f {
@@ -114,7 +114,7 @@ TEST_P(D3D12CachingTests, ReuseShaderWithMultipleEntryPointsPerStage) {
         desc.cFragment.entryPoint = "fragment_main";
         EXPECT_CACHE_HIT(mMockCache, 0u, device.CreateRenderPipeline(&desc));
     }
-    EXPECT_EQ(mMockCache.GetNumEntries(), 2u);
+    EXPECT_EQ(mMockCache.GetNumEntries(), 3u);
 
     // Load the same WGSL shader from the cache.
     {
@@ -125,7 +125,7 @@ TEST_P(D3D12CachingTests, ReuseShaderWithMultipleEntryPointsPerStage) {
         desc.cFragment.entryPoint = "fragment_main";
         EXPECT_CACHE_HIT(mMockCache, 2u, device.CreateRenderPipeline(&desc));
     }
-    EXPECT_EQ(mMockCache.GetNumEntries(), 2u);
+    EXPECT_EQ(mMockCache.GetNumEntries(), 3u);
 
     // Modify the WGSL shader functions and make sure it doesn't hit.
     wgpu::ShaderModule newModule = utils::CreateShaderModule(device, R"(
@@ -146,11 +146,12 @@ TEST_P(D3D12CachingTests, ReuseShaderWithMultipleEntryPointsPerStage) {
         desc.cFragment.entryPoint = "fragment_main";
         EXPECT_CACHE_HIT(mMockCache, 0u, device.CreateRenderPipeline(&desc));
     }
-    EXPECT_EQ(mMockCache.GetNumEntries(), 4u);
+    EXPECT_EQ(mMockCache.GetNumEntries(), 6u);
 }
 
 // Test creating a WGSL shader with two entrypoints in the same stage will cache the correct number
-// of HLSL shaders. WGSL shader should result into caching 1 HLSL shader (stage x entrypoints)
+// of HLSL shaders. WGSL shader should result into caching 1 HLSL shader (stage x entrypoints), in
+// addition to the reflection of the shader module.
 TEST_P(D3D12CachingTests, ReuseShaderWithMultipleEntryPoints) {
     wgpu::ShaderModule module = utils::CreateShaderModule(device, R"(
         struct Data {
@@ -178,7 +179,7 @@ TEST_P(D3D12CachingTests, ReuseShaderWithMultipleEntryPoints) {
         desc.compute.entryPoint = "write42";
         EXPECT_CACHE_HIT(mMockCache, 0u, device.CreateComputePipeline(&desc));
     }
-    EXPECT_EQ(mMockCache.GetNumEntries(), 2u);
+    EXPECT_EQ(mMockCache.GetNumEntries(), 3u);
 
     // Load the same WGSL shader from the cache.
     {
@@ -191,7 +192,7 @@ TEST_P(D3D12CachingTests, ReuseShaderWithMultipleEntryPoints) {
         desc.compute.entryPoint = "write42";
         EXPECT_CACHE_HIT(mMockCache, 1u, device.CreateComputePipeline(&desc));
     }
-    EXPECT_EQ(mMockCache.GetNumEntries(), 2u);
+    EXPECT_EQ(mMockCache.GetNumEntries(), 3u);
 }
 
 DAWN_INSTANTIATE_TEST(D3D12CachingTests, D3D12Backend());
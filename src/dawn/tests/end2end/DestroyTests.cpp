@@ -171,6 +171,65 @@ TEST_P(DestroyTest, TextureSubmitDestroySubmit) {
     ASSERT_DEVICE_ERROR(queue.Submit(1, &commands));
 }
 
+// Destroying a texture releases its GL name, which the next texture of the same size is likely to
+// reuse. Rendering to and reading back from the new texture must not hit state cached for the old
+// one.
+TEST_P(DestroyTest, TextureDestroyThenRecreate) {
+    utils::RGBA8 filled(0, 255, 0, 255);
+    utils::RGBA8 cleared(255, 0, 0, 255);
+
+    wgpu::CommandBuffer commands = CreateTriangleCommandBuffer();
+    queue.Submit(1, &commands);
+    EXPECT_PIXEL_RGBA8_EQ(filled, renderPass.color, 1, 3);
+
+    renderPass.color.Destroy();
+
+    renderPass = utils::CreateBasicRenderPass(device, kRTSize, kRTSize);
+    renderPass.renderPassInfo.cColorAttachments[0].clearValue = {1.0f, 0.0f, 0.0f, 1.0f};
+    commands = CreateTriangleCommandBuffer();
+    queue.Submit(1, &commands);
+
+    EXPECT_PIXEL_RGBA8_EQ(filled, renderPass.color, 1, 3);
+    EXPECT_PIXEL_RGBA8_EQ(cleared, renderPass.color, 3, 0);
+}
+
+// Same as TextureDestroyThenRecreate, but render through a view whose format differs from the
+// texture's, so that on OpenGL the view owns its own texture name as well.
+TEST_P(DestroyTest, TextureWithReinterpretedViewDestroyThenRecreate) {
+    // TODO(crbug.com/dawn/1360): OpenGLES doesn't support view format reinterpretation.
+    DAWN_TEST_UNSUPPORTED_IF(IsOpenGLES());
+
+    wgpu::TextureViewDescriptor viewDesc = {};
+    viewDesc.format = wgpu::TextureFormat::RGBA8UnormSrgb;
+
+    wgpu::TextureDescriptor textureDesc = {};
+    textureDesc.size = {kRTSize, kRTSize, 1};
+    textureDesc.usage = wgpu::TextureUsage::CopySrc | wgpu::TextureUsage::RenderAttachment;
+    textureDesc.format = wgpu::TextureFormat::RGBA8Unorm;
+    textureDesc.viewFormats = &viewDesc.format;
+    textureDesc.viewFormatCount = 1;
+
+    auto ClearThroughView = [&](wgpu::Texture texture, const wgpu::Color& clearValue) {
+        utils::ComboRenderPassDescriptor renderPassInfo({texture.CreateView(&viewDesc)});
+        renderPassInfo.cColorAttachments[0].clearValue = clearValue;
+
+        wgpu::CommandEncoder encoder = device.CreateCommandEncoder();
+        encoder.BeginRenderPass(&renderPassInfo).End();
+        wgpu::CommandBuffer commands = encoder.Finish();
+        queue.Submit(1, &commands);
+    };
+
+    wgpu::Texture texture = device.CreateTexture(&textureDesc);
+    ClearThroughView(texture, {0.0f, 1.0f, 0.0f, 1.0f});
+    EXPECT_PIXEL_RGBA8_EQ(utils::RGBA8(0, 255, 0, 255), texture, 0, 0);
+
+    texture.Destroy();
+
+    texture = device.CreateTexture(&textureDesc);
+    ClearThroughView(texture, {1.0f, 0.0f, 0.0f, 1.0f});
+    EXPECT_PIXEL_RGBA8_EQ(utils::RGBA8(255, 0, 0, 255), texture, 0, 0);
+}
+
 // Attempting to set an object label after it has been destroyed should not cause an error.
 TEST_P(DestroyTest, DestroyObjectThenSetLabel) {
     DAWN_TEST_UNSUPPORTED_IF(UsesWire());
@@ -239,6 +239,201 @@ DAWN_INSTANTIATE_TEST(
     VulkanBackend(),
     VulkanBackend({"vulkan_split_command_buffer_on_compute_pass_after_render_pass"}));
 
+// Tests submitting many command buffers at once, some of which use the same resources. With the
+// vulkan_multithreaded_command_recording toggle, the command buffers that don't use any resource
+// in common are recorded concurrently.
+class MultipleCommandBuffersSyncTests : public GpuMemorySyncTests {
+  protected:
+    static constexpr uint32_t kResourceCount = 4;
+    static constexpr uint32_t kCommandBufferCount = 16;
+};
+
+// Each command buffer increments one of the storage buffers a few times in compute passes. The
+// command buffers using the same storage buffer make a data dependency chain across the submit.
+TEST_P(MultipleCommandBuffersSyncTests, ComputePasses) {
+    std::vector<wgpu::Buffer> buffers;
+    std::vector<wgpu::ComputePipeline> pipelines;
+    std::vector<wgpu::BindGroup> bindGroups;
+    for (uint32_t i = 0; i < kResourceCount; ++i) {
+        buffers.push_back(CreateBuffer());
+        auto [compute, bindGroup] = CreatePipelineAndBindGroupForCompute(buffers.back());
+        pipelines.push_back(compute);
+        bindGroups.push_back(bindGroup);
+    }
+
+    int iteration = 3;
+    std::vector<wgpu::CommandBuffer> commands;
+    for (uint32_t i = 0; i < kCommandBufferCount; ++i) {
+        wgpu::CommandEncoder encoder = device.CreateCommandEncoder();
+        for (int j = 0; j < iteration; ++j) {
+            wgpu::ComputePassEncoder pass = encoder.BeginComputePass();
+            pass.SetPipeline(pipelines[i % kResourceCount]);
+            pass.SetBindGroup(0, bindGroups[i % kResourceCount]);
+            pass.DispatchWorkgroups(1);
+            pass.End();
+        }
+        commands.push_back(encoder.Finish());
+    }
+    queue.Submit(commands.size(), commands.data());
+
+    // Verify the result.
+    for (const wgpu::Buffer& buffer : buffers) {
+        EXPECT_BUFFER_U32_EQ(iteration * kCommandBufferCount / kResourceCount, buffer, 0);
+    }
+}
+
+// Each command buffer renders to its own render target while incrementing one of the storage
+// buffers. The render targets start uninitialized but only need to be cleared with the load
+// operation of the render pass.
+TEST_P(MultipleCommandBuffersSyncTests, RenderPasses) {
+    std::vector<wgpu::Buffer> buffers;
+    std::vector<utils::BasicRenderPass> renderPasses;
+    std::vector<wgpu::RenderPipeline> pipelines;
+    std::vector<wgpu::BindGroup> bindGroups;
+    for (uint32_t i = 0; i < kResourceCount; ++i) {
+        buffers.push_back(CreateBuffer());
+        renderPasses.push_back(utils::CreateBasicRenderPass(device, 1, 1));
+        auto [render, bindGroup] =
+            CreatePipelineAndBindGroupForRender(buffers.back(), renderPasses.back().colorFormat);
+        pipelines.push_back(render);
+        bindGroups.push_back(bindGroup);
+    }
+
+    std::vector<wgpu::CommandBuffer> commands;
+    for (uint32_t i = 0; i < kCommandBufferCount; ++i) {
+        utils::BasicRenderPass& renderPass = renderPasses[i % kResourceCount];
+        wgpu::CommandEncoder encoder = device.CreateCommandEncoder();
+        wgpu::RenderPassEncoder pass = encoder.BeginRenderPass(&renderPass.renderPassInfo);
+        pass.SetPipeline(pipelines[i % kResourceCount]);
+        pass.SetBindGroup(0, bindGroups[i % kResourceCount]);
+        pass.Draw(1);
+        pass.End();
+        commands.push_back(encoder.Finish());
+    }
+    queue.Submit(commands.size(), commands.data());
+
+    // Verify the result.
+    for (const utils::BasicRenderPass& renderPass : renderPasses) {
+        EXPECT_PIXEL_RGBA8_EQ(utils::RGBA8(kCommandBufferCount / kResourceCount, 0, 0, 255),
+                              renderPass.color, 0, 0);
+    }
+}
+
+// Interleave command buffers that copy from uninitialized buffers, and need lazy clears, with
+// command buffers that increment storage buffers in compute passes.
+TEST_P(MultipleCommandBuffersSyncTests, LazyClearsBetweenComputePasses) {
+    std::vector<wgpu::Buffer> buffers;
+    std::vector<wgpu::ComputePipeline> pipelines;
+    std::vector<wgpu::BindGroup> bindGroups;
+    for (uint32_t i = 0; i < kResourceCount; ++i) {
+        buffers.push_back(CreateBuffer());
+        auto [compute, bindGroup] = CreatePipelineAndBindGroupForCompute(buffers.back());
+        pipelines.push_back(compute);
+        bindGroups.push_back(bindGroup);
+    }
+
+    wgpu::BufferDescriptor copyDesc;
+    copyDesc.size = 4;
+    copyDesc.usage = wgpu::BufferUsage::CopySrc | wgpu::BufferUsage::CopyDst;
+
+    std::vector<wgpu::Buffer> copyDestinations;
+    std::vector<wgpu::CommandBuffer> commands;
+    for (uint32_t i = 0; i < kCommandBufferCount; ++i) {
+        wgpu::CommandEncoder encoder = device.CreateCommandEncoder();
+        if (i % 3 == 1) {
+            wgpu::Buffer source = device.CreateBuffer(&copyDesc);
+            copyDestinations.push_back(device.CreateBuffer(&copyDesc));
+            encoder.CopyBufferToBuffer(source, 0, copyDestinations.back(), 0, 4);
+        } else {
+            wgpu::ComputePassEncoder pass = encoder.BeginComputePass();
+            pass.SetPipeline(pipelines[i % kResourceCount]);
+            pass.SetBindGroup(0, bindGroups[i % kResourceCount]);
+            pass.DispatchWorkgroups(1);
+            pass.End();
+        }
+        commands.push_back(encoder.Finish());
+    }
+    queue.Submit(commands.size(), commands.data());
+
+    // Verify the result.
+    for (uint32_t i = 0; i < kResourceCount; ++i) {
+        uint32_t expected = 0;
+        for (uint32_t j = i; j < kCommandBufferCount; j += kResourceCount) {
+            expected += j % 3 == 1 ? 0 : 1;
+        }
+        EXPECT_BUFFER_U32_EQ(expected, buffers[i], 0);
+    }
+    for (const wgpu::Buffer& buffer : copyDestinations) {
+        EXPECT_BUFFER_U32_EQ(0, buffer, 0);
+    }
+}
+
+// Each command buffer increments one of the storage buffers in a render pass and then in a compute
+// pass. With the vulkan_split_command_buffer_on_compute_pass_after_render_pass toggle, these
+// command buffers are recorded on the submitting thread since the split begins a new command
+// buffer from the queue.
+TEST_P(MultipleCommandBuffersSyncTests, RenderPassesThenComputePasses) {
+    std::vector<wgpu::Buffer> buffers;
+    std::vector<utils::BasicRenderPass> renderPasses;
+    std::vector<wgpu::RenderPipeline> renderPipelines;
+    std::vector<wgpu::BindGroup> renderBindGroups;
+    std::vector<wgpu::ComputePipeline> computePipelines;
+    std::vector<wgpu::BindGroup> computeBindGroups;
+    for (uint32_t i = 0; i < kResourceCount; ++i) {
+        buffers.push_back(CreateBuffer());
+        renderPasses.push_back(utils::CreateBasicRenderPass(device, 1, 1));
+        auto [render, renderBindGroup] =
+            CreatePipelineAndBindGroupForRender(buffers.back(), renderPasses.back().colorFormat);
+        renderPipelines.push_back(render);
+        renderBindGroups.push_back(renderBindGroup);
+        auto [compute, computeBindGroup] = CreatePipelineAndBindGroupForCompute(buffers.back());
+        computePipelines.push_back(compute);
+        computeBindGroups.push_back(computeBindGroup);
+    }
+
+    std::vector<wgpu::CommandBuffer> commands;
+    for (uint32_t i = 0; i < kCommandBufferCount; ++i) {
+        wgpu::CommandEncoder encoder = device.CreateCommandEncoder();
+
+        wgpu::RenderPassEncoder renderPass =
+            encoder.BeginRenderPass(&renderPasses[i % kResourceCount].renderPassInfo);
+        renderPass.SetPipeline(renderPipelines[i % kResourceCount]);
+        renderPass.SetBindGroup(0, renderBindGroups[i % kResourceCount]);
+        renderPass.Draw(1);
+        renderPass.End();
+
+        wgpu::ComputePassEncoder computePass = encoder.BeginComputePass();
+        computePass.SetPipeline(computePipelines[i % kResourceCount]);
+        computePass.SetBindGroup(0, computeBindGroups[i % kResourceCount]);
+        computePass.DispatchWorkgroups(1);
+        computePass.End();
+
+        commands.push_back(encoder.Finish());
+    }
+    queue.Submit(commands.size(), commands.data());
+
+    // Verify the result. The last render pass on each render target sees the increments of all the
+    // previous passes on its storage buffer.
+    for (uint32_t i = 0; i < kResourceCount; ++i) {
+        uint32_t increments = 2 * kCommandBufferCount / kResourceCount;
+        EXPECT_BUFFER_U32_EQ(increments, buffers[i], 0);
+        EXPECT_PIXEL_RGBA8_EQ(utils::RGBA8(increments - 1, 0, 0, 255), renderPasses[i].color, 0,
+                              0);
+    }
+}
+
+DAWN_INSTANTIATE_TEST(MultipleCommandBuffersSyncTests,
+                      D3D11Backend(),
+                      D3D12Backend(),
+                      MetalBackend(),
+                      OpenGLBackend(),
+                      OpenGLESBackend(),
+                      VulkanBackend(),
+                      VulkanBackend({"vulkan_multithreaded_command_recording"}),
+                      VulkanBackend(
+                          {"vulkan_multithreaded_command_recording",
+                           "vulkan_split_command_buffer_on_compute_pass_after_render_pass"}));
+
 class StorageToUniformSyncTests : public DawnTest {
   protected:
     void CreateBuffer() {
@@ -409,7 +604,8 @@ DAWN_INSTANTIATE_TEST(StorageToUniformSyncTests,
                       MetalBackend(),
                       OpenGLBackend(),
                       OpenGLESBackend(),
-                      VulkanBackend());
+                      VulkanBackend(),
+                      VulkanBackend({"vulkan_multithreaded_command_recording"}));
 
 constexpr int kRTSize = 8;
 constexpr int kVertexBufferStride = 4 * sizeof(float);
@@ -285,6 +285,30 @@ TEST_P(SinglePipelineCachingTests, ComputePipelineBlobCacheIsolationKey) {
     }
 }
 
+// Tests that shader module creation loads the reflection of the shader from the cache when it is
+// enabled, and that the created module can still compile pipelines that aren't in the cache.
+TEST_P(SinglePipelineCachingTests, ShaderModuleReflectionBlobCache) {
+    // First time should parse the shader and write its reflection out to the cache.
+    {
+        wgpu::Device device = CreateDevice();
+        EXPECT_CACHE_STATS(
+            mMockCache, Hit(0), Add(1),
+            utils::CreateShaderModule(device, kComputeShaderMultipleEntryPoints.data()));
+    }
+
+    // Second time should create the shader module from the cached reflection.
+    {
+        wgpu::Device device = CreateDevice();
+        wgpu::ComputePipelineDescriptor desc;
+        EXPECT_CACHE_STATS(mMockCache, Hit(1), Add(0),
+                           desc.compute.module = utils::CreateShaderModule(
+                               device, kComputeShaderMultipleEntryPoints.data()));
+        desc.compute.entryPoint = "main2";
+        EXPECT_CACHE_STATS(mMockCache, Hit(0), Add(counts.shaderModule + counts.pipeline),
+                           device.CreateComputePipeline(&desc));
+    }
+}
+
 // Tests that pipeline creation works fine even if the cache is disabled.
 // Note: This tests needs to use more than 1 device since the frontend cache on each device
 //   will prevent going out to the blob cache.
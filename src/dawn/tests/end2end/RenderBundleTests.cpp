@@ -209,13 +209,202 @@ TEST_P(RenderBundleTest, BundleAndRenderPassCommands) {
     EXPECT_PIXEL_RGBA8_EQ(kColors[1], renderPass.color, 3, 1);
 }
 
+// Test execution of the same bundle in several submits.
+TEST_P(RenderBundleTest, BundleReplayedAcrossSubmits) {
+    utils::ComboRenderBundleEncoderDescriptor desc = {};
+    desc.colorFormatCount = 1;
+    desc.cColorFormats[0] = renderPass.colorFormat;
+
+    wgpu::RenderBundleEncoder renderBundleEncoder = device.CreateRenderBundleEncoder(&desc);
+
+    renderBundleEncoder.SetPipeline(pipeline);
+    renderBundleEncoder.SetVertexBuffer(0, vertexBuffer);
+    renderBundleEncoder.SetBindGroup(0, bindGroups[0]);
+    renderBundleEncoder.Draw(3);
+
+    wgpu::RenderBundle renderBundle = renderBundleEncoder.Finish();
+
+    for (uint32_t i = 0; i < 3; ++i) {
+        // Each pass clears the render target so that every submit has to draw again.
+        wgpu::CommandEncoder encoder = device.CreateCommandEncoder();
+
+        wgpu::RenderPassEncoder pass = encoder.BeginRenderPass(&renderPass.renderPassInfo);
+        pass.ExecuteBundles(1, &renderBundle);
+        pass.End();
+
+        wgpu::CommandBuffer commands = encoder.Finish();
+        queue.Submit(1, &commands);
+
+        EXPECT_PIXEL_RGBA8_EQ(kColors[0], renderPass.color, 1, 3);
+        EXPECT_PIXEL_RGBA8_EQ(utils::RGBA8::kZero, renderPass.color, 3, 1);
+    }
+}
+
+// Test that a bundle executed in passes of more sizes than the Vulkan backend keeps command buffers
+// for still draws correctly, both the first time and after its least recently used command buffers
+// were evicted and freed.
+TEST_P(RenderBundleTest, ManyRenderPassSizes) {
+    utils::ComboRenderBundleEncoderDescriptor desc = {};
+    desc.colorFormatCount = 1;
+    desc.cColorFormats[0] = renderPass.colorFormat;
+
+    wgpu::RenderBundleEncoder renderBundleEncoder = device.CreateRenderBundleEncoder(&desc);
+
+    renderBundleEncoder.SetPipeline(pipeline);
+    renderBundleEncoder.SetVertexBuffer(0, vertexBuffer);
+    renderBundleEncoder.SetBindGroup(0, bindGroups[0]);
+    renderBundleEncoder.Draw(3);
+    renderBundleEncoder.SetBindGroup(0, bindGroups[1]);
+    renderBundleEncoder.Draw(3, 1, 3);
+
+    wgpu::RenderBundle renderBundle = renderBundleEncoder.Finish();
+
+    constexpr uint32_t kSizes[] = {4, 5, 6, 7, 8, 9};
+    for (uint32_t round = 0; round < 2; ++round) {
+        for (uint32_t size : kSizes) {
+            utils::BasicRenderPass sizedRenderPass =
+                utils::CreateBasicRenderPass(device, size, size);
+
+            wgpu::CommandEncoder encoder = device.CreateCommandEncoder();
+            wgpu::RenderPassEncoder pass =
+                encoder.BeginRenderPass(&sizedRenderPass.renderPassInfo);
+            pass.ExecuteBundles(1, &renderBundle);
+            pass.End();
+
+            wgpu::CommandBuffer commands = encoder.Finish();
+            queue.Submit(1, &commands);
+
+            EXPECT_PIXEL_RGBA8_EQ(kColors[0], sizedRenderPass.color, 1, size - 1);
+            EXPECT_PIXEL_RGBA8_EQ(kColors[1], sizedRenderPass.color, size - 1, 1);
+        }
+
+        // Let the GPU finish so that the evicted command buffers are freed in the next round.
+        WaitForAllOperations();
+    }
+}
+
+// Test execution of a bundle with indirect draws, which the Vulkan backend always records inline.
+TEST_P(RenderBundleTest, BundleWithDrawIndirect) {
+    wgpu::Buffer indirectBuffer = utils::CreateBufferFromData<uint32_t>(
+        device, wgpu::BufferUsage::Indirect, {3, 1, 0, 0, 3, 1, 3, 0});
+
+    utils::ComboRenderBundleEncoderDescriptor desc = {};
+    desc.colorFormatCount = 1;
+    desc.cColorFormats[0] = renderPass.colorFormat;
+
+    wgpu::RenderBundleEncoder renderBundleEncoder = device.CreateRenderBundleEncoder(&desc);
+
+    renderBundleEncoder.SetPipeline(pipeline);
+    renderBundleEncoder.SetVertexBuffer(0, vertexBuffer);
+    renderBundleEncoder.SetBindGroup(0, bindGroups[0]);
+    renderBundleEncoder.DrawIndirect(indirectBuffer, 0);
+    renderBundleEncoder.SetBindGroup(0, bindGroups[1]);
+    renderBundleEncoder.DrawIndirect(indirectBuffer, 4 * sizeof(uint32_t));
+
+    wgpu::RenderBundle renderBundle = renderBundleEncoder.Finish();
+
+    // Execute the bundle in two submits since indirect draws are validated on every execution.
+    for (uint32_t i = 0; i < 2; ++i) {
+        wgpu::CommandEncoder encoder = device.CreateCommandEncoder();
+
+        wgpu::RenderPassEncoder pass = encoder.BeginRenderPass(&renderPass.renderPassInfo);
+        pass.ExecuteBundles(1, &renderBundle);
+        pass.End();
+
+        wgpu::CommandBuffer commands = encoder.Finish();
+        queue.Submit(1, &commands);
+
+        EXPECT_PIXEL_RGBA8_EQ(kColors[0], renderPass.color, 1, 3);
+        EXPECT_PIXEL_RGBA8_EQ(kColors[1], renderPass.color, 3, 1);
+    }
+}
+
+// Test execution of the same bundle in a pass made only of bundles and in a pass that also has
+// inline draws, which the Vulkan backend records differently.
+TEST_P(RenderBundleTest, BundleInBundleOnlyAndMixedPasses) {
+    utils::ComboRenderBundleEncoderDescriptor desc = {};
+    desc.colorFormatCount = 1;
+    desc.cColorFormats[0] = renderPass.colorFormat;
+
+    wgpu::RenderBundleEncoder renderBundleEncoder = device.CreateRenderBundleEncoder(&desc);
+
+    renderBundleEncoder.SetPipeline(pipeline);
+    renderBundleEncoder.SetVertexBuffer(0, vertexBuffer);
+    renderBundleEncoder.SetBindGroup(0, bindGroups[0]);
+    renderBundleEncoder.Draw(3);
+
+    wgpu::RenderBundle renderBundle = renderBundleEncoder.Finish();
+
+    utils::BasicRenderPass otherRenderPass = utils::CreateBasicRenderPass(device, kRTSize, kRTSize);
+
+    wgpu::CommandEncoder encoder = device.CreateCommandEncoder();
+    {
+        wgpu::RenderPassEncoder pass = encoder.BeginRenderPass(&renderPass.renderPassInfo);
+        pass.ExecuteBundles(1, &renderBundle);
+        pass.End();
+    }
+    {
+        wgpu::RenderPassEncoder pass = encoder.BeginRenderPass(&otherRenderPass.renderPassInfo);
+        pass.SetPipeline(pipeline);
+        pass.SetVertexBuffer(0, vertexBuffer);
+        pass.SetBindGroup(0, bindGroups[1]);
+        pass.Draw(3, 1, 3);
+        pass.ExecuteBundles(1, &renderBundle);
+        pass.End();
+    }
+    wgpu::CommandBuffer commands = encoder.Finish();
+    queue.Submit(1, &commands);
+
+    EXPECT_PIXEL_RGBA8_EQ(kColors[0], renderPass.color, 1, 3);
+    EXPECT_PIXEL_RGBA8_EQ(utils::RGBA8::kZero, renderPass.color, 3, 1);
+    EXPECT_PIXEL_RGBA8_EQ(kColors[0], otherRenderPass.color, 1, 3);
+    EXPECT_PIXEL_RGBA8_EQ(kColors[1], otherRenderPass.color, 3, 1);
+}
+
+// Test that releasing a bundle right after submitting it doesn't free the commands the GPU is
+// still executing.
+TEST_P(RenderBundleTest, ReleaseBundleWhileInFlight) {
+    utils::ComboRenderBundleEncoderDescriptor desc = {};
+    desc.colorFormatCount = 1;
+    desc.cColorFormats[0] = renderPass.colorFormat;
+
+    wgpu::RenderBundleEncoder renderBundleEncoder = device.CreateRenderBundleEncoder(&desc);
+
+    renderBundleEncoder.SetPipeline(pipeline);
+    renderBundleEncoder.SetVertexBuffer(0, vertexBuffer);
+    renderBundleEncoder.SetBindGroup(0, bindGroups[0]);
+    renderBundleEncoder.Draw(6);
+
+    wgpu::RenderBundle renderBundle = renderBundleEncoder.Finish();
+
+    wgpu::CommandEncoder encoder = device.CreateCommandEncoder();
+
+    wgpu::RenderPassEncoder pass = encoder.BeginRenderPass(&renderPass.renderPassInfo);
+    pass.ExecuteBundles(1, &renderBundle);
+    pass.End();
+
+    wgpu::CommandBuffer commands = encoder.Finish();
+    queue.Submit(1, &commands);
+
+    // Drop every reference to the bundle so that it is destroyed while its commands are pending.
+    renderBundle = nullptr;
+    commands = nullptr;
+    pass = nullptr;
+    encoder = nullptr;
+    renderBundleEncoder = nullptr;
+
+    EXPECT_PIXEL_RGBA8_EQ(kColors[0], renderPass.color, 1, 3);
+    EXPECT_PIXEL_RGBA8_EQ(kColors[0], renderPass.color, 3, 1);
+}
+
 DAWN_INSTANTIATE_TEST(RenderBundleTest,
                       D3D11Backend(),
                       D3D12Backend(),
                       MetalBackend(),
                       OpenGLBackend(),
                       OpenGLESBackend(),
-                      VulkanBackend());
+                      VulkanBackend(),
+                      VulkanBackend({"vulkan_record_render_bundles_in_secondary_command_buffers"}));
 
 }  // anonymous namespace
 }  // namespace dawn
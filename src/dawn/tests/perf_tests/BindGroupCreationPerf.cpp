@@ -0,0 +1,146 @@
+// Copyright 2024 The Dawn & Tint Authors
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+//
+// 1. Redistributions of source code must retain the above copyright notice, this
+//    list of conditions and the following disclaimer.
+//
+// 2. Redistributions in binary form must reproduce the above copyright notice,
+//    this list of conditions and the following disclaimer in the documentation
+//    and/or other materials provided with the distribution.
+//
+// 3. Neither the name of the copyright holder nor the names of its
+//    contributors may be used to endorse or promote products derived from
+//    this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+// DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+// FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+// DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+// SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+// CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+// OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+// OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+
+#include <vector>
+
+#include "dawn/tests/perf_tests/DawnPerfTest.h"
+
+#include "dawn/utils/WGPUHelpers.h"
+
+namespace dawn {
+namespace {
+
+struct BindGroupCreationParams : AdapterTestParam {
+    BindGroupCreationParams(const AdapterTestParam& param, uint32_t bindingCountIn)
+        : AdapterTestParam(param), bindingCount(bindingCountIn) {}
+    uint32_t bindingCount;
+};
+
+std::ostream& operator<<(std::ostream& ostream, const BindGroupCreationParams& param) {
+    ostream << static_cast<const AdapterTestParam&>(param);
+    ostream << "_bindings_" << param.bindingCount;
+    return ostream;
+}
+
+// Test the performance of creating bind groups, like applications that create a bind group per
+// draw for their per-draw data. The bindings cycle through buffers, textures and samplers. Only
+// the CPU cost of the creation is measured as the bind groups are never used, so the test is
+// meaningful on software adapters like SwiftShader as well.
+class BindGroupCreationPerf : public DawnPerfTestWithParams<BindGroupCreationParams> {
+  public:
+    static constexpr unsigned int kNumIterations = 50;
+    static constexpr uint32_t kBindGroupsPerStep = 1000;
+
+    BindGroupCreationPerf() : DawnPerfTestWithParams(kNumIterations, 1) {}
+    ~BindGroupCreationPerf() override = default;
+
+    void SetUp() override {
+        DawnPerfTestWithParams<BindGroupCreationParams>::SetUp();
+        const BindGroupCreationParams& params = GetParam();
+
+        wgpu::BufferDescriptor bufferDesc;
+        bufferDesc.size = 256;
+        bufferDesc.usage = wgpu::BufferUsage::Uniform | wgpu::BufferUsage::Storage;
+        mBuffer = device.CreateBuffer(&bufferDesc);
+
+        wgpu::TextureDescriptor textureDesc;
+        textureDesc.size = {4, 4};
+        textureDesc.usage = wgpu::TextureUsage::TextureBinding;
+        textureDesc.format = wgpu::TextureFormat::RGBA8Unorm;
+        mTextureView = device.CreateTexture(&textureDesc).CreateView();
+
+        mSampler = device.CreateSampler();
+
+        std::vector<wgpu::BindGroupLayoutEntry> layoutEntries(params.bindingCount);
+        mEntries.resize(params.bindingCount);
+        for (uint32_t i = 0; i < params.bindingCount; ++i) {
+            wgpu::BindGroupLayoutEntry& layoutEntry = layoutEntries[i];
+            layoutEntry.binding = i;
+            layoutEntry.visibility = wgpu::ShaderStage::Fragment | wgpu::ShaderStage::Compute;
+
+            wgpu::BindGroupEntry& entry = mEntries[i];
+            entry.binding = i;
+            switch (i % 4) {
+                case 0:
+                    layoutEntry.buffer.type = wgpu::BufferBindingType::Uniform;
+                    entry.buffer = mBuffer;
+                    break;
+                case 1:
+                    layoutEntry.texture.sampleType = wgpu::TextureSampleType::Float;
+                    entry.textureView = mTextureView;
+                    break;
+                case 2:
+                    layoutEntry.sampler.type = wgpu::SamplerBindingType::Filtering;
+                    entry.sampler = mSampler;
+                    break;
+                case 3:
+                    layoutEntry.buffer.type = wgpu::BufferBindingType::ReadOnlyStorage;
+                    entry.buffer = mBuffer;
+                    break;
+            }
+        }
+
+        wgpu::BindGroupLayoutDescriptor layoutDesc;
+        layoutDesc.entryCount = layoutEntries.size();
+        layoutDesc.entries = layoutEntries.data();
+        mLayout = device.CreateBindGroupLayout(&layoutDesc);
+    }
+
+  private:
+    void Step() override {
+        wgpu::BindGroupDescriptor desc;
+        desc.layout = mLayout;
+        desc.entryCount = mEntries.size();
+        desc.entries = mEntries.data();
+
+        // Release each bind group right away so that its descriptor set is reused, like
+        // applications that don't keep their per-draw bind groups around.
+        for (uint32_t i = 0; i < kBindGroupsPerStep; ++i) {
+            wgpu::BindGroup bindGroup = device.CreateBindGroup(&desc);
+        }
+        // Tick the device so that the deallocated descriptor sets can be recycled.
+        wgpu::CommandBuffer commands = device.CreateCommandEncoder().Finish();
+        queue.Submit(1, &commands);
+    }
+
+    wgpu::Buffer mBuffer;
+    wgpu::TextureView mTextureView;
+    wgpu::Sampler mSampler;
+    wgpu::BindGroupLayout mLayout;
+    std::vector<wgpu::BindGroupEntry> mEntries;
+};
+
+TEST_P(BindGroupCreationPerf, Run) {
+    RunTest();
+}
+
+DAWN_INSTANTIATE_TEST_P(BindGroupCreationPerf,
+                        {D3D12Backend(), MetalBackend(), OpenGLBackend(), VulkanBackend()},
+                        {1, 4, 16});
+
+}  // anonymous namespace
+}  // namespace dawn
@@ -35,9 +35,15 @@ namespace {
 
 constexpr unsigned int kNumIterations = 50;
 
+// The size and spacing of the writes in the ManySmallWriteBuffers variant, similar to the updates
+// of uniform buffers bound with dynamic offsets.
+constexpr size_t kSmallWriteSize = 64;
+constexpr size_t kSmallWriteStride = 256;
+
 enum class UploadMethod {
     WriteBuffer,
     MappedAtCreation,
+    ManySmallWriteBuffers,
 };
 
 // Perf delta exists between ranges [0, 1MB] vs [1MB, MAX_SIZE).
@@ -71,6 +77,9 @@ std::ostream& operator<<(std::ostream& ostream, const BufferUploadParams& param)
         case UploadMethod::MappedAtCreation:
             ostream << "_MappedAtCreation";
             break;
+        case UploadMethod::ManySmallWriteBuffers:
+            ostream << "_ManySmallWriteBuffers";
+            break;
     }
 
     switch (param.uploadSize) {
@@ -114,6 +123,10 @@ class BufferUploadPerf : public DawnPerfTestWithParams<BufferUploadParams> {
 void BufferUploadPerf::SetUp() {
     DawnPerfTestWithParams<BufferUploadParams>::SetUp();
 
+    // Writing larger buffers in small pieces takes too long to be useful.
+    DAWN_TEST_UNSUPPORTED_IF(GetParam().uploadMethod == UploadMethod::ManySmallWriteBuffers &&
+                             GetParam().uploadSize > UploadSize::BufferSize_1MB);
+
     wgpu::BufferDescriptor desc = {};
     desc.size = data.size();
     desc.usage = wgpu::BufferUsage::CopyDst;
@@ -151,6 +164,19 @@ void BufferUploadPerf::Step() {
             queue.Submit(1, &commands);
             break;
         }
+
+        case UploadMethod::ManySmallWriteBuffers: {
+            // Each iteration updates a small part of every |kSmallWriteStride| bytes of the
+            // buffer, with one WriteBuffer for each of them.
+            for (unsigned int i = 0; i < kNumIterations; ++i) {
+                for (size_t offset = 0; offset < data.size(); offset += kSmallWriteStride) {
+                    queue.WriteBuffer(dst, offset, data.data() + offset, kSmallWriteSize);
+                }
+            }
+            // Make sure all WriteBuffer's are flushed.
+            queue.Submit(0, nullptr);
+            break;
+        }
     }
 }
 
@@ -160,7 +186,8 @@ TEST_P(BufferUploadPerf, Run) {
 
 DAWN_INSTANTIATE_TEST_P(BufferUploadPerf,
                         {D3D12Backend(), MetalBackend(), OpenGLBackend(), VulkanBackend()},
-                        {UploadMethod::WriteBuffer, UploadMethod::MappedAtCreation},
+                        {UploadMethod::WriteBuffer, UploadMethod::MappedAtCreation,
+                         UploadMethod::ManySmallWriteBuffers},
                         {UploadSize::BufferSize_1KB, UploadSize::BufferSize_64KB,
                          UploadSize::BufferSize_1MB, UploadSize::BufferSize_4MB,
                          UploadSize::BufferSize_16MB});
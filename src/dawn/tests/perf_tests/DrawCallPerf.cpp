@@ -609,7 +609,8 @@ TEST_P(DrawCallPerf, Run) {
 
 DAWN_INSTANTIATE_TEST_P(
     DrawCallPerf,
-    {D3D12Backend(), MetalBackend(), OpenGLBackend(), VulkanBackend(),
+    {D3D12Backend(), MetalBackend(), OpenGLBackend(), OpenGLESBackend(),
+     OpenGLESBackend({"disable_gl_state_shadowing"}), VulkanBackend(),
      VulkanBackend({"skip_validation"})},
     {
         // Baseline
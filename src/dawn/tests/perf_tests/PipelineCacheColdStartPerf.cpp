@@ -0,0 +1,196 @@
+// Copyright 2024 The Dawn & Tint Authors
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+//
+// 1. Redistributions of source code must retain the above copyright notice, this
+//    list of conditions and the following disclaimer.
+//
+// 2. Redistributions in binary form must reproduce the above copyright notice,
+//    this list of conditions and the following disclaimer in the documentation
+//    and/or other materials provided with the distribution.
+//
+// 3. Neither the name of the copyright holder nor the names of its
+//    contributors may be used to endorse or promote products derived from
+//    this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+// DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+// FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+// DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+// SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+// CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+// OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+// OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+
+#include <algorithm>
+#include <cstdio>
+#include <memory>
+#include <sstream>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include "dawn/platform/DawnPlatform.h"
+#include "dawn/platform/MappedFileCache.h"
+#include "dawn/tests/perf_tests/DawnPerfTest.h"
+#include "dawn/utils/WGPUHelpers.h"
+
+namespace dawn {
+namespace {
+
+enum class DiskCache {
+    None,
+    MappedFile,
+};
+
+struct PipelineCacheColdStartParams : AdapterTestParam {
+    PipelineCacheColdStartParams(const AdapterTestParam& param, DiskCache diskCacheIn)
+        : AdapterTestParam(param), diskCache(diskCacheIn) {}
+    DiskCache diskCache;
+};
+
+std::ostream& operator<<(std::ostream& ostream, const PipelineCacheColdStartParams& param) {
+    ostream << static_cast<const AdapterTestParam&>(param);
+    switch (param.diskCache) {
+        case DiskCache::None:
+            ostream << "_NoDiskCache";
+            break;
+        case DiskCache::MappedFile:
+            ostream << "_MappedFileCache";
+            break;
+    }
+    return ostream;
+}
+
+// Forwards to a cache that can be replaced while the device is alive, to simulate restarting the
+// process with the same cache file.
+class ReopenableCachingInterface : public platform::CachingInterface {
+  public:
+    void Reset(std::unique_ptr<platform::CachingInterface> cache) { mCache = std::move(cache); }
+
+    size_t LoadData(const void* key, size_t keySize, void* valueOut, size_t valueSize) override {
+        return mCache ? mCache->LoadData(key, keySize, valueOut, valueSize) : 0;
+    }
+    void StoreData(const void* key, size_t keySize, const void* value, size_t valueSize) override {
+        if (mCache) {
+            mCache->StoreData(key, keySize, value, valueSize);
+        }
+    }
+
+  private:
+    std::unique_ptr<platform::CachingInterface> mCache;
+};
+
+class ReopenableCachingPlatform : public platform::Platform {
+  public:
+    explicit ReopenableCachingPlatform(ReopenableCachingInterface* cache) : mCache(cache) {}
+
+    platform::CachingInterface* GetCachingInterface() override { return mCache; }
+
+  private:
+    ReopenableCachingInterface* mCache;
+};
+
+// Test the performance of creating the pipelines of an application on startup, with and without a
+// MappedFileCachingInterface holding the results of a previous run. At each step the cache file is
+// opened again, like it would be by a new process, and a set of compute pipelines is created from
+// new shader modules, so that nothing is found in Dawn's in-memory caches.
+class PipelineCacheColdStartPerf : public DawnPerfTestWithParams<PipelineCacheColdStartParams> {
+  public:
+    static constexpr unsigned int kNumPipelines = 32;
+    static constexpr size_t kMaxCacheSize = 64 * 1024 * 1024;
+
+    PipelineCacheColdStartPerf() : DawnPerfTestWithParams(kNumPipelines, 1) {}
+    ~PipelineCacheColdStartPerf() override = default;
+
+    void SetUp() override {
+        std::string testName = testing::UnitTest::GetInstance()->current_test_info()->name();
+        std::replace(testName.begin(), testName.end(), '/', '_');
+        mCachePath = testing::TempDir() + "dawn_pipeline_cache_cold_start_" + testName;
+        std::remove(mCachePath.c_str());
+
+        DawnPerfTestWithParams<PipelineCacheColdStartParams>::SetUp();
+
+        for (unsigned int i = 0; i < kNumPipelines; ++i) {
+            std::ostringstream shader;
+            shader << R"(
+                @group(0) @binding(0) var<storage, read_write> data : array<f32>;
+
+                @compute @workgroup_size(64) fn main(@builtin(global_invocation_id) id : vec3u) {
+                    var x = data[id.x];
+                    for (var j = 0u; j < )"
+                   << (i + 1) << R"(u; j++) {
+                        x = sin(x) * )"
+                   << i << R"(.0 + cos(x);
+                    }
+                    data[id.x] = x;
+                }
+            )";
+            mShaderSources.push_back(shader.str());
+        }
+
+        if (GetParam().diskCache == DiskCache::MappedFile) {
+            OpenCache();
+            DAWN_TEST_UNSUPPORTED_IF(!mHasCache);
+
+            // Populate the cache file, like a previous run of the application would.
+            CreatePipelines();
+        }
+    }
+
+    void TearDown() override {
+        DawnPerfTestWithParams<PipelineCacheColdStartParams>::TearDown();
+        mCache.Reset(nullptr);
+        std::remove(mCachePath.c_str());
+    }
+
+  protected:
+    std::unique_ptr<platform::Platform> CreateTestPlatform() override {
+        return std::make_unique<ReopenableCachingPlatform>(&mCache);
+    }
+
+  private:
+    void Step() override {
+        if (GetParam().diskCache == DiskCache::MappedFile) {
+            OpenCache();
+        }
+        CreatePipelines();
+    }
+
+    void OpenCache() {
+        // Close the previous cache first since the file can only be opened once at a time.
+        mCache.Reset(nullptr);
+        std::unique_ptr<platform::MappedFileCachingInterface> cache =
+            platform::MappedFileCachingInterface::Create(mCachePath, kMaxCacheSize);
+        mHasCache = cache != nullptr;
+        mCache.Reset(std::move(cache));
+    }
+
+    void CreatePipelines() {
+        for (const std::string& source : mShaderSources) {
+            wgpu::ComputePipelineDescriptor desc;
+            desc.compute.module = utils::CreateShaderModule(device, source.c_str());
+            desc.compute.entryPoint = "main";
+            wgpu::ComputePipeline pipeline = device.CreateComputePipeline(&desc);
+        }
+    }
+
+    ReopenableCachingInterface mCache;
+    bool mHasCache = false;
+    std::string mCachePath;
+    std::vector<std::string> mShaderSources;
+};
+
+TEST_P(PipelineCacheColdStartPerf, Run) {
+    RunTest();
+}
+
+DAWN_INSTANTIATE_TEST_P(PipelineCacheColdStartPerf,
+                        {D3D12Backend(), MetalBackend(), OpenGLBackend(), VulkanBackend()},
+                        {DiskCache::None, DiskCache::MappedFile});
+
+}  // anonymous namespace
+}  // namespace dawn
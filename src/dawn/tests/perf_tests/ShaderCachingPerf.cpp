@@ -0,0 +1,127 @@
+// Copyright 2024 The Dawn & Tint Authors
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+//
+// 1. Redistributions of source code must retain the above copyright notice, this
+//    list of conditions and the following disclaimer.
+//
+// 2. Redistributions in binary form must reproduce the above copyright notice,
+//    this list of conditions and the following disclaimer in the documentation
+//    and/or other materials provided with the distribution.
+//
+// 3. Neither the name of the copyright holder nor the names of its
+//    contributors may be used to endorse or promote products derived from
+//    this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+// DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+// FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+// DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+// SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+// CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+// OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+// OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+
+#include <memory>
+#include <sstream>
+#include <string>
+
+#include "dawn/tests/mocks/platform/CachingInterfaceMock.h"
+#include "dawn/tests/perf_tests/DawnPerfTest.h"
+#include "dawn/utils/WGPUHelpers.h"
+
+namespace dawn {
+namespace {
+
+using ::testing::NiceMock;
+
+struct ShaderCachingParams : AdapterTestParam {
+    ShaderCachingParams(const AdapterTestParam& param, uint32_t functionCountIn)
+        : AdapterTestParam(param), functionCount(functionCountIn) {}
+    uint32_t functionCount;
+};
+
+std::ostream& operator<<(std::ostream& ostream, const ShaderCachingParams& param) {
+    ostream << static_cast<const AdapterTestParam&>(param);
+    ostream << "_functions_" << param.functionCount;
+    return ostream;
+}
+
+// Test the performance of creating a compute pipeline from a new shader module when the compiled
+// shader is already in the BlobCache. The shader module and pipeline are released after each
+// creation so that nothing is found in the frontend caches and every iteration has to build the
+// backend compilation request key (e.g. in vulkan::ShaderModule::GetHandleAndSpirv) and load the
+// result from the BlobCache. The shader is made of a chain of |functionCount| helper functions to
+// see how the cost of a cache hit scales with the size of the shader.
+class ShaderCachingPerf : public DawnPerfTestWithParams<ShaderCachingParams> {
+  public:
+    static constexpr unsigned int kNumIterations = 50;
+
+    ShaderCachingPerf() : DawnPerfTestWithParams(kNumIterations, 1) {}
+    ~ShaderCachingPerf() override = default;
+
+    void SetUp() override {
+        DawnPerfTestWithParams<ShaderCachingParams>::SetUp();
+
+        std::ostringstream shader;
+        shader << R"(
+            @group(0) @binding(0) var<storage, read_write> data : array<f32>;
+
+            fn f0(x : f32) -> f32 {
+                return x + data[0];
+            }
+        )";
+        for (uint32_t i = 1; i < GetParam().functionCount; ++i) {
+            shader << "fn f" << i << "(x : f32) -> f32 {\n";
+            shader << "    return f" << (i - 1) << "(x * 2.0) + data[" << i << "];\n";
+            shader << "}\n";
+        }
+        shader << R"(
+            @compute @workgroup_size(64) fn main(@builtin(global_invocation_id) id : vec3u) {
+                data[id.x] = f)"
+               << (GetParam().functionCount - 1) << R"((data[id.x]);
+            }
+        )";
+        mShaderSource = shader.str();
+
+        // Populate the BlobCache with the compiled shader before measuring.
+        CreatePipeline();
+        DAWN_TEST_UNSUPPORTED_IF(mMockCache.GetNumEntries() == 0);
+    }
+
+  protected:
+    std::unique_ptr<platform::Platform> CreateTestPlatform() override {
+        return std::make_unique<DawnCachingMockPlatform>(&mMockCache);
+    }
+
+  private:
+    void Step() override {
+        for (unsigned int i = 0; i < kNumIterations; ++i) {
+            CreatePipeline();
+        }
+    }
+
+    void CreatePipeline() {
+        wgpu::ComputePipelineDescriptor desc;
+        desc.compute.module = utils::CreateShaderModule(device, mShaderSource.c_str());
+        desc.compute.entryPoint = "main";
+        wgpu::ComputePipeline pipeline = device.CreateComputePipeline(&desc);
+    }
+
+    NiceMock<CachingInterfaceMock> mMockCache;
+    std::string mShaderSource;
+};
+
+TEST_P(ShaderCachingPerf, Run) {
+    RunTest();
+}
+
+DAWN_INSTANTIATE_TEST_P(ShaderCachingPerf,
+                        {D3D12Backend(), MetalBackend(), OpenGLBackend(), VulkanBackend()},
+                        {1, 16, 256});
+
+}  // anonymous namespace
+}  // namespace dawn
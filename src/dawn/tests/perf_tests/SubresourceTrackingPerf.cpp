@@ -25,6 +25,8 @@
 // OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
 // OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 
+#include <vector>
+
 #include "dawn/tests/perf_tests/DawnPerfTest.h"
 
 #include "dawn/utils/ComboRenderPipelineDescriptor.h"
@@ -164,5 +166,144 @@ DAWN_INSTANTIATE_TEST_P(SubresourceTrackingPerf,
                         {1, 4, 16, 256},
                         {2, 3, 8});
 
+
+struct ManyBindGroupsParams : AdapterTestParam {
+    ManyBindGroupsParams(const AdapterTestParam& param, uint32_t bindGroupCountIn)
+        : AdapterTestParam(param), bindGroupCount(bindGroupCountIn) {}
+    uint32_t bindGroupCount;
+};
+
+std::ostream& operator<<(std::ostream& ostream, const ManyBindGroupsParams& param) {
+    ostream << static_cast<const AdapterTestParam&>(param);
+    ostream << "_bindGroups_" << param.bindGroupCount;
+    return ostream;
+}
+
+// Test the performance of the resource usage tracking of passes that set many bind groups that
+// each reference different buffers. All the bind groups of the render pass end up in a single
+// synchronization scope while the compute pass creates one scope per dispatch but still tracks
+// all the referenced buffers.
+class ManyBindGroupsTrackingPerf : public DawnPerfTestWithParams<ManyBindGroupsParams> {
+  public:
+    static constexpr unsigned int kNumIterations = 50;
+    static constexpr uint32_t kBuffersPerBindGroup = 4;
+
+    ManyBindGroupsTrackingPerf() : DawnPerfTestWithParams(kNumIterations, 1) {}
+    ~ManyBindGroupsTrackingPerf() override = default;
+
+    void SetUp() override {
+        DawnPerfTestWithParams<ManyBindGroupsParams>::SetUp();
+        const ManyBindGroupsParams& params = GetParam();
+
+        wgpu::BindGroupLayout bgl = utils::MakeBindGroupLayout(
+            device, {
+                        {0, wgpu::ShaderStage::Vertex | wgpu::ShaderStage::Compute,
+                         wgpu::BufferBindingType::Uniform},
+                        {1, wgpu::ShaderStage::Vertex | wgpu::ShaderStage::Compute,
+                         wgpu::BufferBindingType::Uniform},
+                        {2, wgpu::ShaderStage::Vertex | wgpu::ShaderStage::Compute,
+                         wgpu::BufferBindingType::Uniform},
+                        {3, wgpu::ShaderStage::Vertex | wgpu::ShaderStage::Compute,
+                         wgpu::BufferBindingType::Uniform},
+                    });
+        wgpu::PipelineLayout pipelineLayout = utils::MakeBasicPipelineLayout(device, &bgl);
+
+        wgpu::ShaderModule module = utils::CreateShaderModule(device, R"(
+            struct Uniforms { value : vec4f }
+            @group(0) @binding(0) var<uniform> u0 : Uniforms;
+            @group(0) @binding(1) var<uniform> u1 : Uniforms;
+            @group(0) @binding(2) var<uniform> u2 : Uniforms;
+            @group(0) @binding(3) var<uniform> u3 : Uniforms;
+
+            @vertex fn vsMain() -> @builtin(position) vec4f {
+                return u0.value + u1.value + u2.value + u3.value;
+            }
+
+            @fragment fn fsMain() -> @location(0) vec4f {
+                return vec4f(1.0, 0.0, 0.0, 1.0);
+            }
+
+            @compute @workgroup_size(1) fn csMain() {
+                _ = u0.value + u1.value + u2.value + u3.value;
+            }
+        )");
+
+        utils::ComboRenderPipelineDescriptor renderPipelineDesc;
+        renderPipelineDesc.layout = pipelineLayout;
+        renderPipelineDesc.vertex.module = module;
+        renderPipelineDesc.vertex.entryPoint = "vsMain";
+        renderPipelineDesc.cFragment.module = module;
+        renderPipelineDesc.cFragment.entryPoint = "fsMain";
+        renderPipelineDesc.primitive.topology = wgpu::PrimitiveTopology::PointList;
+        mRenderPipeline = device.CreateRenderPipeline(&renderPipelineDesc);
+
+        wgpu::ComputePipelineDescriptor computePipelineDesc;
+        computePipelineDesc.layout = pipelineLayout;
+        computePipelineDesc.compute.module = module;
+        computePipelineDesc.compute.entryPoint = "csMain";
+        mComputePipeline = device.CreateComputePipeline(&computePipelineDesc);
+
+        wgpu::BufferDescriptor bufferDesc;
+        bufferDesc.size = 16;
+        bufferDesc.usage = wgpu::BufferUsage::Uniform;
+        for (uint32_t i = 0; i < params.bindGroupCount; ++i) {
+            std::vector<wgpu::Buffer> buffers;
+            for (uint32_t j = 0; j < kBuffersPerBindGroup; ++j) {
+                buffers.push_back(device.CreateBuffer(&bufferDesc));
+            }
+            mBindGroups.push_back(utils::MakeBindGroup(device, bgl,
+                                                       {
+                                                           {0, buffers[0]},
+                                                           {1, buffers[1]},
+                                                           {2, buffers[2]},
+                                                           {3, buffers[3]},
+                                                       }));
+        }
+
+        mRenderTarget = utils::CreateBasicRenderPass(device, 1, 1);
+    }
+
+  private:
+    void Step() override {
+        wgpu::CommandEncoder encoder = device.CreateCommandEncoder();
+
+        {
+            wgpu::RenderPassEncoder pass = encoder.BeginRenderPass(&mRenderTarget.renderPassInfo);
+            pass.SetPipeline(mRenderPipeline);
+            for (const wgpu::BindGroup& bindGroup : mBindGroups) {
+                pass.SetBindGroup(0, bindGroup);
+                pass.Draw(1);
+            }
+            pass.End();
+        }
+
+        {
+            wgpu::ComputePassEncoder pass = encoder.BeginComputePass();
+            pass.SetPipeline(mComputePipeline);
+            for (const wgpu::BindGroup& bindGroup : mBindGroups) {
+                pass.SetBindGroup(0, bindGroup);
+                pass.DispatchWorkgroups(1);
+            }
+            pass.End();
+        }
+
+        wgpu::CommandBuffer commands = encoder.Finish();
+        queue.Submit(1, &commands);
+    }
+
+    std::vector<wgpu::BindGroup> mBindGroups;
+    utils::BasicRenderPass mRenderTarget;
+    wgpu::RenderPipeline mRenderPipeline;
+    wgpu::ComputePipeline mComputePipeline;
+};
+
+TEST_P(ManyBindGroupsTrackingPerf, Run) {
+    RunTest();
+}
+
+DAWN_INSTANTIATE_TEST_P(ManyBindGroupsTrackingPerf,
+                        {D3D12Backend(), MetalBackend(), OpenGLBackend(), VulkanBackend()},
+                        {16, 256, 1024});
+
 }  // anonymous namespace
 }  // namespace dawn
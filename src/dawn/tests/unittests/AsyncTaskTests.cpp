@@ -29,15 +29,19 @@
 // AsyncTaskTests:
 //     Simple tests for native::AsyncTask and native::AsnycTaskManager.
 
+#include <atomic>
+#include <condition_variable>
 #include <memory>
 #include <mutex>
 #include <set>
+#include <thread>
 #include <utility>
 #include <vector>
 
 #include "dawn/common/NonCopyable.h"
 #include "dawn/native/AsyncTask.h"
 #include "dawn/platform/DawnPlatform.h"
+#include "dawn/platform/WorkerThread.h"
 #include "gtest/gtest.h"
 
 namespace dawn {
@@ -103,5 +107,115 @@ TEST_F(AsyncTaskTest, Basic) {
     ASSERT_TRUE(idset.empty());
 }
 
+// Test that tasks can be cancelled before they start, in which case their cancellation task runs
+// instead.
+TEST_F(AsyncTaskTest, CancelPendingTask) {
+    // Use a single worker and keep it busy so that the other tasks stay pending.
+    platform::AsyncWorkerThreadPool pool(1);
+    native::AsyncTaskManager taskManager(&pool);
+
+    std::mutex mutex;
+    std::condition_variable condition;
+    bool isBlocking = false;
+    bool isReleased = false;
+    taskManager.PostTask([&] {
+        std::unique_lock<std::mutex> lock(mutex);
+        isBlocking = true;
+        condition.notify_all();
+        condition.wait(lock, [&] { return isReleased; });
+    });
+    {
+        std::unique_lock<std::mutex> lock(mutex);
+        condition.wait(lock, [&] { return isBlocking; });
+    }
+
+    std::atomic<bool> didRun = false;
+    std::atomic<bool> didCancel = false;
+    Ref<native::AsyncTaskHandle> task = taskManager.PostCancellableTask(
+        [&] { didRun = true; }, [&] { didCancel = true; }, platform::TaskPriority::Normal);
+    Ref<native::AsyncTaskHandle> uncancellableTask = taskManager.PostTask([] {});
+
+    EXPECT_TRUE(task->Cancel());
+    EXPECT_TRUE(task->IsFinished());
+    EXPECT_TRUE(task->WasCancelled());
+    EXPECT_TRUE(didCancel);
+
+    // A task can only be cancelled once, and tasks without cancellation tasks can't be cancelled.
+    EXPECT_FALSE(task->Cancel());
+    EXPECT_FALSE(uncancellableTask->Cancel());
+
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        isReleased = true;
+    }
+    condition.notify_all();
+    taskManager.WaitAllPendingTasks();
+
+    EXPECT_FALSE(didRun);
+    EXPECT_FALSE(taskManager.HasPendingTasks());
+}
+
+// Test that a pending task can be stolen and run on the current thread.
+TEST_F(AsyncTaskTest, RunNowStealsPendingTask) {
+    platform::AsyncWorkerThreadPool pool(1);
+    native::AsyncTaskManager taskManager(&pool);
+
+    std::mutex mutex;
+    std::condition_variable condition;
+    bool isBlocking = false;
+    bool isReleased = false;
+    Ref<native::AsyncTaskHandle> blockingTask = taskManager.PostTask([&] {
+        std::unique_lock<std::mutex> lock(mutex);
+        isBlocking = true;
+        condition.notify_all();
+        condition.wait(lock, [&] { return isReleased; });
+    });
+    {
+        std::unique_lock<std::mutex> lock(mutex);
+        condition.wait(lock, [&] { return isBlocking; });
+    }
+
+    std::thread::id runThread;
+    Ref<native::AsyncTaskHandle> task =
+        taskManager.PostTask([&runThread] { runThread = std::this_thread::get_id(); });
+
+    EXPECT_TRUE(task->RunNow());
+    EXPECT_TRUE(task->IsFinished());
+    EXPECT_FALSE(task->WasCancelled());
+    EXPECT_EQ(std::this_thread::get_id(), runThread);
+
+    // Tasks that are already running can't be stolen, but can be waited on.
+    EXPECT_FALSE(blockingTask->RunNow());
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        isReleased = true;
+    }
+    condition.notify_all();
+    blockingTask->Wait();
+    EXPECT_TRUE(blockingTask->IsFinished());
+
+    taskManager.WaitAllPendingTasks();
+    EXPECT_FALSE(taskManager.HasPendingTasks());
+}
+
+// Test that CancelAllPendingTasks cancels the tasks that haven't started and waits for the others.
+TEST_F(AsyncTaskTest, CancelAllPendingTasks) {
+    platform::Platform platform;
+    std::unique_ptr<platform::WorkerTaskPool> pool = platform.CreateWorkerTaskPool();
+    native::AsyncTaskManager taskManager(pool.get());
+
+    constexpr uint32_t kTaskCount = 64u;
+    std::atomic<uint32_t> finishedCount = 0;
+    for (uint32_t i = 0; i < kTaskCount; ++i) {
+        taskManager.PostCancellableTask([&finishedCount] { finishedCount++; },
+                                        [&finishedCount] { finishedCount++; },
+                                        platform::TaskPriority::Normal);
+    }
+
+    taskManager.CancelAllPendingTasks();
+    EXPECT_EQ(kTaskCount, finishedCount.load());
+    EXPECT_FALSE(taskManager.HasPendingTasks());
+}
+
 }  // anonymous namespace
 }  // namespace dawn
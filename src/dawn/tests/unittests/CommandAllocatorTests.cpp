@@ -513,4 +513,96 @@ TEST(CommandAllocator, AcquireCommandBlocks) {
     iterator.MakeEmptyAsDataWasDestroyed();
 }
 
+// Test that blocks freed by a CommandIterator are reused by the next allocator using the pool.
+TEST(CommandAllocator, BlockPoolReusesBlocks) {
+    CommandBlockPool pool;
+
+    for (int i = 0; i < 3; ++i) {
+        CommandAllocator allocator(&pool);
+        CommandDraw* draw = allocator.Allocate<CommandDraw>(CommandType::Draw);
+        draw->first = 4;
+        draw->count = 5;
+
+        CommandIterator iterator(std::move(allocator));
+        CommandType type;
+        ASSERT_TRUE(iterator.NextCommandId(&type));
+        ASSERT_EQ(type, CommandType::Draw);
+        CommandDraw* iteratedDraw = iterator.NextCommand<CommandDraw>();
+        ASSERT_EQ(iteratedDraw->first, 4u);
+        ASSERT_EQ(iteratedDraw->count, 5u);
+        iterator.MakeEmptyAsDataWasDestroyed();
+
+        // Only the first iteration had to allocate a block.
+        CommandBlockPool::Stats stats = pool.GetStats();
+        ASSERT_EQ(stats.allocationCount, uint64_t(i + 1));
+        ASSERT_EQ(stats.reuseCount, uint64_t(i));
+        ASSERT_EQ(stats.cachedBlockCount, 1u);
+    }
+}
+
+// Test that resetting a CommandAllocator returns its blocks to the pool.
+TEST(CommandAllocator, BlockPoolAllocatorReset) {
+    CommandBlockPool pool;
+
+    CommandAllocator allocator(&pool);
+    for (int i = 0; i < 1000; ++i) {
+        allocator.Allocate<CommandSmall>(CommandType::Small);
+    }
+    allocator.Reset();
+
+    CommandBlockPool::Stats stats = pool.GetStats();
+    ASSERT_GT(stats.allocationCount, 1u);
+    ASSERT_EQ(stats.cachedBlockCount, stats.allocationCount);
+}
+
+// Test that blocks too large for the size classes bypass the pool.
+TEST(CommandAllocator, BlockPoolLargeBlocksAreNotPooled) {
+    CommandBlockPool pool;
+
+    CommandAllocator allocator(&pool);
+    allocator.Allocate<CommandBig>(CommandType::Big);
+    CommandIterator iterator(std::move(allocator));
+    iterator.MakeEmptyAsDataWasDestroyed();
+
+    CommandBlockPool::Stats stats = pool.GetStats();
+    ASSERT_EQ(stats.allocationCount, 0u);
+    ASSERT_EQ(stats.cachedBlockCount, 0u);
+}
+
+// Test that Trim keeps the blocks needed to reach the last high-water mark and frees the rest.
+TEST(CommandAllocator, BlockPoolTrim) {
+    CommandBlockPool pool;
+    constexpr size_t kAllocatorCount = 4;
+
+    auto EncodeAndDestroy = [&](size_t allocatorCount) {
+        std::vector<CommandIterator> iterators;
+        for (size_t i = 0; i < allocatorCount; ++i) {
+            CommandAllocator allocator(&pool);
+            allocator.Allocate<CommandDraw>(CommandType::Draw);
+            iterators.emplace_back(std::move(allocator));
+        }
+        for (CommandIterator& iterator : iterators) {
+            iterator.MakeEmptyAsDataWasDestroyed();
+        }
+    };
+
+    EncodeAndDestroy(kAllocatorCount);
+    ASSERT_EQ(pool.GetStats().cachedBlockCount, kAllocatorCount);
+
+    // All the blocks were in use at the same time during the last period so they are all kept.
+    pool.Trim();
+    ASSERT_EQ(pool.GetStats().cachedBlockCount, kAllocatorCount);
+
+    // Only one block was needed during the last period, the others are freed.
+    EncodeAndDestroy(1);
+    pool.Trim();
+    ASSERT_EQ(pool.GetStats().cachedBlockCount, 1u);
+
+    // Nothing was needed during the last period, everything is freed.
+    pool.Trim();
+    CommandBlockPool::Stats stats = pool.GetStats();
+    ASSERT_EQ(stats.cachedBlockCount, 0u);
+    ASSERT_EQ(stats.cachedBlockBytes, 0u);
+}
+
 }  // namespace dawn::native
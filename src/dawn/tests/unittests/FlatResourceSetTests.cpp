@@ -0,0 +1,129 @@
+// Copyright 2024 The Dawn & Tint Authors
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+//
+// 1. Redistributions of source code must retain the above copyright notice, this
+//    list of conditions and the following disclaimer.
+//
+// 2. Redistributions in binary form must reproduce the above copyright notice,
+//    this list of conditions and the following disclaimer in the documentation
+//    and/or other materials provided with the distribution.
+//
+// 3. Neither the name of the copyright holder nor the names of its
+//    contributors may be used to endorse or promote products derived from
+//    this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+// DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+// FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+// DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+// SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+// CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+// OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+// OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+
+#include <set>
+#include <vector>
+
+#include "dawn/native/FlatResourceSet.h"
+#include "gtest/gtest.h"
+
+namespace dawn::native {
+namespace {
+
+struct Resource {
+    int value = 0;
+};
+
+// Test inserting in a FlatResourceSet ignores duplicates and preserves insertion order, both
+// below and above the size where the hash table is used.
+TEST(FlatResourceSetTests, InsertAndIterate) {
+    for (size_t count : {1u, 4u, 16u, 17u, 100u, 1000u}) {
+        std::vector<Resource> resources(count);
+        FlatResourceSet<Resource> set;
+
+        for (size_t i = 0; i < count; ++i) {
+            EXPECT_TRUE(set.insert(&resources[i]));
+        }
+        // Insert everything a second time in reverse order.
+        for (size_t i = count; i > 0; --i) {
+            EXPECT_FALSE(set.insert(&resources[i - 1]));
+        }
+
+        ASSERT_EQ(set.size(), count);
+        size_t i = 0;
+        for (Resource* resource : set) {
+            EXPECT_EQ(resource, &resources[i++]);
+        }
+    }
+}
+
+// Test that a cleared FlatResourceSet can be reused.
+TEST(FlatResourceSetTests, Clear) {
+    std::vector<Resource> resources(64);
+    FlatResourceSet<Resource> set;
+
+    for (Resource& resource : resources) {
+        set.insert(&resource);
+    }
+    set.clear();
+    EXPECT_TRUE(set.empty());
+
+    EXPECT_TRUE(set.insert(&resources[3]));
+    EXPECT_FALSE(set.insert(&resources[3]));
+    EXPECT_EQ(set.size(), 1u);
+}
+
+// Test that FlatResourceSet behaves like a std::set for a random sequence of insertions.
+TEST(FlatResourceSetTests, MatchesStdSet) {
+    std::vector<Resource> resources(257);
+    FlatResourceSet<Resource> set;
+    std::set<Resource*> reference;
+
+    uint32_t state = 1;
+    for (int i = 0; i < 5000; ++i) {
+        state = state * 1664525u + 1013904223u;
+        Resource* resource = &resources[(state >> 8) % resources.size()];
+        EXPECT_EQ(set.insert(resource), reference.insert(resource).second);
+    }
+
+    EXPECT_EQ(set.size(), reference.size());
+    EXPECT_EQ(std::set<Resource*>(set.begin(), set.end()), reference);
+}
+
+// Test that FlatResourceMap only constructs values on the first lookup and that Acquire moves
+// out parallel vectors of keys and values.
+TEST(FlatResourceMapTests, GetOrCreateAndAcquire) {
+    std::vector<Resource> resources(40);
+    FlatResourceMap<Resource, std::vector<int>> map;
+
+    for (int pass = 0; pass < 3; ++pass) {
+        for (size_t i = 0; i < resources.size(); ++i) {
+            std::vector<int>& value = map.GetOrCreate(&resources[i], 1, static_cast<int>(i));
+            value.push_back(pass);
+        }
+    }
+    EXPECT_EQ(map.size(), resources.size());
+
+    std::vector<Resource*> keys;
+    std::vector<std::vector<int>> values;
+    map.Acquire(&keys, &values);
+    EXPECT_EQ(map.size(), 0u);
+
+    ASSERT_EQ(keys.size(), resources.size());
+    ASSERT_EQ(values.size(), resources.size());
+    for (size_t i = 0; i < resources.size(); ++i) {
+        EXPECT_EQ(keys[i], &resources[i]);
+        EXPECT_EQ(values[i], (std::vector<int>{static_cast<int>(i), 0, 1, 2}));
+    }
+
+    // The map can be reused after being acquired.
+    map.GetOrCreate(&resources[0]).push_back(7);
+    EXPECT_EQ(map.GetOrCreate(&resources[0]), std::vector<int>{7});
+}
+
+}  // anonymous namespace
+}  // namespace dawn::native
@@ -0,0 +1,314 @@
+// Copyright 2024 The Dawn & Tint Authors
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+//
+// 1. Redistributions of source code must retain the above copyright notice, this
+//    list of conditions and the following disclaimer.
+//
+// 2. Redistributions in binary form must reproduce the above copyright notice,
+//    this list of conditions and the following disclaimer in the documentation
+//    and/or other materials provided with the distribution.
+//
+// 3. Neither the name of the copyright holder nor the names of its
+//    contributors may be used to endorse or promote products derived from
+//    this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+// DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+// FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+// DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+// SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+// CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+// OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+// OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+
+#include <unistd.h>
+
+#include <cstdint>
+#include <cstdio>
+#include <memory>
+#include <string>
+#include <vector>
+
+#include "dawn/platform/MappedFileCache.h"
+#include "gtest/gtest.h"
+
+namespace dawn::platform {
+namespace {
+
+class MappedFileCacheTests : public testing::Test {
+  protected:
+    void SetUp() override {
+        const testing::TestInfo* info = testing::UnitTest::GetInstance()->current_test_info();
+        mPath = testing::TempDir() + "dawn_mapped_file_cache_" + info->name() + "_" +
+                std::to_string(getpid());
+        std::remove(mPath.c_str());
+
+        mCache = MappedFileCachingInterface::Create(mPath, kMaxSize);
+        if (mCache == nullptr) {
+            GTEST_SKIP() << "Mapped file caches are not supported on this platform";
+        }
+    }
+
+    void TearDown() override {
+        mCache = nullptr;
+        std::remove(mPath.c_str());
+        std::remove((mPath + ".tmp").c_str());
+    }
+
+    void Reopen(size_t maxSize = kMaxSize) {
+        mCache = nullptr;
+        mCache = MappedFileCachingInterface::Create(mPath, maxSize);
+        ASSERT_NE(mCache, nullptr);
+    }
+
+    void Store(const std::string& key, const std::string& value) {
+        mCache->StoreData(key.data(), key.size(), value.data(), value.size());
+    }
+
+    // Returns the value for |key|, or an empty string if it isn't in the cache.
+    std::string Load(const std::string& key) {
+        size_t size = mCache->LoadData(key.data(), key.size(), nullptr, 0);
+        std::string value(size, '\0');
+        if (size > 0) {
+            EXPECT_EQ(mCache->LoadData(key.data(), key.size(), value.data(), size), size);
+        }
+        return value;
+    }
+
+    // Returns a view of the value for |key|, that must be released with ReleaseView().
+    CachedDataView LoadView(const std::string& key) {
+        CachedDataView view;
+        EXPECT_TRUE(mCache->LoadDataView(key.data(), key.size(), &view));
+        EXPECT_NE(view.release, nullptr);
+        return view;
+    }
+
+    static std::string ViewToString(const CachedDataView& view) {
+        return std::string(static_cast<const char*>(view.data), view.size);
+    }
+
+    static void ReleaseView(const CachedDataView& view) { view.release(view.userdata); }
+
+    // Changes the size of the cache file to |size| bytes, as if the process had stopped while
+    // writing it.
+    void TruncateFile(size_t size) { ASSERT_EQ(truncate(mPath.c_str(), size), 0); }
+
+    static constexpr size_t kMaxSize = 4096;
+    std::string mPath;
+    std::unique_ptr<MappedFileCachingInterface> mCache;
+};
+
+// Test that stored values can be loaded back.
+TEST_F(MappedFileCacheTests, StoreAndLoad) {
+    Store("key0", "value0");
+    Store("key1", "a longer value1");
+
+    EXPECT_EQ(mCache->GetEntryCount(), 2u);
+    EXPECT_EQ(Load("key0"), "value0");
+    EXPECT_EQ(Load("key1"), "a longer value1");
+    EXPECT_EQ(Load("key2"), "");
+}
+
+// Test that storing a key again replaces its value, and leaves the old record as dead space.
+TEST_F(MappedFileCacheTests, StoreReplacesValue) {
+    Store("key", "value0");
+    size_t fileSize = mCache->GetFileSize();
+    Store("key", "value1");
+
+    EXPECT_EQ(mCache->GetEntryCount(), 1u);
+    EXPECT_EQ(Load("key"), "value1");
+    EXPECT_GT(mCache->GetFileSize(), fileSize);
+    EXPECT_LT(mCache->GetLiveSize(), mCache->GetFileSize());
+}
+
+// Test that the entries are still there after the cache is opened again.
+TEST_F(MappedFileCacheTests, PersistsAcrossReopen) {
+    Store("key0", "value0");
+    Store("key1", "value1");
+    Store("key0", "value2");
+
+    Reopen();
+    EXPECT_EQ(mCache->GetEntryCount(), 2u);
+    EXPECT_EQ(Load("key0"), "value2");
+    EXPECT_EQ(Load("key1"), "value1");
+}
+
+// Test that a cache file can't be used by two caches at the same time.
+TEST_F(MappedFileCacheTests, FileIsLocked) {
+    EXPECT_EQ(MappedFileCachingInterface::Create(mPath, kMaxSize), nullptr);
+
+    mCache = nullptr;
+    EXPECT_NE(MappedFileCachingInterface::Create(mPath, kMaxSize), nullptr);
+}
+
+// Test that a record that was only partially written is dropped when the cache is opened again,
+// and that new records can be appended after that.
+TEST_F(MappedFileCacheTests, PartialRecordIsDropped) {
+    Store("key0", "value0");
+    size_t fileSize = mCache->GetFileSize();
+    Store("key1", "value1");
+    size_t fullFileSize = mCache->GetFileSize();
+    mCache = nullptr;
+
+    TruncateFile(fullFileSize - 3);
+    Reopen();
+    EXPECT_EQ(mCache->GetFileSize(), fileSize);
+    EXPECT_EQ(Load("key0"), "value0");
+    EXPECT_EQ(Load("key1"), "");
+
+    Store("key2", "value2");
+    Reopen();
+    EXPECT_EQ(Load("key0"), "value0");
+    EXPECT_EQ(Load("key2"), "value2");
+}
+
+// Test that a record with a corrupted value is dropped when the cache is opened again.
+TEST_F(MappedFileCacheTests, CorruptedRecordIsDropped) {
+    Store("key0", "value0");
+    size_t recordStart = mCache->GetFileSize();
+    Store("key1", "value1");
+    size_t recordEnd = mCache->GetFileSize();
+    mCache = nullptr;
+
+    // Change a byte in the middle of the last record.
+    FILE* file = fopen(mPath.c_str(), "r+b");
+    ASSERT_NE(file, nullptr);
+    ASSERT_EQ(fseek(file, static_cast<long>((recordStart + recordEnd) / 2), SEEK_SET), 0);
+    int byte = fgetc(file);
+    ASSERT_NE(byte, EOF);
+    ASSERT_EQ(fseek(file, -1, SEEK_CUR), 0);
+    ASSERT_NE(fputc(byte ^ 0xFF, file), EOF);
+    fclose(file);
+
+    Reopen();
+    EXPECT_EQ(Load("key0"), "value0");
+    EXPECT_EQ(Load("key1"), "");
+}
+
+// Test that the least recently used entries are evicted when the cache is full.
+TEST_F(MappedFileCacheTests, EvictsLeastRecentlyUsed) {
+    std::string value(kMaxSize / 3, 'v');
+    Store("key0", value);
+    Store("key1", value);
+    Store("key2", value);
+    ASSERT_EQ(mCache->GetEntryCount(), 2u);
+    EXPECT_EQ(Load("key0"), "");
+
+    // Use key1 so that key2 is the next one evicted.
+    EXPECT_EQ(Load("key1"), value);
+    Store("key3", value);
+    EXPECT_EQ(mCache->GetEntryCount(), 2u);
+    EXPECT_EQ(Load("key1"), value);
+    EXPECT_EQ(Load("key2"), "");
+    EXPECT_EQ(Load("key3"), value);
+    EXPECT_LE(mCache->GetLiveSize(), kMaxSize);
+
+    // The order of use is kept when the cache is opened again.
+    Reopen();
+    EXPECT_EQ(mCache->GetEntryCount(), 2u);
+    EXPECT_EQ(Load("key1"), value);
+    EXPECT_EQ(Load("key3"), value);
+}
+
+// Test that values larger than the cache are not stored.
+TEST_F(MappedFileCacheTests, ValueLargerThanCache) {
+    Store("key0", "value0");
+    Store("key1", std::string(kMaxSize, 'v'));
+    EXPECT_EQ(Load("key0"), "value0");
+    EXPECT_EQ(Load("key1"), "");
+}
+
+// Test that compaction removes the dead records and keeps the live ones.
+TEST_F(MappedFileCacheTests, Compact) {
+    Store("key0", "value0");
+    Store("key1", "value1");
+    Store("key0", "value2");
+    EXPECT_LT(mCache->GetLiveSize(), mCache->GetFileSize());
+
+    EXPECT_TRUE(mCache->Compact());
+    EXPECT_EQ(mCache->GetEntryCount(), 2u);
+    EXPECT_EQ(Load("key0"), "value2");
+    EXPECT_EQ(Load("key1"), "value1");
+
+    size_t fileSize = mCache->GetFileSize();
+    Store("key0", "value2");
+    EXPECT_TRUE(mCache->Compact());
+    EXPECT_EQ(mCache->GetFileSize(), fileSize);
+
+    Reopen();
+    EXPECT_EQ(mCache->GetFileSize(), fileSize);
+    EXPECT_EQ(Load("key0"), "value2");
+    EXPECT_EQ(Load("key1"), "value1");
+}
+
+// Test that the log is compacted automatically when it runs out of space, so that its size stays
+// bounded no matter how many values are stored.
+TEST_F(MappedFileCacheTests, CompactsWhenFull) {
+    std::string value(kMaxSize / 8, 'v');
+    for (uint32_t i = 0; i < 64; ++i) {
+        Store("key" + std::to_string(i % 4), value + std::to_string(i));
+        EXPECT_LE(mCache->GetFileSize(), 3 * kMaxSize);
+    }
+
+    EXPECT_EQ(mCache->GetEntryCount(), 4u);
+    for (uint32_t i = 60; i < 64; ++i) {
+        EXPECT_EQ(Load("key" + std::to_string(i % 4)), value + std::to_string(i));
+    }
+
+    Reopen();
+    for (uint32_t i = 60; i < 64; ++i) {
+        EXPECT_EQ(Load("key" + std::to_string(i % 4)), value + std::to_string(i));
+    }
+}
+
+// Test that entries over the size limit are evicted when the cache is opened with a smaller limit.
+TEST_F(MappedFileCacheTests, ReopenWithSmallerSize) {
+    std::string value(kMaxSize / 4, 'v');
+    Store("key0", value);
+    Store("key1", value);
+    Store("key2", value);
+
+    Reopen(kMaxSize / 2);
+    EXPECT_EQ(mCache->GetEntryCount(), 1u);
+    EXPECT_EQ(Load("key2"), value);
+}
+
+// Test that views of the values point into the file, aligned so that they can be used directly.
+TEST_F(MappedFileCacheTests, LoadDataView) {
+    Store("key0", "value0");
+    Store("k1", "a longer value1");
+
+    CachedDataView view0 = LoadView("key0");
+    CachedDataView view1 = LoadView("k1");
+    EXPECT_EQ(ViewToString(view0), "value0");
+    EXPECT_EQ(ViewToString(view1), "a longer value1");
+    EXPECT_EQ(reinterpret_cast<uintptr_t>(view0.data) % 8, 0u);
+    EXPECT_EQ(reinterpret_cast<uintptr_t>(view1.data) % 8, 0u);
+    ReleaseView(view0);
+    ReleaseView(view1);
+
+    CachedDataView view;
+    EXPECT_FALSE(mCache->LoadDataView("key2", 4, &view));
+}
+
+// Test that views stay valid after the file is compacted and the cache is destroyed.
+TEST_F(MappedFileCacheTests, LoadDataViewOutlivesMapping) {
+    Store("key0", "value0");
+    Store("key0", "value1");
+
+    CachedDataView view = LoadView("key0");
+    ASSERT_TRUE(mCache->Compact());
+    EXPECT_EQ(ViewToString(view), "value1");
+    EXPECT_EQ(Load("key0"), "value1");
+
+    mCache = nullptr;
+    EXPECT_EQ(ViewToString(view), "value1");
+    ReleaseView(view);
+}
+
+}  // anonymous namespace
+}  // namespace dawn::platform
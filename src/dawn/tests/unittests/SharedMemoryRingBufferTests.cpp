@@ -0,0 +1,170 @@
+// Copyright 2024 The Dawn & Tint Authors
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+//
+// 1. Redistributions of source code must retain the above copyright notice, this
+//    list of conditions and the following disclaimer.
+//
+// 2. Redistributions in binary form must reproduce the above copyright notice,
+//    this list of conditions and the following disclaimer in the documentation
+//    and/or other materials provided with the distribution.
+//
+// 3. Neither the name of the copyright holder nor the names of its
+//    contributors may be used to endorse or promote products derived from
+//    this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+// DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+// FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+// DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+// SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+// CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+// OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+// OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+
+#include <memory>
+#include <thread>
+#include <vector>
+
+#include "dawn/utils/SharedMemoryRingBuffer.h"
+#include "gtest/gtest.h"
+
+namespace dawn::utils {
+namespace {
+
+// A command handler that records all the bytes it receives.
+class RecordingHandler : public dawn::wire::CommandHandler {
+  public:
+    const volatile char* HandleCommands(const volatile char* commands, size_t size) override {
+        handleCount++;
+        for (size_t i = 0; i < size; ++i) {
+            received.push_back(static_cast<char>(commands[i]));
+        }
+        return commands + size;
+    }
+
+    std::vector<char> received;
+    size_t handleCount = 0;
+};
+
+class SharedMemoryRingBufferTests : public testing::Test {
+  protected:
+    void SetUp() override {
+        mRing = SharedMemoryRingBuffer::Create(1);
+        if (mRing == nullptr) {
+            GTEST_SKIP() << "Shared memory rings are not supported on this platform";
+        }
+    }
+
+    // Writes |size| bytes of a pattern that depends on |seed| in the serializer.
+    static void WriteCommand(dawn::wire::CommandSerializer* serializer,
+                             size_t size,
+                             uint8_t seed,
+                             std::vector<char>* expected) {
+        char* data = static_cast<char*>(serializer->GetCmdSpace(size));
+        ASSERT_NE(data, nullptr);
+        for (size_t i = 0; i < size; ++i) {
+            data[i] = static_cast<char>(seed + i);
+            expected->push_back(data[i]);
+        }
+    }
+
+    std::unique_ptr<SharedMemoryRingBuffer> mRing;
+};
+
+// Test that commands are only visible to the receiver once they are flushed.
+TEST_F(SharedMemoryRingBufferTests, FlushPublishesCommands) {
+    SharedMemoryCommandSerializer serializer(mRing.get());
+    RecordingHandler handler;
+    SharedMemoryCommandReceiver receiver(mRing.get(), &handler);
+
+    std::vector<char> expected;
+    WriteCommand(&serializer, 24, 1, &expected);
+    WriteCommand(&serializer, 40, 2, &expected);
+
+    EXPECT_TRUE(receiver.ProcessCommands());
+    EXPECT_TRUE(handler.received.empty());
+
+    EXPECT_TRUE(serializer.Flush());
+    EXPECT_TRUE(receiver.ProcessCommands());
+    EXPECT_EQ(handler.received, expected);
+}
+
+// Test that commands wrapping around the end of the ring are contiguous and handled in one piece.
+TEST_F(SharedMemoryRingBufferTests, WrapAround) {
+    SharedMemoryCommandSerializer serializer(mRing.get());
+    RecordingHandler handler;
+    SharedMemoryCommandReceiver receiver(mRing.get(), &handler);
+
+    const size_t capacity = mRing->GetCapacity();
+    const size_t commandSize = serializer.GetMaximumAllocationSize() - 8;
+
+    std::vector<char> expected;
+    for (uint8_t i = 0; i < 8; ++i) {
+        handler.handleCount = 0;
+        WriteCommand(&serializer, commandSize, i, &expected);
+        EXPECT_TRUE(serializer.Flush());
+        EXPECT_TRUE(receiver.ProcessCommands());
+        EXPECT_EQ(handler.handleCount, 1u);
+    }
+
+    // The commands went around the ring several times.
+    EXPECT_GT(8 * commandSize, 2 * capacity);
+    EXPECT_EQ(handler.received, expected);
+}
+
+// Test that a full ring drains into the local receiver instead of failing.
+TEST_F(SharedMemoryRingBufferTests, LocalReceiverDrainsFullRing) {
+    std::unique_ptr<SharedMemoryCommandBuffer> buffer = SharedMemoryCommandBuffer::Create(1);
+    ASSERT_NE(buffer, nullptr);
+    RecordingHandler handler;
+    buffer->SetHandler(&handler);
+
+    std::vector<char> expected;
+    const size_t commandSize = buffer->GetMaximumAllocationSize();
+    for (uint8_t i = 0; i < 10; ++i) {
+        WriteCommand(buffer.get(), commandSize, i, &expected);
+    }
+    EXPECT_TRUE(buffer->Flush());
+    EXPECT_EQ(handler.received, expected);
+}
+
+// Test allocations larger than the maximum allocation size are rejected.
+TEST_F(SharedMemoryRingBufferTests, TooLargeAllocation) {
+    SharedMemoryCommandSerializer serializer(mRing.get());
+    EXPECT_EQ(serializer.GetCmdSpace(serializer.GetMaximumAllocationSize() + 1), nullptr);
+}
+
+// Test streaming commands to a receiver on another thread through a small ring.
+TEST_F(SharedMemoryRingBufferTests, ProducerConsumerThreads) {
+    SharedMemoryCommandSerializer serializer(mRing.get());
+    RecordingHandler handler;
+    SharedMemoryCommandReceiver receiver(mRing.get(), &handler);
+
+    std::thread consumer([&] {
+        while (!mRing->IsClosed()) {
+            ASSERT_TRUE(receiver.ProcessCommands());
+            std::this_thread::yield();
+        }
+        ASSERT_TRUE(receiver.ProcessCommands());
+    });
+
+    std::vector<char> expected;
+    for (uint32_t i = 0; i < 1000; ++i) {
+        WriteCommand(&serializer, 8 * (1 + i % 64), static_cast<uint8_t>(i), &expected);
+        if (i % 16 == 0) {
+            EXPECT_TRUE(serializer.Flush());
+        }
+    }
+    EXPECT_TRUE(serializer.Flush());
+    mRing->Close();
+    consumer.join();
+
+    EXPECT_EQ(handler.received, expected);
+}
+
+}  // anonymous namespace
+}  // namespace dawn::utils
@@ -0,0 +1,199 @@
+// Copyright 2024 The Dawn & Tint Authors
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+//
+// 1. Redistributions of source code must retain the above copyright notice, this
+//    list of conditions and the following disclaimer.
+//
+// 2. Redistributions in binary form must reproduce the above copyright notice,
+//    this list of conditions and the following disclaimer in the documentation
+//    and/or other materials provided with the distribution.
+//
+// 3. Neither the name of the copyright holder nor the names of its
+//    contributors may be used to endorse or promote products derived from
+//    this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+// DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+// FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+// DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+// SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+// CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+// OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+// OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+
+#include <algorithm>
+#include <vector>
+
+#include "dawn/native/TLSFAllocator.h"
+#include "gtest/gtest.h"
+
+namespace dawn::native {
+
+constexpr uint64_t TLSFAllocator::kInvalidOffset;
+
+// Verify the TLSF allocator with a basic test.
+TEST(TLSFAllocatorTests, SingleBlock) {
+    constexpr uint64_t maxSize = 100;
+    TLSFAllocator allocator(maxSize);
+
+    // Check that we cannot allocate an oversized block.
+    ASSERT_EQ(allocator.Allocate(maxSize + 1), TLSFAllocator::kInvalidOffset);
+
+    // Check that we cannot allocate a zero sized block.
+    ASSERT_EQ(allocator.Allocate(0u), TLSFAllocator::kInvalidOffset);
+
+    // Allocate the whole range, which doesn't need to be a power-of-two.
+    uint64_t offset = allocator.Allocate(maxSize);
+    ASSERT_EQ(offset, 0u);
+    ASSERT_EQ(allocator.GetUsedSize(), maxSize);
+
+    // Check that we are full.
+    ASSERT_EQ(allocator.Allocate(1), TLSFAllocator::kInvalidOffset);
+    ASSERT_EQ(allocator.ComputeTotalNumOfFreeBlocksForTesting(), 0u);
+    ASSERT_EQ(allocator.ComputeLargestFreeBlockSize(), 0u);
+
+    allocator.Deallocate(offset);
+    ASSERT_EQ(allocator.ComputeTotalNumOfFreeBlocksForTesting(), 1u);
+    ASSERT_EQ(allocator.ComputeLargestFreeBlockSize(), maxSize);
+}
+
+// Verify that allocations are packed without rounding their size up.
+TEST(TLSFAllocatorTests, OddSizes) {
+    constexpr uint64_t maxSize = 1000;
+    TLSFAllocator allocator(maxSize);
+
+    // A buddy allocator would use 512 bytes for each of these.
+    for (uint64_t i = 0; i < 3; i++) {
+        ASSERT_EQ(allocator.Allocate(300), i * 300);
+    }
+    ASSERT_EQ(allocator.GetUsedSize(), 900u);
+    ASSERT_EQ(allocator.ComputeLargestFreeBlockSize(), 100u);
+
+    ASSERT_EQ(allocator.Allocate(100), 900u);
+    ASSERT_EQ(allocator.ComputeTotalNumOfFreeBlocksForTesting(), 0u);
+}
+
+// Verify that freed blocks are merged with their free neighbors.
+TEST(TLSFAllocatorTests, MergeFreeBlocks) {
+    constexpr uint64_t maxSize = 1024;
+    constexpr uint64_t blockSize = 100;
+    TLSFAllocator allocator(maxSize);
+
+    std::vector<uint64_t> offsets;
+    for (uint64_t i = 0; i < 10; i++) {
+        offsets.push_back(allocator.Allocate(blockSize));
+        ASSERT_EQ(offsets.back(), i * blockSize);
+    }
+    ASSERT_EQ(allocator.ComputeTotalNumOfFreeBlocksForTesting(), 1u);
+
+    // Free every other block, none of them can be merged.
+    for (uint64_t i = 0; i < 10; i += 2) {
+        allocator.Deallocate(offsets[i]);
+    }
+    ASSERT_EQ(allocator.ComputeTotalNumOfFreeBlocksForTesting(), 6u);
+    ASSERT_EQ(allocator.ComputeLargestFreeBlockSize(), blockSize);
+
+    // Freeing the block in between merges the previous and next free blocks with it.
+    allocator.Deallocate(offsets[1]);
+    ASSERT_EQ(allocator.ComputeTotalNumOfFreeBlocksForTesting(), 5u);
+    ASSERT_EQ(allocator.ComputeLargestFreeBlockSize(), 3 * blockSize);
+
+    // The merged block can hold an allocation larger than the blocks it was made of.
+    ASSERT_EQ(allocator.Allocate(3 * blockSize), 0u);
+
+    for (uint64_t i = 3; i < 10; i += 2) {
+        allocator.Deallocate(offsets[i]);
+    }
+    allocator.Deallocate(0);
+    ASSERT_EQ(allocator.ComputeTotalNumOfFreeBlocksForTesting(), 1u);
+    ASSERT_EQ(allocator.GetUsedSize(), 0u);
+    ASSERT_EQ(allocator.ComputeLargestFreeBlockSize(), maxSize);
+}
+
+// Verify that allocations respect their alignment and that the padding is reused.
+TEST(TLSFAllocatorTests, Alignment) {
+    constexpr uint64_t maxSize = 4096;
+    TLSFAllocator allocator(maxSize);
+
+    ASSERT_EQ(allocator.Allocate(10), 0u);
+
+    // The allocation is placed at the next aligned offset, the padding before it stays free.
+    ASSERT_EQ(allocator.Allocate(256, 256), 256u);
+    ASSERT_EQ(allocator.ComputeTotalNumOfFreeBlocksForTesting(), 2u);
+
+    // The padding can be used for small allocations.
+    ASSERT_EQ(allocator.Allocate(200, 8), 16u);
+
+    // Check that large alignments work.
+    ASSERT_EQ(allocator.Allocate(1, 2048), 2048u);
+    ASSERT_EQ(allocator.Allocate(1, maxSize * 2), TLSFAllocator::kInvalidOffset);
+}
+
+// Verify that an allocation almost as large as the range can be made even though it doesn't fit
+// in the size class searched first.
+TEST(TLSFAllocatorTests, AlmostFullRange) {
+    constexpr uint64_t maxSize = 8 * 1024 * 1024;
+    TLSFAllocator allocator(maxSize);
+
+    ASSERT_EQ(allocator.Allocate(maxSize - 1, 64 * 1024), 0u);
+    ASSERT_EQ(allocator.Allocate(1), maxSize - 1);
+    ASSERT_EQ(allocator.Allocate(1), TLSFAllocator::kInvalidOffset);
+}
+
+// Verify that a mix of allocations and deallocations never overlap.
+TEST(TLSFAllocatorTests, NoOverlap) {
+    constexpr uint64_t maxSize = 1 << 20;
+    TLSFAllocator allocator(maxSize);
+
+    struct Allocation {
+        uint64_t offset;
+        uint64_t size;
+    };
+    std::vector<Allocation> allocations;
+
+    // Allocate sizes that aren't powers of two with various alignments until the allocator is
+    // full, free every third allocation, and fill the holes again.
+    for (uint32_t round = 0; round < 2; round++) {
+        for (uint64_t i = 1;; i++) {
+            uint64_t size = (i * 2654435761u) % 5000 + 1;
+            uint64_t alignment = uint64_t(1) << (i % 9);
+            uint64_t offset = allocator.Allocate(size, alignment);
+            if (offset == TLSFAllocator::kInvalidOffset) {
+                break;
+            }
+            ASSERT_EQ(offset % alignment, 0u);
+            ASSERT_LE(offset + size, maxSize);
+            allocations.push_back({offset, size});
+        }
+
+        for (size_t i = 0; i < allocations.size(); i += 3) {
+            allocator.Deallocate(allocations[i].offset);
+            allocations[i].size = 0;
+        }
+        allocations.erase(std::remove_if(allocations.begin(), allocations.end(),
+                                         [](const Allocation& a) { return a.size == 0; }),
+                          allocations.end());
+    }
+
+    std::sort(allocations.begin(), allocations.end(),
+              [](const Allocation& a, const Allocation& b) { return a.offset < b.offset; });
+    uint64_t usedSize = 0;
+    for (size_t i = 0; i < allocations.size(); i++) {
+        usedSize += allocations[i].size;
+        if (i > 0) {
+            ASSERT_LE(allocations[i - 1].offset + allocations[i - 1].size, allocations[i].offset);
+        }
+    }
+    ASSERT_EQ(allocator.GetUsedSize(), usedSize);
+
+    for (const Allocation& allocation : allocations) {
+        allocator.Deallocate(allocation.offset);
+    }
+    ASSERT_EQ(allocator.ComputeTotalNumOfFreeBlocksForTesting(), 1u);
+}
+
+}  // namespace dawn::native
@@ -0,0 +1,255 @@
+// Copyright 2024 The Dawn & Tint Authors
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+//
+// 1. Redistributions of source code must retain the above copyright notice, this
+//    list of conditions and the following disclaimer.
+//
+// 2. Redistributions in binary form must reproduce the above copyright notice,
+//    this list of conditions and the following disclaimer in the documentation
+//    and/or other materials provided with the distribution.
+//
+// 3. Neither the name of the copyright holder nor the names of its
+//    contributors may be used to endorse or promote products derived from
+//    this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+// DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+// FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+// DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+// SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+// CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+// OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+// OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+
+#include <memory>
+#include <set>
+#include <utility>
+#include <vector>
+
+#include "dawn/native/PooledResourceMemoryAllocator.h"
+#include "dawn/native/ResourceHeapAllocator.h"
+#include "dawn/native/TLSFMemoryAllocator.h"
+#include "gtest/gtest.h"
+
+namespace dawn::native {
+namespace {
+
+class PlaceholderHeapAllocator : public ResourceHeapAllocator {
+  public:
+    ResultOrError<std::unique_ptr<ResourceHeapBase>> AllocateResourceHeap(uint64_t size) override {
+        return std::make_unique<ResourceHeapBase>();
+    }
+    void DeallocateResourceHeap(std::unique_ptr<ResourceHeapBase> allocation) override {}
+};
+
+class PlaceholderTLSFResourceAllocator {
+  public:
+    explicit PlaceholderTLSFResourceAllocator(uint64_t heapSize)
+        : mAllocator(heapSize, &mHeapAllocator) {}
+
+    PlaceholderTLSFResourceAllocator(uint64_t heapSize, ResourceHeapAllocator* heapAllocator)
+        : mAllocator(heapSize, heapAllocator) {}
+
+    ResourceMemoryAllocation Allocate(uint64_t allocationSize, uint64_t alignment = 1) {
+        ResultOrError<ResourceMemoryAllocation> result =
+            mAllocator.Allocate(allocationSize, alignment);
+        return (result.IsSuccess()) ? result.AcquireSuccess() : ResourceMemoryAllocation{};
+    }
+
+    void Deallocate(ResourceMemoryAllocation& allocation) { mAllocator.Deallocate(allocation); }
+
+    TLSFMemoryAllocator::Usage ComputeUsage() const { return mAllocator.ComputeUsage(); }
+
+    uint64_t ComputeTotalNumOfHeapsForTesting() const {
+        return mAllocator.ComputeTotalNumOfHeapsForTesting();
+    }
+
+  private:
+    PlaceholderHeapAllocator mHeapAllocator;
+    TLSFMemoryAllocator mAllocator;
+};
+
+// Verify a single resource allocation in a single heap.
+TEST(TLSFMemoryAllocatorTests, SingleHeap) {
+    constexpr uint64_t heapSize = 100;
+    PlaceholderTLSFResourceAllocator allocator(heapSize);
+
+    // Cannot allocate greater than heap size.
+    ResourceMemoryAllocation invalidAllocation = allocator.Allocate(heapSize + 1);
+    ASSERT_EQ(invalidAllocation.GetInfo().mMethod, AllocationMethod::kInvalid);
+
+    // Allocate one allocation the size of the heap, which isn't a power-of-two.
+    ResourceMemoryAllocation allocation1 = allocator.Allocate(heapSize);
+    ASSERT_EQ(allocation1.GetInfo().mBlockOffset, 0u);
+    ASSERT_EQ(allocation1.GetInfo().mMethod, AllocationMethod::kSubAllocated);
+    ASSERT_EQ(allocator.ComputeTotalNumOfHeapsForTesting(), 1u);
+
+    allocator.Deallocate(allocation1);
+    ASSERT_EQ(allocator.ComputeTotalNumOfHeapsForTesting(), 0u);
+}
+
+// Verify that allocations are packed in a heap and that new heaps are created when it is full.
+TEST(TLSFMemoryAllocatorTests, MultipleHeaps) {
+    constexpr uint64_t heapSize = 1000;
+    PlaceholderTLSFResourceAllocator allocator(heapSize);
+
+    // Three 300 byte allocations fit in the first heap.
+    std::vector<ResourceMemoryAllocation> allocations;
+    for (uint64_t i = 0; i < 3; i++) {
+        allocations.push_back(allocator.Allocate(300));
+        ASSERT_EQ(allocations.back().GetInfo().mMethod, AllocationMethod::kSubAllocated);
+        ASSERT_EQ(allocations.back().GetOffset(), i * 300);
+        ASSERT_EQ(allocations.back().GetResourceHeap(), allocations[0].GetResourceHeap());
+    }
+    ASSERT_EQ(allocator.ComputeTotalNumOfHeapsForTesting(), 1u);
+
+    // The fourth one goes in a second heap, its block offset is past the first heap.
+    ResourceMemoryAllocation allocation4 = allocator.Allocate(300);
+    ASSERT_EQ(allocation4.GetOffset(), 0u);
+    ASSERT_EQ(allocation4.GetInfo().mBlockOffset, heapSize);
+    ASSERT_NE(allocation4.GetResourceHeap(), allocations[0].GetResourceHeap());
+    ASSERT_EQ(allocator.ComputeTotalNumOfHeapsForTesting(), 2u);
+
+    // Smaller allocations still fit at the end of the first heap.
+    ResourceMemoryAllocation allocation5 = allocator.Allocate(100);
+    ASSERT_EQ(allocation5.GetResourceHeap(), allocations[0].GetResourceHeap());
+    ASSERT_EQ(allocation5.GetOffset(), 900u);
+
+    TLSFMemoryAllocator::Usage usage = allocator.ComputeUsage();
+    ASSERT_EQ(usage.heapCount, 2u);
+    ASSERT_EQ(usage.heapSize, 2 * heapSize);
+    ASSERT_EQ(usage.usedSize, 1300u);
+    ASSERT_EQ(usage.largestFreeBlockSize, 700u);
+
+    // Heaps are released as soon as they are empty.
+    allocator.Deallocate(allocation4);
+    ASSERT_EQ(allocator.ComputeTotalNumOfHeapsForTesting(), 1u);
+    for (ResourceMemoryAllocation& allocation : allocations) {
+        allocator.Deallocate(allocation);
+    }
+    ASSERT_EQ(allocator.ComputeTotalNumOfHeapsForTesting(), 1u);
+    allocator.Deallocate(allocation5);
+    ASSERT_EQ(allocator.ComputeTotalNumOfHeapsForTesting(), 0u);
+}
+
+// Verify that the slots of released heaps are reused.
+TEST(TLSFMemoryAllocatorTests, ReuseHeapSlots) {
+    constexpr uint64_t heapSize = 128;
+    PlaceholderTLSFResourceAllocator allocator(heapSize);
+
+    ResourceMemoryAllocation allocation1 = allocator.Allocate(heapSize);
+    ResourceMemoryAllocation allocation2 = allocator.Allocate(heapSize);
+    ASSERT_EQ(allocation2.GetInfo().mBlockOffset, heapSize);
+
+    allocator.Deallocate(allocation1);
+    ASSERT_EQ(allocator.ComputeTotalNumOfHeapsForTesting(), 1u);
+
+    ResourceMemoryAllocation allocation3 = allocator.Allocate(heapSize);
+    ASSERT_EQ(allocation3.GetInfo().mBlockOffset, 0u);
+    ASSERT_EQ(allocator.ComputeTotalNumOfHeapsForTesting(), 2u);
+
+    allocator.Deallocate(allocation2);
+    allocator.Deallocate(allocation3);
+    ASSERT_EQ(allocator.ComputeTotalNumOfHeapsForTesting(), 0u);
+}
+
+// Verify that allocations respect their alignment.
+TEST(TLSFMemoryAllocatorTests, Alignment) {
+    constexpr uint64_t heapSize = 4096;
+    PlaceholderTLSFResourceAllocator allocator(heapSize);
+
+    ResourceMemoryAllocation allocation1 = allocator.Allocate(10);
+    ASSERT_EQ(allocation1.GetOffset(), 0u);
+
+    ResourceMemoryAllocation allocation2 = allocator.Allocate(100, 1024);
+    ASSERT_EQ(allocation2.GetOffset(), 1024u);
+    ASSERT_EQ(allocation2.GetResourceHeap(), allocation1.GetResourceHeap());
+
+    // Alignments larger than the heap can't be satisfied.
+    ResourceMemoryAllocation invalidAllocation = allocator.Allocate(1, heapSize * 2);
+    ASSERT_EQ(invalidAllocation.GetInfo().mMethod, AllocationMethod::kInvalid);
+}
+
+// Verify resource heaps will be reused from a pool.
+TEST(TLSFMemoryAllocatorTests, ReuseFreedHeaps) {
+    constexpr uint64_t kHeapSize = 128;
+
+    PlaceholderHeapAllocator heapAllocator;
+    PooledResourceMemoryAllocator poolAllocator(&heapAllocator);
+    PlaceholderTLSFResourceAllocator allocator(kHeapSize, &poolAllocator);
+
+    std::set<ResourceHeapBase*> heaps = {};
+    std::vector<ResourceMemoryAllocation> allocations = {};
+
+    constexpr uint32_t kNumOfAllocations = 100;
+
+    for (uint32_t i = 0; i < kNumOfAllocations; i++) {
+        ResourceMemoryAllocation allocation = allocator.Allocate(12);
+        ASSERT_EQ(allocation.GetInfo().mMethod, AllocationMethod::kSubAllocated);
+        heaps.insert(allocation.GetResourceHeap());
+        allocations.push_back(std::move(allocation));
+    }
+
+    // 10 allocations of 12 bytes fit in each 128 byte heap.
+    ASSERT_EQ(heaps.size(), 10u);
+    ASSERT_EQ(poolAllocator.GetPoolSizeForTesting(), 0u);
+
+    for (ResourceMemoryAllocation& allocation : allocations) {
+        allocator.Deallocate(allocation);
+    }
+
+    ASSERT_EQ(poolAllocator.GetPoolSizeForTesting(), heaps.size());
+
+    // Allocate again reusing the same heaps.
+    for (uint32_t i = 0; i < kNumOfAllocations; i++) {
+        ResourceMemoryAllocation allocation = allocator.Allocate(12);
+        ASSERT_EQ(allocation.GetInfo().mMethod, AllocationMethod::kSubAllocated);
+        ASSERT_FALSE(heaps.insert(allocation.GetResourceHeap()).second);
+    }
+
+    ASSERT_EQ(poolAllocator.GetPoolSizeForTesting(), 0u);
+}
+
+// Verify that trimming the pool frees only the heaps that weren't reused since the last trim.
+TEST(TLSFMemoryAllocatorTests, TrimPool) {
+    constexpr uint64_t kHeapSize = 128;
+
+    PlaceholderHeapAllocator heapAllocator;
+    PooledResourceMemoryAllocator poolAllocator(&heapAllocator);
+    PlaceholderTLSFResourceAllocator allocator(kHeapSize, &poolAllocator);
+
+    // Fill 4 heaps and return them all to the pool.
+    constexpr uint32_t kNumOfHeaps = 4;
+    std::vector<ResourceMemoryAllocation> allocations = {};
+    for (uint32_t i = 0; i < kNumOfHeaps; i++) {
+        allocations.push_back(allocator.Allocate(kHeapSize));
+        ASSERT_EQ(allocations.back().GetInfo().mMethod, AllocationMethod::kSubAllocated);
+    }
+    for (ResourceMemoryAllocation& allocation : allocations) {
+        allocator.Deallocate(allocation);
+    }
+    allocations.clear();
+    ASSERT_EQ(poolAllocator.GetPoolSizeForTesting(), kNumOfHeaps);
+
+    // None of the heaps were pooled at the previous trim, so none are freed yet.
+    poolAllocator.TrimPool();
+    ASSERT_EQ(poolAllocator.GetPoolSizeForTesting(), kNumOfHeaps);
+
+    // Reuse one heap and return it before trimming again: the 3 other heaps are freed.
+    ResourceMemoryAllocation allocation = allocator.Allocate(kHeapSize);
+    ASSERT_EQ(poolAllocator.GetPoolSizeForTesting(), kNumOfHeaps - 1);
+    allocator.Deallocate(allocation);
+    poolAllocator.TrimPool();
+    ASSERT_EQ(poolAllocator.GetPoolSizeForTesting(), 1u);
+
+    // The last heap wasn't reused since, so it is freed by the next trim.
+    poolAllocator.TrimPool();
+    ASSERT_EQ(poolAllocator.GetPoolSizeForTesting(), 0u);
+}
+
+}  // anonymous namespace
+}  // namespace dawn::native
@@ -0,0 +1,215 @@
+// Copyright 2024 The Dawn & Tint Authors
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+//
+// 1. Redistributions of source code must retain the above copyright notice, this
+//    list of conditions and the following disclaimer.
+//
+// 2. Redistributions in binary form must reproduce the above copyright notice,
+//    this list of conditions and the following disclaimer in the documentation
+//    and/or other materials provided with the distribution.
+//
+// 3. Neither the name of the copyright holder nor the names of its
+//    contributors may be used to endorse or promote products derived from
+//    this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+// DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+// FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+// DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+// SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+// CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+// OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+// OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+
+//
+// WorkerThreadTests:
+//     Tests for platform::AsyncWorkerThreadPool.
+
+#include <atomic>
+#include <condition_variable>
+#include <memory>
+#include <mutex>
+#include <utility>
+#include <vector>
+
+#include "dawn/platform/WorkerThread.h"
+#include "gtest/gtest.h"
+
+namespace dawn {
+namespace {
+
+using platform::AsyncWorkerThreadPool;
+using platform::TaskPriority;
+using platform::WaitableEvent;
+
+void IncrementCounter(void* userdata) {
+    static_cast<std::atomic<uint32_t>*>(userdata)->fetch_add(1);
+}
+
+// Test that all the posted tasks run and that their events complete.
+TEST(WorkerThreadTests, AllTasksComplete) {
+    AsyncWorkerThreadPool pool(4);
+    std::atomic<uint32_t> counter = 0;
+
+    constexpr uint32_t kTaskCount = 1000;
+    std::vector<std::unique_ptr<WaitableEvent>> events;
+    for (uint32_t i = 0; i < kTaskCount; ++i) {
+        events.push_back(pool.PostWorkerTask(IncrementCounter, &counter));
+    }
+    for (std::unique_ptr<WaitableEvent>& event : events) {
+        event->Wait();
+        EXPECT_TRUE(event->IsComplete());
+    }
+    EXPECT_EQ(kTaskCount, counter.load());
+}
+
+// Test that the pool never starts more threads than its maximum worker count.
+TEST(WorkerThreadTests, BoundedThreadCount) {
+    AsyncWorkerThreadPool pool(3);
+    EXPECT_EQ(3u, pool.GetMaxWorkerCount());
+    EXPECT_EQ(0u, pool.GetStartedWorkerCount());
+
+    std::atomic<uint32_t> counter = 0;
+    std::vector<std::unique_ptr<WaitableEvent>> events;
+    for (uint32_t i = 0; i < 500; ++i) {
+        events.push_back(pool.PostWorkerTask(IncrementCounter, &counter));
+    }
+    for (std::unique_ptr<WaitableEvent>& event : events) {
+        event->Wait();
+    }
+    EXPECT_LE(pool.GetStartedWorkerCount(), 3u);
+    EXPECT_GE(pool.GetStartedWorkerCount(), 1u);
+}
+
+// Test that the default worker count is non-zero.
+TEST(WorkerThreadTests, DefaultWorkerCount) {
+    AsyncWorkerThreadPool pool;
+    EXPECT_GE(pool.GetMaxWorkerCount(), 1u);
+}
+
+struct OrderTracker {
+    std::mutex mutex;
+    std::vector<TaskPriority> order;
+};
+
+struct PriorityTask {
+    OrderTracker* tracker;
+    TaskPriority priority;
+};
+
+void RecordPriority(void* userdata) {
+    PriorityTask* task = static_cast<PriorityTask*>(userdata);
+    std::lock_guard<std::mutex> lock(task->tracker->mutex);
+    task->tracker->order.push_back(task->priority);
+}
+
+struct BlockingTask {
+    std::mutex mutex;
+    std::condition_variable condition;
+    bool isStarted = false;
+    bool isReleased = false;
+};
+
+void Block(void* userdata) {
+    BlockingTask* task = static_cast<BlockingTask*>(userdata);
+    std::unique_lock<std::mutex> lock(task->mutex);
+    task->isStarted = true;
+    task->condition.notify_all();
+    task->condition.wait(lock, [task] { return task->isReleased; });
+}
+
+// Test that higher priority tasks queued behind a busy worker start before lower priority ones.
+TEST(WorkerThreadTests, HigherPriorityTasksRunFirst) {
+    AsyncWorkerThreadPool pool(1);
+
+    // Keep the only worker busy while the prioritized tasks are queued.
+    BlockingTask blocker;
+    std::unique_ptr<WaitableEvent> blockerEvent = pool.PostWorkerTask(Block, &blocker);
+    {
+        std::unique_lock<std::mutex> lock(blocker.mutex);
+        blocker.condition.wait(lock, [&blocker] { return blocker.isStarted; });
+    }
+
+    OrderTracker tracker;
+    std::vector<PriorityTask> tasks = {
+        {&tracker, TaskPriority::Normal}, {&tracker, TaskPriority::Normal},
+        {&tracker, TaskPriority::High},   {&tracker, TaskPriority::Normal},
+        {&tracker, TaskPriority::High},
+    };
+    std::vector<std::unique_ptr<WaitableEvent>> events;
+    for (PriorityTask& task : tasks) {
+        events.push_back(pool.PostWorkerTaskWithPriority(RecordPriority, &task, task.priority));
+    }
+
+    {
+        std::lock_guard<std::mutex> lock(blocker.mutex);
+        blocker.isReleased = true;
+    }
+    blocker.condition.notify_all();
+    for (std::unique_ptr<WaitableEvent>& event : events) {
+        event->Wait();
+    }
+
+    std::vector<TaskPriority> expected = {TaskPriority::High, TaskPriority::High,
+                                          TaskPriority::Normal, TaskPriority::Normal,
+                                          TaskPriority::Normal};
+    EXPECT_EQ(expected, tracker.order);
+}
+
+struct NestedTask {
+    AsyncWorkerThreadPool* pool;
+    std::atomic<uint32_t>* counter;
+    std::mutex mutex;
+    std::vector<std::unique_ptr<WaitableEvent>> events;
+};
+
+void PostNestedTasks(void* userdata) {
+    NestedTask* task = static_cast<NestedTask*>(userdata);
+    for (uint32_t i = 0; i < 10; ++i) {
+        std::unique_ptr<WaitableEvent> event =
+            task->pool->PostWorkerTask(IncrementCounter, task->counter);
+        std::lock_guard<std::mutex> lock(task->mutex);
+        task->events.push_back(std::move(event));
+    }
+}
+
+// Test that tasks can post other tasks from worker threads.
+TEST(WorkerThreadTests, PostFromWorker) {
+    AsyncWorkerThreadPool pool(2);
+    std::atomic<uint32_t> counter = 0;
+
+    NestedTask nested;
+    nested.pool = &pool;
+    nested.counter = &counter;
+    pool.PostWorkerTask(PostNestedTasks, &nested)->Wait();
+
+    for (std::unique_ptr<WaitableEvent>& event : nested.events) {
+        event->Wait();
+    }
+    EXPECT_EQ(10u, counter.load());
+}
+
+// Test that destroying the pool runs the tasks that are still queued, and that their events stay
+// valid after the pool is gone.
+TEST(WorkerThreadTests, DestructionDrainsQueuedTasks) {
+    std::atomic<uint32_t> counter = 0;
+    std::vector<std::unique_ptr<WaitableEvent>> events;
+    {
+        AsyncWorkerThreadPool pool(2);
+        for (uint32_t i = 0; i < 100; ++i) {
+            events.push_back(pool.PostWorkerTask(IncrementCounter, &counter));
+        }
+    }
+    EXPECT_EQ(100u, counter.load());
+    for (std::unique_ptr<WaitableEvent>& event : events) {
+        EXPECT_TRUE(event->IsComplete());
+        event->Wait();
+    }
+}
+
+}  // anonymous namespace
+}  // namespace dawn
@@ -0,0 +1,142 @@
+// Copyright 2024 The Dawn & Tint Authors
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+//
+// 1. Redistributions of source code must retain the above copyright notice, this
+//    list of conditions and the following disclaimer.
+//
+// 2. Redistributions in binary form must reproduce the above copyright notice,
+//    this list of conditions and the following disclaimer in the documentation
+//    and/or other materials provided with the distribution.
+//
+// 3. Neither the name of the copyright holder nor the names of its
+//    contributors may be used to endorse or promote products derived from
+//    this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+// DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+// FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+// DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+// SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+// CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+// OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+// OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+
+#include <gtest/gtest.h>
+
+#include <utility>
+
+#include "dawn/native/Buffer.h"
+#include "dawn/native/DynamicUploader.h"
+#include "mocks/DawnMockTest.h"
+
+namespace dawn::native {
+namespace {
+
+constexpr uint64_t kLargeAllocationSize = 8 * 1024 * 1024;
+
+class DynamicUploaderTests : public DawnMockTest {
+  protected:
+    BufferBase* Allocate(DynamicUploader* uploader, uint64_t size, ExecutionSerial serial) {
+        return uploader->Allocate(size, serial, 4).AcquireSuccess().stagingBuffer;
+    }
+};
+
+// Test that large allocations reuse the staging buffers once their serial completed.
+TEST_F(DynamicUploaderTests, LargeAllocationsReuseStagingBuffers) {
+    DynamicUploader uploader(mDeviceMock);
+
+    BufferBase* first = Allocate(&uploader, kLargeAllocationSize, ExecutionSerial(1));
+    BufferBase* second = Allocate(&uploader, kLargeAllocationSize, ExecutionSerial(1));
+    EXPECT_NE(first, second);
+
+    // The buffers are still in flight until serial 1 completes.
+    uploader.Deallocate(ExecutionSerial(0));
+    BufferBase* third = Allocate(&uploader, kLargeAllocationSize, ExecutionSerial(1));
+    EXPECT_NE(third, first);
+    EXPECT_NE(third, second);
+
+    uploader.Deallocate(ExecutionSerial(1));
+    BufferBase* reused = Allocate(&uploader, kLargeAllocationSize, ExecutionSerial(2));
+    EXPECT_TRUE(reused == first || reused == second || reused == third);
+
+    DynamicUploader::Stats stats = uploader.GetStats();
+    EXPECT_EQ(stats.bytesUploaded, 4 * kLargeAllocationSize);
+    EXPECT_EQ(stats.pooledAllocationCount, 4u);
+    EXPECT_EQ(stats.poolHitCount, 1u);
+    EXPECT_EQ(stats.residentStagingBytes, 3 * kLargeAllocationSize);
+    EXPECT_EQ(stats.peakResidentStagingBytes, 3 * kLargeAllocationSize);
+}
+
+// Test that allocations are pooled by power-of-two size class.
+TEST_F(DynamicUploaderTests, StagingBuffersArePooledBySizeClass) {
+    DynamicUploader uploader(mDeviceMock);
+
+    BufferBase* buffer = Allocate(&uploader, kLargeAllocationSize - 1024, ExecutionSerial(1));
+    EXPECT_EQ(buffer->GetSize(), kLargeAllocationSize);
+    uploader.Deallocate(ExecutionSerial(1));
+
+    // A larger size class doesn't reuse the buffer.
+    BufferBase* larger = Allocate(&uploader, kLargeAllocationSize + 1024, ExecutionSerial(2));
+    EXPECT_NE(larger, buffer);
+    EXPECT_EQ(larger->GetSize(), 2 * kLargeAllocationSize);
+
+    // But another allocation in the same size class does.
+    EXPECT_EQ(Allocate(&uploader, kLargeAllocationSize, ExecutionSerial(2)), buffer);
+    EXPECT_EQ(uploader.GetStats().poolHitCount, 1u);
+}
+
+// Test that the unused staging buffers are freed when their size class isn't used for a while.
+TEST_F(DynamicUploaderTests, UnusedStagingBuffersAreTrimmed) {
+    DynamicUploader uploader(mDeviceMock);
+
+    Allocate(&uploader, kLargeAllocationSize, ExecutionSerial(1));
+    uploader.Deallocate(ExecutionSerial(1));
+    EXPECT_EQ(uploader.GetStats().residentStagingBytes, kLargeAllocationSize);
+
+    ExecutionSerial lastKeptSerial = ExecutionSerial(1) + DynamicUploader::kMaxUnusedPooledSerials;
+    uploader.Deallocate(lastKeptSerial);
+    EXPECT_EQ(uploader.GetStats().residentStagingBytes, kLargeAllocationSize);
+
+    uploader.Deallocate(lastKeptSerial + ExecutionSerial(1));
+    EXPECT_EQ(uploader.GetStats().residentStagingBytes, 0u);
+    EXPECT_EQ(uploader.GetStats().peakResidentStagingBytes, kLargeAllocationSize);
+
+    // The next allocation has to create a new buffer.
+    Allocate(&uploader, kLargeAllocationSize, ExecutionSerial(20));
+    EXPECT_EQ(uploader.GetStats().poolHitCount, 0u);
+}
+
+// Test that the unused staging buffers are freed by the device's tick once the queue is idle.
+TEST_F(DynamicUploaderTests, UnusedStagingBuffersAreFreedWhenIdle) {
+    DynamicUploader* uploader = mDeviceMock->GetDynamicUploader();
+
+    Allocate(uploader, kLargeAllocationSize, ExecutionSerial(1));
+    uploader->Deallocate(ExecutionSerial(1));
+    EXPECT_EQ(uploader->GetStats().residentStagingBytes, kLargeAllocationSize);
+
+    // Nothing was submitted to the queue, so it is idle.
+    EXPECT_FALSE(mDeviceMock->Tick().IsError());
+    EXPECT_EQ(uploader->GetStats().residentStagingBytes, 0u);
+}
+
+// Test that the staging buffers released by their owner aren't counted as resident in the
+// uploader.
+TEST_F(DynamicUploaderTests, ReleasedStagingBuffersAreNotCounted) {
+    DynamicUploader uploader(mDeviceMock);
+
+    BufferDescriptor desc = {};
+    desc.usage = wgpu::BufferUsage::CopySrc | wgpu::BufferUsage::MapWrite;
+    desc.size = kLargeAllocationSize;
+    Ref<BufferBase> stagingBuffer = mDeviceMock->CreateBuffer(&desc).AcquireSuccess();
+
+    uploader.ReleaseStagingBuffer(std::move(stagingBuffer));
+    EXPECT_EQ(uploader.GetStats().residentStagingBytes, 0u);
+    EXPECT_EQ(uploader.GetStats().peakResidentStagingBytes, 0u);
+}
+
+}  // anonymous namespace
+}  // namespace dawn::native
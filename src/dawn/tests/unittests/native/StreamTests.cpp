@@ -27,9 +27,11 @@
 
 #include <cstring>
 #include <iomanip>
+#include <map>
 #include <string>
 #include <tuple>
 #include <unordered_map>
+#include <unordered_set>
 #include <utility>
 #include <vector>
 
@@ -272,6 +274,17 @@ TEST(SerializeTests, StdUnorderedMap) {
     EXPECT_CACHE_KEY_EQ(m, expected);
 }
 
+// Test that ByteVectorSink serializes std::unordered_set as expected.
+TEST(SerializeTests, StdUnorderedSet) {
+    std::unordered_set<uint32_t> set = {4, 1, 7, 3};
+
+    // Expect the number of elements, followed by the elements in sorted order.
+    ByteVectorSink expected;
+    StreamIn(&expected, size_t(4), uint32_t(1), uint32_t(3), uint32_t(4), uint32_t(7));
+
+    EXPECT_CACHE_KEY_EQ(set, expected);
+}
+
 // Test that ByteVectorSink serializes tint::BindingPoint as expected.
 TEST(SerializeTests, TintSemBindingPoint) {
     tint::BindingPoint bp{3, 6};
@@ -414,7 +427,10 @@ static auto kStreamValueVectorParams = std::make_tuple(
         BitsetFromBitString("000110010101011000100110101011001100101010010011001010100"),
         BitsetFromBitString("111111111111111111111111111111111111111111111111111111111"), 0},
     // Test vectors.
-    std::vector<std::vector<int>>{{}, {1, 5, 2, 7, 4}, {3, 3, 3, 3, 3, 3, 3}});
+    std::vector<std::vector<int>>{{}, {1, 5, 2, 7, 4}, {3, 3, 3, 3, 3, 3, 3}},
+    // Test ordered maps and unordered sets.
+    std::vector<std::map<int, std::string>>{{}, {{3, "three"}, {1, ""}, {42, "answer"}}},
+    std::vector<std::unordered_set<std::string>>{{}, {"abc", "", "defgh"}});
 
 static auto kStreamValueInitListParams = std::make_tuple(
     std::initializer_list<char[12]>{"test string", "string test"},
@@ -0,0 +1,125 @@
+// Copyright 2024 The Dawn & Tint Authors
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+//
+// 1. Redistributions of source code must retain the above copyright notice, this
+//    list of conditions and the following disclaimer.
+//
+// 2. Redistributions in binary form must reproduce the above copyright notice,
+//    this list of conditions and the following disclaimer in the documentation
+//    and/or other materials provided with the distribution.
+//
+// 3. Neither the name of the copyright holder nor the names of its
+//    contributors may be used to endorse or promote products derived from
+//    this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+// DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+// FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+// DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+// SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+// CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+// OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+// OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+
+#include <gtest/gtest.h>
+
+#include "dawn/native/Buffer.h"
+#include "dawn/native/TransientBufferAllocator.h"
+#include "mocks/DawnMockTest.h"
+
+namespace dawn::native {
+namespace {
+
+constexpr uint64_t kBlockSize = TransientBufferAllocator::kBlockSize;
+
+class TransientBufferAllocatorTests : public DawnMockTest {
+  protected:
+    TransientBufferAllocation Allocate(TransientBufferAllocator* allocator,
+                                       uint64_t size,
+                                       ExecutionSerial serial) {
+        return allocator->Allocate(size, serial, 256).AcquireSuccess();
+    }
+};
+
+// Test that allocations are bumped out of the same block at aligned offsets.
+TEST_F(TransientBufferAllocatorTests, AllocationsShareBlock) {
+    TransientBufferAllocator allocator(mDeviceMock);
+
+    TransientBufferAllocation first = Allocate(&allocator, 4, ExecutionSerial(1));
+    TransientBufferAllocation second = Allocate(&allocator, 1000, ExecutionSerial(1));
+    TransientBufferAllocation third = Allocate(&allocator, 4, ExecutionSerial(2));
+
+    EXPECT_EQ(first.buffer, second.buffer);
+    EXPECT_EQ(first.buffer, third.buffer);
+    EXPECT_EQ(first.offset, 0u);
+    EXPECT_EQ(second.offset, 256u);
+    EXPECT_EQ(third.offset, 1280u);
+    EXPECT_EQ(first.buffer->GetSize(), kBlockSize);
+    EXPECT_EQ(allocator.GetStats().createdBufferCount, 1u);
+}
+
+// Test that the block is kept while any of its serials is in flight and freed once all of them
+// completed.
+TEST_F(TransientBufferAllocatorTests, BlockIsFreedOnceComplete) {
+    TransientBufferAllocator allocator(mDeviceMock);
+
+    Ref<BufferBase> block = Allocate(&allocator, 1024, ExecutionSerial(1)).buffer;
+    Allocate(&allocator, 1024, ExecutionSerial(2));
+
+    allocator.Deallocate(ExecutionSerial(1));
+    EXPECT_EQ(Allocate(&allocator, 4, ExecutionSerial(3)).offset, 2048u);
+    EXPECT_EQ(block->GetRefCountForTesting(), 2u);
+
+    // Nothing is in flight anymore so the allocator no longer references the block.
+    allocator.Deallocate(ExecutionSerial(3));
+    EXPECT_EQ(block->GetRefCountForTesting(), 1u);
+
+    TransientBufferAllocation allocation = Allocate(&allocator, 4, ExecutionSerial(4));
+    EXPECT_NE(allocation.buffer, block.Get());
+    EXPECT_EQ(allocation.offset, 0u);
+    EXPECT_EQ(allocator.GetStats().createdBufferCount, 2u);
+}
+
+// Test that full blocks are recycled once their serial completed.
+TEST_F(TransientBufferAllocatorTests, FullBlocksAreRecycled) {
+    TransientBufferAllocator allocator(mDeviceMock);
+
+    BufferBase* first = Allocate(&allocator, kBlockSize, ExecutionSerial(1)).buffer;
+    BufferBase* second = Allocate(&allocator, kBlockSize, ExecutionSerial(1)).buffer;
+    EXPECT_NE(first, second);
+
+    // The first block is still in flight.
+    allocator.Deallocate(ExecutionSerial(0));
+    BufferBase* third = Allocate(&allocator, kBlockSize, ExecutionSerial(2)).buffer;
+    EXPECT_NE(third, first);
+    EXPECT_NE(third, second);
+
+    allocator.Deallocate(ExecutionSerial(1));
+    TransientBufferAllocation reused = Allocate(&allocator, kBlockSize, ExecutionSerial(3));
+    EXPECT_TRUE(reused.buffer == first || reused.buffer == second);
+    EXPECT_EQ(reused.offset, 0u);
+    EXPECT_EQ(allocator.GetStats().createdBufferCount, 3u);
+}
+
+// Test that allocations larger than a block get their own buffer.
+TEST_F(TransientBufferAllocatorTests, LargeAllocationsAreDedicated) {
+    TransientBufferAllocator allocator(mDeviceMock);
+
+    TransientBufferAllocation small = Allocate(&allocator, 4, ExecutionSerial(1));
+    TransientBufferAllocation large = Allocate(&allocator, kBlockSize + 4, ExecutionSerial(1));
+    EXPECT_NE(small.buffer, large.buffer);
+    EXPECT_EQ(large.offset, 0u);
+    EXPECT_EQ(large.buffer->GetSize(), kBlockSize + 4);
+
+    // The large allocation didn't consume the current block.
+    EXPECT_EQ(Allocate(&allocator, 4, ExecutionSerial(1)).buffer, small.buffer);
+    EXPECT_EQ(allocator.GetStats().allocationCount, 3u);
+    EXPECT_EQ(allocator.GetStats().createdBufferCount, 2u);
+}
+
+}  // anonymous namespace
+}  // namespace dawn::native
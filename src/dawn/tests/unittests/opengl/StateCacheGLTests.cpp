@@ -0,0 +1,146 @@
+// Copyright 2024 The Dawn & Tint Authors
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+//
+// 1. Redistributions of source code must retain the above copyright notice, this
+//    list of conditions and the following disclaimer.
+//
+// 2. Redistributions in binary form must reproduce the above copyright notice,
+//    this list of conditions and the following disclaimer in the documentation
+//    and/or other materials provided with the distribution.
+//
+// 3. Neither the name of the copyright holder nor the names of its
+//    contributors may be used to endorse or promote products derived from
+//    this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+// DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+// FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+// DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+// SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+// CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+// OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+// OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+
+#include "dawn/native/opengl/OpenGLFunctions.h"
+#include "dawn/native/opengl/StateCacheGL.h"
+#include "gtest/gtest.h"
+
+namespace dawn::native::opengl {
+namespace {
+
+// The number of calls made to the mock GL functions below.
+struct GLCallCounts {
+    uint64_t bindBuffer = 0;
+    uint64_t bindBufferBase = 0;
+    uint64_t bindBufferRange = 0;
+    uint64_t stencilFuncSeparate = 0;
+
+    uint64_t Total() const {
+        return bindBuffer + bindBufferBase + bindBufferRange + stencilFuncSeparate;
+    }
+};
+GLCallCounts gCallCounts;
+
+void KHRONOS_APIENTRY MockBindBuffer(GLenum, GLuint) {
+    gCallCounts.bindBuffer++;
+}
+void KHRONOS_APIENTRY MockBindBufferBase(GLenum, GLuint, GLuint) {
+    gCallCounts.bindBufferBase++;
+}
+void KHRONOS_APIENTRY MockBindBufferRange(GLenum, GLuint, GLuint, GLintptr, GLsizeiptr) {
+    gCallCounts.bindBufferRange++;
+}
+void KHRONOS_APIENTRY MockStencilFuncSeparate(GLenum, GLenum, GLint, GLuint) {
+    gCallCounts.stencilFuncSeparate++;
+}
+
+class StateCacheGLTests : public testing::Test {
+  protected:
+    void SetUp() override {
+        gCallCounts = {};
+        mGL.BindBuffer = MockBindBuffer;
+        mGL.BindBufferBase = MockBindBufferBase;
+        mGL.BindBufferRange = MockBindBufferRange;
+        mGL.StencilFuncSeparate = MockStencilFuncSeparate;
+    }
+
+    // Checks that the stats of the cache match the calls that reached the GL functions.
+    void ExpectStats(const StateCache& cache, uint64_t issuedCalls, uint64_t elidedCalls) {
+        EXPECT_EQ(gCallCounts.Total(), issuedCalls);
+        EXPECT_EQ(cache.GetStats().issuedCalls, issuedCalls);
+        EXPECT_EQ(cache.GetStats().elidedCalls, elidedCalls);
+    }
+
+    OpenGLFunctions mGL;
+};
+
+// Test that binding the same buffer twice only issues the first call.
+TEST_F(StateCacheGLTests, BindBufferIsElided) {
+    StateCache cache(true);
+
+    cache.BindBuffer(mGL, GL_ARRAY_BUFFER, 1);
+    cache.BindBuffer(mGL, GL_ARRAY_BUFFER, 1);
+    EXPECT_EQ(gCallCounts.bindBuffer, 1u);
+    ExpectStats(cache, 1, 1);
+
+    cache.BindBuffer(mGL, GL_ARRAY_BUFFER, 2);
+    cache.BindBuffer(mGL, GL_COPY_READ_BUFFER, 2);
+    EXPECT_EQ(gCallCounts.bindBuffer, 3u);
+    ExpectStats(cache, 3, 1);
+}
+
+// Test that indexed buffer bindings are always issued and counted as such, and that they update
+// the generic binding point of their target.
+TEST_F(StateCacheGLTests, IndexedBufferBindingsAreIssued) {
+    StateCache cache(true);
+
+    cache.BindBufferBase(mGL, GL_UNIFORM_BUFFER, 0, 1);
+    cache.BindBufferBase(mGL, GL_UNIFORM_BUFFER, 0, 1);
+    cache.BindBufferRange(mGL, GL_UNIFORM_BUFFER, 1, 1, 0, 4);
+    cache.BindBufferRange(mGL, GL_UNIFORM_BUFFER, 1, 1, 0, 4);
+    EXPECT_EQ(gCallCounts.bindBufferBase, 2u);
+    EXPECT_EQ(gCallCounts.bindBufferRange, 2u);
+    ExpectStats(cache, 4, 0);
+
+    // The generic binding point is now known to be the buffer.
+    cache.BindBuffer(mGL, GL_UNIFORM_BUFFER, 1);
+    EXPECT_EQ(gCallCounts.bindBuffer, 0u);
+    ExpectStats(cache, 4, 1);
+}
+
+// Test that the stencil functions are counted as one call per face.
+TEST_F(StateCacheGLTests, StencilFuncsCountBothFaces) {
+    StateCache cache(true);
+
+    cache.SetStencilFuncsAndMask(mGL, GL_ALWAYS, GL_LESS, 0xff);
+    EXPECT_EQ(gCallCounts.stencilFuncSeparate, 2u);
+    ExpectStats(cache, 2, 0);
+
+    cache.SetStencilFuncsAndMask(mGL, GL_ALWAYS, GL_LESS, 0xff);
+    cache.SetStencilReference(mGL, 0);
+    ExpectStats(cache, 2, 4);
+
+    cache.SetStencilReference(mGL, 1);
+    EXPECT_EQ(gCallCounts.stencilFuncSeparate, 4u);
+    ExpectStats(cache, 4, 4);
+}
+
+// Test that a disabled cache issues every call.
+TEST_F(StateCacheGLTests, DisabledCacheIssuesEveryCall) {
+    StateCache cache(false);
+
+    cache.BindBuffer(mGL, GL_ARRAY_BUFFER, 1);
+    cache.BindBuffer(mGL, GL_ARRAY_BUFFER, 1);
+    cache.SetStencilFuncsAndMask(mGL, GL_ALWAYS, GL_ALWAYS, 0xff);
+    cache.SetStencilFuncsAndMask(mGL, GL_ALWAYS, GL_ALWAYS, 0xff);
+    EXPECT_EQ(gCallCounts.bindBuffer, 2u);
+    EXPECT_EQ(gCallCounts.stencilFuncSeparate, 4u);
+    ExpectStats(cache, 6, 0);
+}
+
+}  // anonymous namespace
+}  // namespace dawn::native::opengl
@@ -27,6 +27,7 @@
 
 #include <vector>
 
+#include "dawn/native/Device.h"
 #include "dawn/tests/unittests/validation/ValidationTest.h"
 
 #include "dawn/utils/ComboRenderPipelineDescriptor.h"
@@ -40,10 +41,18 @@ using testing::Not;
 // These tests works assuming Dawn Native's object deduplication. Comparing the pointer is
 // exploiting an implementation detail of Dawn Native.
 class ObjectCachingTest : public ValidationTest {
+  protected:
     void SetUp() override {
         ValidationTest::SetUp();
         DAWN_SKIP_TEST_IF(UsesWire());
     }
+
+    wgpu::Buffer CreateBuffer(uint64_t size, wgpu::BufferUsage usage) {
+        wgpu::BufferDescriptor descriptor;
+        descriptor.size = size;
+        descriptor.usage = usage;
+        return device.CreateBuffer(&descriptor);
+    }
 };
 
 // Test that BindGroupLayouts are correctly deduplicated.
@@ -472,5 +481,110 @@ TEST_F(ObjectCachingTest, SamplerDeduplication) {
     EXPECT_EQ(sampler.Get(), sameSampler.Get());
 }
 
+// Test that bind groups aren't deduplicated by default.
+TEST_F(ObjectCachingTest, BindGroupNotDeduplicatedByDefault) {
+    wgpu::BindGroupLayout bgl = utils::MakeBindGroupLayout(
+        device, {{0, wgpu::ShaderStage::Fragment, wgpu::BufferBindingType::Uniform}});
+    wgpu::Buffer buffer = CreateBuffer(16, wgpu::BufferUsage::Uniform);
+
+    wgpu::BindGroup bindGroup = utils::MakeBindGroup(device, bgl, {{0, buffer}});
+    wgpu::BindGroup sameBindGroup = utils::MakeBindGroup(device, bgl, {{0, buffer}});
+
+    EXPECT_NE(bindGroup.Get(), sameBindGroup.Get());
+}
+
+class BindGroupCachingTest : public ObjectCachingTest {
+  protected:
+    WGPUDevice CreateTestDevice(native::Adapter dawnAdapter,
+                                wgpu::DeviceDescriptor descriptor) override {
+        const char* toggle = "deduplicate_bind_groups";
+        wgpu::DawnTogglesDescriptor deviceTogglesDesc;
+        deviceTogglesDesc.enabledToggles = &toggle;
+        deviceTogglesDesc.enabledToggleCount = 1;
+        descriptor.nextInChain = &deviceTogglesDesc;
+        return dawnAdapter.CreateDevice(&descriptor);
+    }
+
+    uint64_t GetHitCount() {
+        return native::FromAPI(device.Get())->GetBindGroupCacheHitCountForTesting();
+    }
+};
+
+// Test that bind groups are deduplicated on their layout and resources.
+TEST_F(BindGroupCachingTest, BindGroupDeduplication) {
+    wgpu::BindGroupLayout bgl = utils::MakeBindGroupLayout(
+        device, {{0, wgpu::ShaderStage::Fragment, wgpu::BufferBindingType::Uniform},
+                 {1, wgpu::ShaderStage::Fragment, wgpu::SamplerBindingType::Filtering}});
+    wgpu::BindGroupLayout otherBgl = utils::MakeBindGroupLayout(
+        device, {{0, wgpu::ShaderStage::Vertex, wgpu::BufferBindingType::Uniform},
+                 {1, wgpu::ShaderStage::Vertex, wgpu::SamplerBindingType::Filtering}});
+    wgpu::Buffer buffer = CreateBuffer(512, wgpu::BufferUsage::Uniform);
+    wgpu::Buffer otherBuffer = CreateBuffer(512, wgpu::BufferUsage::Uniform);
+    wgpu::Sampler sampler = device.CreateSampler();
+
+    wgpu::BindGroup bindGroup = utils::MakeBindGroup(device, bgl, {{0, buffer}, {1, sampler}});
+    EXPECT_EQ(GetHitCount(), 0u);
+
+    wgpu::BindGroup sameBindGroup = utils::MakeBindGroup(device, bgl, {{0, buffer}, {1, sampler}});
+    wgpu::BindGroup otherBindGroupBuffer =
+        utils::MakeBindGroup(device, bgl, {{0, otherBuffer}, {1, sampler}});
+    wgpu::BindGroup otherBindGroupOffset =
+        utils::MakeBindGroup(device, bgl, {{0, buffer, 256, 256}, {1, sampler}});
+    wgpu::BindGroup otherBindGroupSize =
+        utils::MakeBindGroup(device, bgl, {{0, buffer, 0, 256}, {1, sampler}});
+    wgpu::BindGroup otherBindGroupLayout =
+        utils::MakeBindGroup(device, otherBgl, {{0, buffer}, {1, sampler}});
+
+    EXPECT_EQ(bindGroup.Get(), sameBindGroup.Get());
+    EXPECT_NE(bindGroup.Get(), otherBindGroupBuffer.Get());
+    EXPECT_NE(bindGroup.Get(), otherBindGroupOffset.Get());
+    EXPECT_NE(bindGroup.Get(), otherBindGroupSize.Get());
+    EXPECT_NE(bindGroup.Get(), otherBindGroupLayout.Get());
+    EXPECT_EQ(GetHitCount(), 1u);
+}
+
+// Test that the cache doesn't keep bind groups alive.
+TEST_F(BindGroupCachingTest, BindGroupNotKeptAlive) {
+    wgpu::BindGroupLayout bgl = utils::MakeBindGroupLayout(
+        device, {{0, wgpu::ShaderStage::Fragment, wgpu::BufferBindingType::Uniform}});
+    wgpu::Buffer buffer = CreateBuffer(16, wgpu::BufferUsage::Uniform);
+
+    utils::MakeBindGroup(device, bgl, {{0, buffer}});
+    utils::MakeBindGroup(device, bgl, {{0, buffer}});
+    EXPECT_EQ(GetHitCount(), 0u);
+}
+
+// Test that bind groups referencing a destroyed resource aren't returned by the cache.
+TEST_F(BindGroupCachingTest, BindGroupWithDestroyedResource) {
+    wgpu::BindGroupLayout bgl = utils::MakeBindGroupLayout(
+        device, {{0, wgpu::ShaderStage::Fragment, wgpu::BufferBindingType::Uniform},
+                 {1, wgpu::ShaderStage::Fragment, wgpu::TextureSampleType::Float}});
+    wgpu::Buffer buffer = CreateBuffer(16, wgpu::BufferUsage::Uniform);
+
+    wgpu::TextureDescriptor textureDesc;
+    textureDesc.size = {1, 1};
+    textureDesc.format = wgpu::TextureFormat::RGBA8Unorm;
+    textureDesc.usage = wgpu::TextureUsage::TextureBinding;
+    wgpu::Texture texture = device.CreateTexture(&textureDesc);
+    wgpu::TextureView view = texture.CreateView();
+
+    wgpu::BindGroup bindGroup = utils::MakeBindGroup(device, bgl, {{0, buffer}, {1, view}});
+    texture.Destroy();
+    wgpu::BindGroup bindGroupAfterTextureDestroy =
+        utils::MakeBindGroup(device, bgl, {{0, buffer}, {1, view}});
+    EXPECT_NE(bindGroup.Get(), bindGroupAfterTextureDestroy.Get());
+
+    wgpu::Texture otherTexture = device.CreateTexture(&textureDesc);
+    wgpu::TextureView otherView = otherTexture.CreateView();
+    wgpu::BindGroup otherBindGroup =
+        utils::MakeBindGroup(device, bgl, {{0, buffer}, {1, otherView}});
+    buffer.Destroy();
+    wgpu::BindGroup otherBindGroupAfterBufferDestroy =
+        utils::MakeBindGroup(device, bgl, {{0, buffer}, {1, otherView}});
+    EXPECT_NE(otherBindGroup.Get(), otherBindGroupAfterBufferDestroy.Get());
+
+    EXPECT_EQ(GetHitCount(), 0u);
+}
+
 }  // anonymous namespace
 }  // namespace dawn
@@ -726,6 +726,70 @@ TEST_F(ShaderModuleValidationTest, CreateErrorShaderModule) {
     FlushWire();
 }
 
+class ShaderModuleAsyncParsingValidationTest : public ValidationTest {
+  protected:
+    WGPUDevice CreateTestDevice(native::Adapter dawnAdapter,
+                                wgpu::DeviceDescriptor descriptor) override {
+        const char* toggle = "async_shader_module_parsing";
+        wgpu::DawnTogglesDescriptor deviceTogglesDesc;
+        deviceTogglesDesc.enabledToggles = &toggle;
+        deviceTogglesDesc.enabledToggleCount = 1;
+        descriptor.nextInChain = &deviceTogglesDesc;
+        return dawnAdapter.CreateDevice(&descriptor);
+    }
+
+    void CreateComputePipeline(const wgpu::ShaderModule& module) {
+        wgpu::ComputePipelineDescriptor csDesc;
+        csDesc.compute.module = module;
+        device.CreateComputePipeline(&csDesc);
+    }
+};
+
+// Test that shader modules with deferred parsing can be used like the others.
+TEST_F(ShaderModuleAsyncParsingValidationTest, Success) {
+    wgpu::ShaderModule module = utils::CreateShaderModule(device, R"(
+        @group(0) @binding(0) var<storage, read_write> data : u32;
+        @compute @workgroup_size(1) fn main() {
+            data = 1u;
+        })");
+    CreateComputePipeline(module);
+}
+
+// Test that the errors of the descriptor are still reported on creation, but that the parsing
+// errors are reported by the pipeline creation instead.
+TEST_F(ShaderModuleAsyncParsingValidationTest, ParsingErrorReportedOnUse) {
+    wgpu::ShaderModuleDescriptor desc = {};
+    ASSERT_DEVICE_ERROR(device.CreateShaderModule(&desc));
+
+    wgpu::ShaderModule module = utils::CreateShaderModule(device, R"(
+        @compute @workgroup_size(1) fn main() {
+            let x : u32 = 1.0;
+        })");
+    ASSERT_DEVICE_ERROR(CreateComputePipeline(module));
+}
+
+// Test that GetCompilationInfo waits for the parsing and reports its errors.
+TEST_F(ShaderModuleAsyncParsingValidationTest, GetCompilationInfo) {
+    wgpu::ShaderModule module = utils::CreateShaderModule(device, R"(
+        @compute @workgroup_size(1) fn main() {
+            let x : u32 = 1.0;
+        })");
+
+    auto callback = [](WGPUCompilationInfoRequestStatus status, const WGPUCompilationInfo* info,
+                       void* userdata) {
+        *static_cast<bool*>(userdata) = true;
+        ASSERT_EQ(WGPUCompilationInfoRequestStatus_Success, status);
+        ASSERT_NE(nullptr, info);
+        ASSERT_EQ(1u, info->messageCount);
+        ASSERT_EQ(WGPUCompilationMessageType_Error, info->messages[0].type);
+    };
+    bool called = false;
+    module.GetCompilationInfo(callback, &called);
+
+    FlushWire();
+    EXPECT_TRUE(called);
+}
+
 class ShaderModuleExtensionValidationTestBase : public ValidationTest {
   protected:
     // Skip tests if using Wire, because some features are not supported by the wire and cause the
@@ -0,0 +1,188 @@
+// Copyright 2024 The Dawn & Tint Authors
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+//
+// 1. Redistributions of source code must retain the above copyright notice, this
+//    list of conditions and the following disclaimer.
+//
+// 2. Redistributions in binary form must reproduce the above copyright notice,
+//    this list of conditions and the following disclaimer in the documentation
+//    and/or other materials provided with the distribution.
+//
+// 3. Neither the name of the copyright holder nor the names of its
+//    contributors may be used to endorse or promote products derived from
+//    this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+// DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+// FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+// DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+// SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+// CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+// OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+// OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+
+#include <gtest/gtest.h>
+
+#include <limits>
+#include <memory>
+#include <thread>
+#include <unordered_map>
+#include <vector>
+
+#include "dawn/wire/client/ObjectStore.h"
+#include "dawn/wire/server/ObjectStorage.h"
+
+namespace dawn::wire {
+namespace {
+
+class TestObject : public client::ObjectBase {
+  public:
+    explicit TestObject(ObjectHandle handle) : ObjectBase({nullptr, handle}) {}
+};
+
+class WireObjectStoreTests : public testing::Test {
+  protected:
+    client::ObjectBase* Make() {
+        ObjectHandle handle = mStore.ReserveHandle();
+        client::ObjectBase* object = new TestObject(handle);
+        mObjects.Append(object);
+        mStore.Insert(std::unique_ptr<client::ObjectBase>(object));
+        return object;
+    }
+
+    client::ObjectStore mStore;
+    LinkedList<client::ObjectBase> mObjects;
+};
+
+// Test that IDs start at 1 and are reused with the next generation once freed.
+TEST_F(WireObjectStoreTests, HandlesAreReusedWithNextGeneration) {
+    client::ObjectBase* first = Make();
+    client::ObjectBase* second = Make();
+    EXPECT_EQ(first->GetWireId(), 1u);
+    EXPECT_EQ(second->GetWireId(), 2u);
+    EXPECT_EQ(first->GetWireGeneration(), 0u);
+
+    ObjectHandle firstHandle = first->GetWireHandle();
+    mStore.Free(first);
+    EXPECT_EQ(mStore.Get(firstHandle.id), nullptr);
+
+    client::ObjectBase* reused = Make();
+    EXPECT_EQ(reused->GetWireId(), 1u);
+    EXPECT_EQ(reused->GetWireGeneration(), 1u);
+    EXPECT_EQ(mStore.Get(ObjectId(1)), reused);
+    EXPECT_EQ(mStore.Get(reused->GetWireHandle()), reused);
+
+    // The handle of the freed object doesn't refer to the object reusing its ID.
+    EXPECT_EQ(mStore.Get(firstHandle), nullptr);
+}
+
+// Test getting IDs that were never allocated.
+TEST_F(WireObjectStoreTests, GetUnknownId) {
+    Make();
+    EXPECT_EQ(mStore.Get(ObjectId(0)), nullptr);
+    EXPECT_EQ(mStore.Get(ObjectId(2)), nullptr);
+    EXPECT_EQ(mStore.Get(ObjectId(100000)), nullptr);
+    EXPECT_EQ(mStore.Get(std::numeric_limits<ObjectId>::max()), nullptr);
+}
+
+// Test that the objects stay accessible while the store grows.
+TEST_F(WireObjectStoreTests, ManyObjects) {
+    std::vector<client::ObjectBase*> objects;
+    for (uint32_t i = 0; i < 10000; ++i) {
+        objects.push_back(Make());
+    }
+    for (client::ObjectBase* object : objects) {
+        EXPECT_EQ(mStore.Get(object->GetWireId()), object);
+    }
+}
+
+// Test reserving and freeing handles from several threads at once.
+TEST_F(WireObjectStoreTests, ConcurrentReserveAndFree) {
+    constexpr uint32_t kThreadCount = 4;
+    constexpr uint32_t kIterationCount = 2000;
+
+    std::vector<std::thread> threads;
+    for (uint32_t t = 0; t < kThreadCount; ++t) {
+        threads.emplace_back([&] {
+            LinkedList<client::ObjectBase> objects;
+            for (uint32_t i = 0; i < kIterationCount; ++i) {
+                ObjectHandle handle = mStore.ReserveHandle();
+                client::ObjectBase* object = new TestObject(handle);
+                objects.Append(object);
+                mStore.Insert(std::unique_ptr<client::ObjectBase>(object));
+                EXPECT_EQ(mStore.Get(handle), object);
+                if (i % 2 == 0) {
+                    mStore.Free(object);
+                }
+            }
+            while (!objects.empty()) {
+                mStore.Free(objects.head()->value());
+            }
+        });
+    }
+    for (std::thread& thread : threads) {
+        thread.join();
+    }
+
+    // All the IDs were returned, so only a few were allocated.
+    EXPECT_LE(Make()->GetWireId(), kThreadCount * kIterationCount);
+}
+
+// Test storing, getting and removing IDs in the server's lookup table.
+TEST(WireObjectIdLookupTableTests, StoreGetRemove) {
+    server::ObjectIdLookupTable<int*> table;
+    std::vector<int> values(1000);
+
+    EXPECT_EQ(table.Get(&values[0]), 0u);
+    for (uint32_t i = 0; i < values.size(); ++i) {
+        table.Store(&values[i], i + 1);
+    }
+    for (uint32_t i = 0; i < values.size(); ++i) {
+        EXPECT_EQ(table.Get(&values[i]), i + 1);
+    }
+
+    // Overwrite an ID.
+    table.Store(&values[10], 12345);
+    EXPECT_EQ(table.Get(&values[10]), 12345u);
+
+    // Remove every other entry, the others must still be found.
+    for (uint32_t i = 0; i < values.size(); i += 2) {
+        table.Remove(&values[i]);
+    }
+    table.Remove(&values[0]);
+    for (uint32_t i = 0; i < values.size(); ++i) {
+        EXPECT_EQ(table.Get(&values[i]), i % 2 == 0 ? 0 : i + 1);
+    }
+}
+
+// Test the lookup table against std::unordered_map with random operations.
+TEST(WireObjectIdLookupTableTests, MatchesUnorderedMap) {
+    server::ObjectIdLookupTable<int*> table;
+    std::unordered_map<int*, ObjectId> expected;
+    std::vector<int> values(256);
+
+    uint32_t random = 1;
+    for (uint32_t i = 0; i < 100000; ++i) {
+        random = random * 1664525 + 1013904223;
+        int* key = &values[(random >> 8) % values.size()];
+        if ((random >> 4) % 3 == 0) {
+            table.Remove(key);
+            expected.erase(key);
+        } else {
+            table.Store(key, i + 1);
+            expected[key] = i + 1;
+        }
+    }
+
+    for (int& value : values) {
+        auto it = expected.find(&value);
+        EXPECT_EQ(table.Get(&value), it == expected.end() ? 0 : it->second);
+    }
+}
+
+}  // anonymous namespace
+}  // namespace dawn::wire
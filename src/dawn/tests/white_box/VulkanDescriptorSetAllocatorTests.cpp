@@ -0,0 +1,151 @@
+// Copyright 2024 The Dawn & Tint Authors
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+//
+// 1. Redistributions of source code must retain the above copyright notice, this
+//    list of conditions and the following disclaimer.
+//
+// 2. Redistributions in binary form must reproduce the above copyright notice,
+//    this list of conditions and the following disclaimer in the documentation
+//    and/or other materials provided with the distribution.
+//
+// 3. Neither the name of the copyright holder nor the names of its
+//    contributors may be used to endorse or promote products derived from
+//    this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+// DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+// FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+// DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+// SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+// CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+// OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+// OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+
+#include <vector>
+
+#include "dawn/native/BindGroupLayout.h"
+#include "dawn/native/vulkan/BindGroupLayoutVk.h"
+#include "dawn/tests/DawnTest.h"
+#include "dawn/utils/WGPUHelpers.h"
+
+namespace dawn::native::vulkan {
+namespace {
+
+class VulkanDescriptorSetAllocatorTests : public DawnTest {
+  protected:
+    void SetUp() override {
+        DawnTest::SetUp();
+        DAWN_TEST_UNSUPPORTED_IF(UsesWire());
+
+        // A single descriptor per set so that the first pool holds 64 sets and each following
+        // pool holds twice as many as the previous one.
+        mBindGroupLayout = utils::MakeBindGroupLayout(
+            device, {{0, wgpu::ShaderStage::Compute, wgpu::BufferBindingType::Uniform}});
+
+        wgpu::BufferDescriptor bufferDesc;
+        bufferDesc.size = 4;
+        bufferDesc.usage = wgpu::BufferUsage::Uniform;
+        mBuffer = device.CreateBuffer(&bufferDesc);
+    }
+
+    void CreateBindGroups(uint32_t count) {
+        for (uint32_t i = 0; i < count; ++i) {
+            mBindGroups.push_back(utils::MakeBindGroup(device, mBindGroupLayout, {{0, mBuffer}}));
+        }
+    }
+
+    DescriptorSetAllocator::Stats GetStats() {
+        BindGroupLayout* layout =
+            ToBackend(FromAPI(mBindGroupLayout.Get())->GetInternalBindGroupLayout());
+        return layout->GetDescriptorSetAllocatorStats();
+    }
+
+    // Deallocations complete once the GPU is done with the commands that might use the sets,
+    // submit some work and wait for it to make sure all pending deallocations are processed.
+    void FinishPendingDeallocations() {
+        wgpu::CommandBuffer commands = device.CreateCommandEncoder().Finish();
+        queue.Submit(1, &commands);
+        WaitForAllOperations();
+    }
+
+    wgpu::BindGroupLayout mBindGroupLayout;
+    wgpu::Buffer mBuffer;
+    std::vector<wgpu::BindGroup> mBindGroups;
+};
+
+// Test that each new pool is twice as large as the previous one.
+TEST_P(VulkanDescriptorSetAllocatorTests, PoolsGrowGeometrically) {
+    CreateBindGroups(1);
+    DescriptorSetAllocator::Stats stats = GetStats();
+    EXPECT_EQ(stats.poolCount, 1u);
+    EXPECT_EQ(stats.setCapacity, 64u);
+    EXPECT_EQ(stats.setsInUse, 1u);
+
+    CreateBindGroups(63 + 1);
+    stats = GetStats();
+    EXPECT_EQ(stats.poolCount, 2u);
+    EXPECT_EQ(stats.setCapacity, 64u + 128u);
+    EXPECT_EQ(stats.setsInUse, 65u);
+
+    CreateBindGroups(127 + 1);
+    stats = GetStats();
+    EXPECT_EQ(stats.poolCount, 3u);
+    EXPECT_EQ(stats.setCapacity, 64u + 128u + 256u);
+    EXPECT_EQ(stats.setsInUse, 193u);
+    EXPECT_EQ(stats.fragmentedSets, 0u);
+}
+
+// Test that freed sets fragment a pool until all of its sets are freed and it is reset, at which
+// point it is reused for new allocations.
+TEST_P(VulkanDescriptorSetAllocatorTests, PoolIsResetWhenAllSetsAreFreed) {
+    // Fill the first pool and start the second one.
+    CreateBindGroups(64 + 1);
+
+    // Free half of the first pool.
+    mBindGroups.erase(mBindGroups.begin(), mBindGroups.begin() + 32);
+    FinishPendingDeallocations();
+    DescriptorSetAllocator::Stats stats = GetStats();
+    EXPECT_EQ(stats.poolCount, 2u);
+    EXPECT_EQ(stats.setsInUse, 33u);
+    EXPECT_EQ(stats.fragmentedSets, 32u);
+
+    // Free the rest of the first pool, it gets reset.
+    mBindGroups.erase(mBindGroups.begin(), mBindGroups.begin() + 32);
+    FinishPendingDeallocations();
+    stats = GetStats();
+    EXPECT_EQ(stats.poolCount, 2u);
+    EXPECT_EQ(stats.setsInUse, 1u);
+    EXPECT_EQ(stats.fragmentedSets, 0u);
+
+    // Fill the second pool, the first one is reused instead of creating a new pool.
+    CreateBindGroups(127 + 1);
+    stats = GetStats();
+    EXPECT_EQ(stats.poolCount, 2u);
+    EXPECT_EQ(stats.setCapacity, 64u + 128u);
+    EXPECT_EQ(stats.setsInUse, 129u);
+}
+
+// Test that only the largest idle pool is kept after a burst of allocations is freed.
+TEST_P(VulkanDescriptorSetAllocatorTests, IdlePoolsAreTrimmed) {
+    CreateBindGroups(64 + 128 + 1);
+    EXPECT_EQ(GetStats().poolCount, 3u);
+
+    mBindGroups.clear();
+    FinishPendingDeallocations();
+
+    // The pool that was being allocated from and the largest empty pool are kept.
+    DescriptorSetAllocator::Stats stats = GetStats();
+    EXPECT_EQ(stats.poolCount, 2u);
+    EXPECT_EQ(stats.setCapacity, 128u + 256u);
+    EXPECT_EQ(stats.setsInUse, 0u);
+    EXPECT_EQ(stats.fragmentedSets, 0u);
+}
+
+DAWN_INSTANTIATE_TEST(VulkanDescriptorSetAllocatorTests, VulkanBackend());
+
+}  // anonymous namespace
+}  // namespace dawn::native::vulkan
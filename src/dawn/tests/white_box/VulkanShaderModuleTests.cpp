@@ -0,0 +1,103 @@
+// Copyright 2024 The Dawn & Tint Authors
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+//
+// 1. Redistributions of source code must retain the above copyright notice, this
+//    list of conditions and the following disclaimer.
+//
+// 2. Redistributions in binary form must reproduce the above copyright notice,
+//    this list of conditions and the following disclaimer in the documentation
+//    and/or other materials provided with the distribution.
+//
+// 3. Neither the name of the copyright holder nor the names of its
+//    contributors may be used to endorse or promote products derived from
+//    this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+// DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+// FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+// DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+// SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+// CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+// OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+// OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+
+#include "dawn/tests/DawnTest.h"
+#include "dawn/utils/ComboRenderPipelineDescriptor.h"
+#include "dawn/utils/WGPUHelpers.h"
+
+namespace dawn::native::vulkan {
+namespace {
+
+using ::testing::HasSubstr;
+
+class VulkanShaderModuleTests : public DawnTest {
+  protected:
+    static constexpr uint32_t kRTSize = 4;
+
+    wgpu::RenderPipeline CreatePipeline(wgpu::ShaderModule module) {
+        utils::ComboRenderPipelineDescriptor descriptor;
+        descriptor.vertex.module = module;
+        descriptor.vertex.entryPoint = "vs_main";
+        descriptor.cFragment.module = module;
+        descriptor.cFragment.entryPoint = "fs_main";
+        descriptor.cTargets[0].format = wgpu::TextureFormat::RGBA8Unorm;
+        return device.CreateRenderPipeline(&descriptor);
+    }
+};
+
+// Test that a render pipeline whose vertex and fragment stages come from the same shader module,
+// which compiles both stages in parallel before adding them to the pipeline, renders correctly.
+TEST_P(VulkanShaderModuleTests, SharedModuleForVertexAndFragment) {
+    wgpu::ShaderModule module = utils::CreateShaderModule(device, R"(
+        @vertex fn vs_main(@builtin(vertex_index) i : u32) -> @builtin(position) vec4f {
+            var pos = array(vec2f(-1.0, -1.0), vec2f(3.0, -1.0), vec2f(-1.0, 3.0));
+            return vec4f(pos[i], 0.0, 1.0);
+        }
+
+        @fragment fn fs_main() -> @location(0) vec4f {
+            return vec4f(0.0, 1.0, 0.0, 1.0);
+        }
+    )");
+    wgpu::RenderPipeline pipeline = CreatePipeline(module);
+
+    utils::BasicRenderPass renderPass = utils::CreateBasicRenderPass(device, kRTSize, kRTSize);
+    wgpu::CommandEncoder encoder = device.CreateCommandEncoder();
+    wgpu::RenderPassEncoder pass = encoder.BeginRenderPass(&renderPass.renderPassInfo);
+    pass.SetPipeline(pipeline);
+    pass.Draw(3);
+    pass.End();
+    wgpu::CommandBuffer commands = encoder.Finish();
+    queue.Submit(1, &commands);
+
+    EXPECT_PIXEL_RGBA8_EQ(utils::RGBA8::kGreen, renderPass.color, 0, 0);
+    EXPECT_PIXEL_RGBA8_EQ(utils::RGBA8::kGreen, renderPass.color, kRTSize - 1, kRTSize - 1);
+}
+
+// Test that an error compiling the fragment stage, which is compiled on a worker thread when both
+// stages come from the same shader module, is returned as the error of the pipeline creation.
+TEST_P(VulkanShaderModuleTests, SharedModuleFragmentStageError) {
+    // The division by zero is only detected when the override is substituted, at the time the
+    // fragment stage is compiled.
+    wgpu::ShaderModule module = utils::CreateShaderModule(device, R"(
+        override zero : i32 = 0;
+
+        @vertex fn vs_main() -> @builtin(position) vec4f {
+            return vec4f(0.0, 0.0, 0.0, 1.0);
+        }
+
+        @fragment fn fs_main() -> @location(0) vec4f {
+            let x = 1 / zero;
+            return vec4f(f32(x), 1.0, 0.0, 1.0);
+        }
+    )");
+    ASSERT_DEVICE_ERROR_MSG(CreatePipeline(module), HasSubstr("division by zero"));
+}
+
+DAWN_INSTANTIATE_TEST(VulkanShaderModuleTests, VulkanBackend());
+
+}  // anonymous namespace
+}  // namespace dawn::native::vulkan
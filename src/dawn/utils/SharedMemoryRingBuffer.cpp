@@ -0,0 +1,331 @@
+// Copyright 2024 The Dawn & Tint Authors
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+//
+// 1. Redistributions of source code must retain the above copyright notice, this
+//    list of conditions and the following disclaimer.
+//
+// 2. Redistributions in binary form must reproduce the above copyright notice,
+//    this list of conditions and the following disclaimer in the documentation
+//    and/or other materials provided with the distribution.
+//
+// 3. Neither the name of the copyright holder nor the names of its
+//    contributors may be used to endorse or promote products derived from
+//    this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+// DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+// FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+// DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+// SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+// CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+// OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+// OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+
+#include "dawn/utils/SharedMemoryRingBuffer.h"
+
+#include <algorithm>
+#include <atomic>
+#include <thread>
+#include <utility>
+
+#include "dawn/common/Assert.h"
+#include "dawn/common/Math.h"
+#include "dawn/common/Platform.h"
+
+#if DAWN_PLATFORM_IS(LINUX) || DAWN_PLATFORM_IS(APPLE)
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#define DAWN_SHARED_MEMORY_RING_SUPPORTED 1
+#if DAWN_PLATFORM_IS(LINUX)
+#include <sys/syscall.h>
+#ifndef MFD_CLOEXEC
+#define MFD_CLOEXEC 0x0001U
+#endif
+#else
+#include <string>
+#endif
+#endif
+
+namespace dawn::utils {
+
+// The header lives in its own page at the start of the shared memory, followed by the data pages.
+// The offsets increase monotonically and are taken modulo the capacity to index the data.
+struct SharedMemoryRingBuffer::Header {
+    // Written by the producer, read by the consumer.
+    alignas(64) std::atomic<uint64_t> writeOffset;
+    // Written by the consumer, read by the producer.
+    alignas(64) std::atomic<uint64_t> readOffset;
+    std::atomic<uint32_t> closed;
+};
+
+static_assert(std::atomic<uint64_t>::is_always_lock_free,
+              "The ring offsets must be lock-free to be shared between processes");
+
+namespace {
+
+#if defined(DAWN_SHARED_MEMORY_RING_SUPPORTED)
+int CreateSharedMemoryFile(size_t size) {
+#if DAWN_PLATFORM_IS(LINUX)
+    // Use the raw syscall since memfd_create isn't exposed by older libcs.
+    int fd = static_cast<int>(syscall(SYS_memfd_create, "dawn_wire_ring", MFD_CLOEXEC));
+#else
+    static std::atomic<uint32_t> sNextId{0};
+    std::string name = "/dawn_wire_ring_" + std::to_string(getpid()) + "_" +
+                       std::to_string(sNextId.fetch_add(1));
+    int fd = shm_open(name.c_str(), O_RDWR | O_CREAT | O_EXCL, S_IRUSR | S_IWUSR);
+    if (fd >= 0) {
+        // The memory stays alive as long as there are file descriptors or mappings to it.
+        shm_unlink(name.c_str());
+    }
+#endif
+    if (fd < 0) {
+        return -1;
+    }
+    if (ftruncate(fd, static_cast<off_t>(size)) != 0) {
+        close(fd);
+        return -1;
+    }
+    return fd;
+}
+#endif  // defined(DAWN_SHARED_MEMORY_RING_SUPPORTED)
+
+}  // anonymous namespace
+
+// static
+std::unique_ptr<SharedMemoryRingBuffer> SharedMemoryRingBuffer::Create(size_t capacity) {
+#if defined(DAWN_SHARED_MEMORY_RING_SUPPORTED)
+    size_t pageSize = static_cast<size_t>(sysconf(_SC_PAGESIZE));
+    capacity = Align(std::max(capacity, pageSize), pageSize);
+
+    int fd = CreateSharedMemoryFile(pageSize + capacity);
+    if (fd < 0) {
+        return nullptr;
+    }
+    return Import(fd, capacity);
+#else
+    return nullptr;
+#endif
+}
+
+// static
+std::unique_ptr<SharedMemoryRingBuffer> SharedMemoryRingBuffer::Import(int fd, size_t capacity) {
+#if defined(DAWN_SHARED_MEMORY_RING_SUPPORTED)
+    size_t pageSize = static_cast<size_t>(sysconf(_SC_PAGESIZE));
+    if (fd < 0 || capacity == 0 || capacity % pageSize != 0) {
+        if (fd >= 0) {
+            close(fd);
+        }
+        return nullptr;
+    }
+
+    // Reserve the address space for the header and two copies of the data, then map the file
+    // over it: once for the header and data, and once more for the data alone, right after.
+    size_t mappingSize = pageSize + 2 * capacity;
+    void* reservation = mmap(nullptr, mappingSize, PROT_NONE, MAP_PRIVATE | MAP_ANON, -1, 0);
+    if (reservation == MAP_FAILED) {
+        close(fd);
+        return nullptr;
+    }
+    char* mapping = static_cast<char*>(reservation);
+
+    void* primary = mmap(mapping, pageSize + capacity, PROT_READ | PROT_WRITE,
+                         MAP_SHARED | MAP_FIXED, fd, 0);
+    void* mirror = mmap(mapping + pageSize + capacity, capacity, PROT_READ | PROT_WRITE,
+                        MAP_SHARED | MAP_FIXED, fd, static_cast<off_t>(pageSize));
+    if (primary == MAP_FAILED || mirror == MAP_FAILED) {
+        munmap(mapping, mappingSize);
+        close(fd);
+        return nullptr;
+    }
+
+    return std::unique_ptr<SharedMemoryRingBuffer>(
+        new SharedMemoryRingBuffer(fd, capacity, mappingSize, mapping));
+#else
+    return nullptr;
+#endif
+}
+
+SharedMemoryRingBuffer::SharedMemoryRingBuffer(int fd,
+                                               size_t capacity,
+                                               size_t mappingSize,
+                                               char* mapping)
+    : mFd(fd), mCapacity(capacity), mMappingSize(mappingSize), mMapping(mapping) {}
+
+SharedMemoryRingBuffer::~SharedMemoryRingBuffer() {
+#if defined(DAWN_SHARED_MEMORY_RING_SUPPORTED)
+    munmap(mMapping, mMappingSize);
+    close(mFd);
+#endif
+}
+
+int SharedMemoryRingBuffer::GetFileDescriptor() const {
+    return mFd;
+}
+
+size_t SharedMemoryRingBuffer::GetCapacity() const {
+    return mCapacity;
+}
+
+void SharedMemoryRingBuffer::Close() {
+    GetHeader()->closed.store(1, std::memory_order_release);
+}
+
+bool SharedMemoryRingBuffer::IsClosed() const {
+    return GetHeader()->closed.load(std::memory_order_acquire) != 0;
+}
+
+SharedMemoryRingBuffer::Header* SharedMemoryRingBuffer::GetHeader() const {
+    return reinterpret_cast<Header*>(mMapping);
+}
+
+char* SharedMemoryRingBuffer::GetData(uint64_t offset) const {
+    // The data starts after the header page, which is at least as large as the header.
+    size_t headerSize = mMappingSize - 2 * mCapacity;
+    return mMapping + headerSize + static_cast<size_t>(offset % mCapacity);
+}
+
+// SharedMemoryCommandSerializer
+
+SharedMemoryCommandSerializer::SharedMemoryCommandSerializer(SharedMemoryRingBuffer* ring)
+    : mRing(ring) {
+    mWriteOffset = mRing->GetHeader()->writeOffset.load(std::memory_order_relaxed);
+}
+
+SharedMemoryCommandSerializer::~SharedMemoryCommandSerializer() = default;
+
+void SharedMemoryCommandSerializer::SetLocalReceiver(SharedMemoryCommandReceiver* receiver) {
+    mLocalReceiver = receiver;
+}
+
+size_t SharedMemoryCommandSerializer::GetMaximumAllocationSize() const {
+    // Use at most half of the ring for a single command so that the producer can keep
+    // serializing while the consumer handles the other half. The capacity is a multiple of the
+    // page size so this stays aligned.
+    return mRing->GetCapacity() / 2;
+}
+
+void* SharedMemoryCommandSerializer::GetCmdSpace(size_t size) {
+    // Note: This returns non-null even if size is zero.
+    if (size > GetMaximumAllocationSize()) {
+        return nullptr;
+    }
+
+    uint64_t readOffset = mRing->GetHeader()->readOffset.load(std::memory_order_acquire);
+    if (readOffset > mWriteOffset || mRing->GetCapacity() - (mWriteOffset - readOffset) < size) {
+        // All the previous allocations have been filled by now, so they can be published while
+        // waiting for the consumer to catch up.
+        Publish();
+        if (!WaitForSpace(size)) {
+            return nullptr;
+        }
+    }
+
+    // Thanks to the mirrored mapping the allocation is contiguous even if it wraps around.
+    char* result = mRing->GetData(mWriteOffset);
+    mWriteOffset += size;
+    return result;
+}
+
+bool SharedMemoryCommandSerializer::Flush() {
+    Publish();
+    if (mLocalReceiver != nullptr) {
+        return mLocalReceiver->ProcessCommands();
+    }
+    return !mRing->IsClosed();
+}
+
+void SharedMemoryCommandSerializer::Publish() {
+    mRing->GetHeader()->writeOffset.store(mWriteOffset, std::memory_order_release);
+}
+
+bool SharedMemoryCommandSerializer::WaitForSpace(size_t size) {
+    SharedMemoryRingBuffer::Header* header = mRing->GetHeader();
+    while (true) {
+        uint64_t readOffset = header->readOffset.load(std::memory_order_acquire);
+        // The consumer can't be trusted to give a sensible read offset.
+        if (readOffset > mWriteOffset || mWriteOffset - readOffset > mRing->GetCapacity()) {
+            return false;
+        }
+        if (mRing->GetCapacity() - (mWriteOffset - readOffset) >= size) {
+            return true;
+        }
+
+        if (mLocalReceiver != nullptr) {
+            if (!mLocalReceiver->ProcessCommands()) {
+                return false;
+            }
+        } else if (mRing->IsClosed()) {
+            return false;
+        } else {
+            std::this_thread::yield();
+        }
+    }
+}
+
+// SharedMemoryCommandReceiver
+
+SharedMemoryCommandReceiver::SharedMemoryCommandReceiver(SharedMemoryRingBuffer* ring,
+                                                         dawn::wire::CommandHandler* handler)
+    : mRing(ring), mHandler(handler) {
+    mReadOffset = mRing->GetHeader()->readOffset.load(std::memory_order_relaxed);
+}
+
+SharedMemoryCommandReceiver::~SharedMemoryCommandReceiver() = default;
+
+void SharedMemoryCommandReceiver::SetHandler(dawn::wire::CommandHandler* handler) {
+    mHandler = handler;
+}
+
+bool SharedMemoryCommandReceiver::ProcessCommands() {
+    DAWN_ASSERT(mHandler != nullptr);
+    SharedMemoryRingBuffer::Header* header = mRing->GetHeader();
+
+    uint64_t writeOffset = header->writeOffset.load(std::memory_order_acquire);
+    // The producer can't be trusted to give a sensible write offset.
+    if (writeOffset < mReadOffset || writeOffset - mReadOffset > mRing->GetCapacity()) {
+        return false;
+    }
+    if (writeOffset == mReadOffset) {
+        return true;
+    }
+
+    // The commands are handled in place, the handler reads them through volatile pointers so
+    // it is robust to the producer modifying them concurrently.
+    size_t size = static_cast<size_t>(writeOffset - mReadOffset);
+    bool success = mHandler->HandleCommands(mRing->GetData(mReadOffset), size) != nullptr;
+
+    mReadOffset = writeOffset;
+    header->readOffset.store(mReadOffset, std::memory_order_release);
+    return success;
+}
+
+// SharedMemoryCommandBuffer
+
+// static
+std::unique_ptr<SharedMemoryCommandBuffer> SharedMemoryCommandBuffer::Create(size_t capacity) {
+    std::unique_ptr<SharedMemoryRingBuffer> ring = SharedMemoryRingBuffer::Create(capacity);
+    if (ring == nullptr) {
+        return nullptr;
+    }
+    return std::unique_ptr<SharedMemoryCommandBuffer>(
+        new SharedMemoryCommandBuffer(std::move(ring)));
+}
+
+SharedMemoryCommandBuffer::SharedMemoryCommandBuffer(std::unique_ptr<SharedMemoryRingBuffer> ring)
+    : SharedMemoryCommandSerializer(ring.get()), mRing(std::move(ring)), mReceiver(mRing.get()) {
+    SetLocalReceiver(&mReceiver);
+}
+
+SharedMemoryCommandBuffer::~SharedMemoryCommandBuffer() = default;
+
+void SharedMemoryCommandBuffer::SetHandler(dawn::wire::CommandHandler* handler) {
+    mReceiver.SetHandler(handler);
+}
+
+}  // namespace dawn::utils
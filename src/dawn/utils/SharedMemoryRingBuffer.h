@@ -0,0 +1,152 @@
+// Copyright 2024 The Dawn & Tint Authors
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+//
+// 1. Redistributions of source code must retain the above copyright notice, this
+//    list of conditions and the following disclaimer.
+//
+// 2. Redistributions in binary form must reproduce the above copyright notice,
+//    this list of conditions and the following disclaimer in the documentation
+//    and/or other materials provided with the distribution.
+//
+// 3. Neither the name of the copyright holder nor the names of its
+//    contributors may be used to endorse or promote products derived from
+//    this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+// DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+// FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+// DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+// SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+// CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+// OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+// OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+
+#ifndef SRC_DAWN_UTILS_SHAREDMEMORYRINGBUFFER_H_
+#define SRC_DAWN_UTILS_SHAREDMEMORYRINGBUFFER_H_
+
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+
+#include "dawn/wire/Wire.h"
+
+namespace dawn::utils {
+
+// A single-producer single-consumer ring buffer in shared memory that can be used as a transport
+// for dawn::wire between two threads or two processes.
+//
+// The data pages are mapped twice, back to back, so that any range of up to GetCapacity() bytes
+// starting in the ring is contiguous in memory. This lets the producer serialize commands
+// directly into the ring and the consumer deserialize them in place even when they wrap around
+// the end of the ring.
+//
+// Only Linux (memfd) and macOS (POSIX shared memory) are supported. Create() returns nullptr on
+// other platforms.
+class SharedMemoryRingBuffer {
+  public:
+    // Creates a new ring of at least |capacity| bytes. The capacity is rounded up to a multiple of
+    // the page size.
+    static std::unique_ptr<SharedMemoryRingBuffer> Create(size_t capacity);
+    // Maps a ring created by another process from its file descriptor, see GetFileDescriptor().
+    // Takes ownership of |fd|.
+    static std::unique_ptr<SharedMemoryRingBuffer> Import(int fd, size_t capacity);
+
+    ~SharedMemoryRingBuffer();
+
+    // The file descriptor to send to the other process so that it can Import() the ring.
+    int GetFileDescriptor() const;
+    size_t GetCapacity() const;
+
+    // Marks the ring as closed so that the peer stops waiting on it.
+    void Close();
+    bool IsClosed() const;
+
+  private:
+    friend class SharedMemoryCommandSerializer;
+    friend class SharedMemoryCommandReceiver;
+
+    struct Header;
+
+    SharedMemoryRingBuffer(int fd, size_t capacity, size_t mappingSize, char* mapping);
+
+    Header* GetHeader() const;
+    char* GetData(uint64_t offset) const;
+
+    int mFd;
+    size_t mCapacity;
+    size_t mMappingSize;
+    char* mMapping;
+};
+
+class SharedMemoryCommandReceiver;
+
+// The producer side of the ring. Commands are written directly into the shared memory and are
+// made visible to the consumer on Flush().
+class SharedMemoryCommandSerializer : public dawn::wire::CommandSerializer {
+  public:
+    explicit SharedMemoryCommandSerializer(SharedMemoryRingBuffer* ring);
+    ~SharedMemoryCommandSerializer() override;
+
+    // When the consumer lives on the same thread, |receiver| is run synchronously on Flush() and
+    // when the ring is full. Otherwise GetCmdSpace() waits for the consumer to make space.
+    void SetLocalReceiver(SharedMemoryCommandReceiver* receiver);
+
+    size_t GetMaximumAllocationSize() const override;
+    void* GetCmdSpace(size_t size) override;
+    bool Flush() override;
+
+  private:
+    // Makes all the commands returned by GetCmdSpace so far visible to the consumer.
+    void Publish();
+    bool WaitForSpace(size_t size);
+
+    SharedMemoryRingBuffer* mRing;
+    SharedMemoryCommandReceiver* mLocalReceiver = nullptr;
+    // The offset after the last allocation returned by GetCmdSpace.
+    uint64_t mWriteOffset = 0;
+};
+
+// The consumer side of the ring. It hands the published commands to the wire CommandHandler
+// directly from the shared memory.
+class SharedMemoryCommandReceiver {
+  public:
+    SharedMemoryCommandReceiver(SharedMemoryRingBuffer* ring,
+                                dawn::wire::CommandHandler* handler = nullptr);
+    ~SharedMemoryCommandReceiver();
+
+    void SetHandler(dawn::wire::CommandHandler* handler);
+
+    // Handles all the commands published so far. Returns false if the handler failed or if the
+    // ring is in an invalid state.
+    bool ProcessCommands();
+
+  private:
+    SharedMemoryRingBuffer* mRing;
+    dawn::wire::CommandHandler* mHandler = nullptr;
+    // A local copy of the read offset: the one in shared memory can't be trusted.
+    uint64_t mReadOffset = 0;
+};
+
+// Bundles a ring with both its endpoints for in-process use. It is a drop-in replacement for
+// TerribleCommandBuffer.
+class SharedMemoryCommandBuffer : public SharedMemoryCommandSerializer {
+  public:
+    static std::unique_ptr<SharedMemoryCommandBuffer> Create(size_t capacity);
+    ~SharedMemoryCommandBuffer() override;
+
+    void SetHandler(dawn::wire::CommandHandler* handler);
+
+  private:
+    explicit SharedMemoryCommandBuffer(std::unique_ptr<SharedMemoryRingBuffer> ring);
+
+    std::unique_ptr<SharedMemoryRingBuffer> mRing;
+    SharedMemoryCommandReceiver mReceiver;
+};
+
+}  // namespace dawn::utils
+
+#endif  // SRC_DAWN_UTILS_SHAREDMEMORYRINGBUFFER_H_
@@ -29,15 +29,18 @@
 #include <cstring>
 #include <fstream>
 #include <iomanip>
+#include <memory>
 #include <set>
 #include <sstream>
 #include <string>
+#include <utility>
 
 #include "dawn/common/Assert.h"
 #include "dawn/common/Log.h"
 #include "dawn/common/SystemUtils.h"
 #include "dawn/dawn_proc.h"
 #include "dawn/native/DawnNative.h"
+#include "dawn/utils/SharedMemoryRingBuffer.h"
 #include "dawn/utils/TerribleCommandBuffer.h"
 #include "dawn/utils/WireHelper.h"
 #include "dawn/wire/WireClient.h"
@@ -106,12 +109,15 @@ class WireHelperDirect : public WireHelper {
     bool FlushServer() override { return true; }
 };
 
+// CommandBuffer is either TerribleCommandBuffer or SharedMemoryCommandBuffer.
+template <typename CommandBuffer>
 class WireHelperProxy : public WireHelper {
   public:
-    explicit WireHelperProxy(const char* wireTraceDir, const DawnProcTable& procs) {
-        mC2sBuf = std::make_unique<dawn::utils::TerribleCommandBuffer>();
-        mS2cBuf = std::make_unique<dawn::utils::TerribleCommandBuffer>();
-
+    WireHelperProxy(const char* wireTraceDir,
+                    const DawnProcTable& procs,
+                    std::unique_ptr<CommandBuffer> c2sBuf,
+                    std::unique_ptr<CommandBuffer> s2cBuf)
+        : mC2sBuf(std::move(c2sBuf)), mS2cBuf(std::move(s2cBuf)) {
         dawn::wire::WireServerDescriptor serverDesc = {};
         serverDesc.procs = &procs;
         serverDesc.serializer = mS2cBuf.get();
@@ -153,8 +159,8 @@ class WireHelperProxy : public WireHelper {
     bool FlushServer() override { return mS2cBuf->Flush(); }
 
   private:
-    std::unique_ptr<dawn::utils::TerribleCommandBuffer> mC2sBuf;
-    std::unique_ptr<dawn::utils::TerribleCommandBuffer> mS2cBuf;
+    std::unique_ptr<CommandBuffer> mC2sBuf;
+    std::unique_ptr<CommandBuffer> mS2cBuf;
     std::unique_ptr<WireServerTraceLayer> mWireServerTraceLayer;
     std::unique_ptr<dawn::wire::WireServer> mWireServer;
     std::unique_ptr<dawn::wire::WireClient> mWireClient;
@@ -175,12 +181,28 @@ std::pair<wgpu::Instance, std::unique_ptr<dawn::native::Instance>> WireHelper::C
 
 std::unique_ptr<WireHelper> CreateWireHelper(const DawnProcTable& procs,
                                              bool useWire,
-                                             const char* wireTraceDir) {
-    if (useWire) {
-        return std::unique_ptr<WireHelper>(new WireHelperProxy(wireTraceDir, procs));
-    } else {
+                                             const char* wireTraceDir,
+                                             WireTransport transport) {
+    if (!useWire) {
         return std::unique_ptr<WireHelper>(new WireHelperDirect(procs));
     }
+
+    if (transport == WireTransport::SharedMemory) {
+        // Use rings of about the size of the TerribleCommandBuffer buffer.
+        constexpr size_t kRingCapacity = 1 << 20;
+        auto c2sBuf = SharedMemoryCommandBuffer::Create(kRingCapacity);
+        auto s2cBuf = SharedMemoryCommandBuffer::Create(kRingCapacity);
+        if (c2sBuf != nullptr && s2cBuf != nullptr) {
+            return std::unique_ptr<WireHelper>(new WireHelperProxy<SharedMemoryCommandBuffer>(
+                wireTraceDir, procs, std::move(c2sBuf), std::move(s2cBuf)));
+        }
+        dawn::WarningLog() << "Shared memory is not supported, using TerribleCommandBuffer for "
+                              "the wire transport.";
+    }
+
+    return std::unique_ptr<WireHelper>(new WireHelperProxy<TerribleCommandBuffer>(
+        wireTraceDir, procs, std::make_unique<TerribleCommandBuffer>(),
+        std::make_unique<TerribleCommandBuffer>()));
 }
 
 WireHelper::~WireHelper() {
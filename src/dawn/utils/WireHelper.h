@@ -65,9 +65,20 @@ class WireHelper {
     virtual bool FlushServer() = 0;
 };
 
-std::unique_ptr<WireHelper> CreateWireHelper(const DawnProcTable& procs,
-                                             bool useWire,
-                                             const char* wireTraceDir = nullptr);
+// The transport used between the wire client and server when the wire is used.
+enum class WireTransport {
+    // A fixed-size buffer that is synchronously handled on flush.
+    TerribleCommandBuffer,
+    // A ring buffer in shared memory that is handled in place. Falls back to
+    // TerribleCommandBuffer if shared memory isn't supported.
+    SharedMemory,
+};
+
+std::unique_ptr<WireHelper> CreateWireHelper(
+    const DawnProcTable& procs,
+    bool useWire,
+    const char* wireTraceDir = nullptr,
+    WireTransport transport = WireTransport::TerribleCommandBuffer);
 
 }  // namespace dawn::utils
 
@@ -30,36 +30,96 @@
 #include <limits>
 #include <utility>
 
+#include "dawn/common/Assert.h"
+#include "dawn/common/Math.h"
+
 namespace dawn::wire::client {
 
+namespace {
+
+constexpr uint64_t kFreeHandlesIdMask = 0xFFFF'FFFF;
+
+uint64_t MakeFreeHandlesHead(uint64_t previousHead, ObjectId id) {
+    return ((previousHead & ~kFreeHandlesIdMask) + (kFreeHandlesIdMask + 1)) | id;
+}
+
+}  // anonymous namespace
+
 ObjectStore::ObjectStore() {
     // ID 0 is nullptr
-    mObjects.emplace_back(nullptr);
     mCurrentId = 1;
+    GetOrCreateSlot(0);
+}
+
+ObjectStore::~ObjectStore() {
+    for (size_t i = 0; i < kSegmentCount; ++i) {
+        Slot* segment = mSegments[i].load(std::memory_order_relaxed);
+        if (segment == nullptr) {
+            continue;
+        }
+        for (uint64_t j = 0; j < (kFirstSegmentSize << i); ++j) {
+            delete segment[j].object.load(std::memory_order_relaxed);
+        }
+        delete[] segment;
+    }
+}
+
+ObjectStore::Slot* ObjectStore::GetSlot(ObjectId id) const {
+    // Segment i starts at ID kFirstSegmentSize * (2^i - 1).
+    uint64_t segmentIndex = Log2(uint64_t(id) / kFirstSegmentSize + 1);
+    uint64_t segmentStart = kFirstSegmentSize * ((uint64_t(1) << segmentIndex) - 1);
+    Slot* segment = mSegments[segmentIndex].load(std::memory_order_acquire);
+    if (segment == nullptr) {
+        return nullptr;
+    }
+    return &segment[id - segmentStart];
+}
+
+ObjectStore::Slot* ObjectStore::GetOrCreateSlot(ObjectId id) {
+    Slot* slot = GetSlot(id);
+    if (slot != nullptr) {
+        return slot;
+    }
+
+    // Only the creation of segments is serialized, which happens a logarithmic number of times.
+    std::lock_guard<std::mutex> lock(mSegmentCreationMutex);
+    uint64_t segmentIndex = Log2(uint64_t(id) / kFirstSegmentSize + 1);
+    if (mSegments[segmentIndex].load(std::memory_order_relaxed) == nullptr) {
+        mSegments[segmentIndex].store(new Slot[kFirstSegmentSize << segmentIndex],
+                                      std::memory_order_release);
+    }
+    return GetSlot(id);
 }
 
 ObjectHandle ObjectStore::ReserveHandle() {
-    if (mFreeHandles.empty()) {
-        return {mCurrentId++, 0};
+    uint64_t head = mFreeHandlesHead.load(std::memory_order_acquire);
+    while ((head & kFreeHandlesIdMask) != 0) {
+        ObjectId id = static_cast<ObjectId>(head & kFreeHandlesIdMask);
+        Slot* slot = GetSlot(id);
+        // The slot might be concurrently popped and pushed again, in which case nextFreeId is
+        // stale but the counter in the head makes the exchange fail.
+        uint64_t newHead =
+            MakeFreeHandlesHead(head, slot->nextFreeId.load(std::memory_order_relaxed));
+        if (mFreeHandlesHead.compare_exchange_weak(head, newHead, std::memory_order_acquire)) {
+            return {id, slot->generation.load(std::memory_order_relaxed)};
+        }
     }
-    ObjectHandle handle = mFreeHandles.back();
-    mFreeHandles.pop_back();
-    return handle;
+
+    ObjectId id = mCurrentId.fetch_add(1, std::memory_order_relaxed);
+    GetOrCreateSlot(id);
+    return {id, 0};
 }
 
 void ObjectStore::Insert(std::unique_ptr<ObjectBase> obj) {
-    ObjectId id = obj->GetWireId();
-
-    if (id >= mObjects.size()) {
-        DAWN_ASSERT(id == mObjects.size());
-        mObjects.emplace_back(std::move(obj));
-    } else {
-        // The generation should never overflow. We don't recycle ObjectIds that would
-        // overflow their next generation.
-        DAWN_ASSERT(obj->GetWireGeneration() != 0);
-        DAWN_ASSERT(mObjects[id] == nullptr);
-        mObjects[id] = std::move(obj);
-    }
+    const ObjectHandle& handle = obj->GetWireHandle();
+    Slot* slot = GetSlot(handle.id);
+    DAWN_ASSERT(slot != nullptr);
+
+    // The generation should never overflow. We don't recycle ObjectIds that would
+    // overflow their next generation.
+    DAWN_ASSERT(handle.generation == slot->generation.load(std::memory_order_relaxed));
+    DAWN_ASSERT(slot->object.load(std::memory_order_relaxed) == nullptr);
+    slot->object.store(obj.release(), std::memory_order_release);
 }
 
 void ObjectStore::Free(ObjectBase* obj) {
@@ -68,18 +128,40 @@ void ObjectStore::Free(ObjectBase* obj) {
     // To avoid issues with asynchronous server->client communication referring to an ID that's
     // already reused, each handle also has a generation that's increment by one on each reuse.
     // Avoid overflows by only reusing the ID if the increment of the generation won't overflow.
-    const ObjectHandle& currentHandle = obj->GetWireHandle();
-    if (DAWN_LIKELY(currentHandle.generation != std::numeric_limits<ObjectGeneration>::max())) {
-        mFreeHandles.push_back({currentHandle.id, currentHandle.generation + 1});
+    const ObjectHandle currentHandle = obj->GetWireHandle();
+    Slot* slot = GetSlot(currentHandle.id);
+    DAWN_ASSERT(slot != nullptr && slot->object.load(std::memory_order_relaxed) == obj);
+    slot->object.store(nullptr, std::memory_order_relaxed);
+    delete obj;
+
+    if (DAWN_UNLIKELY(currentHandle.generation == std::numeric_limits<ObjectGeneration>::max())) {
+        return;
     }
-    mObjects[currentHandle.id] = nullptr;
+    slot->generation.store(currentHandle.generation + 1, std::memory_order_relaxed);
+
+    uint64_t head = mFreeHandlesHead.load(std::memory_order_relaxed);
+    do {
+        slot->nextFreeId.store(static_cast<ObjectId>(head & kFreeHandlesIdMask),
+                               std::memory_order_relaxed);
+    } while (!mFreeHandlesHead.compare_exchange_weak(
+        head, MakeFreeHandlesHead(head, currentHandle.id), std::memory_order_release,
+        std::memory_order_relaxed));
 }
 
 ObjectBase* ObjectStore::Get(ObjectId id) const {
-    if (id >= mObjects.size()) {
+    Slot* slot = GetSlot(id);
+    if (slot == nullptr) {
+        return nullptr;
+    }
+    return slot->object.load(std::memory_order_acquire);
+}
+
+ObjectBase* ObjectStore::Get(const ObjectHandle& handle) const {
+    ObjectBase* object = Get(handle.id);
+    if (object == nullptr || object->GetWireGeneration() != handle.generation) {
         return nullptr;
     }
-    return mObjects[id].get();
+    return object;
 }
 
 }  // namespace dawn::wire::client
@@ -28,8 +28,10 @@
 #ifndef SRC_DAWN_WIRE_CLIENT_OBJECTSTORE_H_
 #define SRC_DAWN_WIRE_CLIENT_OBJECTSTORE_H_
 
+#include <array>
+#include <atomic>
 #include <memory>
-#include <vector>
+#include <mutex>
 
 #include "dawn/wire/client/ObjectBase.h"
 
@@ -44,19 +46,47 @@ class Client;
 // Since the wire has one "ID" namespace per type of object, each ObjectStore should contain a
 // single type of objects. However no templates are used because Client wraps ObjectStore and is
 // type-generic, so ObjectStore is type-erased to only work on ObjectBase.
+//
+// ObjectStore is thread-safe and doesn't take locks except when it grows: the objects are stored
+// in slots that never move, and the free handles are kept in a lock-free list threaded through
+// the slots.
 class ObjectStore {
   public:
     ObjectStore();
+    ~ObjectStore();
 
     ObjectHandle ReserveHandle();
     void Insert(std::unique_ptr<ObjectBase> obj);
     void Free(ObjectBase* obj);
     ObjectBase* Get(ObjectId id) const;
+    // Same as Get(handle.id) but returns nullptr if the ID was reused by a later generation.
+    ObjectBase* Get(const ObjectHandle& handle) const;
 
   private:
-    uint32_t mCurrentId;
-    std::vector<ObjectHandle> mFreeHandles;
-    std::vector<std::unique_ptr<ObjectBase>> mObjects;
+    struct Slot {
+        std::atomic<ObjectBase*> object{nullptr};
+        // The generation of the last handle reserved in this slot.
+        std::atomic<ObjectGeneration> generation{0};
+        // The next ID in the list of free handles when this slot is in it.
+        std::atomic<ObjectId> nextFreeId{0};
+    };
+
+    // Segment i contains kFirstSegmentSize * 2^i slots, which is enough to hold all the IDs
+    // with kSegmentCount segments.
+    static constexpr uint64_t kFirstSegmentSize = 64;
+    static constexpr size_t kSegmentCount = 27;
+
+    // Returns nullptr if the slot for |id| wasn't allocated yet.
+    Slot* GetSlot(ObjectId id) const;
+    Slot* GetOrCreateSlot(ObjectId id);
+
+    std::array<std::atomic<Slot*>, kSegmentCount> mSegments = {};
+    std::mutex mSegmentCreationMutex;
+
+    std::atomic<ObjectId> mCurrentId;
+    // The ID of the first free handle in the low 32 bits, and a counter in the high 32 bits that
+    // is incremented on each update to prevent ABA issues. An ID of 0 means the list is empty.
+    std::atomic<uint64_t> mFreeHandlesHead{0};
 };
 
 }  // namespace dawn::wire::client
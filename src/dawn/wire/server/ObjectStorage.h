@@ -29,7 +29,6 @@
 #define SRC_DAWN_WIRE_SERVER_OBJECTSTORAGE_H_
 
 #include <algorithm>
-#include <map>
 #include <memory>
 #include <unordered_set>
 #include <utility>
@@ -277,29 +276,94 @@ class KnownObjects<WGPUDevice> : public KnownObjectsBase<WGPUDevice> {
 // ObjectIds are lost in deserialization. Store the ids of deserialized
 // objects here so they can be used in command handlers. This is useful
 // for creating ReturnWireCmds which contain client ids
+//
+// The table uses open addressing with linear probing on the backend handles, which are never
+// nullptr, and is kept at most half full.
 template <typename T>
 class ObjectIdLookupTable {
   public:
-    void Store(T key, ObjectId id) { mTable[key] = id; }
+    void Store(T key, ObjectId id) {
+        DAWN_ASSERT(key != nullptr);
+        if ((mCount + 1) * 2 > mEntries.size()) {
+            Grow();
+        }
+
+        Entry* entry = &mEntries[FindIndex(key)];
+        if (entry->key == nullptr) {
+            entry->key = key;
+            mCount++;
+        }
+        entry->id = id;
+    }
 
     // Return the cached ObjectId, or 0 (null handle)
     ObjectId Get(T key) const {
-        const auto it = mTable.find(key);
-        if (it != mTable.end()) {
-            return it->second;
+        if (mCount == 0 || key == nullptr) {
+            return 0;
         }
-        return 0;
+        const Entry& entry = mEntries[FindIndex(key)];
+        return entry.key == key ? entry.id : 0;
     }
 
     void Remove(T key) {
-        auto it = mTable.find(key);
-        if (it != mTable.end()) {
-            mTable.erase(it);
+        if (mCount == 0 || key == nullptr) {
+            return;
         }
+        size_t hole = FindIndex(key);
+        if (mEntries[hole].key != key) {
+            return;
+        }
+
+        // Shift back the following entries of the probe sequence that can fill the hole, so that
+        // lookups never need tombstones.
+        size_t mask = mEntries.size() - 1;
+        for (size_t i = (hole + 1) & mask; mEntries[i].key != nullptr; i = (i + 1) & mask) {
+            size_t ideal = Hash(mEntries[i].key) & mask;
+            if (((i - ideal) & mask) >= ((i - hole) & mask)) {
+                mEntries[hole] = mEntries[i];
+                hole = i;
+            }
+        }
+        mEntries[hole] = {};
+        mCount--;
     }
 
   private:
-    std::map<T, ObjectId> mTable;
+    struct Entry {
+        T key = nullptr;
+        ObjectId id = 0;
+    };
+
+    static constexpr size_t kInitialSize = 16;
+
+    static size_t Hash(T key) {
+        // Fibonacci hashing, keeping the high bits which depend on all the bits of the pointer.
+        uint64_t value = static_cast<uint64_t>(reinterpret_cast<uintptr_t>(key));
+        return static_cast<size_t>((value * uint64_t(0x9E3779B97F4A7C15)) >> 32);
+    }
+
+    // Returns the index of the entry for |key|, or of the empty entry where it would be inserted.
+    size_t FindIndex(T key) const {
+        size_t mask = mEntries.size() - 1;
+        size_t i = Hash(key) & mask;
+        while (mEntries[i].key != nullptr && mEntries[i].key != key) {
+            i = (i + 1) & mask;
+        }
+        return i;
+    }
+
+    void Grow() {
+        size_t newSize = std::max(kInitialSize, 2 * mEntries.size());
+        std::vector<Entry> oldEntries = std::exchange(mEntries, std::vector<Entry>(newSize));
+        for (const Entry& entry : oldEntries) {
+            if (entry.key != nullptr) {
+                mEntries[FindIndex(entry.key)] = entry;
+            }
+        }
+    }
+
+    std::vector<Entry> mEntries;
+    size_t mCount = 0;
 };
 
 }  // namespace dawn::wire::server
@@ -50,6 +50,7 @@ tint_target_add_dependencies(tint_cmd_bench_bench_cmd bench_cmd
   tint_lang_core_bench
   tint_lang_wgsl
   tint_lang_wgsl_ast
+  tint_lang_wgsl_ast_transform_bench
   tint_lang_wgsl_program
   tint_lang_wgsl_sem
   tint_lang_wgsl_bench
@@ -62,6 +62,10 @@ class Void;
 namespace tint::core::type {
 
 /// The type manager holds all the pointers to the known types.
+/// The const methods of the Manager don't modify it, and can be called concurrently from multiple
+/// threads as long as no non-const method is called at the same time. The Manager of a built
+/// Program is only accessible through const methods, and new types for a cloned program are
+/// created in the Manager of the destination ProgramBuilder.
 class Manager final {
   public:
     /// Iterator is the type returned by begin() and end()
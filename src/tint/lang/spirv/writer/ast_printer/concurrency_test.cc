@@ -0,0 +1,161 @@
+// Copyright 2024 The Dawn & Tint Authors
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+//
+// 1. Redistributions of source code must retain the above copyright notice, this
+//    list of conditions and the following disclaimer.
+//
+// 2. Redistributions in binary form must reproduce the above copyright notice,
+//    this list of conditions and the following disclaimer in the documentation
+//    and/or other materials provided with the distribution.
+//
+// 3. Neither the name of the copyright holder nor the names of its
+//    contributors may be used to endorse or promote products derived from
+//    this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+// DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+// FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+// DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+// SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+// CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+// OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+// OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+
+// GEN_BUILD:CONDITION(tint_build_wgsl_reader && tint_build_wgsl_writer)
+
+#include <filesystem>
+#include <fstream>
+#include <sstream>
+#include <string>
+#include <thread>
+#include <utility>
+#include <vector>
+
+#include "gtest/gtest.h"
+#include "src/tint/lang/spirv/writer/writer.h"
+#include "src/tint/lang/wgsl/reader/reader.h"
+#include "src/tint/lang/wgsl/writer/writer.h"
+
+namespace tint::spirv::writer {
+namespace {
+
+/// The shaders used by the Tint benchmarks, found under test/tint/benchmark.
+const char* const kBenchmarkShaders[] = {
+    "atan2-const-eval.wgsl",
+    "cluster-lights.wgsl",
+    "metaball-isosurface.wgsl",
+    "particles.wgsl",
+    "shadow-fragment.wgsl",
+    "skinned-shadowed-pbr-fragment.wgsl",
+    "skinned-shadowed-pbr-vertex.wgsl",
+};
+
+/// @returns the path to test/tint/benchmark, searching up from the current working directory, or
+/// an empty path if it could not be found.
+std::filesystem::path FindBenchmarkInputDir() {
+    auto path = std::filesystem::current_path();
+    while (std::filesystem::is_directory(path)) {
+        auto dir = path / "test" / "tint" / "benchmark";
+        if (std::filesystem::is_directory(dir)) {
+            return dir;
+        }
+        auto parent = path.parent_path();
+        if (path == parent) {
+            break;
+        }
+        path = parent;
+    }
+    return {};
+}
+
+/// The output of both writers for a single program.
+struct WriterOutputs {
+    std::vector<uint32_t> spirv;
+    std::string wgsl;
+    std::string error;
+};
+
+/// Runs the SPIR-V writer, including its full set of AST transforms, and the WGSL writer on
+/// @p program.
+WriterOutputs Run(const Program& program) {
+    WriterOutputs outputs;
+    auto spirv = Generate(program, Options{});
+    if (!spirv) {
+        outputs.error = spirv.Failure().reason.str();
+        return outputs;
+    }
+    outputs.spirv = std::move(spirv->spirv);
+
+    auto wgsl = wgsl::writer::Generate(program, wgsl::writer::Options{});
+    if (!wgsl) {
+        outputs.error = wgsl.Failure().reason.str();
+        return outputs;
+    }
+    outputs.wgsl = std::move(wgsl->wgsl);
+    return outputs;
+}
+
+using SpirvWriterConcurrencyTest = testing::TestWithParam<const char*>;
+
+// Test that the SPIR-V and WGSL writers can run concurrently on multiple threads from the same
+// input program, as Dawn does when it compiles several pipelines from one shader module. Running
+// this under TSAN checks that the writers and the transforms only read from the shared program.
+TEST_P(SpirvWriterConcurrencyTest, GenerateOnSharedProgram) {
+    static constexpr size_t kNumThreads = 8;
+
+    auto dir = FindBenchmarkInputDir();
+    if (dir.empty()) {
+        GTEST_SKIP() << "failed to locate benchmark input files";
+    }
+
+    auto path = (dir / GetParam()).string();
+    std::ifstream stream(path, std::ios::binary);
+    ASSERT_TRUE(stream.good()) << "failed to open " << path;
+    std::stringstream content;
+    content << stream.rdbuf();
+
+    Source::File file(path, content.str());
+    Program program = wgsl::reader::Parse(&file);
+    ASSERT_TRUE(program.IsValid()) << program.Diagnostics();
+
+    WriterOutputs expected = Run(program);
+    ASSERT_EQ(expected.error, "");
+    ASSERT_FALSE(expected.spirv.empty());
+    ASSERT_FALSE(expected.wgsl.empty());
+
+    std::vector<WriterOutputs> results(kNumThreads);
+    std::vector<std::thread> threads;
+    for (size_t t = 0; t < kNumThreads; t++) {
+        threads.emplace_back([&, t] { results[t] = Run(program); });
+    }
+    for (auto& thread : threads) {
+        thread.join();
+    }
+
+    for (auto& result : results) {
+        EXPECT_EQ(result.error, "");
+        EXPECT_EQ(result.spirv, expected.spirv);
+        EXPECT_EQ(result.wgsl, expected.wgsl);
+    }
+}
+
+INSTANTIATE_TEST_SUITE_P(,
+                         SpirvWriterConcurrencyTest,
+                         testing::ValuesIn(kBenchmarkShaders),
+                         [](const testing::TestParamInfo<const char*>& info) {
+                             std::string name = info.param;
+                             name = name.substr(0, name.find('.'));
+                             for (auto& c : name) {
+                                 if (c == '-') {
+                                     c = '_';
+                                 }
+                             }
+                             return name;
+                         });
+
+}  // namespace
+}  // namespace tint::spirv::writer
@@ -226,6 +226,47 @@ if(TINT_BUILD_WGSL_WRITER)
 endif(TINT_BUILD_WGSL_WRITER)
 
 endif(TINT_BUILD_WGSL_READER AND TINT_BUILD_WGSL_WRITER)
+################################################################################
+# Target:    tint_lang_wgsl_ast_transform_bench
+# Kind:      bench
+################################################################################
+tint_add_target(tint_lang_wgsl_ast_transform_bench bench
+  lang/wgsl/ast/transform/manager_bench.cc
+)
+
+tint_target_add_dependencies(tint_lang_wgsl_ast_transform_bench bench
+  tint_api_common
+  tint_api_options
+  tint_cmd_bench_bench
+  tint_lang_core
+  tint_lang_core_constant
+  tint_lang_core_type
+  tint_lang_wgsl
+  tint_lang_wgsl_ast
+  tint_lang_wgsl_ast_transform
+  tint_lang_wgsl_common
+  tint_lang_wgsl_features
+  tint_lang_wgsl_program
+  tint_lang_wgsl_sem
+  tint_utils_containers
+  tint_utils_diagnostic
+  tint_utils_ice
+  tint_utils_id
+  tint_utils_macros
+  tint_utils_math
+  tint_utils_memory
+  tint_utils_reflection
+  tint_utils_result
+  tint_utils_rtti
+  tint_utils_symbol
+  tint_utils_text
+  tint_utils_traits
+)
+
+tint_target_add_external_dependencies(tint_lang_wgsl_ast_transform_bench bench
+  "google-benchmark"
+)
+
 if(TINT_BUILD_WGSL_READER)
 ################################################################################
 # Target:    tint_lang_wgsl_ast_transform_fuzz
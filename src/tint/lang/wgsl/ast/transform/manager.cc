@@ -48,6 +48,19 @@ Manager::Manager() = default;
 Manager::~Manager() = default;
 
 Program Manager::Run(const Program& program_in, const DataMap& inputs, DataMap& outputs) const {
+    if (auto output = Apply(program_in, inputs, outputs)) {
+        return std::move(output.value());
+    }
+
+    ProgramBuilder b;
+    program::CloneContext ctx{&b, &program_in, /* auto_clone_symbols */ true};
+    ctx.Clone();
+    return resolver::Resolve(b);
+}
+
+Transform::ApplyResult Manager::Apply(const Program& program_in,
+                                      const DataMap& inputs,
+                                      DataMap& outputs) const {
     const Program* program = &program_in;
 
 #if TINT_PRINT_PROGRAM_FOR_EACH_TRANSFORM
@@ -91,13 +104,7 @@ Program Manager::Run(const Program& program_in, const DataMap& inputs, DataMap&
 
     TINT_IF_PRINT_PROGRAM(print_program("Final output of", nullptr));
 
-    if (!output) {
-        ProgramBuilder b;
-        program::CloneContext ctx{&b, program, /* auto_clone_symbols */ true};
-        ctx.Clone();
-        output = resolver::Resolve(b);
-    }
-    return std::move(output.value());
+    return output;
 }
 
 }  // namespace tint::ast::transform
@@ -69,6 +69,17 @@ class Manager {
     /// @returns the transformed program
     Program Run(const Program& program, const DataMap& inputs, DataMap& outputs) const;
 
+    /// Runs the transforms on @p program. Unlike Run(), @p program is not cloned if all the
+    /// transforms were skipped, which saves a clone and resolve of the whole program.
+    /// @param program the source program to transform
+    /// @param inputs optional extra transform-specific input data
+    /// @param outputs optional extra transform-specific output data
+    /// @returns the transformed program, or Transform::SkipTransform if all the transforms were
+    /// skipped, in which case @p program can be used as is.
+    Transform::ApplyResult Apply(const Program& program,
+                                 const DataMap& inputs,
+                                 DataMap& outputs) const;
+
   private:
     std::vector<std::unique_ptr<Transform>> transforms_;
 };
@@ -0,0 +1,138 @@
+// Copyright 2024 The Dawn & Tint Authors
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+//
+// 1. Redistributions of source code must retain the above copyright notice, this
+//    list of conditions and the following disclaimer.
+//
+// 2. Redistributions in binary form must reproduce the above copyright notice,
+//    this list of conditions and the following disclaimer in the documentation
+//    and/or other materials provided with the distribution.
+//
+// 3. Neither the name of the copyright holder nor the names of its
+//    contributors may be used to endorse or promote products derived from
+//    this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+// DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+// FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+// DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+// SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+// CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+// OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+// OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+
+#include <atomic>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "src/tint/cmd/bench/bench.h"
+#include "src/tint/lang/wgsl/ast/transform/manager.h"
+#include "src/tint/lang/wgsl/ast/transform/renamer.h"
+#include "src/tint/lang/wgsl/ast/transform/single_entry_point.h"
+
+namespace tint::ast::transform {
+namespace {
+
+// Runs the transforms that Dawn's Vulkan backend applies before generating SPIR-V, once per entry
+// point of the program.
+void RunVulkanTransforms(benchmark::State& state, std::string input_name, bool rename) {
+    auto res = bench::LoadProgram(input_name);
+    if (!res) {
+        state.SkipWithError(res.Failure().reason.str());
+        return;
+    }
+
+    std::vector<std::string> entry_points;
+    for (auto* func : res->program.AST().Functions()) {
+        if (func->IsEntryPoint()) {
+            entry_points.push_back(func->name->symbol.Name());
+        }
+    }
+
+    for (auto _ : state) {
+        for (const std::string& entry_point : entry_points) {
+            Manager manager;
+            DataMap inputs;
+            manager.Add<SingleEntryPoint>();
+            inputs.Add<SingleEntryPoint::Config>(entry_point);
+            if (rename) {
+                manager.Add<Renamer>();
+            }
+
+            DataMap outputs;
+            auto output = manager.Apply(res->program, inputs, outputs);
+            if (output && !output->IsValid()) {
+                state.SkipWithError(output->Diagnostics().str());
+                return;
+            }
+        }
+    }
+}
+
+void VulkanTransforms(benchmark::State& state, std::string input_name) {
+    RunVulkanTransforms(state, input_name, true);
+}
+
+void VulkanTransformsNoRenaming(benchmark::State& state, std::string input_name) {
+    RunVulkanTransforms(state, input_name, false);
+}
+
+// Runs the Vulkan transforms for every entry point on multiple threads at once, all reading from
+// the same input program.
+void ConcurrentVulkanTransforms(benchmark::State& state, std::string input_name) {
+    static constexpr size_t kNumThreads = 8;
+
+    auto res = bench::LoadProgram(input_name);
+    if (!res) {
+        state.SkipWithError(res.Failure().reason.str());
+        return;
+    }
+
+    std::vector<std::string> entry_points;
+    for (auto* func : res->program.AST().Functions()) {
+        if (func->IsEntryPoint()) {
+            entry_points.push_back(func->name->symbol.Name());
+        }
+    }
+
+    for (auto _ : state) {
+        std::vector<std::thread> threads;
+        std::atomic<bool> valid{true};
+        for (size_t i = 0; i < kNumThreads; i++) {
+            threads.emplace_back([&] {
+                for (const std::string& entry_point : entry_points) {
+                    Manager manager;
+                    DataMap inputs;
+                    manager.Add<SingleEntryPoint>();
+                    inputs.Add<SingleEntryPoint::Config>(entry_point);
+                    manager.Add<Renamer>();
+
+                    DataMap outputs;
+                    auto output = manager.Apply(res->program, inputs, outputs);
+                    if (output && !output->IsValid()) {
+                        valid = false;
+                    }
+                }
+            });
+        }
+        for (auto& thread : threads) {
+            thread.join();
+        }
+        if (!valid) {
+            state.SkipWithError("transform produced an invalid program");
+            return;
+        }
+    }
+}
+
+TINT_BENCHMARK_PROGRAMS(VulkanTransforms);
+TINT_BENCHMARK_PROGRAMS(VulkanTransformsNoRenaming);
+TINT_BENCHMARK_PROGRAMS(ConcurrentVulkanTransforms);
+
+}  // namespace
+}  // namespace tint::ast::transform
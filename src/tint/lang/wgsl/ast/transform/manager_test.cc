@@ -28,13 +28,19 @@
 #include "src/tint/lang/wgsl/ast/transform/manager.h"
 
 #include <string>
+#include <thread>
+#include <vector>
 
 #include "gtest/gtest.h"
+#include "src/tint/lang/wgsl/ast/transform/renamer.h"
+#include "src/tint/lang/wgsl/ast/transform/single_entry_point.h"
 #include "src/tint/lang/wgsl/ast/transform/transform.h"
 #include "src/tint/lang/wgsl/program/clone_context.h"
 #include "src/tint/lang/wgsl/program/program_builder.h"
 #include "src/tint/lang/wgsl/resolver/resolve.h"
 
+using namespace tint::core::number_suffixes;  // NOLINT
+
 namespace tint::ast::transform {
 namespace {
 
@@ -77,5 +83,95 @@ TEST_F(TransformManagerTest, AST_AlwaysClone) {
     EXPECT_EQ(result.AST().Functions()[0]->name->symbol.Name(), "main");
 }
 
+// Test that Apply() doesn't clone the program if all transforms are skipped.
+TEST_F(TransformManagerTest, AST_ApplySkipsClone) {
+    Program ast = MakeAST();
+
+    Manager manager;
+    DataMap outputs;
+    manager.Add<AST_NoOp>();
+
+    auto result = manager.Apply(ast, {}, outputs);
+    EXPECT_FALSE(result.has_value());
+}
+
+// Test that Apply() returns the output of the transforms that ran.
+TEST_F(TransformManagerTest, AST_Apply) {
+    Program ast = MakeAST();
+
+    Manager manager;
+    DataMap outputs;
+    manager.Add<AST_NoOp>();
+    manager.Add<AST_AddFunction>();
+
+    auto result = manager.Apply(ast, {}, outputs);
+    ASSERT_TRUE(result.has_value());
+    EXPECT_TRUE(result->IsValid()) << result->Diagnostics();
+    EXPECT_EQ(result->AST().Functions().Length(), 2u);
+}
+
+// Test that transforms can run concurrently on multiple threads from the same input program.
+TEST_F(TransformManagerTest, AST_ConcurrentApplyOnSharedProgram) {
+    static constexpr size_t kNumThreads = 8;
+    static constexpr size_t kNumEntryPoints = 4;
+
+    ProgramBuilder b;
+    b.GlobalVar("g", b.ty.i32(), core::AddressSpace::kPrivate);
+    b.Func("helper", tint::Empty, b.ty.i32(), Vector{b.Return("g")});
+    for (size_t i = 0; i < kNumEntryPoints; i++) {
+        b.Func("main" + std::to_string(i), tint::Empty, b.ty.void_(),
+               Vector{b.Assign(b.Phony(), b.Call("helper"))},
+               Vector{b.Stage(PipelineStage::kCompute), b.WorkgroupSize(1_a)});
+    }
+    Program src = resolver::Resolve(b);
+    ASSERT_TRUE(src.IsValid()) << src.Diagnostics();
+
+    // Runs the transforms that Dawn runs before generating code for an entry point, and returns
+    // the names of the functions of the output program.
+    auto Run = [&src](size_t entry_point) {
+        Manager manager;
+        DataMap inputs;
+        manager.Add<SingleEntryPoint>();
+        inputs.Add<SingleEntryPoint::Config>("main" + std::to_string(entry_point));
+        manager.Add<Renamer>();
+
+        DataMap outputs;
+        std::vector<std::string> names;
+        auto output = manager.Apply(src, inputs, outputs);
+        if (!output.has_value() || !output->IsValid()) {
+            return names;
+        }
+        for (auto* func : output->AST().Functions()) {
+            names.push_back(func->name->symbol.Name());
+        }
+        return names;
+    };
+
+    std::vector<std::vector<std::string>> expected(kNumEntryPoints);
+    for (size_t i = 0; i < kNumEntryPoints; i++) {
+        expected[i] = Run(i);
+        ASSERT_EQ(expected[i].size(), 2u);
+    }
+
+    std::vector<std::vector<std::string>> results(kNumThreads * kNumEntryPoints);
+    std::vector<std::thread> threads;
+    for (size_t t = 0; t < kNumThreads; t++) {
+        threads.emplace_back([&, t] {
+            for (size_t i = 0; i < kNumEntryPoints; i++) {
+                results[t * kNumEntryPoints + i] = Run(i);
+            }
+        });
+    }
+    for (auto& thread : threads) {
+        thread.join();
+    }
+
+    for (size_t t = 0; t < kNumThreads; t++) {
+        for (size_t i = 0; i < kNumEntryPoints; i++) {
+            EXPECT_EQ(results[t * kNumEntryPoints + i], expected[i]);
+        }
+    }
+}
+
 }  // namespace
 }  // namespace tint::ast::transform
@@ -80,6 +80,32 @@ Transform::ApplyResult SingleEntryPoint::Apply(const Program& src,
     auto& sem = src.Sem();
     auto& referenced_vars = sem.Get(entry_point)->TransitivelyReferencedGlobals();
 
+    // Skip the transform if no declaration would be removed, which is common for shader modules
+    // with a single entry point.
+    bool strips_declarations = false;
+    for (auto* decl : src.AST().GlobalDeclarations()) {
+        strips_declarations = Switch(
+            decl,  //
+            [&](const Override* override) {
+                return !referenced_vars.Contains(sem.Get(override));
+            },
+            [&](const Var* var) {
+                return !referenced_vars.Contains(sem.Get<sem::GlobalVariable>(var));
+            },
+            [&](const Function* func) {
+                return func != entry_point &&
+                       !sem.Get(func)->HasAncestorEntryPoint(entry_point->name->symbol);
+            },
+            [&](const Requires*) { return true; },  //
+            [&](Default) { return false; });
+        if (strips_declarations) {
+            break;
+        }
+    }
+    if (!strips_declarations) {
+        return SkipTransform;
+    }
+
     // Clone any module-scope variables, types, and functions that are statically referenced by the
     // target entry point.
     for (auto* decl : src.AST().GlobalDeclarations()) {
@@ -112,6 +112,58 @@ fn main() {
     EXPECT_EQ(src, str(got));
 }
 
+TEST_F(SingleEntryPointTest, ShouldRunSingleEntryPoint) {
+    auto* src = R"(
+var<private> v : f32;
+
+fn helper() {
+  v = 1.0;
+}
+
+@compute @workgroup_size(1)
+fn main() {
+  helper();
+}
+)";
+
+    DataMap data;
+    data.Add<SingleEntryPoint::Config>("main");
+
+    EXPECT_FALSE(ShouldRun<SingleEntryPoint>(src, data));
+}
+
+TEST_F(SingleEntryPointTest, ShouldRunMultipleEntryPoints) {
+    auto* src = R"(
+@compute @workgroup_size(1)
+fn main1() {
+}
+
+@compute @workgroup_size(1)
+fn main2() {
+}
+)";
+
+    DataMap data;
+    data.Add<SingleEntryPoint::Config>("main1");
+
+    EXPECT_TRUE(ShouldRun<SingleEntryPoint>(src, data));
+}
+
+TEST_F(SingleEntryPointTest, ShouldRunUnusedGlobal) {
+    auto* src = R"(
+var<private> v : f32;
+
+@compute @workgroup_size(1)
+fn main() {
+}
+)";
+
+    DataMap data;
+    data.Add<SingleEntryPoint::Config>("main");
+
+    EXPECT_TRUE(ShouldRun<SingleEntryPoint>(src, data));
+}
+
 TEST_F(SingleEntryPointTest, MultipleEntryPoints) {
     auto* src = R"(
 @vertex
@@ -38,6 +38,8 @@
 namespace tint::program {
 
 /// CloneContext holds the state used while cloning Programs.
+/// The source Program is only read by the CloneContext, so multiple CloneContexts can clone from
+/// the same Program concurrently on different threads, each into its own ProgramBuilder.
 class CloneContext {
   public:
     /// SymbolTransform is a function that takes a symbol and returns a new
@@ -46,6 +46,12 @@ class Module;
 namespace tint {
 
 /// Program holds the AST, Type information and SymbolTable for a tint program.
+///
+/// A Program is immutable once built: its AST, semantic info, types, constants and symbols can only
+/// be accessed through const methods, none of which modify the program. A Program can therefore be
+/// shared between threads without synchronization, for example to run several transforms and
+/// writers from the same input program concurrently, as long as it is not moved, assigned or
+/// destructed while being used.
 class Program {
   public:
     /// ASTNodeAllocator is an alias to BlockAllocator<ast::Node>
@@ -37,6 +37,8 @@
 namespace tint {
 
 /// Holds mappings from symbols to their associated string names
+/// The const methods of the SymbolTable don't modify it, and can be called concurrently from
+/// multiple threads as long as no non-const method is called at the same time.
 class SymbolTable {
   public:
     /// Constructor